@@ -36,3 +36,37 @@ macro(moveit_get_include_and_libs_from_target namespace tgt)
   get_target_property(${namespace}_INTERFACE_LINK_LIBRARIES ${tgt} INTERFACE_LINK_LIBRARIES)
   set(${namespace}_LIBRARIES ${tgt} ${${namespace}_INTERFACE_LINK_LIBRARIES})
 endmacro()
+
+# Generate C++ source with forward kinematics compiled for a fixed robot model and add it to the sources of TARGET.
+# Fixed transforms are folded into constants and the kinematic tree is unrolled. Once linked, the generated code
+# registers itself and RobotState uses it for all robot models matching the given URDF and SRDF.
+# Jacobians are generated for the chain GROUPS, w.r.t. their tip link or the link given as group:link.
+# TARGET should be an executable or shared library: static libraries may drop the registration.
+#
+#   moveit_generate_fk(TARGET my_node URDF robot.urdf SRDF robot.srdf [GROUPS arm arm:tool0])
+function(moveit_generate_fk)
+  cmake_parse_arguments(ARG "" "TARGET;URDF;SRDF" "GROUPS" ${ARGN})
+  if(NOT ARG_TARGET OR NOT ARG_URDF OR NOT ARG_SRDF)
+    message(FATAL_ERROR "moveit_generate_fk() requires TARGET, URDF and SRDF")
+  endif()
+
+  if(TARGET moveit_generate_fk)
+    set(generator $<TARGET_FILE:moveit_generate_fk>)
+  else()
+    find_program(MOVEIT_GENERATE_FK_EXECUTABLE moveit_generate_fk
+      HINTS ${moveit_core_DIR}/../../../lib/moveit_core ${moveit_core_DIR}/../../../bin)
+    if(NOT MOVEIT_GENERATE_FK_EXECUTABLE)
+      message(FATAL_ERROR "moveit_generate_fk() cannot find the moveit_generate_fk executable")
+    endif()
+    set(generator ${MOVEIT_GENERATE_FK_EXECUTABLE})
+  endif()
+
+  set(output ${CMAKE_CURRENT_BINARY_DIR}/${ARG_TARGET}_fk_accelerator.cpp)
+  add_custom_command(
+    OUTPUT ${output}
+    COMMAND ${generator} ${ARG_URDF} ${ARG_SRDF} ${output} ${ARG_GROUPS}
+    DEPENDS ${ARG_URDF} ${ARG_SRDF} ${generator}
+    COMMENT "Generating forward kinematics for ${ARG_TARGET} from ${ARG_URDF}"
+  )
+  target_sources(${ARG_TARGET} PRIVATE ${output})
+endfunction()
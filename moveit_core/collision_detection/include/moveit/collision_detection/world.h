@@ -149,6 +149,13 @@ public:
   /** \brief Check if a particular object exists in the collision world*/
   bool hasObject(const std::string& object_id) const;
 
+  /** \brief Get the version of the world. It changes whenever an object is added, modified or removed, and is unique
+   * among all World instances. */
+  std::size_t getVersion() const
+  {
+    return version_;
+  }
+
   /** \brief Check if an object or subframe with given name exists in the collision world.
    * A subframe name needs to be prefixed with the object's name separated by a slash. */
   bool knowsTransform(const std::string& name) const;
@@ -339,6 +346,9 @@ private:
   /** The objects maintained in the world */
   std::map<std::string, ObjectPtr> objects_;
 
+  /** Changed after each modification of objects_ */
+  std::size_t version_;
+
   /** Wrapper for a callback function to call when something changes in the world */
   class Observer
   {
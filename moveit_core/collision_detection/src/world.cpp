@@ -38,14 +38,24 @@
 #include <geometric_shapes/check_isometry.h>
 #include <boost/algorithm/string/predicate.hpp>
 #include <ros/console.h>
+#include <atomic>
 
 namespace collision_detection
 {
-World::World()
+namespace
+{
+std::size_t newVersion()
+{
+  static std::atomic<std::size_t> counter(0);
+  return ++counter;
+}
+}  // namespace
+
+World::World() : version_(newVersion())
 {
 }
 
-World::World(const World& other)
+World::World(const World& other) : version_(newVersion())
 {
   objects_ = other.objects_;
 }
@@ -354,6 +364,7 @@ bool World::setSubframesOfObject(const std::string& object_id, const moveit::cor
   obj_pair->second->subframe_poses_ = subframe_poses;
   obj_pair->second->global_subframe_poses_ = subframe_poses;
   updateGlobalPosesInternal(obj_pair->second, false, true);
+  version_ = newVersion();
   return true;
 }
 
@@ -406,6 +417,8 @@ void World::notify(const ObjectConstPtr& obj, Action action)
 {
   for (Observer* observer : observers_)
     observer->callback_(obj, action);
+  // after the callbacks, so that frames resolved by observers are considered outdated too
+  version_ = newVersion();
 }
 
 void World::notifyObserverAllObjects(const ObserverHandle observer_handle, Action action) const
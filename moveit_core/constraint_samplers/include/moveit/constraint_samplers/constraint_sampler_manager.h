@@ -38,6 +38,8 @@
 
 #include <moveit/constraint_samplers/constraint_sampler_allocator.h>
 #include <moveit/macros/class_forward.h>
+#include <moveit/reachability_map/reachability_map.h>
+#include <map>
 
 namespace constraint_samplers
 {
@@ -72,6 +74,18 @@ public:
   {
     sampler_alloc_.push_back(sa);
   }
+
+  /**
+   * \brief Register a precomputed reachability map for the group it was computed for.
+   *
+   * IKConstraintSampler instances returned by \ref selectSampler for that group (directly or as part of a
+   * UnionConstraintSampler) use the map to skip unreachable poses and to seed IK. A map registered
+   * for the same group replaces the previous one.
+   */
+  void registerReachabilityMap(const reachability_map::ReachabilityMapConstPtr& reachability_map)
+  {
+    reachability_maps_[reachability_map->getGroupName()] = reachability_map;
+  }
   /**
    * \brief Selects among the potential sampler allocators.
    *
@@ -138,7 +152,12 @@ public:
                                                    const moveit_msgs::Constraints& constr);
 
 private:
+  /** \brief Hand the registered reachability maps to the IK samplers contained in \e sampler */
+  void attachReachabilityMaps(const ConstraintSamplerPtr& sampler) const;
+
   std::vector<ConstraintSamplerAllocatorPtr>
       sampler_alloc_; /**< \brief Holds the constraint sampler allocators, which will be tested in order  */
+  std::map<std::string, reachability_map::ReachabilityMapConstPtr>
+      reachability_maps_; /**< \brief Reachability maps by group name */
 };
 }  // namespace constraint_samplers
@@ -38,6 +38,7 @@
 
 #include <moveit/constraint_samplers/constraint_sampler.h>
 #include <moveit/macros/class_forward.h>
+#include <moveit/reachability_map/reachability_map.h>
 #include <random_numbers/random_numbers.h>
 
 namespace constraint_samplers
@@ -427,6 +428,24 @@ public:
    */
   const std::string& getLinkName() const;
 
+  /**
+   * \brief Use a precomputed reachability map to seed IK.
+   *
+   * Sampled poses in a reachable cell of the map are solved starting from the configuration recorded for the cell.
+   * All other poses are solved from the usual seed.
+   *
+   * Must be called after configure(), which resets the map. The map is only accepted if it was computed for
+   * the group of this sampler and the tip frame of its IK solver.
+   *
+   * @return True if the map is used by this sampler
+   */
+  bool setReachabilityMap(const reachability_map::ReachabilityMapConstPtr& reachability_map);
+
+  const reachability_map::ReachabilityMapConstPtr& getReachabilityMap() const
+  {
+    return reachability_map_;
+  }
+
   /**
    * \brief Produces an IK sample.
    *
@@ -525,5 +544,7 @@ protected:
   bool need_eef_to_ik_tip_transform_; /**< \brief True if the tip frame of the inverse kinematic is different than the
                                         frame of the end effector */
   Eigen::Isometry3d eef_to_ik_tip_transform_; /**< \brief Holds the transformation from end effector to IK tip frame */
+  reachability_map::ReachabilityMapConstPtr reachability_map_; /**< \brief Optional map used to seed IK */
+  std::vector<double> reachability_seed_;                      /**< \brief Scratch space for seeds from the map */
 };
 }  // namespace constraint_samplers
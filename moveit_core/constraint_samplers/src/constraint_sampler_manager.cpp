@@ -46,10 +46,31 @@ constraint_samplers::ConstraintSamplerManager::selectSampler(const planning_scen
 {
   for (const ConstraintSamplerAllocatorPtr& sampler : sampler_alloc_)
     if (sampler->canService(scene, group_name, constr))
-      return sampler->alloc(scene, group_name, constr);
+    {
+      ConstraintSamplerPtr result = sampler->alloc(scene, group_name, constr);
+      attachReachabilityMaps(result);
+      return result;
+    }
 
   // if no default sampler was used, try a default one
-  return selectDefaultSampler(scene, group_name, constr);
+  ConstraintSamplerPtr result = selectDefaultSampler(scene, group_name, constr);
+  attachReachabilityMaps(result);
+  return result;
+}
+
+void constraint_samplers::ConstraintSamplerManager::attachReachabilityMaps(const ConstraintSamplerPtr& sampler) const
+{
+  if (!sampler || reachability_maps_.empty())
+    return;
+  if (IKConstraintSampler* ik_sampler = dynamic_cast<IKConstraintSampler*>(sampler.get()))
+  {
+    auto it = reachability_maps_.find(ik_sampler->getGroupName());
+    if (it != reachability_maps_.end())
+      ik_sampler->setReachabilityMap(it->second);
+  }
+  else if (UnionConstraintSampler* union_sampler = dynamic_cast<UnionConstraintSampler*>(sampler.get()))
+    for (const ConstraintSamplerPtr& s : union_sampler->getSamplers())
+      attachReachabilityMaps(s);
 }
 
 constraint_samplers::ConstraintSamplerPtr
@@ -243,6 +243,25 @@ void IKConstraintSampler::clear()
   transform_ik_ = false;
   eef_to_ik_tip_transform_ = Eigen::Isometry3d::Identity();
   need_eef_to_ik_tip_transform_ = false;
+  reachability_map_.reset();
+}
+
+bool IKConstraintSampler::setReachabilityMap(const reachability_map::ReachabilityMapConstPtr& reachability_map)
+{
+  reachability_map_.reset();
+  if (!reachability_map || !is_valid_)
+    return false;
+  if (reachability_map->getGroupName() != jmg_->getName() ||
+      !moveit::core::Transforms::sameFrame(reachability_map->getTipFrame(), kb_->getTipFrame()))
+  {
+    ROS_WARN_NAMED("constraint_samplers",
+                   "Reachability map for group '%s' and tip '%s' does not match group '%s' with IK tip '%s'",
+                   reachability_map->getGroupName().c_str(), reachability_map->getTipFrame().c_str(),
+                   jmg_->getName().c_str(), kb_->getTipFrame().c_str());
+    return false;
+  }
+  reachability_map_ = reachability_map;
+  return true;
 }
 
 bool IKConstraintSampler::configure(const IKSamplingPose& sp)
@@ -612,6 +631,22 @@ bool IKConstraintSampler::sampleHelper(moveit::core::RobotState& state, const mo
       quat = Eigen::Quaterniond(ikq.linear());  // ikq is isometry, so quat is normalized
     }
 
+    bool use_as_seed = a == 0;
+    if (reachability_map_)
+    {
+      // the map works in the model frame, point and quat are relative to the IK base frame at this stage
+      Eigen::Isometry3d tip_pose(Eigen::Translation3d(point) * quat);  // valid isometry by construction
+      if (transform_ik_)
+        tip_pose = reference_state.getFrameTransform(ik_frame_) * tip_pose;
+      // poses outside of the mapped cells are still tried from a random seed, as the map is sampled and may miss
+      // reachable cells
+      if (reachability_map_->getSeed(reference_state, tip_pose, reachability_seed_))
+      {
+        state.setJointGroupPositions(jmg_, reachability_seed_);
+        use_as_seed = true;
+      }
+    }
+
     geometry_msgs::Pose ik_query;
     ik_query.position.x = point.x();
     ik_query.position.y = point.y();
@@ -621,7 +656,7 @@ bool IKConstraintSampler::sampleHelper(moveit::core::RobotState& state, const mo
     ik_query.orientation.z = quat.z();
     ik_query.orientation.w = quat.w();
 
-    if (callIK(ik_query, adapted_ik_validity_callback, ik_timeout_, state, a == 0))
+    if (callIK(ik_query, adapted_ik_validity_callback, ik_timeout_, state, use_as_seed))
       return true;
   }
   return false;
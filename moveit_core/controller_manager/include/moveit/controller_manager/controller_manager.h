@@ -126,6 +126,23 @@ public:
    * Return false when the controller cannot accept the trajectory. */
   virtual bool sendTrajectory(const moveit_msgs::RobotTrajectory& trajectory) = 0;
 
+  /** \brief Report whether spliceTrajectory() is implemented by this controller. */
+  virtual bool supportsTrajectorySplicing() const
+  {
+    return false;
+  }
+
+  /** \brief Replace the not yet executed tail of the trajectory currently being executed.
+   *
+   * The header stamp of \e trajectory marks the (future) instant from which on its points supersede the ones of the
+   * active trajectory. Motion must not be interrupted and the execution started by sendTrajectory() is continued,
+   * i.e. waitForExecution() returns once the spliced trajectory is complete.
+   * Return false when the controller cannot splice trajectories (the default). */
+  virtual bool spliceTrajectory(const moveit_msgs::RobotTrajectory& /* trajectory */)
+  {
+    return false;
+  }
+
   /** \brief Cancel the execution of any motion using this controller.
    *
    * Report false if canceling is not possible.
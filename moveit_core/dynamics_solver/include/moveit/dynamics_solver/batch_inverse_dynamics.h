@@ -0,0 +1,153 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/robot_model/robot_model.h>
+#include <geometry_msgs/Vector3.h>
+#include <geometry_msgs/Wrench.h>
+
+#include <mutex>
+#include <vector>
+
+namespace dynamics_solver
+{
+MOVEIT_CLASS_FORWARD(BatchInverseDynamics);  // Defines BatchInverseDynamicsPtr, ConstPtr, WeakPtr... etc
+
+/**
+ * Recursive Newton-Euler inverse dynamics for a chain group, evaluated for many waypoints in one call.
+ *
+ * The conventions are those of DynamicsSolver::getTorques(): gravity is given in the frame of the chain's base link
+ * and there is one external wrench per link of the chain (from base to tip), expressed in the frame of that link.
+ * Kinematic and inertial parameters are extracted from the RobotModel and the intermediate results of each OpenMP
+ * thread are allocated once at construction, so evaluating waypoints does not allocate memory. Only concurrent calls
+ * from several threads allocate their own intermediate results. Waypoints are distributed among OpenMP threads.
+ */
+class BatchInverseDynamics
+{
+public:
+  /** \brief External wrench acting on one link of the chain, in the frame of that link */
+  struct ExternalWrench
+  {
+    Eigen::Vector3d force;
+    Eigen::Vector3d torque;
+  };
+
+  /**
+   * @brief Initialize the inverse dynamics for the chain \e group_name of \e robot_model
+   * Check isValid() afterwards; errors are logged.
+   */
+  BatchInverseDynamics(const moveit::core::RobotModelConstPtr& robot_model, const std::string& group_name,
+                       const geometry_msgs::Vector3& gravity_vector);
+
+  /** @brief False if the group cannot be handled: it must be a chain of fixed, revolute and prismatic joints
+   * without mimic joints */
+  bool isValid() const
+  {
+    return joint_model_group_ != nullptr;
+  }
+
+  /** @brief The number of values per waypoint, i.e. the number of variables of the group */
+  std::size_t getVariableCount() const
+  {
+    return variable_count_;
+  }
+
+  /** @brief The number of links of the chain, i.e. the number of external wrenches */
+  std::size_t getSegmentCount() const
+  {
+    return segments_.size();
+  }
+
+  /**
+   * @brief Compute the joint torques for \e count waypoints
+   * Each array holds \e count consecutive blocks of getVariableCount() values, in the variable order of the group.
+   * @param wrenches External wrenches acting on the links of the chain, applied at every waypoint.
+   * This must have size getSegmentCount()
+   * @return False if the solver is not valid or \e wrenches has the wrong size
+   */
+  bool getTorques(const double* positions, const double* velocities, const double* accelerations, std::size_t count,
+                  const std::vector<geometry_msgs::Wrench>& wrenches, double* torques) const;
+
+  /**
+   * @brief Compute the joint torques for \e count waypoints, with wrenches converted by convertWrenches()
+   * Use this for repeated calls with the same wrenches.
+   */
+  bool getTorques(const double* positions, const double* velocities, const double* accelerations, std::size_t count,
+                  const std::vector<ExternalWrench>& wrenches, double* torques) const;
+
+  /** @brief Convert the wrench messages of the links of the chain for getTorques() */
+  static std::vector<ExternalWrench> convertWrenches(const std::vector<geometry_msgs::Wrench>& wrenches);
+
+  const moveit::core::JointModelGroup* getGroup() const
+  {
+    return joint_model_group_;
+  }
+
+private:
+  /** \brief Constant data of one link of the chain and its parent joint */
+  struct Segment
+  {
+    moveit::core::JointModel::JointType type;
+    int variable;  // index of the joint variable within the group, -1 for fixed joints
+    Eigen::Matrix3d origin_rotation;
+    Eigen::Vector3d origin_translation;
+    Eigen::Vector3d axis;
+    double mass;
+    Eigen::Vector3d com;      // center of mass, in the link frame
+    Eigen::Matrix3d inertia;  // rotational inertia about the center of mass, in the link frame
+  };
+
+  /** \brief Per-waypoint intermediate results of one segment */
+  struct SegmentState
+  {
+    Eigen::Matrix3d rotation;  // link frame w.r.t. the parent link frame
+    Eigen::Vector3d translation;
+    Eigen::Vector3d force, torque;  // spatial force transmitted by the parent joint, in the link frame
+  };
+
+  void computeTorques(const double* positions, const double* velocities, const double* accelerations,
+                      const ExternalWrench* wrenches, SegmentState* states, double* torques) const;
+
+  moveit::core::RobotModelConstPtr robot_model_;
+  const moveit::core::JointModelGroup* joint_model_group_;
+  std::size_t variable_count_;
+  std::vector<Segment> segments_;
+  Eigen::Vector3d gravity_;
+
+  /// intermediate results of each OpenMP thread, guarded by states_lock_
+  mutable std::vector<std::vector<SegmentState>> thread_states_;
+  mutable std::mutex states_lock_;
+};
+}  // namespace dynamics_solver
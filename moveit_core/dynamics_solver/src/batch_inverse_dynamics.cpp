@@ -0,0 +1,297 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/dynamics_solver/batch_inverse_dynamics.h>
+#include <algorithm>
+#include <omp.h>
+
+namespace dynamics_solver
+{
+namespace
+{
+constexpr char LOGNAME[] = "dynamics_solver";
+
+// below this number of waypoints, starting threads costs more than it saves
+constexpr std::size_t MIN_PARALLEL_WAYPOINTS = 64;
+}  // namespace
+
+BatchInverseDynamics::BatchInverseDynamics(const moveit::core::RobotModelConstPtr& robot_model,
+                                           const std::string& group_name, const geometry_msgs::Vector3& gravity_vector)
+  : robot_model_(robot_model)
+  , joint_model_group_(nullptr)
+  , variable_count_(0)
+  , gravity_(gravity_vector.x, gravity_vector.y, gravity_vector.z)
+{
+  const moveit::core::JointModelGroup* group = robot_model_->getJointModelGroup(group_name);
+  if (!group)
+    return;
+
+  if (!group->isChain())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Group '%s' is not a chain. Will not initialize inverse dynamics", group_name.c_str());
+    return;
+  }
+  if (!group->getMimicJointModels().empty())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Group '%s' has a mimic joint. Will not initialize inverse dynamics", group_name.c_str());
+    return;
+  }
+  const moveit::core::LinkModel* base = group->getJointRoots()[0]->getParentLinkModel();
+  if (!base)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Group '%s' does not have a parent link", group_name.c_str());
+    return;
+  }
+
+  // collect the links from the tip up to the base, like KDL::Tree::getChain()
+  std::vector<const moveit::core::LinkModel*> links;
+  for (const moveit::core::LinkModel* link = robot_model_->getLinkModel(group->getLinkModelNames().back());
+       link && link != base; link = link->getParentLinkModel())
+    links.push_back(link);
+  std::reverse(links.begin(), links.end());
+
+  const urdf::ModelInterfaceSharedPtr& urdf_model = robot_model_->getURDF();
+  segments_.reserve(links.size());
+  for (const moveit::core::LinkModel* link : links)
+  {
+    const moveit::core::JointModel* joint = link->getParentJointModel();
+    Segment segment;
+    segment.type = joint->getType();
+    segment.variable = -1;
+    segment.axis = Eigen::Vector3d::Zero();
+    if (segment.type == moveit::core::JointModel::REVOLUTE)
+      segment.axis = static_cast<const moveit::core::RevoluteJointModel*>(joint)->getAxis();
+    else if (segment.type == moveit::core::JointModel::PRISMATIC)
+      segment.axis = static_cast<const moveit::core::PrismaticJointModel*>(joint)->getAxis();
+    else if (segment.type != moveit::core::JointModel::FIXED)
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Joint '%s' of group '%s' is neither fixed, revolute nor prismatic",
+                      joint->getName().c_str(), group_name.c_str());
+      segments_.clear();
+      return;
+    }
+    if (segment.type != moveit::core::JointModel::FIXED)
+    {
+      if (!group->hasJointModel(joint->getName()))
+      {
+        ROS_ERROR_NAMED(LOGNAME, "Joint '%s' is part of the chain, but not of group '%s'", joint->getName().c_str(),
+                        group_name.c_str());
+        segments_.clear();
+        return;
+      }
+      segment.variable = group->getVariableGroupIndex(joint->getName());
+    }
+
+    segment.origin_rotation = link->getJointOriginTransform().linear();
+    segment.origin_translation = link->getJointOriginTransform().translation();
+
+    // inertial parameters are only available from the URDF
+    segment.mass = 0.0;
+    segment.com = Eigen::Vector3d::Zero();
+    segment.inertia = Eigen::Matrix3d::Zero();
+    const urdf::LinkConstSharedPtr urdf_link = urdf_model->getLink(link->getName());
+    if (urdf_link && urdf_link->inertial)
+    {
+      const urdf::Inertial& inertial = *urdf_link->inertial;
+      const urdf::Pose& origin = inertial.origin;
+      const Eigen::Matrix3d rotation =
+          Eigen::Quaterniond(origin.rotation.w, origin.rotation.x, origin.rotation.y, origin.rotation.z)
+              .toRotationMatrix();
+      Eigen::Matrix3d inertia;
+      inertia << inertial.ixx, inertial.ixy, inertial.ixz, inertial.ixy, inertial.iyy, inertial.iyz, inertial.ixz,
+          inertial.iyz, inertial.izz;
+      segment.mass = inertial.mass;
+      segment.com = Eigen::Vector3d(origin.position.x, origin.position.y, origin.position.z);
+      segment.inertia = rotation * inertia * rotation.transpose();
+    }
+    segments_.push_back(segment);
+  }
+
+  joint_model_group_ = group;
+  variable_count_ = group->getVariableCount();
+  thread_states_.assign(std::max(1, omp_get_max_threads()), std::vector<SegmentState>(segments_.size()));
+}
+
+bool BatchInverseDynamics::getTorques(const double* positions, const double* velocities, const double* accelerations,
+                                      std::size_t count, const std::vector<geometry_msgs::Wrench>& wrenches,
+                                      double* torques) const
+{
+  return getTorques(positions, velocities, accelerations, count, convertWrenches(wrenches), torques);
+}
+
+std::vector<BatchInverseDynamics::ExternalWrench>
+BatchInverseDynamics::convertWrenches(const std::vector<geometry_msgs::Wrench>& wrenches)
+{
+  std::vector<ExternalWrench> external_wrenches(wrenches.size());
+  for (std::size_t i = 0; i < wrenches.size(); ++i)
+  {
+    external_wrenches[i].force = Eigen::Vector3d(wrenches[i].force.x, wrenches[i].force.y, wrenches[i].force.z);
+    external_wrenches[i].torque = Eigen::Vector3d(wrenches[i].torque.x, wrenches[i].torque.y, wrenches[i].torque.z);
+  }
+  return external_wrenches;
+}
+
+bool BatchInverseDynamics::getTorques(const double* positions, const double* velocities, const double* accelerations,
+                                      std::size_t count, const std::vector<ExternalWrench>& wrenches,
+                                      double* torques) const
+{
+  if (!joint_model_group_)
+  {
+    ROS_DEBUG_NAMED(LOGNAME, "Did not construct BatchInverseDynamics object properly. Check error logs.");
+    return false;
+  }
+  if (wrenches.size() != segments_.size())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Wrenches vector should be size %zu", segments_.size());
+    return false;
+  }
+
+  const int threads = count >= MIN_PARALLEL_WAYPOINTS ? static_cast<int>(thread_states_.size()) : 1;
+  std::vector<SegmentState>* states = thread_states_.data();
+  std::vector<std::vector<SegmentState>> local_states;
+  std::unique_lock<std::mutex> lock(states_lock_, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    // another thread is using the preallocated intermediate results
+    local_states.assign(threads, std::vector<SegmentState>(segments_.size()));
+    states = local_states.data();
+  }
+
+  const long n = count;
+  if (threads == 1)
+  {
+    for (long i = 0; i < n; ++i)
+    {
+      const std::size_t offset = i * variable_count_;
+      computeTorques(positions + offset, velocities + offset, accelerations + offset, wrenches.data(),
+                     states[0].data(), torques + offset);
+    }
+    return true;
+  }
+
+#pragma omp parallel num_threads(threads)
+  {
+    SegmentState* thread_states = states[omp_get_thread_num()].data();
+#pragma omp for schedule(static)
+    for (long i = 0; i < n; ++i)
+    {
+      const std::size_t offset = i * variable_count_;
+      computeTorques(positions + offset, velocities + offset, accelerations + offset, wrenches.data(), thread_states,
+                     torques + offset);
+    }
+  }
+  return true;
+}
+
+void BatchInverseDynamics::computeTorques(const double* positions, const double* velocities,
+                                          const double* accelerations, const ExternalWrench* wrenches,
+                                          SegmentState* states, double* torques) const
+{
+  // Forward sweep: spatial velocity (w, v) and acceleration (dw, dv) of each link, in the link frame.
+  // Gravity enters as acceleration of the base, as in KDL::ChainIdSolver_RNE.
+  Eigen::Vector3d w = Eigen::Vector3d::Zero(), v = Eigen::Vector3d::Zero();
+  Eigen::Vector3d dw = Eigen::Vector3d::Zero(), dv = -gravity_;
+  const std::size_t segment_count = segments_.size();
+  for (std::size_t i = 0; i < segment_count; ++i)
+  {
+    const Segment& segment = segments_[i];
+    SegmentState& state = states[i];
+    double q = 0.0, qd = 0.0, qdd = 0.0;
+    if (segment.variable >= 0)
+    {
+      q = positions[segment.variable];
+      qd = velocities[segment.variable];
+      qdd = accelerations[segment.variable];
+    }
+
+    state.translation = segment.origin_translation;
+    Eigen::Vector3d joint_w = Eigen::Vector3d::Zero(), joint_v = Eigen::Vector3d::Zero();
+    if (segment.type == moveit::core::JointModel::REVOLUTE)
+    {
+      state.rotation.noalias() = segment.origin_rotation * Eigen::AngleAxisd(q, segment.axis).toRotationMatrix();
+      joint_w = segment.axis * qd;
+    }
+    else
+    {
+      state.rotation = segment.origin_rotation;
+      if (segment.type == moveit::core::JointModel::PRISMATIC)
+      {
+        state.translation.noalias() += segment.origin_rotation * (segment.axis * q);
+        joint_v = segment.axis * qd;
+      }
+    }
+
+    // transform the motion of the parent into this link's frame and add the joint motion
+    const Eigen::Matrix3d rt = state.rotation.transpose();
+    const Eigen::Vector3d link_w = rt * w + joint_w;
+    const Eigen::Vector3d link_v = rt * (v + w.cross(state.translation)) + joint_v;
+    Eigen::Vector3d link_dw = rt * dw + link_w.cross(joint_w);
+    Eigen::Vector3d link_dv = rt * (dv + dw.cross(state.translation)) + link_w.cross(joint_v) + link_v.cross(joint_w);
+    if (segment.type == moveit::core::JointModel::REVOLUTE)
+      link_dw += segment.axis * qdd;
+    else if (segment.type == moveit::core::JointModel::PRISMATIC)
+      link_dv += segment.axis * qdd;
+
+    // f = I * a + v x* (I * v) - f_ext
+    const Eigen::Vector3d momentum = segment.mass * (link_v + link_w.cross(segment.com));
+    const Eigen::Vector3d angular_momentum = segment.inertia * link_w + segment.com.cross(momentum);
+    const Eigen::Vector3d inertial_force = segment.mass * (link_dv + link_dw.cross(segment.com));
+    state.force = inertial_force + link_w.cross(momentum) - wrenches[i].force;
+    state.torque = segment.inertia * link_dw + segment.com.cross(inertial_force) + link_w.cross(angular_momentum) +
+                   link_v.cross(momentum) - wrenches[i].torque;
+
+    w = link_w;
+    v = link_v;
+    dw = link_dw;
+    dv = link_dv;
+  }
+
+  // Backward sweep: project the transmitted forces on the joint axes and propagate them to the parent links
+  for (std::size_t i = segment_count; i-- > 0;)
+  {
+    const Segment& segment = segments_[i];
+    const SegmentState& state = states[i];
+    if (segment.type == moveit::core::JointModel::REVOLUTE)
+      torques[segment.variable] = segment.axis.dot(state.torque);
+    else if (segment.type == moveit::core::JointModel::PRISMATIC)
+      torques[segment.variable] = segment.axis.dot(state.force);
+    if (i > 0)
+    {
+      const Eigen::Vector3d force = state.rotation * state.force;
+      states[i - 1].force += force;
+      states[i - 1].torque += state.rotation * state.torque + state.translation.cross(force);
+    }
+  }
+}
+}  // namespace dynamics_solver
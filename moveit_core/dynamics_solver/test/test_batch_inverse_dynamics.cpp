@@ -0,0 +1,136 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/dynamics_solver/batch_inverse_dynamics.h>
+#include <moveit/dynamics_solver/dynamics_solver.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace
+{
+geometry_msgs::Vector3 makeGravity()
+{
+  geometry_msgs::Vector3 gravity;
+  gravity.z = -9.81;
+  return gravity;
+}
+}  // namespace
+
+// The batched solver must agree with the KDL-based DynamicsSolver
+TEST(BatchInverseDynamics, matchesDynamicsSolver)
+{
+  moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("panda");
+  const moveit::core::JointModelGroup* group = robot_model->getJointModelGroup("panda_arm");
+  dynamics_solver::DynamicsSolver kdl_solver(robot_model, group->getName(), makeGravity());
+  dynamics_solver::BatchInverseDynamics batch_solver(robot_model, group->getName(), makeGravity());
+  ASSERT_TRUE(batch_solver.isValid());
+
+  const std::size_t dof = batch_solver.getVariableCount();
+  ASSERT_EQ(dof, group->getVariableCount());
+
+  std::vector<geometry_msgs::Wrench> wrenches(batch_solver.getSegmentCount());
+  wrenches.back().force.x = 2.0;
+  wrenches.back().torque.z = -0.5;
+
+  // more waypoints than needed to run in parallel
+  const std::size_t count = 200;
+  moveit::core::RobotState state(robot_model);
+  random_numbers::RandomNumberGenerator& rng = state.getRandomNumberGenerator();
+  std::vector<double> positions(count * dof), velocities(count * dof), accelerations(count * dof);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    state.setToRandomPositions(group);
+    state.copyJointGroupPositions(group, &positions[i * dof]);
+    for (std::size_t j = 0; j < dof; ++j)
+    {
+      velocities[i * dof + j] = rng.uniformReal(-2.0, 2.0);
+      accelerations[i * dof + j] = rng.uniformReal(-5.0, 5.0);
+    }
+  }
+
+  std::vector<double> torques(count * dof);
+  ASSERT_TRUE(batch_solver.getTorques(positions.data(), velocities.data(), accelerations.data(), count, wrenches,
+                                      torques.data()));
+
+  std::vector<double> expected(dof);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto row = [&](const std::vector<double>& values) {
+      return std::vector<double>(values.begin() + i * dof, values.begin() + (i + 1) * dof);
+    };
+    ASSERT_TRUE(kdl_solver.getTorques(row(positions), row(velocities), row(accelerations), wrenches, expected));
+    for (std::size_t j = 0; j < dof; ++j)
+      EXPECT_NEAR(torques[i * dof + j], expected[j], 1e-9) << "waypoint " << i << ", joint " << j;
+  }
+
+  // single waypoints with converted wrenches, as evaluated by the torque limited parameterization
+  const std::vector<dynamics_solver::BatchInverseDynamics::ExternalWrench> external_wrenches =
+      dynamics_solver::BatchInverseDynamics::convertWrenches(wrenches);
+  std::vector<double> waypoint_torques(dof);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ASSERT_TRUE(batch_solver.getTorques(&positions[i * dof], &velocities[i * dof], &accelerations[i * dof], 1,
+                                        external_wrenches, waypoint_torques.data()));
+    for (std::size_t j = 0; j < dof; ++j)
+      EXPECT_DOUBLE_EQ(waypoint_torques[j], torques[i * dof + j]) << "waypoint " << i << ", joint " << j;
+  }
+
+  // concurrent calls don't share intermediate results
+  std::vector<std::vector<double>> concurrent_torques(4, std::vector<double>(count * dof));
+  std::vector<std::thread> threads;
+  for (std::vector<double>& result : concurrent_torques)
+  {
+    double* result_data = result.data();
+    threads.emplace_back([&, result_data] {
+      batch_solver.getTorques(positions.data(), velocities.data(), accelerations.data(), count, external_wrenches,
+                              result_data);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  for (const std::vector<double>& result : concurrent_torques)
+    for (std::size_t i = 0; i < count * dof; ++i)
+      EXPECT_DOUBLE_EQ(result[i], torques[i]);
+
+  EXPECT_FALSE(batch_solver.getTorques(positions.data(), velocities.data(), accelerations.data(), count,
+                                       std::vector<geometry_msgs::Wrench>(), torques.data()));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
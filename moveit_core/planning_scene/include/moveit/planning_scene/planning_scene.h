@@ -164,6 +164,48 @@ using ObjectColorMap = std::map<std::string, std_msgs::ColorRGBA>;
 /** \brief A map from object names (e.g., attached bodies, collision objects) to their types */
 using ObjectTypeMap = std::map<std::string, object_recognition_msgs::ObjectType>;
 
+/** \brief A frame of a planning scene, resolved once from its name by PlanningScene::getFrameHandle().
+ *
+ *  Retrieving the transform of a handle needs no string lookups for links, collision objects, their subframes and fixed
+ *  frames. Attached bodies belong to the robot state and are looked up by name. A handle stays valid until the world or
+ *  the fixed transforms of the scene change; outdated handles are transparently resolved again by name. */
+class FrameHandle
+{
+public:
+  /** \brief The name of the frame, without leading slash */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /** \brief Check whether the frame was known when the handle was resolved */
+  explicit operator bool() const
+  {
+    return type_ != UNKNOWN;
+  }
+
+private:
+  friend class PlanningScene;
+
+  enum Type
+  {
+    UNKNOWN,
+    MODEL_FRAME,
+    LINK,
+    ATTACHED_BODY,
+    WORLD_OBJECT,
+    FIXED
+  };
+
+  std::string name_;
+  Type type_ = UNKNOWN;
+  const moveit::core::LinkModel* link_ = nullptr;
+  const Eigen::Isometry3d* transform_ = nullptr;        // pose of a collision object or fixed frame
+  collision_detection::World::ObjectConstPtr object_;  // keeps the pose of a collision object alive
+  std::size_t world_version_ = 0;
+  std::size_t transforms_version_ = 0;
+};
+
 /** \brief This class maintains the representation of the
     environment as seen by a planning instance. The environment
     geometry, the robot geometry and state are maintained. */
@@ -306,6 +348,30 @@ public:
    * body id or a collision object */
   bool knowsFrameTransform(const moveit::core::RobotState& state, const std::string& id) const;
 
+  /** \brief Resolve the frame \e id, as known to the current state, to a handle for repeated lookups with
+   * getFrameTransform(). The handle evaluates to false if the frame is not known. */
+  FrameHandle getFrameHandle(const std::string& id) const;
+
+  /** \brief Resolve the frame \e id, as known to \e state, to a handle for repeated lookups with getFrameTransform().
+   * The handle evaluates to false if the frame is not known. */
+  FrameHandle getFrameHandle(const moveit::core::RobotState& state, const std::string& id) const;
+
+  /** \brief Check whether \e frame can be looked up without resolving its name again */
+  bool isFrameHandleValid(const FrameHandle& frame) const;
+
+  /** \brief Get the transform of the frame referenced by \e frame in the current state.
+      Return identity when the frame is not known. */
+  const Eigen::Isometry3d& getFrameTransform(const FrameHandle& frame) const;
+
+  /** \brief Get the transform of the frame referenced by \e frame in the current state.
+      Return identity when the frame is not known.
+      Because this function is non-const, the current state transforms are also updated, if needed. */
+  const Eigen::Isometry3d& getFrameTransform(const FrameHandle& frame);
+
+  /** \brief Get the transform of the frame referenced by \e frame in \e state.
+      Return identity when the frame is not known. */
+  const Eigen::Isometry3d& getFrameTransform(const moveit::core::RobotState& state, const FrameHandle& frame) const;
+
   /**@}*/
 
   /**
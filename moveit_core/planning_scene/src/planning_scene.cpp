@@ -1957,19 +1957,7 @@ const Eigen::Isometry3d& PlanningScene::getFrameTransform(const std::string& fra
 const Eigen::Isometry3d& PlanningScene::getFrameTransform(const moveit::core::RobotState& state,
                                                           const std::string& frame_id) const
 {
-  if (!frame_id.empty() && frame_id[0] == '/')
-    // Recursively call itself without the slash in front of frame name
-    return getFrameTransform(frame_id.substr(1));
-
-  bool frame_found;
-  const Eigen::Isometry3d& t1 = state.getFrameTransform(frame_id, &frame_found);
-  if (frame_found)
-    return t1;
-
-  const Eigen::Isometry3d& t2 = getWorld()->getTransform(frame_id, frame_found);
-  if (frame_found)
-    return t2;
-  return getTransforms().Transforms::getTransform(frame_id);
+  return getFrameTransform(state, getFrameHandle(state, frame_id));
 }
 
 bool PlanningScene::knowsFrameTransform(const std::string& frame_id) const
@@ -1979,14 +1967,142 @@ bool PlanningScene::knowsFrameTransform(const std::string& frame_id) const
 
 bool PlanningScene::knowsFrameTransform(const moveit::core::RobotState& state, const std::string& frame_id) const
 {
-  if (!frame_id.empty() && frame_id[0] == '/')
-    return knowsFrameTransform(frame_id.substr(1));
+  return static_cast<bool>(getFrameHandle(state, frame_id));
+}
 
-  if (state.knowsFrameTransform(frame_id))
-    return true;
-  if (getWorld()->knowsTransform(frame_id))
-    return true;
-  return getTransforms().Transforms::canTransform(frame_id);
+FrameHandle PlanningScene::getFrameHandle(const std::string& frame_id) const
+{
+  return getFrameHandle(getCurrentState(), frame_id);
+}
+
+FrameHandle PlanningScene::getFrameHandle(const moveit::core::RobotState& state, const std::string& frame_id) const
+{
+  FrameHandle frame;
+  frame.name_ = !frame_id.empty() && frame_id[0] == '/' ? frame_id.substr(1) : frame_id;
+  const moveit::core::Transforms& transforms = getTransforms();
+  frame.world_version_ = getWorld()->getVersion();
+  frame.transforms_version_ = transforms.getVersion();
+  if (frame.name_.empty())
+    return frame;
+
+  // same precedence as the string lookups: robot state, then collision objects, then fixed frames
+  bool found;
+  if (frame.name_ == getRobotModel()->getModelFrame())
+    frame.type_ = FrameHandle::MODEL_FRAME;
+  else if ((frame.link_ = getRobotModel()->getLinkModel(frame.name_, &found)))
+    frame.type_ = FrameHandle::LINK;
+  else if (state.hasAttachedBody(frame.name_))
+    frame.type_ = FrameHandle::ATTACHED_BODY;
+  else
+  {
+    std::vector<const moveit::core::AttachedBody*> attached_bodies;
+    state.getAttachedBodies(attached_bodies);
+    for (const moveit::core::AttachedBody* body : attached_bodies)
+      if (body->hasSubframeTransform(frame.name_))
+      {
+        frame.type_ = FrameHandle::ATTACHED_BODY;
+        return frame;
+      }
+
+    if ((frame.object_ = getWorld()->getObject(frame.name_)))
+    {
+      frame.type_ = FrameHandle::WORLD_OBJECT;
+      frame.transform_ = &frame.object_->pose_;
+      return frame;
+    }
+    // subframes are named "<object>/<subframe>", where the object name may contain slashes itself
+    for (std::size_t pos = frame.name_.find('/'); pos != std::string::npos; pos = frame.name_.find('/', pos + 1))
+    {
+      collision_detection::World::ObjectConstPtr object = getWorld()->getObject(frame.name_.substr(0, pos));
+      if (!object)
+        continue;
+      auto it = object->global_subframe_poses_.find(frame.name_.substr(pos + 1));
+      if (it != object->global_subframe_poses_.end())
+      {
+        frame.type_ = FrameHandle::WORLD_OBJECT;
+        frame.object_ = object;
+        frame.transform_ = &it->second;
+        return frame;
+      }
+    }
+
+    moveit::core::FixedFrameHandle fixed_frame = transforms.getFixedFrameHandle(frame.name_);
+    if (fixed_frame)
+    {
+      frame.type_ = FrameHandle::FIXED;
+      frame.transform_ = fixed_frame.transform;
+    }
+  }
+  return frame;
+}
+
+bool PlanningScene::isFrameHandleValid(const FrameHandle& frame) const
+{
+  switch (frame.type_)
+  {
+    case FrameHandle::MODEL_FRAME:
+    case FrameHandle::LINK:
+    case FrameHandle::ATTACHED_BODY:
+      return true;  // frames of the robot state take precedence, attached bodies are looked up by name anyway
+    case FrameHandle::WORLD_OBJECT:
+    case FrameHandle::FIXED:
+      return frame.world_version_ == getWorld()->getVersion() &&
+             frame.transforms_version_ == getTransforms().getVersion();
+    default:
+      return false;  // unknown frames might have become known in the meantime
+  }
+}
+
+const Eigen::Isometry3d& PlanningScene::getFrameTransform(const FrameHandle& frame) const
+{
+  return getFrameTransform(getCurrentState(), frame);
+}
+
+const Eigen::Isometry3d& PlanningScene::getFrameTransform(const FrameHandle& frame)
+{
+  if (getCurrentState().dirtyLinkTransforms())
+    getCurrentStateNonConst().updateLinkTransforms();
+  return getFrameTransform(getCurrentState(), frame);
+}
+
+const Eigen::Isometry3d& PlanningScene::getFrameTransform(const moveit::core::RobotState& state,
+                                                          const FrameHandle& frame) const
+{
+  static const Eigen::Isometry3d IDENTITY = Eigen::Isometry3d::Identity();
+  if (frame.type_ != FrameHandle::UNKNOWN && !isFrameHandleValid(frame))
+    return getFrameTransform(state, getFrameHandle(state, frame.name_));
+
+  switch (frame.type_)
+  {
+    case FrameHandle::MODEL_FRAME:
+      return IDENTITY;
+    case FrameHandle::LINK:
+      return state.getGlobalLinkTransform(frame.link_);
+    case FrameHandle::ATTACHED_BODY:
+    {
+      bool found;
+      const Eigen::Isometry3d& transform = state.getFrameTransform(frame.name_, &found);
+      if (found)
+        return transform;
+      // the handle was resolved for a state with different attached bodies
+      FrameHandle resolved = getFrameHandle(state, frame.name_);
+      if (resolved.type_ != FrameHandle::ATTACHED_BODY)
+        return getFrameTransform(state, resolved);
+      break;
+    }
+    case FrameHandle::WORLD_OBJECT:
+    case FrameHandle::FIXED:
+      return *frame.transform_;
+    default:
+    {
+      // resolve again: the frame might be known by now (e.g. an attached body of this state)
+      FrameHandle resolved = getFrameHandle(state, frame.name_);
+      if (resolved)
+        return getFrameTransform(state, resolved);
+      break;
+    }
+  }
+  return getTransforms().Transforms::getTransform(frame.name_);  // reports the unknown frame
 }
 
 bool PlanningScene::hasObjectType(const std::string& object_id) const
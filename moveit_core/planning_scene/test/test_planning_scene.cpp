@@ -312,6 +312,37 @@ TEST(PlanningScene, FailRetrievingNonExistentObject)
   EXPECT_FALSE(ps.getCollisionObjectMsg(obj, "non_existent_object"));
 }
 
+TEST(PlanningScene, FrameHandles)
+{
+  moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("pr2");
+  planning_scene::PlanningScene ps{ robot_model };
+  ps.getCurrentStateNonConst().update();
+
+  planning_scene::FrameHandle link = ps.getFrameHandle("/r_gripper_palm_link");
+  ASSERT_TRUE(link);
+  EXPECT_EQ("r_gripper_palm_link", link.getName());
+  EXPECT_TRUE(ps.getFrameTransform(link).isApprox(ps.getFrameTransform("r_gripper_palm_link")));
+
+  planning_scene::FrameHandle box = ps.getFrameHandle("box");
+  EXPECT_FALSE(box);
+
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(1.0, 0.0, 0.5);
+  ps.getWorldNonConst()->addToObject("box", pose, shapes::ShapeConstPtr(new shapes::Box(0.1, 0.1, 0.1)),
+                                     Eigen::Isometry3d::Identity());
+  EXPECT_TRUE(ps.getFrameTransform(box).isApprox(pose)) << "unknown frame was not resolved again";
+
+  box = ps.getFrameHandle("box");
+  ASSERT_TRUE(box);
+  EXPECT_TRUE(ps.isFrameHandleValid(box));
+  EXPECT_TRUE(ps.getFrameTransform(box).isApprox(pose));
+
+  pose.translation().z() = 1.0;
+  ps.getWorldNonConst()->setObjectPose("box", pose);
+  EXPECT_FALSE(ps.isFrameHandleValid(box)) << "handle survived a change of the world";
+  EXPECT_TRUE(ps.getFrameTransform(box).isApprox(pose));
+}
+
 class CollisionDetectorTests : public testing::TestWithParam<const char*>
 {
 };
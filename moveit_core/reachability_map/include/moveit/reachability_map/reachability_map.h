@@ -0,0 +1,191 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/robot_state/robot_state.h>
+#include <moveit/macros/class_forward.h>
+#include <unordered_map>
+
+/** @brief Namespace for precomputed reachability maps */
+namespace reachability_map
+{
+MOVEIT_CLASS_FORWARD(ReachabilityMap);  // Defines ReachabilityMapPtr, ConstPtr, WeakPtr... etc
+
+/** \brief Discretization of a ReachabilityMap */
+struct ReachabilityMapParameters
+{
+  /** \brief Edge length of the position voxels (m) */
+  double position_resolution = 0.05;
+  /** \brief Number of bins along each edge of a cube face used to discretize the direction of the tip z axis */
+  unsigned int direction_resolution = 4;
+  /** \brief Number of bins for the rotation about the tip z axis */
+  unsigned int roll_resolution = 8;
+};
+
+/**
+ * \brief A discretized 6D map of the poses the tip frame of a group can reach relative to a base frame.
+ *
+ * The map is computed offline by sampling random configurations of the group (see compute()) and stored in a
+ * compact binary file (see save() and load()). A cell combines a position voxel with a bin for the direction of
+ * the tip's z axis (a cube map with 6 * direction_resolution^2 bins) and a bin for the rotation about that axis.
+ * Queries are O(1): a cell is marked reachable if at least one sample fell into it, and for each reachable cell
+ * the configuration of the first such sample is kept as IK seed.
+ *
+ * As the map is built from samples, a pose in an empty cell is not guaranteed to be unreachable, but with enough
+ * samples it is unlikely to be reachable.
+ *
+ * Maps registered with a constraint_samplers::ConstraintSamplerManager seed the IK constraint samplers it creates.
+ * This covers goal sampling in move_group and the grasp pose filter of pick and place, which load maps from the
+ * ~reachability_maps parameter. IK solved directly on a RobotState, like the pose targets of
+ * moveit::planning_interface::MoveGroupInterface, does not use maps.
+ */
+class ReachabilityMap
+{
+public:
+  using Parameters = ReachabilityMapParameters;
+
+  ReachabilityMap() = default;
+
+  /**
+   * \brief Fill the map by sampling random configurations of a group
+   *
+   * Only the variables of the group are sampled, all other variables are kept at their default values.
+   * @param robot_model The robot model
+   * @param group_name The group whose reachability is mapped
+   * @param base_frame The link the tip poses are expressed in
+   * @param tip_frame The link whose reachability is mapped
+   * @param samples Number of random configurations to sample
+   * @param params Discretization of the map
+   * @param seed Seed of the random number generator, so maps can be recomputed exactly
+   * @return False if the group or the frames are not known to the robot model
+   */
+  bool compute(const moveit::core::RobotModelConstPtr& robot_model, const std::string& group_name,
+               const std::string& base_frame, const std::string& tip_frame, std::size_t samples,
+               const Parameters& params = Parameters(), std::uint32_t seed = 42);
+
+  /** \brief Write the map to a binary file */
+  bool save(const std::string& filename) const;
+
+  /** \brief Read a map written by save() */
+  bool load(const std::string& filename);
+
+  /** \brief Check whether \e tip_pose (relative to the base frame) lies in a reachable cell */
+  bool isReachable(const Eigen::Isometry3d& tip_pose) const;
+
+  /** \brief Check whether \e tip_pose (relative to the model frame) lies in a reachable cell,
+   * using \e state to locate the base frame */
+  bool isReachable(const moveit::core::RobotState& state, const Eigen::Isometry3d& tip_pose) const;
+
+  /**
+   * \brief Get the group configuration of a sample whose tip pose (relative to the base frame) is close to \e tip_pose
+   *
+   * The cell of \e tip_pose is tried first, then the cells with the same orientation bin in the neighboring
+   * position voxels.
+   * @param seed The configuration in the variable order of the group
+   * @return False if no nearby sample was recorded
+   */
+  bool getSeed(const Eigen::Isometry3d& tip_pose, std::vector<double>& seed) const;
+
+  /** \brief Like getSeed(), with \e tip_pose relative to the model frame */
+  bool getSeed(const moveit::core::RobotState& state, const Eigen::Isometry3d& tip_pose,
+               std::vector<double>& seed) const;
+
+  const std::string& getRobotName() const
+  {
+    return robot_name_;
+  }
+
+  const std::string& getGroupName() const
+  {
+    return group_name_;
+  }
+
+  const std::string& getBaseFrame() const
+  {
+    return base_frame_;
+  }
+
+  const std::string& getTipFrame() const
+  {
+    return tip_frame_;
+  }
+
+  const Parameters& getParameters() const
+  {
+    return params_;
+  }
+
+  /** \brief Number of reachable cells */
+  std::size_t getReachableCellCount() const
+  {
+    return seed_index_.size();
+  }
+
+  /** \brief Total number of cells */
+  std::size_t getCellCount() const
+  {
+    return cell_count_;
+  }
+
+private:
+  /** \brief Index of the cell containing \e tip_pose, or -1 if the position is outside the mapped volume */
+  std::int64_t cellIndex(const Eigen::Isometry3d& tip_pose) const;
+  std::int64_t cellIndex(const Eigen::Vector3i& voxel, std::size_t orientation_bin) const;
+  bool voxel(const Eigen::Vector3d& position, Eigen::Vector3i& voxel) const;
+  std::size_t orientationBin(const Eigen::Matrix3d& rotation) const;
+  Eigen::Isometry3d toBaseFrame(const moveit::core::RobotState& state, const Eigen::Isometry3d& tip_pose) const;
+  void clear();
+
+  std::string robot_name_;
+  std::string group_name_;
+  std::string base_frame_;
+  std::string tip_frame_;
+  std::size_t variable_count_ = 0;
+  Parameters params_;
+
+  /** \brief Corner of the mapped volume and its size in voxels */
+  Eigen::Vector3d origin_ = Eigen::Vector3d::Zero();
+  Eigen::Vector3i size_ = Eigen::Vector3i::Zero();
+  std::size_t orientation_bins_ = 0;
+  std::size_t cell_count_ = 0;
+
+  /** \brief One bit per cell */
+  std::vector<std::uint64_t> reachable_;
+  /** \brief Maps reachable cells to their seed configuration in seeds_ */
+  std::unordered_map<std::int64_t, std::uint32_t> seed_index_;
+  /** \brief Seed configurations, variable_count_ values each */
+  std::vector<float> seeds_;
+};
+}  // namespace reachability_map
@@ -0,0 +1,358 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/reachability_map/reachability_map.h>
+#include <random_numbers/random_numbers.h>
+#include <boost/math/constants/constants.hpp>
+#include <ros/console.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+
+namespace reachability_map
+{
+namespace
+{
+const std::string LOGNAME = "reachability_map";
+const char FILE_MAGIC[8] = { 'M', 'V', 'R', 'E', 'A', 'C', 'H', '1' };
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value)
+{
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writeString(std::ofstream& out, const std::string& value)
+{
+  writeValue(out, static_cast<std::uint32_t>(value.size()));
+  out.write(value.data(), value.size());
+}
+
+bool readString(std::ifstream& in, std::string& value)
+{
+  std::uint32_t size;
+  if (!readValue(in, size) || size > 4096)
+    return false;
+  value.resize(size);
+  return static_cast<bool>(in.read(&value[0], size));
+}
+}  // namespace
+
+void ReachabilityMap::clear()
+{
+  origin_.setZero();
+  size_.setZero();
+  orientation_bins_ = 0;
+  cell_count_ = 0;
+  reachable_.clear();
+  seed_index_.clear();
+  seeds_.clear();
+}
+
+bool ReachabilityMap::compute(const moveit::core::RobotModelConstPtr& robot_model, const std::string& group_name,
+                              const std::string& base_frame, const std::string& tip_frame, std::size_t samples,
+                              const Parameters& params, std::uint32_t seed)
+{
+  const moveit::core::JointModelGroup* jmg = robot_model->getJointModelGroup(group_name);
+  if (!jmg)
+    return false;
+  if (!robot_model->hasLinkModel(base_frame) || !robot_model->hasLinkModel(tip_frame))
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Unknown base frame '%s' or tip frame '%s'", base_frame.c_str(), tip_frame.c_str());
+    return false;
+  }
+  if (params.position_resolution <= 0.0 || params.direction_resolution == 0 || params.roll_resolution == 0)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Invalid reachability map resolution");
+    return false;
+  }
+
+  clear();
+  robot_name_ = robot_model->getName();
+  group_name_ = group_name;
+  base_frame_ = base_frame;
+  tip_frame_ = tip_frame;
+  variable_count_ = jmg->getVariableCount();
+  params_ = params;
+  orientation_bins_ = 6 * params_.direction_resolution * params_.direction_resolution * params_.roll_resolution;
+
+  const moveit::core::LinkModel* base = robot_model->getLinkModel(base_frame);
+  const moveit::core::LinkModel* tip = robot_model->getLinkModel(tip_frame);
+  moveit::core::RobotState state(robot_model);
+  state.setToDefaultValues();
+  std::vector<double> values(variable_count_);
+
+  // the same sequence of samples is generated twice: first to find the volume to map, then to fill the map
+  auto sample_poses = [&](const std::function<void(const Eigen::Isometry3d&)>& callback) {
+    random_numbers::RandomNumberGenerator rng(seed);
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+      jmg->getVariableRandomPositions(rng, values);
+      state.setJointGroupPositions(jmg, values);
+      state.updateLinkTransforms();
+      callback(state.getGlobalLinkTransform(base).inverse() * state.getGlobalLinkTransform(tip));
+    }
+  };
+
+  Eigen::Vector3d min = Eigen::Vector3d::Constant(std::numeric_limits<double>::infinity());
+  Eigen::Vector3d max = -min;
+  sample_poses([&](const Eigen::Isometry3d& pose) {
+    min = min.cwiseMin(pose.translation());
+    max = max.cwiseMax(pose.translation());
+  });
+  if (samples == 0)
+    min = max = Eigen::Vector3d::Zero();
+
+  origin_ = min - Eigen::Vector3d::Constant(params_.position_resolution);
+  size_ = (((max - origin_) / params_.position_resolution).array().floor().cast<int>() + 2).matrix();
+  cell_count_ = std::size_t(size_.prod()) * orientation_bins_;
+  reachable_.assign((cell_count_ + 63) / 64, 0);
+
+  sample_poses([&](const Eigen::Isometry3d& pose) {
+    const std::int64_t cell = cellIndex(pose);
+    if (cell < 0 || !seed_index_.emplace(cell, seeds_.size() / variable_count_).second)
+      return;
+    reachable_[cell / 64] |= std::uint64_t(1) << (cell % 64);
+    seeds_.insert(seeds_.end(), values.begin(), values.end());
+  });
+
+  ROS_INFO_NAMED(LOGNAME, "%zu of %zu cells of group '%s' are reachable after %zu samples", seed_index_.size(),
+                 cell_count_, group_name_.c_str(), samples);
+  return true;
+}
+
+bool ReachabilityMap::save(const std::string& filename) const
+{
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Unable to open '%s' for writing", filename.c_str());
+    return false;
+  }
+
+  out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+  writeString(out, robot_name_);
+  writeString(out, group_name_);
+  writeString(out, base_frame_);
+  writeString(out, tip_frame_);
+  writeValue(out, static_cast<std::uint32_t>(variable_count_));
+  writeValue(out, params_.position_resolution);
+  writeValue(out, static_cast<std::uint32_t>(params_.direction_resolution));
+  writeValue(out, static_cast<std::uint32_t>(params_.roll_resolution));
+  for (int i = 0; i < 3; ++i)
+    writeValue(out, origin_[i]);
+  for (int i = 0; i < 3; ++i)
+    writeValue(out, static_cast<std::int32_t>(size_[i]));
+  out.write(reinterpret_cast<const char*>(reachable_.data()), reachable_.size() * sizeof(std::uint64_t));
+
+  // seeds are written in cell order so that identical maps produce identical files
+  std::vector<std::pair<std::int64_t, std::uint32_t>> cells(seed_index_.begin(), seed_index_.end());
+  std::sort(cells.begin(), cells.end());
+  writeValue(out, static_cast<std::uint64_t>(cells.size()));
+  for (const auto& cell : cells)
+  {
+    writeValue(out, cell.first);
+    out.write(reinterpret_cast<const char*>(&seeds_[cell.second * variable_count_]), variable_count_ * sizeof(float));
+  }
+
+  if (!out)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Failed writing reachability map to '%s'", filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ReachabilityMap::load(const std::string& filename)
+{
+  clear();
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Unable to open reachability map '%s'", filename.c_str());
+    return false;
+  }
+
+  char magic[sizeof(FILE_MAGIC)];
+  std::uint32_t variable_count, direction_resolution, roll_resolution;
+  std::int32_t size[3];
+  bool ok = in.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), FILE_MAGIC) &&
+            readString(in, robot_name_) && readString(in, group_name_) && readString(in, base_frame_) &&
+            readString(in, tip_frame_) && readValue(in, variable_count) &&
+            readValue(in, params_.position_resolution) && readValue(in, direction_resolution) &&
+            readValue(in, roll_resolution) && readValue(in, origin_[0]) && readValue(in, origin_[1]) &&
+            readValue(in, origin_[2]) && readValue(in, size[0]) && readValue(in, size[1]) && readValue(in, size[2]);
+  if (ok)
+  {
+    variable_count_ = variable_count;
+    params_.direction_resolution = direction_resolution;
+    params_.roll_resolution = roll_resolution;
+    size_ = Eigen::Vector3i(size[0], size[1], size[2]);
+    orientation_bins_ = 6 * direction_resolution * direction_resolution * roll_resolution;
+    cell_count_ = std::size_t(size_.prod()) * orientation_bins_;
+    reachable_.resize((cell_count_ + 63) / 64);
+    ok = (size_.array() > 0).all() &&
+         in.read(reinterpret_cast<char*>(reachable_.data()), reachable_.size() * sizeof(std::uint64_t));
+  }
+
+  std::uint64_t seed_count = 0;
+  ok = ok && readValue(in, seed_count) && seed_count <= cell_count_;
+  if (ok)
+  {
+    seeds_.resize(seed_count * variable_count_);
+    seed_index_.reserve(seed_count);
+    for (std::uint64_t i = 0; ok && i < seed_count; ++i)
+    {
+      std::int64_t cell;
+      ok = readValue(in, cell) && cell >= 0 && static_cast<std::uint64_t>(cell) < cell_count_ &&
+           in.read(reinterpret_cast<char*>(&seeds_[i * variable_count_]), variable_count_ * sizeof(float));
+      seed_index_[cell] = i;
+    }
+  }
+
+  if (!ok)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "'%s' is not a valid reachability map", filename.c_str());
+    clear();
+    return false;
+  }
+  ROS_DEBUG_NAMED(LOGNAME, "Loaded reachability map of group '%s' with %zu reachable cells", group_name_.c_str(),
+                  seed_index_.size());
+  return true;
+}
+
+bool ReachabilityMap::voxel(const Eigen::Vector3d& position, Eigen::Vector3i& voxel) const
+{
+  voxel = ((position - origin_) / params_.position_resolution).array().floor().cast<int>().matrix();
+  return (voxel.array() >= 0).all() && (voxel.array() < size_.array()).all();
+}
+
+std::size_t ReachabilityMap::orientationBin(const Eigen::Matrix3d& rotation) const
+{
+  // direction of the z axis: the face of the cube it points to and the cell on that face
+  const Eigen::Vector3d z = rotation.col(2);
+  int axis;
+  z.cwiseAbs().maxCoeff(&axis);
+  const std::size_t face = 2 * axis + (z[axis] < 0.0 ? 1 : 0);
+  const std::size_t n = params_.direction_resolution;
+  auto bin = [](double value, std::size_t bins) {
+    return std::min<std::size_t>(bins - 1, std::max(0.0, std::floor(value * bins)));
+  };
+  const std::size_t u = bin(0.5 * (z[(axis + 1) % 3] / std::abs(z[axis]) + 1.0), n);
+  const std::size_t v = bin(0.5 * (z[(axis + 2) % 3] / std::abs(z[axis]) + 1.0), n);
+
+  // rotation about the z axis, relative to a reference axis that is never close to z
+  const Eigen::Vector3d reference = std::abs(z.x()) < 0.9 ? Eigen::Vector3d::UnitX() : Eigen::Vector3d::UnitY();
+  const Eigen::Vector3d e1 = (reference - reference.dot(z) * z).normalized();
+  const Eigen::Vector3d e2 = z.cross(e1);
+  const double roll = std::atan2(rotation.col(0).dot(e2), rotation.col(0).dot(e1));
+  const std::size_t r = bin((roll + boost::math::constants::pi<double>()) /
+                                (2.0 * boost::math::constants::pi<double>()),
+                            params_.roll_resolution);
+
+  return ((face * n + u) * n + v) * params_.roll_resolution + r;
+}
+
+std::int64_t ReachabilityMap::cellIndex(const Eigen::Vector3i& voxel, std::size_t orientation_bin) const
+{
+  return ((std::int64_t(voxel.x()) * size_.y() + voxel.y()) * size_.z() + voxel.z()) * orientation_bins_ +
+         orientation_bin;
+}
+
+std::int64_t ReachabilityMap::cellIndex(const Eigen::Isometry3d& tip_pose) const
+{
+  Eigen::Vector3i v;
+  if (!voxel(tip_pose.translation(), v))
+    return -1;
+  return cellIndex(v, orientationBin(tip_pose.linear()));
+}
+
+bool ReachabilityMap::isReachable(const Eigen::Isometry3d& tip_pose) const
+{
+  const std::int64_t cell = cellIndex(tip_pose);
+  return cell >= 0 && ((reachable_[cell / 64] >> (cell % 64)) & 1);
+}
+
+bool ReachabilityMap::isReachable(const moveit::core::RobotState& state, const Eigen::Isometry3d& tip_pose) const
+{
+  return isReachable(toBaseFrame(state, tip_pose));
+}
+
+bool ReachabilityMap::getSeed(const Eigen::Isometry3d& tip_pose, std::vector<double>& seed) const
+{
+  Eigen::Vector3i center;
+  if (!voxel(tip_pose.translation(), center))
+    return false;
+  const std::size_t orientation_bin = orientationBin(tip_pose.linear());
+
+  auto find = [&](const Eigen::Vector3i& v) {
+    if ((v.array() < 0).any() || (v.array() >= size_.array()).any())
+      return false;
+    auto it = seed_index_.find(cellIndex(v, orientation_bin));
+    if (it == seed_index_.end())
+      return false;
+    const float* values = &seeds_[it->second * variable_count_];
+    seed.assign(values, values + variable_count_);
+    return true;
+  };
+
+  if (find(center))
+    return true;
+  for (int dx = -1; dx <= 1; ++dx)
+    for (int dy = -1; dy <= 1; ++dy)
+      for (int dz = -1; dz <= 1; ++dz)
+        if ((dx || dy || dz) && find(center + Eigen::Vector3i(dx, dy, dz)))
+          return true;
+  return false;
+}
+
+bool ReachabilityMap::getSeed(const moveit::core::RobotState& state, const Eigen::Isometry3d& tip_pose,
+                              std::vector<double>& seed) const
+{
+  return getSeed(toBaseFrame(state, tip_pose), seed);
+}
+
+Eigen::Isometry3d ReachabilityMap::toBaseFrame(const moveit::core::RobotState& state,
+                                               const Eigen::Isometry3d& tip_pose) const
+{
+  // getGlobalLinkTransform() returns a valid isometry by contract
+  return state.getGlobalLinkTransform(base_frame_).inverse() * tip_pose;
+}
+}  // namespace reachability_map
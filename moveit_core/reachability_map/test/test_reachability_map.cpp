@@ -0,0 +1,175 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/reachability_map/reachability_map.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+class ReachabilityMapTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    jmg_ = robot_model_->getJointModelGroup("panda_arm");
+    params_.position_resolution = 0.2;
+    params_.direction_resolution = 2;
+    params_.roll_resolution = 4;
+    ASSERT_TRUE(map_.compute(robot_model_, "panda_arm", "panda_link0", "panda_link8", 50000, params_));
+  }
+
+  Eigen::Isometry3d randomTipPose(moveit::core::RobotState& state)
+  {
+    state.setToRandomPositions(jmg_, rng_);
+    return state.getGlobalLinkTransform("panda_link8");
+  }
+
+  random_numbers::RandomNumberGenerator rng_{ 7 };
+  moveit::core::RobotModelConstPtr robot_model_;
+  const moveit::core::JointModelGroup* jmg_;
+  reachability_map::ReachabilityMap::Parameters params_;
+  reachability_map::ReachabilityMap map_;
+};
+
+TEST_F(ReachabilityMapTest, Metadata)
+{
+  EXPECT_EQ(map_.getRobotName(), robot_model_->getName());
+  EXPECT_EQ(map_.getGroupName(), "panda_arm");
+  EXPECT_EQ(map_.getBaseFrame(), "panda_link0");
+  EXPECT_EQ(map_.getTipFrame(), "panda_link8");
+  EXPECT_GT(map_.getReachableCellCount(), 0u);
+  EXPECT_LT(map_.getReachableCellCount(), map_.getCellCount());
+}
+
+TEST_F(ReachabilityMapTest, SampledPosesAreReachable)
+{
+  // the configurations the map was computed from, in the same order
+  random_numbers::RandomNumberGenerator rng(42);
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  std::vector<double> values;
+  for (std::size_t i = 0; i < 50000; ++i)
+  {
+    jmg_->getVariableRandomPositions(rng, values);
+    state.setJointGroupPositions(jmg_, values);
+    ASSERT_TRUE(map_.isReachable(state, state.getGlobalLinkTransform("panda_link8"))) << i;
+  }
+}
+
+TEST_F(ReachabilityMapTest, ComputeIsRepeatable)
+{
+  reachability_map::ReachabilityMap other;
+  ASSERT_TRUE(other.compute(robot_model_, "panda_arm", "panda_link0", "panda_link8", 50000, params_));
+  EXPECT_EQ(other.getReachableCellCount(), map_.getReachableCellCount());
+
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  std::vector<double> seed, other_seed;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const Eigen::Isometry3d pose = randomTipPose(state);
+    ASSERT_EQ(other.isReachable(pose), map_.isReachable(pose));
+    ASSERT_EQ(other.getSeed(pose, other_seed), map_.getSeed(pose, seed));
+    EXPECT_EQ(other_seed, seed);
+  }
+}
+
+TEST_F(ReachabilityMapTest, FarPosesAreUnreachable)
+{
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(10.0, 0.0, 0.0);
+  EXPECT_FALSE(map_.isReachable(pose));
+  std::vector<double> seed;
+  EXPECT_FALSE(map_.getSeed(pose, seed));
+}
+
+TEST_F(ReachabilityMapTest, SeedsReachNearbyPoses)
+{
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  std::vector<double> seed;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const Eigen::Isometry3d pose = randomTipPose(state);
+    if (!map_.isReachable(pose))
+      continue;
+    ASSERT_TRUE(map_.getSeed(pose, seed));
+    ASSERT_EQ(seed.size(), jmg_->getVariableCount());
+    state.setJointGroupPositions(jmg_, seed);
+    const Eigen::Isometry3d& seed_pose = state.getGlobalLinkTransform("panda_link8");
+    // same cell: at most one voxel diagonal apart
+    EXPECT_LE((seed_pose.translation() - pose.translation()).norm(),
+              std::sqrt(3.0) * params_.position_resolution + 1e-6);
+    EXPECT_TRUE(map_.isReachable(seed_pose));
+  }
+}
+
+TEST_F(ReachabilityMapTest, SaveAndLoad)
+{
+  const std::string filename = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  ASSERT_TRUE(map_.save(filename));
+
+  reachability_map::ReachabilityMap loaded;
+  ASSERT_TRUE(loaded.load(filename));
+  boost::filesystem::remove(filename);
+
+  EXPECT_EQ(loaded.getGroupName(), map_.getGroupName());
+  EXPECT_EQ(loaded.getTipFrame(), map_.getTipFrame());
+  EXPECT_EQ(loaded.getReachableCellCount(), map_.getReachableCellCount());
+  EXPECT_EQ(loaded.getCellCount(), map_.getCellCount());
+
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  std::vector<double> seed, loaded_seed;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const Eigen::Isometry3d pose = randomTipPose(state);
+    ASSERT_EQ(loaded.isReachable(pose), map_.isReachable(pose));
+    ASSERT_EQ(loaded.getSeed(pose, loaded_seed), map_.getSeed(pose, seed));
+    EXPECT_EQ(loaded_seed, seed);
+  }
+}
+
+TEST(ReachabilityMap, LoadInvalidFile)
+{
+  reachability_map::ReachabilityMap map;
+  EXPECT_FALSE(map.load("/nonexistent/reachability.map"));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/robot_model/robot_model.h>
+#include <moveit/macros/class_forward.h>
+#include <Eigen/Geometry>
+#include <cstdint>
+
+namespace moveit
+{
+namespace core
+{
+MOVEIT_CLASS_FORWARD(FKAccelerator);  // Defines FKAcceleratorPtr, ConstPtr, WeakPtr... etc
+
+/** @brief Forward kinematics compiled for one specific robot model.
+ *
+ * Implementations are emitted by the moveit_generate_fk tool (see the moveit_generate_fk() CMake function) and
+ * register themselves when the library or executable containing them is loaded. RobotState uses a registered
+ * accelerator for every robot model whose hash (computeFKModelHash()) matches the one it was generated for. */
+class FKAccelerator
+{
+public:
+  virtual ~FKAccelerator() = default;
+
+  /** \brief The hash of the robot model this accelerator was generated for */
+  virtual std::uint64_t getModelHash() const = 0;
+
+  /** \brief Compute the global transforms of the links with indices in [\e begin, \e end) from the variable
+      \e positions of the full robot state. The range must consist of a subtree (in link index order), whose parent
+      link transform, if any, is already up to date in \e link_transforms. Only the affine part of the transforms is
+      written; the last row is expected to be initialized already. */
+  virtual void computeLinkTransforms(const double* positions, Eigen::Isometry3d* link_transforms, int begin,
+                                     int end) const = 0;
+
+  /** \brief Add the geometric Jacobian of \e link w.r.t. the variables of the chain \e group to the first six rows
+      of \e jacobian, which is expected to be zero-initialized. \e reference_transform maps the model frame to the
+      frame of the chain root's parent link and \e point is the reference point expressed in that frame.
+      Return false, without touching \e jacobian, if no code was generated for this group and link. */
+  virtual bool computeJacobian(const JointModelGroup* group, const LinkModel* link,
+                               const Eigen::Isometry3d* link_transforms, const Eigen::Isometry3d& reference_transform,
+                               const Eigen::Vector3d& point, Eigen::MatrixXd& jacobian) const = 0;
+};
+
+/** \brief Compute a hash of everything generated forward kinematics depends on: the link order and tree structure,
+    joint types, variable indices, fixed origin transforms and joint axes */
+std::uint64_t computeFKModelHash(const RobotModel& model);
+
+/** \brief Make \e accelerator available to all robot states of models with a matching hash.
+    Accelerators stay registered for the lifetime of the process. Returns true to allow static registration. */
+bool registerFKAccelerator(const FKAcceleratorConstPtr& accelerator);
+
+/** \brief Get the accelerator registered for \e model, or nullptr if there is none */
+const FKAccelerator* findFKAccelerator(const RobotModelConstPtr& model);
+}  // namespace core
+}  // namespace moveit
@@ -39,6 +39,7 @@
 
 #include <moveit/robot_model/robot_model.h>
 #include <moveit/robot_state/attached_body.h>
+#include <moveit/robot_state/fk_accelerator.h>
 #include <moveit/transforms/transforms.h>
 #include <sensor_msgs/JointState.h>
 #include <visualization_msgs/MarkerArray.h>
@@ -1362,6 +1363,30 @@ public:
   /** \brief Update all transforms. */
   void update(bool force = false);
 
+  /** \brief Update the transforms of \e link and of its ancestors up to the root of the dirty links only.
+
+      Other dirty links, e.g. on other branches of the kinematic tree, are not updated. All links remain marked dirty,
+      so the next call to updateLinkTransforms() recomputes them. Transforms of collision bodies and attached bodies
+      are not updated. */
+  void updateLinkTransformsOnChain(const LinkModel* link);
+
+  /** \brief Update the transforms of \e links and of their ancestors only, see updateLinkTransformsOnChain(). */
+  void updateLinkTransformsOnChain(const std::vector<const LinkModel*>& links);
+
+  /** \brief Get the compiled forward kinematics used to update link transforms and Jacobians, if any.
+      By default, this is the accelerator registered for the robot model (see moveit_generate_fk). */
+  const FKAccelerator* getFKAccelerator() const
+  {
+    return fk_accelerator_;
+  }
+
+  /** \brief Set the compiled forward kinematics to use for this state; nullptr disables acceleration.
+      The accelerator must have been generated for the robot model of this state. */
+  void setFKAccelerator(const FKAccelerator* accelerator)
+  {
+    fk_accelerator_ = accelerator;
+  }
+
   /** \brief Update the state after setting a particular link to the input global transform pose.
 
       This "warps" the given link to the given pose, neglecting the joint values of its parent joint.
@@ -1408,6 +1433,18 @@ public:
     return global_link_transforms_[link->getLinkIndex()];
   }
 
+  /** \brief Get the link transform w.r.t. the root link (model frame) of the RobotModel, updating only the
+   *   transforms on the kinematic chain to the link (see updateLinkTransformsOnChain()).
+   *   Use this instead of getGlobalLinkTransform() when the transforms of other links are not needed.
+   *
+   *  The returned transformation is always a valid isometry.
+   */
+  const Eigen::Isometry3d& getGlobalLinkTransformOnChain(const LinkModel* link)
+  {
+    updateLinkTransformsOnChain(link);
+    return global_link_transforms_[link->getLinkIndex()];
+  }
+
   const Eigen::Isometry3d& getGlobalLinkTransform(const std::string& link_name) const
   {
     return getGlobalLinkTransform(robot_model_->getLinkModel(link_name));
@@ -1933,6 +1970,12 @@ private:
 
   void updateLinkTransformsInternal(const JointModel* start);
 
+  /** \brief Compute the global transform of \e link from the global transform of its parent link */
+  void updateLinkTransform(const LinkModel* link);
+
+  /** \brief Compute the global transforms of the links from \e top down to \e link */
+  void updateChainLinkTransforms(const LinkModel* link, const LinkModel* top);
+
   void getMissingKeys(const std::map<std::string, double>& variable_map,
                       std::vector<std::string>& missing_variables) const;
   void getStateTreeJointString(std::ostream& ss, const JointModel* jm, const std::string& pfx0, bool last) const;
@@ -1960,6 +2003,9 @@ private:
   const JointModel* dirty_link_transforms_;
   const JointModel* dirty_collision_body_transforms_;
 
+  /** \brief Compiled forward kinematics for robot_model_, or nullptr */
+  const FKAccelerator* fk_accelerator_;
+
   // All the following transform variables point into aligned memory in memory_
   // They are updated lazily, based on the flags in dirty_joint_transforms_
   // resp. the pointers dirty_link_transforms_ and dirty_collision_body_transforms_
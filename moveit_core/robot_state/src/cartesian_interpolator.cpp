@@ -61,7 +61,7 @@ double CartesianInterpolator::computeCartesianPath(RobotState* start_state, cons
 {
   const double distance = translation.norm();
   // The target pose is obtained by adding the translation vector to the link's current pose
-  Eigen::Isometry3d pose = start_state->getGlobalLinkTransform(link);
+  Eigen::Isometry3d pose = start_state->getGlobalLinkTransformOnChain(link);
 
   // the translation direction can be specified w.r.t. the local link frame (then rotate into global frame)
   pose.translation() += global_reference_frame ? translation : pose.linear() * translation;
@@ -89,7 +89,7 @@ double CartesianInterpolator::computeCartesianPath(RobotState* start_state, cons
     start_state->enforceBounds(joint);
 
   // Cartesian pose we start from
-  Eigen::Isometry3d start_pose = start_state->getGlobalLinkTransform(link) * link_offset;
+  Eigen::Isometry3d start_pose = start_state->getGlobalLinkTransformOnChain(link) * link_offset;
   Eigen::Isometry3d offset = link_offset.inverse();
 
   // the target can be in the local reference frame (in which case we rotate it)
@@ -0,0 +1,171 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/robot_state/fk_accelerator.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace moveit
+{
+namespace core
+{
+namespace
+{
+class ModelHasher
+{
+public:
+  void add(const void* data, std::size_t size)
+  {
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash_ ^= bytes[i];
+      hash_ *= 1099511628211ull;
+    }
+  }
+
+  void add(const std::string& value)
+  {
+    add(value.c_str(), value.size() + 1);
+  }
+
+  void add(int value)
+  {
+    add(&value, sizeof(value));
+  }
+
+  void add(double value)
+  {
+    // hash the bit pattern: generated code folds the exact values of constants
+    add(&value, sizeof(value));
+  }
+
+  std::uint64_t get() const
+  {
+    return hash_;
+  }
+
+private:
+  std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+struct Registry
+{
+  std::mutex lock;
+  std::atomic<bool> empty{ true };
+  std::vector<FKAcceleratorConstPtr> accelerators;
+  // models we already looked up an accelerator for; the weak pointer detects models reallocated at the same address
+  std::map<const RobotModel*, std::pair<std::weak_ptr<const RobotModel>, const FKAccelerator*>> models;
+};
+
+Registry& getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+}  // namespace
+
+std::uint64_t computeFKModelHash(const RobotModel& model)
+{
+  ModelHasher hasher;
+  hasher.add(static_cast<int>(model.getLinkModelCount()));
+  hasher.add(static_cast<int>(model.getVariableCount()));
+  for (const LinkModel* link : model.getLinkModels())
+  {
+    const JointModel* joint = link->getParentJointModel();
+    hasher.add(link->getName());
+    hasher.add(link->getParentLinkModel() ? link->getParentLinkModel()->getLinkIndex() : -1);
+    hasher.add(joint->getName());
+    hasher.add(static_cast<int>(joint->getType()));
+    hasher.add(joint->getFirstVariableIndex());
+    hasher.add(static_cast<int>(joint->getVariableCount()));
+    const Eigen::Isometry3d& origin = link->getJointOriginTransform();
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 4; ++j)
+        hasher.add(origin(i, j));
+    if (joint->getType() == JointModel::REVOLUTE || joint->getType() == JointModel::PRISMATIC)
+    {
+      const Eigen::Vector3d& axis = joint->getType() == JointModel::REVOLUTE ?
+                                        static_cast<const RevoluteJointModel*>(joint)->getAxis() :
+                                        static_cast<const PrismaticJointModel*>(joint)->getAxis();
+      for (int i = 0; i < 3; ++i)
+        hasher.add(axis[i]);
+    }
+  }
+  return hasher.get();
+}
+
+bool registerFKAccelerator(const FKAcceleratorConstPtr& accelerator)
+{
+  Registry& registry = getRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  registry.accelerators.push_back(accelerator);
+  // models without an accelerator so far may match the new one
+  registry.models.clear();
+  registry.empty = false;
+  return true;
+}
+
+const FKAccelerator* findFKAccelerator(const RobotModelConstPtr& model)
+{
+  Registry& registry = getRegistry();
+  if (registry.empty)
+    return nullptr;
+
+  std::lock_guard<std::mutex> guard(registry.lock);
+  auto it = registry.models.find(model.get());
+  if (it != registry.models.end() && it->second.first.lock() == model)
+    return it->second.second;
+
+  for (it = registry.models.begin(); it != registry.models.end();)
+    if (it->second.first.expired())
+      it = registry.models.erase(it);
+    else
+      ++it;
+
+  const std::uint64_t hash = computeFKModelHash(*model);
+  const FKAccelerator* accelerator = nullptr;
+  for (const FKAcceleratorConstPtr& candidate : registry.accelerators)
+    if (candidate->getModelHash() == hash)
+    {
+      accelerator = candidate.get();
+      break;
+    }
+  registry.models[model.get()] = std::make_pair(std::weak_ptr<const RobotModel>(model), accelerator);
+  return accelerator;
+}
+}  // namespace core
+}  // namespace moveit
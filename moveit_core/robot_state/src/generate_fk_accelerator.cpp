@@ -0,0 +1,484 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Emits C++ source with forward kinematics compiled for one robot model, see moveit/robot_state/fk_accelerator.h */
+
+#include <moveit/robot_state/fk_accelerator.h>
+#include <urdf_parser/urdf_parser.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+using moveit::core::JointModel;
+using moveit::core::JointModelGroup;
+using moveit::core::LinkModel;
+
+/** \brief A scalar of the generated code: either a constant folded at generation time or a C++ expression */
+struct Term
+{
+  bool constant;
+  double value;
+  std::string expr;
+  bool atomic;  // the expression can be used as operand without parentheses
+};
+
+Term constant(double value)
+{
+  return Term{ true, value, "", true };
+}
+
+Term expression(const std::string& expr)
+{
+  return Term{ false, 0.0, expr, true };
+}
+
+std::string literal(double value)
+{
+  // shortest representation that reads back to the same bits
+  std::stringstream ss;
+  for (int precision = 15; precision <= 17; ++precision)
+  {
+    ss.str("");
+    ss << std::setprecision(precision) << value;
+    if (std::stod(ss.str()) == value)
+      break;
+  }
+  std::string s = ss.str();
+  if (s.find_first_of(".eEn") == std::string::npos)
+    s += ".0";
+  return s;
+}
+
+std::string code(const Term& term)
+{
+  return term.constant ? literal(term.value) : term.expr;
+}
+
+std::string operand(const Term& term)
+{
+  if (term.constant)
+    return term.value < 0.0 ? "(" + literal(term.value) + ")" : literal(term.value);
+  return term.atomic ? term.expr : "(" + term.expr + ")";
+}
+
+Term operator*(const Term& a, const Term& b)
+{
+  if ((a.constant && a.value == 0.0) || (b.constant && b.value == 0.0))
+    return constant(0.0);
+  if (a.constant && b.constant)
+    return constant(a.value * b.value);
+  if (a.constant && a.value == 1.0)
+    return b;
+  if (b.constant && b.value == 1.0)
+    return a;
+  if (a.constant && a.value == -1.0)
+    return Term{ false, 0.0, "-" + operand(b), true };
+  if (b.constant && b.value == -1.0)
+    return Term{ false, 0.0, "-" + operand(a), true };
+  return Term{ false, 0.0, operand(a) + " * " + operand(b), false };
+}
+
+Term operator+(const Term& a, const Term& b)
+{
+  if (a.constant && b.constant)
+    return constant(a.value + b.value);
+  if (a.constant && a.value == 0.0)
+    return b;
+  if (b.constant && b.value == 0.0)
+    return a;
+  const std::string rhs = code(b);
+  if (rhs[0] == '-')
+    return Term{ false, 0.0, code(a) + " - " + rhs.substr(1), false };
+  return Term{ false, 0.0, code(a) + " + " + rhs, false };
+}
+
+/** \brief Symbolic affine transform: rotation in columns 0-2, translation in column 3 */
+struct Affine
+{
+  Term m[3][4];
+
+  static Affine identity()
+  {
+    Affine a;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 4; ++j)
+        a.m[i][j] = constant(i == j ? 1.0 : 0.0);
+    return a;
+  }
+
+  static Affine fixed(const Eigen::Isometry3d& transform)
+  {
+    Affine a;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 4; ++j)
+        a.m[i][j] = constant(transform(i, j));
+    return a;
+  }
+
+  // an affine transform stored column major at the double array 'name'
+  static Affine stored(const std::string& name)
+  {
+    Affine a;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 4; ++j)
+        a.m[i][j] = expression(name + "[" + std::to_string(j * 4 + i) + "]");
+    return a;
+  }
+
+  Affine operator*(const Affine& other) const
+  {
+    Affine r;
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 4; ++j)
+      {
+        Term sum = j == 3 ? m[i][3] : constant(0.0);
+        for (int k = 0; k < 3; ++k)
+          sum = sum + m[i][k] * other.m[k][j];
+        r.m[i][j] = sum;
+      }
+    return r;
+  }
+};
+
+/** \brief Emit locals for the compound entries of \e a, so they are evaluated only once */
+void emitLocals(std::ostream& out, const std::string& indent, Affine& a, const std::string& prefix = "l")
+{
+  int count = 0;
+  for (int j = 0; j < 4; ++j)
+    for (int i = 0; i < 3; ++i)
+      if (!a.m[i][j].constant && !a.m[i][j].atomic)
+      {
+        const std::string name = prefix + std::to_string(count++);
+        out << indent << "const double " << name << " = " << a.m[i][j].expr << ";\n";
+        a.m[i][j] = expression(name);
+      }
+}
+
+/** \brief The local transform of the parent joint of \e link, including the fixed joint origin */
+Affine emitJointTransform(std::ostream& out, const std::string& indent, const LinkModel* link)
+{
+  const JointModel* joint = link->getParentJointModel();
+  const std::string q = "q[" + std::to_string(joint->getFirstVariableIndex()) + "]";
+  Affine j = Affine::identity();
+  switch (joint->getType())
+  {
+    case JointModel::REVOLUTE:
+    {
+      const Eigen::Vector3d& axis = static_cast<const moveit::core::RevoluteJointModel*>(joint)->getAxis();
+      out << indent << "const double s = std::sin(" << q << ");\n";
+      out << indent << "const double c = std::cos(" << q << ");\n";
+      const Term s = expression("s"), c = expression("c"), v = expression("v");
+      // the versine is not needed for axes along x, y or z
+      if ((axis.x() != 0.0) + (axis.y() != 0.0) + (axis.z() != 0.0) > 1)
+        out << indent << "const double v = 1.0 - c;\n";
+      // for axes along x, y or z, v * a^2 + c with a^2 = 1 is folded to 1
+      auto diagonal = [&](double a2) { return a2 == 1.0 ? constant(1.0) : v * constant(a2) + c; };
+      auto offdiagonal = [&](double ab) { return v * constant(ab); };
+      j.m[0][0] = diagonal(axis.x() * axis.x());
+      j.m[1][0] = offdiagonal(axis.x() * axis.y()) + constant(axis.z()) * s;
+      j.m[2][0] = offdiagonal(axis.x() * axis.z()) + constant(-axis.y()) * s;
+      j.m[0][1] = offdiagonal(axis.x() * axis.y()) + constant(-axis.z()) * s;
+      j.m[1][1] = diagonal(axis.y() * axis.y());
+      j.m[2][1] = offdiagonal(axis.y() * axis.z()) + constant(axis.x()) * s;
+      j.m[0][2] = offdiagonal(axis.x() * axis.z()) + constant(axis.y()) * s;
+      j.m[1][2] = offdiagonal(axis.y() * axis.z()) + constant(-axis.x()) * s;
+      j.m[2][2] = diagonal(axis.z() * axis.z());
+      emitLocals(out, indent, j, "r");
+      break;
+    }
+    case JointModel::PRISMATIC:
+    {
+      const Eigen::Vector3d& axis = static_cast<const moveit::core::PrismaticJointModel*>(joint)->getAxis();
+      for (int i = 0; i < 3; ++i)
+        j.m[i][3] = constant(axis[i]) * expression(q);
+      break;
+    }
+    case JointModel::PLANAR:
+    {
+      const int index = joint->getFirstVariableIndex();
+      out << indent << "const double s = std::sin(q[" << index + 2 << "]);\n";
+      out << indent << "const double c = std::cos(q[" << index + 2 << "]);\n";
+      j.m[0][0] = j.m[1][1] = expression("c");
+      j.m[1][0] = expression("s");
+      j.m[0][1] = expression("-s");
+      j.m[0][3] = expression("q[" + std::to_string(index) + "]");
+      j.m[1][3] = expression("q[" + std::to_string(index + 1) + "]");
+      break;
+    }
+    case JointModel::FLOATING:
+    {
+      const int index = joint->getFirstVariableIndex();
+      out << indent << "const Eigen::Matrix3d r = Eigen::Quaterniond(q[" << index + 6 << "], q[" << index + 3
+          << "], q[" << index + 4 << "], q[" << index + 5 << "]).normalized().toRotationMatrix();\n";
+      for (int r = 0; r < 3; ++r)
+      {
+        for (int c = 0; c < 3; ++c)
+          j.m[r][c] = expression("r(" + std::to_string(r) + ", " + std::to_string(c) + ")");
+        j.m[r][3] = expression("q[" + std::to_string(index + r) + "]");
+      }
+      break;
+    }
+    default:  // fixed
+      break;
+  }
+  return Affine::fixed(link->getJointOriginTransform()) * j;
+}
+
+void emitLinkTransforms(std::ostream& out, const moveit::core::RobotModel& model)
+{
+  out << "  void computeLinkTransforms(const double* q, Eigen::Isometry3d* t, int begin, int end) const override\n"
+      << "  {\n"
+      << "    // links are numbered depth-first, so we start at the first link of the range and fall through the "
+         "rest\n"
+      << "    switch (begin)\n"
+      << "    {\n";
+  const std::string indent = "        ";
+  for (const LinkModel* link : model.getLinkModels())
+  {
+    const int index = link->getLinkIndex();
+    out << "      case " << index << ":  // " << link->getName() << "\n"
+        << "      {\n"
+        << indent << "if (end <= " << index << ")\n"
+        << indent << "  return;\n";
+    Affine local = emitJointTransform(out, indent, link);
+    Affine global = local;
+    if (link->getParentLinkModel())
+    {
+      emitLocals(out, indent, local);
+      out << indent << "const double* p = t[" << link->getParentLinkModel()->getLinkIndex() << "].data();\n";
+      global = Affine::stored("p") * local;
+    }
+    out << indent << "double* d = t[" << index << "].data();\n";
+    for (int j = 0; j < 4; ++j)
+      for (int i = 0; i < 3; ++i)
+        out << indent << "d[" << j * 4 + i << "] = " << code(global.m[i][j]) << ";\n";
+    out << "      }\n"
+        << "        // fall through\n";
+  }
+  out << "      default:\n"
+      << "        break;\n"
+      << "    }\n"
+      << "  }\n";
+}
+
+/** \brief Emit the Jacobian of \e link w.r.t. \e group, following RobotState::getJacobian() */
+bool emitJacobian(std::ostream& out, const JointModelGroup* group, const LinkModel* link)
+{
+  std::stringstream body;
+  const JointModel* root_joint_model = group->getJointModels()[0];
+  while (link)
+  {
+    const JointModel* pjm = link->getParentJointModel();
+    if (pjm->getVariableCount() > 0 && group->hasJointModel(pjm->getName()))
+    {
+      const int column = group->getVariableGroupIndex(pjm->getName());
+      Eigen::Vector3d axis;
+      if (pjm->getType() == JointModel::REVOLUTE)
+        axis = static_cast<const moveit::core::RevoluteJointModel*>(pjm)->getAxis();
+      else if (pjm->getType() == JointModel::PRISMATIC)
+        axis = static_cast<const moveit::core::PrismaticJointModel*>(pjm)->getAxis();
+      else
+      {
+        std::cerr << "Joint '" << pjm->getName() << "' of group '" << group->getName()
+                  << "' is neither revolute nor prismatic. No Jacobian is generated for this group." << std::endl;
+        return false;
+      }
+
+      std::string world_axis;
+      for (int i = 0; i < 3; ++i)
+        if (axis[i] == 1.0 || axis[i] == -1.0)
+          world_axis = std::string(axis[i] < 0.0 ? "-" : "") + "joint_transform.linear().col(" + std::to_string(i) + ")";
+      if (world_axis.empty())
+        world_axis = "joint_transform.linear() * Eigen::Vector3d(" + literal(axis.x()) + ", " + literal(axis.y()) +
+                     ", " + literal(axis.z()) + ")";
+
+      body << "      {  // " << pjm->getName() << "\n"
+           << "        const Eigen::Isometry3d joint_transform = reference_transform * t[" << link->getLinkIndex()
+           << "];\n"
+           << "        const Eigen::Vector3d joint_axis = " << world_axis << ";\n";
+      if (pjm->getType() == JointModel::REVOLUTE)
+        body << "        jacobian.block<3, 1>(0, " << column
+             << ") += joint_axis.cross(point - joint_transform.translation());\n"
+             << "        jacobian.block<3, 1>(3, " << column << ") += joint_axis;\n";
+      else
+        body << "        jacobian.block<3, 1>(0, " << column << ") += joint_axis;\n";
+      body << "      }\n";
+    }
+    if (pjm == root_joint_model)
+      break;
+    link = pjm->getParentLinkModel();
+  }
+  out << body.str();
+  return true;
+}
+
+void emitJacobians(std::ostream& out, const std::vector<std::pair<const JointModelGroup*, const LinkModel*>>& chains)
+{
+  std::stringstream body;
+  for (const auto& chain : chains)
+  {
+    std::stringstream code;
+    if (!emitJacobian(code, chain.first, chain.second))
+      continue;
+    body << "    if (link->getLinkIndex() == " << chain.second->getLinkIndex() << " && group->getName() == \""
+         << chain.first->getName() << "\")\n"
+         << "    {\n"
+         << code.str() << "      return true;\n"
+         << "    }\n";
+  }
+
+  const bool empty = body.str().empty();
+  auto param = [empty](const std::string& name) { return empty ? "/* " + name + " */" : name; };
+  out << "  bool computeJacobian(const moveit::core::JointModelGroup* " << param("group")
+      << ", const moveit::core::LinkModel* " << param("link") << ",\n"
+      << "                       const Eigen::Isometry3d* " << param("t")
+      << ", const Eigen::Isometry3d& " << param("reference_transform") << ",\n"
+      << "                       const Eigen::Vector3d& " << param("point") << ", Eigen::MatrixXd& "
+      << param("jacobian") << ") const override\n"
+      << "  {\n"
+      << body.str() << "    return false;\n"
+      << "  }\n";
+}
+
+/** \brief The links at the end of the chain \e group, i.e. those without a child link in the group */
+std::vector<const LinkModel*> getTips(const JointModelGroup* group)
+{
+  std::vector<const LinkModel*> tips;
+  for (const LinkModel* link : group->getLinkModels())
+  {
+    bool tip = true;
+    for (const JointModel* child : link->getChildJointModels())
+      if (group->hasLinkModel(child->getChildLinkModel()->getName()))
+        tip = false;
+    if (tip)
+      tips.push_back(link);
+  }
+  return tips;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " <urdf file> <srdf file> <output file> [group[:link]...]\n\n"
+              << "Generate C++ source with forward kinematics compiled for the given robot model, and with Jacobians\n"
+              << "of the given chain groups w.r.t. their tip or the given link (by default: all chain groups).\n"
+              << "Linking the generated code registers it as accelerator for RobotState." << std::endl;
+    return 1;
+  }
+
+  urdf::ModelInterfaceSharedPtr urdf_model = urdf::parseURDFFile(argv[1]);
+  if (!urdf_model)
+  {
+    std::cerr << "Cannot parse URDF file '" << argv[1] << "'" << std::endl;
+    return 1;
+  }
+  auto srdf_model = std::make_shared<srdf::Model>();
+  if (!srdf_model->initFile(*urdf_model, argv[2]))
+  {
+    std::cerr << "Cannot parse SRDF file '" << argv[2] << "'" << std::endl;
+    return 1;
+  }
+  moveit::core::RobotModel model(urdf_model, srdf_model);
+
+  std::vector<std::pair<const JointModelGroup*, const LinkModel*>> chains;
+  std::vector<std::string> specs(argv + 4, argv + argc);
+  if (specs.empty())
+    for (const JointModelGroup* group : model.getJointModelGroups())
+      if (group->isChain())
+        specs.push_back(group->getName());
+  for (const std::string& spec : specs)
+  {
+    const std::size_t colon = spec.find(':');
+    const JointModelGroup* group = model.getJointModelGroup(spec.substr(0, colon));
+    if (!group || !group->isChain())
+    {
+      std::cerr << "'" << spec.substr(0, colon) << "' is not a chain group of the robot model" << std::endl;
+      return 1;
+    }
+    if (colon != std::string::npos)
+    {
+      const LinkModel* link = model.getLinkModel(spec.substr(colon + 1));
+      if (!link || !group->isLinkUpdated(link->getName()))
+      {
+        std::cerr << "Link '" << spec.substr(colon + 1) << "' is not updated by group '" << group->getName() << "'"
+                  << std::endl;
+        return 1;
+      }
+      chains.emplace_back(group, link);
+    }
+    else
+      for (const LinkModel* tip : getTips(group))
+        chains.emplace_back(group, tip);
+  }
+
+  std::stringstream out;
+  out << "// Generated by moveit_generate_fk for robot '" << model.getName() << "'. Do not edit.\n\n"
+      << "#include <moveit/robot_state/fk_accelerator.h>\n"
+      << "#include <cmath>\n\n"
+      << "namespace\n"
+      << "{\n"
+      << "class GeneratedFKAccelerator : public moveit::core::FKAccelerator\n"
+      << "{\n"
+      << "public:\n"
+      << "  std::uint64_t getModelHash() const override\n"
+      << "  {\n"
+      << "    return " << moveit::core::computeFKModelHash(model) << "ull;\n"
+      << "  }\n\n";
+  emitLinkTransforms(out, model);
+  out << "\n";
+  emitJacobians(out, chains);
+  out << "};\n\n"
+      << "struct Registrar\n"
+      << "{\n"
+      << "  Registrar()\n"
+      << "  {\n"
+      << "    moveit::core::registerFKAccelerator(std::make_shared<GeneratedFKAccelerator>());\n"
+      << "  }\n"
+      << "} REGISTRAR;\n"
+      << "}  // namespace\n";
+
+  std::ofstream file(argv[3]);
+  file << out.str();
+  if (!file)
+  {
+    std::cerr << "Cannot write '" << argv[3] << "'" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -70,12 +70,14 @@ RobotState::RobotState(const RobotModelConstPtr& robot_model)
     throw std::invalid_argument("RobotState cannot be constructed with nullptr RobotModelConstPtr");
   }
 
+  fk_accelerator_ = findFKAccelerator(robot_model_);
+
   dirty_link_transforms_ = robot_model_->getRootJoint();
   allocMemory();
   initTransforms();
 }
 
-RobotState::RobotState(const RobotState& other) : rng_(nullptr)
+RobotState::RobotState(const RobotState& other) : fk_accelerator_(other.fk_accelerator_), rng_(nullptr)
 {
   robot_model_ = other.robot_model_;
   allocMemory();
@@ -148,6 +150,7 @@ RobotState& RobotState::operator=(const RobotState& other)
 
 void RobotState::copyFrom(const RobotState& other)
 {
+  fk_accelerator_ = other.fk_accelerator_;
   has_velocity_ = other.has_velocity_;
   has_acceleration_ = other.has_acceleration_;
   has_effort_ = other.has_effort_;
@@ -715,38 +718,49 @@ void RobotState::updateLinkTransforms()
   }
 }
 
-void RobotState::updateLinkTransformsInternal(const JointModel* start)
+inline void RobotState::updateLinkTransform(const LinkModel* link)
 {
-  for (const LinkModel* link : start->getDescendantLinkModels())
+  int idx_link = link->getLinkIndex();
+  const LinkModel* parent = link->getParentLinkModel();
+  if (parent)  // root JointModel will not have a parent
   {
-    int idx_link = link->getLinkIndex();
-    const LinkModel* parent = link->getParentLinkModel();
-    if (parent)  // root JointModel will not have a parent
+    int idx_parent = parent->getLinkIndex();
+    if (link->parentJointIsFixed())  // fixed joint
+      global_link_transforms_[idx_link].affine().noalias() =
+          global_link_transforms_[idx_parent].affine() * link->getJointOriginTransform().matrix();
+    else  // non-fixed joint
     {
-      int idx_parent = parent->getLinkIndex();
-      if (link->parentJointIsFixed())  // fixed joint
+      if (link->jointOriginTransformIsIdentity())  // Link has identity transform
         global_link_transforms_[idx_link].affine().noalias() =
-            global_link_transforms_[idx_parent].affine() * link->getJointOriginTransform().matrix();
-      else  // non-fixed joint
-      {
-        if (link->jointOriginTransformIsIdentity())  // Link has identity transform
-          global_link_transforms_[idx_link].affine().noalias() =
-              global_link_transforms_[idx_parent].affine() * getJointTransform(link->getParentJointModel()).matrix();
-        else  // Link has non-identity transform
-          global_link_transforms_[idx_link].affine().noalias() =
-              global_link_transforms_[idx_parent].affine() * link->getJointOriginTransform().matrix() *
-              getJointTransform(link->getParentJointModel()).matrix();
-      }
-    }
-    else  // is the origin / root / 'model frame'
-    {
-      if (link->jointOriginTransformIsIdentity())
-        global_link_transforms_[idx_link] = getJointTransform(link->getParentJointModel());
-      else
+            global_link_transforms_[idx_parent].affine() * getJointTransform(link->getParentJointModel()).matrix();
+      else  // Link has non-identity transform
         global_link_transforms_[idx_link].affine().noalias() =
-            link->getJointOriginTransform().affine() * getJointTransform(link->getParentJointModel()).matrix();
+            global_link_transforms_[idx_parent].affine() * link->getJointOriginTransform().matrix() *
+            getJointTransform(link->getParentJointModel()).matrix();
     }
   }
+  else  // is the origin / root / 'model frame'
+  {
+    if (link->jointOriginTransformIsIdentity())
+      global_link_transforms_[idx_link] = getJointTransform(link->getParentJointModel());
+    else
+      global_link_transforms_[idx_link].affine().noalias() =
+          link->getJointOriginTransform().affine() * getJointTransform(link->getParentJointModel()).matrix();
+  }
+}
+
+void RobotState::updateLinkTransformsInternal(const JointModel* start)
+{
+  const std::vector<const LinkModel*>& links = start->getDescendantLinkModels();
+  // compiled kinematics work on ranges of link indices; the descendants of a joint form such a range,
+  // unless mimic joints add the subtrees of other branches
+  if (fk_accelerator_ && !links.empty() &&
+      links.back()->getLinkIndex() - links.front()->getLinkIndex() + 1 == static_cast<int>(links.size()))
+    fk_accelerator_->computeLinkTransforms(position_, global_link_transforms_, links.front()->getLinkIndex(),
+                                           links.back()->getLinkIndex() + 1);
+  else
+    for (const LinkModel* link : links)
+      updateLinkTransform(link);
 
   // update attached bodies tf; these are usually very few, so we update them all
   for (const auto& attached_body : attached_body_map_)
@@ -754,6 +768,35 @@ void RobotState::updateLinkTransformsInternal(const JointModel* start)
         global_link_transforms_[attached_body.second->getAttachedLink()->getLinkIndex()]);
 }
 
+void RobotState::updateChainLinkTransforms(const LinkModel* link, const LinkModel* top)
+{
+  if (link != top)
+    updateChainLinkTransforms(link->getParentLinkModel(), top);
+  updateLinkTransform(link);
+}
+
+void RobotState::updateLinkTransformsOnChain(const LinkModel* link)
+{
+  if (dirty_link_transforms_ == nullptr)
+    return;
+
+  // only the links below the root of the dirty links need to be updated
+  const LinkModel* top = link;
+  while (top->getParentJointModel() != dirty_link_transforms_)
+  {
+    top = top->getParentLinkModel();
+    if (!top)  // link is not below the dirty root, so its transform is up to date
+      return;
+  }
+  updateChainLinkTransforms(link, top);
+}
+
+void RobotState::updateLinkTransformsOnChain(const std::vector<const LinkModel*>& links)
+{
+  for (const LinkModel* link : links)
+    updateLinkTransformsOnChain(link);
+}
+
 void RobotState::updateStateWithLinkAt(const LinkModel* link, const Eigen::Isometry3d& transform, bool backward)
 {
   updateLinkTransforms();  // no link transforms must be dirty, otherwise the transform we set will be overwritten
@@ -1347,7 +1390,10 @@ bool RobotState::getJacobian(const JointModelGroup* group, const LinkModel* link
   Eigen::Vector3d joint_axis;
   Eigen::Isometry3d joint_transform;
 
-  while (link)
+  const bool accelerated = fk_accelerator_ && fk_accelerator_->computeJacobian(group, link, global_link_transforms_,
+                                                                               reference_transform, point_transform,
+                                                                               jacobian);
+  while (link && !accelerated)
   {
     /*
     ROS_DEBUG_NAMED(LOGNAME, "Link: %s, %f %f %f",link_state->getName().c_str(),
@@ -1568,7 +1614,7 @@ bool RobotState::setToIKSolverFrame(Eigen::Isometry3d& pose, const std::string&
       ROS_ERROR_STREAM_NAMED(LOGNAME, "IK frame '" << ik_frame << "' does not exist.");
       return false;
     }
-    pose = getGlobalLinkTransform(link_model).inverse() * pose;
+    pose = getGlobalLinkTransformOnChain(link_model).inverse() * pose;
   }
   return true;
 }
@@ -1777,7 +1823,7 @@ bool RobotState::setFromIK(const JointModelGroup* jmg, const EigenSTL::vector_Is
       solver_tip_frame = solver_tip_frame.substr(1);
 
     // Get the pose of a different EE tip link
-    Eigen::Isometry3d current_pose = getGlobalLinkTransform(solver_tip_frame);
+    Eigen::Isometry3d current_pose = getGlobalLinkTransformOnChain(getLinkModel(solver_tip_frame));
 
     // bring the pose to the frame of the IK solver
     if (!setToIKSolverFrame(current_pose, solver))
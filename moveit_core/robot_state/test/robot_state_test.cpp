@@ -693,6 +693,41 @@ TEST_F(OneRobot, testInterpolation)
   EXPECT_TRUE(nan_exception) << "NaN interpolation parameter did not create expected exception.";
 }
 
+TEST_F(OneRobot, updateLinkTransformsOnChain)
+{
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  state.update();
+
+  const moveit::core::LinkModel* link_c = robot_model_->getLinkModel("link_c");
+  const moveit::core::LinkModel* link_e = robot_model_->getLinkModel("link_e");
+  for (int i = 0; i < 10; ++i)
+  {
+    state.setToRandomPositions();
+    moveit::core::RobotState expected(state);
+    expected.update();
+
+    // only the chains are updated, everything else stays dirty
+    EXPECT_NEAR_TRACED(state.getGlobalLinkTransformOnChain(link_c).matrix(),
+                       expected.getGlobalLinkTransform(link_c).matrix());
+    EXPECT_TRUE(state.dirtyLinkTransforms());
+    state.updateLinkTransformsOnChain({ link_c, link_e });
+    EXPECT_NEAR_TRACED(state.getGlobalLinkTransformOnChain(link_e).matrix(),
+                       expected.getGlobalLinkTransform(link_e).matrix());
+    EXPECT_TRUE(state.dirtyLinkTransforms());
+
+    // a full update afterwards computes all links
+    state.update();
+    EXPECT_FALSE(state.dirtyLinkTransforms());
+    for (const moveit::core::LinkModel* link : robot_model_->getLinkModels())
+      EXPECT_NEAR_TRACED(state.getGlobalLinkTransform(link).matrix(), expected.getGlobalLinkTransform(link).matrix());
+  }
+
+  // updating a chain of an up-to-date state changes nothing
+  const Eigen::Isometry3d pose = state.getGlobalLinkTransform(link_e);
+  EXPECT_NEAR_TRACED(state.getGlobalLinkTransformOnChain(link_e).matrix(), pose.matrix());
+}
+
 TEST_F(OneRobot, rigidlyConnectedParent)
 {
   // link_e is its own rigidly-connected parent
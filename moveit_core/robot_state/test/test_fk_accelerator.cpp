@@ -0,0 +1,141 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/robot_state/robot_state.h>
+#include <moveit/robot_state/fk_accelerator.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <moveit/utils/eigen_test_utils.h>
+#include <gtest/gtest.h>
+
+using namespace moveit::core;
+
+// this test links forward kinematics generated for the panda by moveit_generate_fk()
+class PandaFKAccelerator : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = loadTestingRobotModel("panda");
+    arm_ = robot_model_->getJointModelGroup("panda_arm");
+  }
+
+  RobotModelPtr robot_model_;
+  const JointModelGroup* arm_;
+};
+
+TEST_F(PandaFKAccelerator, registration)
+{
+  const FKAccelerator* accelerator = findFKAccelerator(robot_model_);
+  ASSERT_NE(accelerator, nullptr);
+  EXPECT_EQ(accelerator->getModelHash(), computeFKModelHash(*robot_model_));
+  EXPECT_EQ(RobotState(robot_model_).getFKAccelerator(), accelerator);
+
+  RobotModelBuilder builder("simple", "a");
+  builder.addChain("a->b->c", "revolute");
+  RobotModelPtr other = builder.build();
+  EXPECT_EQ(findFKAccelerator(other), nullptr);
+  EXPECT_EQ(RobotState(other).getFKAccelerator(), nullptr);
+}
+
+TEST_F(PandaFKAccelerator, copy)
+{
+  RobotState generic(robot_model_);
+  generic.setFKAccelerator(nullptr);
+  EXPECT_EQ(RobotState(generic).getFKAccelerator(), nullptr);
+
+  // assignment copies the accelerator as well, in both directions
+  RobotState state(robot_model_);
+  const FKAccelerator* accelerator = state.getFKAccelerator();
+  ASSERT_NE(accelerator, nullptr);
+  state = generic;
+  EXPECT_EQ(state.getFKAccelerator(), nullptr);
+  state = RobotState(robot_model_);
+  EXPECT_EQ(state.getFKAccelerator(), accelerator);
+}
+
+TEST_F(PandaFKAccelerator, linkTransforms)
+{
+  RobotState accelerated(robot_model_);
+  RobotState generic(robot_model_);
+  generic.setFKAccelerator(nullptr);
+  ASSERT_NE(accelerated.getFKAccelerator(), nullptr);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    // the first update computes all links, the second one the subtree of the arm only
+    accelerated.setToRandomPositions();
+    generic.setVariablePositions(accelerated.getVariablePositions());
+    for (int update = 0; update < 2; ++update)
+    {
+      accelerated.update();
+      generic.update();
+      for (const LinkModel* link : robot_model_->getLinkModels())
+        EXPECT_EIGEN_NEAR(accelerated.getGlobalLinkTransform(link).matrix(),
+                          generic.getGlobalLinkTransform(link).matrix(), 1e-12);
+
+      accelerated.setToRandomPositions(arm_);
+      generic.setVariablePositions(accelerated.getVariablePositions());
+    }
+  }
+}
+
+TEST_F(PandaFKAccelerator, jacobian)
+{
+  RobotState accelerated(robot_model_);
+  RobotState generic(robot_model_);
+  generic.setFKAccelerator(nullptr);
+  const Eigen::Vector3d reference_point(0.01, -0.02, 0.1);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    accelerated.setToRandomPositions();
+    generic.setVariablePositions(accelerated.getVariablePositions());
+    for (const char* link : { "panda_link8", "panda_hand", "panda_link5" })
+      for (bool use_quaternion_representation : { false, true })
+      {
+        Eigen::MatrixXd expected, actual;
+        ASSERT_TRUE(accelerated.getJacobian(arm_, robot_model_->getLinkModel(link), reference_point, actual,
+                                            use_quaternion_representation));
+        ASSERT_TRUE(generic.getJacobian(arm_, robot_model_->getLinkModel(link), reference_point, expected,
+                                        use_quaternion_representation));
+        EXPECT_EIGEN_NEAR(actual, expected, 1e-12);
+      }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
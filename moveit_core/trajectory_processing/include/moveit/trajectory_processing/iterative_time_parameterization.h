@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include <Eigen/Core>
 #include <moveit/robot_trajectory/robot_trajectory.h>
 #include <moveit/trajectory_processing/time_parameterization.h>
 
@@ -47,7 +48,14 @@ MOVEIT_CLASS_FORWARD(IterativeParabolicTimeParameterization);
 class IterativeParabolicTimeParameterization : public TimeParameterization
 {
 public:
-  IterativeParabolicTimeParameterization(unsigned int max_iterations = 100, double max_time_change_per_it = .01);
+  /// @brief positions of the group's variables, one row per variable and one column per waypoint
+  using PositionMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /// If vectorized is true, the group's positions are copied into a contiguous matrix once, processed with array
+  /// operations and written back once. The result is identical to the original waypoint-by-waypoint implementation,
+  /// which is used if vectorized is false.
+  IterativeParabolicTimeParameterization(unsigned int max_iterations = 100, double max_time_change_per_it = .01,
+                                         bool vectorized = true);
 
   bool computeTimeStamps(robot_trajectory::RobotTrajectory& trajectory, const double max_velocity_scaling_factor = 1.0,
                          const double max_acceleration_scaling_factor = 1.0) const override;
@@ -57,6 +65,7 @@ public:
 private:
   unsigned int max_iterations_;    /// @brief maximum number of iterations to find solution
   double max_time_change_per_it_;  /// @brief maximum allowed time change per iteration in seconds
+  bool vectorized_;                /// @brief operate on a positions matrix instead of the RobotStates
 
   void applyVelocityConstraints(robot_trajectory::RobotTrajectory& rob_trajectory, std::vector<double>& time_diff,
                                 const double max_velocity_scaling_factor) const;
@@ -64,6 +73,16 @@ private:
   void applyAccelerationConstraints(robot_trajectory::RobotTrajectory& rob_trajectory, std::vector<double>& time_diff,
                                     const double max_acceleration_scaling_factor) const;
 
+  void applyVelocityConstraints(const PositionMatrix& positions, const std::vector<double>& max_velocities,
+                                std::vector<double>& time_diff) const;
+
+  void applyAccelerationConstraints(const PositionMatrix& positions, const double* start_velocities,
+                                    const std::vector<double>& max_accelerations, std::vector<double>& time_diff) const;
+
+  void computeTimeStampsVectorized(robot_trajectory::RobotTrajectory& trajectory,
+                                   const double max_velocity_scaling_factor,
+                                   const double max_acceleration_scaling_factor) const;
+
   double findT1(const double d1, const double d2, double t1, const double t2, const double a_max) const;
   double findT2(const double d1, const double d2, const double t1, double t2, const double a_max) const;
 };
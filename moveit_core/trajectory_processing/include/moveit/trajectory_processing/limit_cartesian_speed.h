@@ -39,6 +39,7 @@
 
 #include <moveit/macros/class_forward.h>
 #include <string>
+#include <vector>
 namespace trajectory_processing
 {
 MOVEIT_CLASS_FORWARD(RobotTrajectory);
@@ -50,4 +51,8 @@ bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, c
                                 const moveit::core::LinkModel* link_model);
 bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, const double speed,
                                 const std::string& link_name = "");
+/// Limit the Cartesian speed of several links in a single pass. The link positions are computed for all waypoints in
+/// parallel, updating only the kinematic chains to these links.
+bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, const double speed,
+                                const std::vector<const moveit::core::LinkModel*>& link_models);
 }  // namespace trajectory_processing
@@ -52,12 +52,13 @@ public:
    * \param max_acceleration_scaling_factor Scale all joint acceleration limits by this factor. Usually 1.0.
    * \param mitigate_overshoot If true, overshoot is mitigated by extending trajectory duration.
    * \param overshoot_threshold If an overshoot is greater than this, duration is extended (radians, for a single joint)
+   * \param parallel If true, segments are smoothed in parallel and failing segments are slowed down individually.
    * \return true if successful.
    */
   static bool applySmoothing(robot_trajectory::RobotTrajectory& trajectory,
                              const double max_velocity_scaling_factor = 1.0,
                              const double max_acceleration_scaling_factor = 1.0, const bool mitigate_overshoot = false,
-                             const double overshoot_threshold = 0.01);
+                             const double overshoot_threshold = 0.01, const bool parallel = false);
 
   /**
    * \brief Apply jerk-limited smoothing to a trajectory
@@ -66,20 +67,15 @@ public:
    * \param jerk_limits Joint names and jerk limits in rad/s^3
    * \param mitigate_overshoot If true, overshoot is mitigated by extending trajectory duration.
    * \param overshoot_threshold If an overshoot is greater than this, duration is extended (radians, for a single joint)
+   * \param parallel If true, segments are smoothed in parallel and failing segments are slowed down individually.
    * \return true if successful.
    */
   static bool applySmoothing(robot_trajectory::RobotTrajectory& trajectory,
                              const std::unordered_map<std::string, double>& velocity_limits,
                              const std::unordered_map<std::string, double>& acceleration_limits,
                              const std::unordered_map<std::string, double>& jerk_limits,
-                             const bool mitigate_overshoot = false, const double overshoot_threshold = 0.01);
-
-private:
-  /**
-   * \brief A utility function to check if the group is defined.
-   * \param trajectory      Trajectory to smooth.
-   */
-  [[nodiscard]] static bool validateGroup(const robot_trajectory::RobotTrajectory& trajectory);
+                             const bool mitigate_overshoot = false, const double overshoot_threshold = 0.01,
+                             const bool parallel = false);
 
   /**
    * \brief A utility function to get bounds from a JointModelGroup and save them for Ruckig.
@@ -93,6 +89,13 @@ private:
                                                 moveit::core::JointModelGroup const* const group,
                                                 ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input);
 
+private:
+  /**
+   * \brief A utility function to check if the group is defined.
+   * \param trajectory      Trajectory to smooth.
+   */
+  [[nodiscard]] static bool validateGroup(const robot_trajectory::RobotTrajectory& trajectory);
+
   /**
    * \brief Feed previous output back as input for next iteration. Get next target state from the next waypoint.
    * \param current_waypoint    The nominal current state
@@ -143,6 +146,33 @@ private:
                                       ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
                                       const bool mitigate_overshoot = false, const double overshoot_threshold = 0.01);
 
+  /**
+   * \brief Like runRuckig(), but computes all segments in parallel, using one Ruckig calculator per thread.
+   * Segments that fail are slowed down individually afterwards, instead of growing a factor shared by all subsequent
+   * segments. For trajectories that need no slow-down, the result is identical to runRuckig().
+   * \param[in, out] trajectory      Trajectory to smooth.
+   * \param[in]      ruckig_input    Necessary input for Ruckig smoothing. Contains kinematic limits (vel, accel, jerk)
+   * \param mitigate_overshoot If true, overshoot is mitigated by extending trajectory duration.
+   * \param overshoot_threshold If an overshoot is greater than this, duration is extended (radians, for a single joint)
+   */
+  [[nodiscard]] static bool runRuckigParallel(robot_trajectory::RobotTrajectory& trajectory,
+                                              const ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
+                                              const bool mitigate_overshoot = false,
+                                              const double overshoot_threshold = 0.01);
+
+  /**
+   * \brief Run Ruckig for the segment from waypoint_idx to waypoint_idx + 1
+   * \param[in, out] ruckig  The calculator to use
+   * \param[in, out] ruckig_input  Input parameters with kinematic limits. The segment's states are filled in here.
+   * \param[out] ruckig_trajectory  The computed segment
+   * \return true if the segment reaches its target (without overshoot, if mitigate_overshoot is set)
+   */
+  static bool smoothSegment(ruckig::Ruckig<ruckig::DynamicDOFs>& ruckig,
+                            ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
+                            ruckig::Trajectory<ruckig::DynamicDOFs, ruckig::StandardVector>& ruckig_trajectory,
+                            robot_trajectory::RobotTrajectory& trajectory, size_t waypoint_idx,
+                            const bool mitigate_overshoot, const double overshoot_threshold);
+
   /**
    * \brief Extend the duration of every trajectory segment
    * \param[in] duration_extension_factor A number greater than 1. Extend every timestep by this much.
@@ -0,0 +1,139 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <moveit/robot_trajectory/robot_trajectory.h>
+#include <ruckig/ruckig.hpp>
+
+namespace trajectory_processing
+{
+/**
+ * \brief Incremental, jerk-limited time parameterization of a stream of waypoints.
+ *
+ * Unlike the TimeParameterization implementations, which need the complete path up front, this class accepts
+ * waypoints one at a time and hands out time-stamped segments as soon as they can no longer change. A waypoint is
+ * final once look_ahead further waypoints are known (or the stream was finished): its velocity is then chosen such
+ * that the robot can still come to rest at the last known waypoint, so the emitted prefix stays valid whatever
+ * waypoints follow. Each segment between waypoints is computed with Ruckig from the exact end state of the previous
+ * one, so the concatenated output is continuous in position, velocity and acceleration.
+ *
+ * Every segment returned by getSegment() starts with the last waypoint of the previous segment (or the start state),
+ * so it can be validated and executed on its own, e.g. by pushing it to the TrajectoryExecutionManager. While the
+ * first segment is executed, each following one can be appended with TrajectoryExecutionManager::splice() at the time
+ * of its first waypoint, i.e. at the execution start plus the durations of all previous segments.
+ * Waypoints of continuous joints are expected to be unwound.
+ */
+class StreamingTimeParameterization
+{
+public:
+  /**
+   * \param group The group whose variables are parameterized
+   * \param look_ahead Number of waypoints that must follow a waypoint before it is emitted. Larger values allow
+   *        higher speeds on dense paths at the cost of a longer latency.
+   * \param max_velocity_scaling_factor Scale all joint velocity limits by this factor
+   * \param max_acceleration_scaling_factor Scale all joint acceleration limits by this factor
+   * \param sample_period If positive, segments are sampled at this period (s) in addition to the input waypoints
+   */
+  StreamingTimeParameterization(const moveit::core::JointModelGroup* group, std::size_t look_ahead = 5,
+                                double max_velocity_scaling_factor = 1.0, double max_acceleration_scaling_factor = 1.0,
+                                double sample_period = 0.0);
+
+  /** \brief Start a new stream at start_state, discarding pending waypoints and undelivered output.
+      The velocities and accelerations of start_state are used as initial condition. */
+  void reset(const moveit::core::RobotState& start_state);
+
+  /** \brief Append the next waypoint of the path. Only the group's positions are used.
+      Returns false if reset() was not called, the stream is already finished or parameterization failed. */
+  bool addWayPoint(const moveit::core::RobotState& waypoint);
+
+  /** \brief Declare the last added waypoint as the end of the path; it is reached at rest.
+      Returns false if the remaining waypoints could not be parameterized. */
+  bool finish();
+
+  /** \brief Move all time-stamped waypoints that became final into segment.
+      Returns false (and leaves segment empty) if there is no new output. */
+  bool getSegment(robot_trajectory::RobotTrajectory& segment);
+
+  /** \brief True when the stream was finished and all output was delivered */
+  bool isDone() const
+  {
+    return finished_ && pending_.empty() && output_.empty();
+  }
+
+  /** \brief Number of waypoints added but not yet parameterized */
+  std::size_t getPendingWayPointCount() const
+  {
+    return pending_.size();
+  }
+
+  /** \brief Total duration of the output produced so far */
+  double getDuration() const
+  {
+    return duration_;
+  }
+
+private:
+  /** \brief Parameterize all pending waypoints that became final */
+  bool process();
+
+  /** \brief Velocity at which the first pending waypoint is passed */
+  void computeTargetVelocity(std::vector<double>& velocity) const;
+
+  /** \brief Maximum speed from which a joint can stop within distance, starting at zero acceleration */
+  double getStoppingVelocity(std::size_t joint, double distance) const;
+
+  /** \brief Append a time-stamped waypoint to the output */
+  void addOutput(const std::vector<double>& position, const std::vector<double>& velocity,
+                 const std::vector<double>& acceleration, double duration_from_previous);
+
+  const moveit::core::JointModelGroup* group_;
+  std::size_t look_ahead_;
+  double sample_period_;
+  bool valid_;
+
+  ruckig::Ruckig<ruckig::DynamicDOFs> ruckig_;
+  ruckig::InputParameter<ruckig::DynamicDOFs> input_;
+  ruckig::Trajectory<ruckig::DynamicDOFs, ruckig::StandardVector> trajectory_;
+
+  moveit::core::RobotStatePtr reference_;  // source of the variables outside the group
+  std::deque<std::vector<double>> pending_;
+  std::deque<std::pair<moveit::core::RobotStatePtr, double>> output_;
+  moveit::core::RobotStatePtr last_emitted_;
+  bool started_;
+  bool finished_;
+  double duration_;
+};
+}  // namespace trajectory_processing
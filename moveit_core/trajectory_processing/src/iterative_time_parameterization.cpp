@@ -45,11 +45,54 @@ static const double DEFAULT_ACCEL_MAX = 1.0;
 static const double ROUNDING_THRESHOLD = 0.01;
 
 IterativeParabolicTimeParameterization::IterativeParabolicTimeParameterization(unsigned int max_iterations,
-                                                                               double max_time_change_per_it)
-  : max_iterations_(max_iterations), max_time_change_per_it_(max_time_change_per_it)
+                                                                               double max_time_change_per_it,
+                                                                               bool vectorized)
+  : max_iterations_(max_iterations), max_time_change_per_it_(max_time_change_per_it), vectorized_(vectorized)
 {
 }
 
+namespace
+{
+// Returns the requested scaling factor if it is valid, 1.0 otherwise
+double verifyScalingFactor(const double requested_scaling_factor, const char* name)
+{
+  double scaling_factor = 1.0;
+
+  if (requested_scaling_factor > 0.0 && requested_scaling_factor <= 1.0)
+    scaling_factor = requested_scaling_factor;
+  else if (requested_scaling_factor == 0.0)
+    ROS_DEBUG_NAMED("trajectory_processing.iterative_time_parameterization",
+                    "A %s of 0.0 was specified, defaulting to %f instead.", name, scaling_factor);
+  else
+    ROS_WARN_NAMED("trajectory_processing.iterative_time_parameterization",
+                   "Invalid %s %f specified, defaulting to %f instead.", name, requested_scaling_factor,
+                   scaling_factor);
+  return scaling_factor;
+}
+
+// Velocities (averaged over the adjacent intervals) and accelerations of the inner waypoints 1 .. num_points - 2 of a
+// single variable, with the same operations as the waypoint-by-waypoint implementation.
+// Waypoints next to a zero-length interval get zero velocity and acceleration.
+void computeInnerDerivatives(const double* positions, const std::vector<double>& time_diff, Eigen::Index num_points,
+                             Eigen::ArrayXd& interval_velocities, Eigen::ArrayXd& velocities,
+                             Eigen::ArrayXd& accelerations)
+{
+  const Eigen::Index inner = num_points - 2;
+  if (inner <= 0)
+    return;
+
+  const Eigen::Map<const Eigen::ArrayXd> q(positions, num_points);
+  const Eigen::Map<const Eigen::ArrayXd> dt(time_diff.data(), num_points - 1);
+  interval_velocities = (q.tail(num_points - 1) - q.head(num_points - 1)) / dt;
+
+  const auto v1 = interval_velocities.head(inner);
+  const auto v2 = interval_velocities.tail(inner);
+  const auto zero_interval = dt.head(inner) == 0.0 || dt.tail(inner) == 0.0;
+  velocities.segment(1, inner) = zero_interval.select(0.0, (v2 + v1) / 2.0);
+  accelerations.segment(1, inner) = zero_interval.select(0.0, 2.0 * (v2 - v1) / (dt.head(inner) + dt.tail(inner)));
+}
+}  // namespace
+
 #if 0  // unused functions
 namespace
 {
@@ -108,18 +151,8 @@ void IterativeParabolicTimeParameterization::applyVelocityConstraints(robot_traj
   const moveit::core::RobotModel& rmodel = group->getParentModel();
   const int num_points = rob_trajectory.getWayPointCount();
 
-  double velocity_scaling_factor = 1.0;
-
-  if (max_velocity_scaling_factor > 0.0 && max_velocity_scaling_factor <= 1.0)
-    velocity_scaling_factor = max_velocity_scaling_factor;
-  else if (max_velocity_scaling_factor == 0.0)
-    ROS_DEBUG_NAMED("trajectory_processing.iterative_time_parameterization",
-                    "A max_velocity_scaling_factor of 0.0 was specified, defaulting to %f instead.",
-                    velocity_scaling_factor);
-  else
-    ROS_WARN_NAMED("trajectory_processing.iterative_time_parameterization",
-                   "Invalid max_velocity_scaling_factor %f specified, defaulting to %f instead.",
-                   max_velocity_scaling_factor, velocity_scaling_factor);
+  const double velocity_scaling_factor =
+      verifyScalingFactor(max_velocity_scaling_factor, "max_velocity_scaling_factor");
 
   for (int i = 0; i < num_points - 1; ++i)
   {
@@ -142,6 +175,20 @@ void IterativeParabolicTimeParameterization::applyVelocityConstraints(robot_traj
   }
 }
 
+// Same as above, on contiguous arrays: each interval is at least as long as its slowest variable requires
+void IterativeParabolicTimeParameterization::applyVelocityConstraints(const PositionMatrix& positions,
+                                                                      const std::vector<double>& max_velocities,
+                                                                      std::vector<double>& time_diff) const
+{
+  const Eigen::Index num_points = positions.cols();
+  Eigen::Map<Eigen::ArrayXd> intervals(time_diff.data(), num_points - 1);
+  for (Eigen::Index j = 0; j < positions.rows(); ++j)
+  {
+    const Eigen::Map<const Eigen::ArrayXd> q(positions.row(j).data(), num_points);
+    intervals = intervals.max((q.tail(num_points - 1) - q.head(num_points - 1)).abs() / max_velocities[j]);
+  }
+}
+
 // Iteratively expand dt1 interval by a constant factor until within acceleration constraint
 // In the future we may want to solve to quadratic equation to get the exact timing interval.
 // To do this, use the CubicTrajectory::quadSolve() function in cubic_trajectory.h
@@ -322,18 +369,8 @@ void IterativeParabolicTimeParameterization::applyAccelerationConstraints(
   double v2;
   double a;
 
-  double acceleration_scaling_factor = 1.0;
-
-  if (max_acceleration_scaling_factor > 0.0 && max_acceleration_scaling_factor <= 1.0)
-    acceleration_scaling_factor = max_acceleration_scaling_factor;
-  else if (max_acceleration_scaling_factor == 0.0)
-    ROS_DEBUG_NAMED("trajectory_processing.iterative_time_parameterization",
-                    "A max_acceleration_scaling_factor of 0.0 was specified, defaulting to %f instead.",
-                    acceleration_scaling_factor);
-  else
-    ROS_WARN_NAMED("trajectory_processing.iterative_time_parameterization",
-                   "Invalid max_acceleration_scaling_factor %f specified, defaulting to %f instead.",
-                   max_acceleration_scaling_factor, acceleration_scaling_factor);
+  const double acceleration_scaling_factor =
+      verifyScalingFactor(max_acceleration_scaling_factor, "max_acceleration_scaling_factor");
 
   do
   {
@@ -455,6 +492,212 @@ void IterativeParabolicTimeParameterization::applyAccelerationConstraints(
   } while (num_updates > 0 && iteration < static_cast<int>(max_iterations_));
 }
 
+// Same as above, on contiguous arrays. The acceleration of an inner waypoint only depends on the two intervals next
+// to it, so it can only change when the previously visited waypoint extended the interval they share. All other
+// waypoints are checked at once against accelerations computed vectorized; the remaining ones in the same order and
+// with the same operations as above, so the result is identical.
+void IterativeParabolicTimeParameterization::applyAccelerationConstraints(const PositionMatrix& positions,
+                                                                          const double* start_velocities,
+                                                                          const std::vector<double>& max_accelerations,
+                                                                          std::vector<double>& time_diff) const
+{
+  const int num_points = positions.cols();
+  const int num_joints = positions.rows();
+  if (num_points < 2)
+    return;
+
+  Eigen::ArrayXd interval_velocities(num_points - 1);
+  Eigen::ArrayXd velocities(num_points);
+  Eigen::ArrayXd accelerations = Eigen::ArrayXd::Zero(num_points);
+  int num_updates = 0;
+  int iteration = 0;
+  bool backwards = false;
+
+  do
+  {
+    num_updates = 0;
+    iteration++;
+
+    for (int j = 0; j < num_joints; ++j)
+    {
+      const double* q = positions.row(j).data();
+      const double a_max = max_accelerations[j];
+
+      // Loop forwards, then backwards
+      for (int count = 0; count < 2; ++count)
+      {
+        computeInnerDerivatives(q, time_diff, num_points, interval_velocities, velocities, accelerations);
+        bool neighbor_updated = false;
+        for (int i = 0; i < num_points - 1; ++i)
+        {
+          const int index = backwards ? (num_points - 1) - i : i;
+          if (index > 0 && index < num_points - 1 && !neighbor_updated &&
+              !(fabs(accelerations[index]) > a_max + ROUNDING_THRESHOLD))
+            continue;
+          neighbor_updated = false;
+
+          double q1;
+          double q2;
+          double q3;
+          double dt1;
+          double dt2;
+          if (index == 0)
+          {
+            // First point
+            q1 = q[index + 1];
+            q2 = q[index];
+            q3 = q[index + 1];
+            dt1 = dt2 = time_diff[index];
+          }
+          else if (index < num_points - 1)
+          {
+            // middle points
+            q1 = q[index - 1];
+            q2 = q[index];
+            q3 = q[index + 1];
+            dt1 = time_diff[index - 1];
+            dt2 = time_diff[index];
+          }
+          else
+          {
+            // last point - careful, there are only numpoints-1 time intervals
+            q1 = q[index - 1];
+            q2 = q[index];
+            q3 = q[index - 1];
+            dt1 = dt2 = time_diff[index - 1];
+          }
+
+          double a = 0.0;
+          if (dt1 != 0.0 && dt2 != 0.0)
+          {
+            const double v1 = (index == 0 && start_velocities) ? start_velocities[j] : (q2 - q1) / dt1;
+            const double v2 = (q3 - q2) / dt2;
+            a = 2.0 * (v2 - v1) / (dt1 + dt2);
+          }
+
+          if (fabs(a) > a_max + ROUNDING_THRESHOLD)
+          {
+            if (!backwards)
+              time_diff[index] = std::min(dt2 + max_time_change_per_it_, findT2(q2 - q1, q3 - q2, dt1, dt2, a_max));
+            else
+              time_diff[index - 1] =
+                  std::min(dt1 + max_time_change_per_it_, findT1(q2 - q1, q3 - q2, dt1, dt2, a_max));
+            num_updates++;
+            neighbor_updated = true;
+          }
+        }
+        backwards = !backwards;
+      }
+    }
+  } while (num_updates > 0 && iteration < static_cast<int>(max_iterations_));
+}
+
+void IterativeParabolicTimeParameterization::computeTimeStampsVectorized(
+    robot_trajectory::RobotTrajectory& trajectory, const double max_velocity_scaling_factor,
+    const double max_acceleration_scaling_factor) const
+{
+  const moveit::core::JointModelGroup* group = trajectory.getGroup();
+  const std::vector<std::string>& vars = group->getVariableNames();
+  const std::vector<int>& idx = group->getVariableIndexList();
+  const moveit::core::RobotModel& rmodel = group->getParentModel();
+  const int num_points = trajectory.getWayPointCount();
+  const int num_joints = group->getVariableCount();
+
+  const double velocity_scaling_factor =
+      verifyScalingFactor(max_velocity_scaling_factor, "max_velocity_scaling_factor");
+  const double acceleration_scaling_factor =
+      verifyScalingFactor(max_acceleration_scaling_factor, "max_acceleration_scaling_factor");
+  std::vector<double> max_velocities(num_joints, DEFAULT_VEL_MAX);
+  std::vector<double> max_accelerations(num_joints, DEFAULT_ACCEL_MAX);
+  for (int j = 0; j < num_joints; ++j)
+  {
+    const moveit::core::VariableBounds& b = rmodel.getVariableBounds(vars[j]);
+    if (b.velocity_bounded_)
+      max_velocities[j] =
+          std::min(fabs(b.max_velocity_ * velocity_scaling_factor), fabs(b.min_velocity_ * velocity_scaling_factor));
+    if (b.acceleration_bounded_)
+      max_accelerations[j] = std::min(fabs(b.max_acceleration_ * acceleration_scaling_factor),
+                                      fabs(b.min_acceleration_ * acceleration_scaling_factor));
+  }
+
+  // Read the positions once
+  PositionMatrix positions(num_joints, num_points);
+  for (int i = 0; i < num_points; ++i)
+  {
+    const double* state_positions = trajectory.getWayPoint(i).getVariablePositions();
+    for (int j = 0; j < num_joints; ++j)
+      positions(j, i) = state_positions[idx[j]];
+  }
+  std::vector<double> start_velocities;
+  const moveit::core::RobotState& first_waypoint = trajectory.getFirstWayPoint();
+  if (first_waypoint.hasVelocities())
+    for (int j = 0; j < num_joints; ++j)
+      start_velocities.push_back(first_waypoint.getVariableVelocity(idx[j]));
+  const double* start = start_velocities.empty() ? nullptr : start_velocities.data();
+
+  std::vector<double> time_diff(num_points - 1, 0.0);  // the time difference between adjacent points
+  applyVelocityConstraints(positions, max_velocities, time_diff);
+  applyAccelerationConstraints(positions, start, max_accelerations, time_diff);
+
+  // Same as updateTrajectory()
+  trajectory.setWayPointDurationFromPrevious(0, 0.0);
+  for (int i = 1; i < num_points; ++i)
+    trajectory.setWayPointDurationFromPrevious(i, time_diff[i - 1]);
+  if (num_points <= 1)
+    return;
+
+  PositionMatrix velocities(num_joints, num_points);
+  PositionMatrix accelerations(num_joints, num_points);
+  Eigen::ArrayXd interval_velocities(num_points - 1);
+  Eigen::ArrayXd joint_velocities(num_points);
+  Eigen::ArrayXd joint_accelerations(num_points);
+  for (int j = 0; j < num_joints; ++j)
+  {
+    const double* q = positions.row(j).data();
+    computeInnerDerivatives(q, time_diff, num_points, interval_velocities, joint_velocities, joint_accelerations);
+
+    // The first and last points mirror their neighbor; the first point may keep its given velocity instead.
+    // updateTrajectory() marks the first waypoint as having velocities when writing the first variable, so all
+    // further variables keep their given velocity, which is zero if there was none.
+    const int last = num_points - 1;
+    const bool keep_velocity = start || j > 0;
+    double v1 = 0.0;
+    double v2 = 0.0;
+    double dt = time_diff[0];
+    if (dt != 0.0)
+    {
+      v1 = keep_velocity ? (start ? start[j] : 0.0) : (q[0] - q[1]) / dt;
+      v2 = keep_velocity ? v1 : (q[1] - q[0]) / dt;
+    }
+    joint_velocities[0] = (v2 + v1) / 2.0;
+    joint_accelerations[0] = dt != 0.0 ? 2.0 * (v2 - v1) / (dt + dt) : 0.0;
+
+    v1 = v2 = 0.0;
+    dt = time_diff[last - 1];
+    if (dt != 0.0)
+    {
+      v1 = (q[last] - q[last - 1]) / dt;
+      v2 = (q[last - 1] - q[last]) / dt;
+    }
+    joint_velocities[last] = (v2 + v1) / 2.0;
+    joint_accelerations[last] = dt != 0.0 ? 2.0 * (v2 - v1) / (dt + dt) : 0.0;
+
+    velocities.row(j) = joint_velocities.matrix().transpose();
+    accelerations.row(j) = joint_accelerations.matrix().transpose();
+  }
+
+  // Write the derivatives back once
+  for (int i = 0; i < num_points; ++i)
+  {
+    moveit::core::RobotState& waypoint = *trajectory.getWayPointPtr(i);
+    for (int j = 0; j < num_joints; ++j)
+    {
+      waypoint.setVariableVelocity(idx[j], velocities(j, i));
+      waypoint.setVariableAcceleration(idx[j], accelerations(j, i));
+    }
+  }
+}
+
 bool IterativeParabolicTimeParameterization::computeTimeStamps(robot_trajectory::RobotTrajectory& trajectory,
                                                                const double max_velocity_scaling_factor,
                                                                const double max_acceleration_scaling_factor) const
@@ -473,6 +716,12 @@ bool IterativeParabolicTimeParameterization::computeTimeStamps(robot_trajectory:
   // this lib does not actually work properly when angles wrap around, so we need to unwind the path first
   trajectory.unwind();
 
+  if (vectorized_)
+  {
+    computeTimeStampsVectorized(trajectory, max_velocity_scaling_factor, max_acceleration_scaling_factor);
+    return true;
+  }
+
   const int num_points = trajectory.getWayPointCount();
   std::vector<double> time_diff(num_points - 1, 0.0);  // the time difference between adjacent points
 
@@ -33,7 +33,8 @@
 
 /* Author: Andy Zelenak */
 
-#include <moveit/dynamics_solver/dynamics_solver.h>
+#include <moveit/dynamics_solver/batch_inverse_dynamics.h>
+#include <algorithm>
 #include "moveit/trajectory_processing/iterative_torque_limit_parameterization.h"
 
 namespace trajectory_processing
@@ -90,7 +91,9 @@ bool IterativeTorqueLimitParameterization::computeTimeStampsWithTorqueLimits(
     return false;
   }
 
-  dynamics_solver::DynamicsSolver dynamics_solver(trajectory.getRobotModel(), group->getName(), gravity_vector);
+  dynamics_solver::BatchInverseDynamics inverse_dynamics(trajectory.getRobotModel(), group->getName(), gravity_vector);
+  const std::vector<dynamics_solver::BatchInverseDynamics::ExternalWrench> wrenches =
+      dynamics_solver::BatchInverseDynamics::convertWrenches(external_link_wrenches);
 
   // Copy the waypoints so we can modify them while iterating
   moveit_msgs::RobotTrajectory original_traj;
@@ -101,6 +104,13 @@ bool IterativeTorqueLimitParameterization::computeTimeStampsWithTorqueLimits(
   size_t num_iterations = 0;
   const size_t max_iterations = 10;
 
+  // Joint values of all waypoints, one block of dof values per waypoint
+  std::vector<double> positions, velocities, accelerations, torques;
+  std::vector<double> joint_accelerations(dof);
+  std::vector<double> joint_torques(dof);
+
+  const std::vector<const moveit::core::JointModel*>& joint_models = group->getActiveJointModels();
+
   while (iteration_needed && num_iterations < max_iterations)
   {
     ++num_iterations;
@@ -109,32 +119,36 @@ bool IterativeTorqueLimitParameterization::computeTimeStampsWithTorqueLimits(
     totg_.computeTimeStamps(trajectory, velocity_limits, mutable_accel_limits, max_velocity_scaling_factor,
                             max_acceleration_scaling_factor);
 
-    std::vector<double> joint_positions(dof);
-    std::vector<double> joint_velocities(dof);
-    std::vector<double> joint_accelerations(dof);
-    std::vector<double> joint_torques(dof);
+    const size_t num_waypoints = trajectory.getWayPointCount();
+    positions.resize(num_waypoints * dof);
+    velocities.resize(num_waypoints * dof);
+    accelerations.resize(num_waypoints * dof);
+    torques.resize(num_waypoints * dof);
+    for (size_t waypoint_idx = 0; waypoint_idx < num_waypoints; ++waypoint_idx)
+    {
+      const moveit::core::RobotState& waypoint = trajectory.getWayPoint(waypoint_idx);
+      waypoint.copyJointGroupPositions(group, &positions[waypoint_idx * dof]);
+      waypoint.copyJointGroupVelocities(group, &velocities[waypoint_idx * dof]);
+      waypoint.copyJointGroupAccelerations(group, &accelerations[waypoint_idx * dof]);
+    }
 
-    const std::vector<const moveit::core::JointModel*>& joint_models = group->getActiveJointModels();
+    // Run inverse dynamics for all waypoints at once
+    if (!inverse_dynamics.getTorques(positions.data(), velocities.data(), accelerations.data(), num_waypoints, wrenches,
+                                     torques.data()))
+    {
+      ROS_ERROR_STREAM_NAMED(LOGNAME, "Dynamics computation failed.");
+      return false;
+    }
 
     // Check if any torque limits are violated
-    for (size_t waypoint_idx = 0; waypoint_idx < trajectory.getWayPointCount(); ++waypoint_idx)
+    for (size_t waypoint_idx = 0; waypoint_idx < num_waypoints; ++waypoint_idx)
     {
-      moveit::core::RobotStatePtr& waypoint = trajectory.getWayPointPtr(waypoint_idx);
-      waypoint->copyJointGroupPositions(group->getName(), joint_positions);
-      waypoint->copyJointGroupVelocities(group->getName(), joint_velocities);
-      waypoint->copyJointGroupAccelerations(group->getName(), joint_accelerations);
-
-      if (!dynamics_solver.getTorques(joint_positions, joint_velocities, joint_accelerations, external_link_wrenches,
-                                      joint_torques))
-      {
-        ROS_ERROR_STREAM_NAMED(LOGNAME, "Dynamics computation failed.");
-        return false;
-      }
+      const size_t offset = waypoint_idx * dof;
 
       // For each joint, check if torque exceeds the limit
       for (size_t joint_idx = 0; joint_idx < joint_torque_limits.size(); ++joint_idx)
       {
-        if (std::fabs(joint_torques.at(joint_idx)) > joint_torque_limits.at(joint_idx))
+        if (std::fabs(torques[offset + joint_idx]) > joint_torque_limits.at(joint_idx))
         {
           // We can't always just decrease acceleration to decrease joint torque.
           // There are some edge cases where decreasing acceleration could actually increase joint torque. For example,
@@ -144,13 +158,13 @@ bool IterativeTorqueLimitParameterization::computeTimeStampsWithTorqueLimits(
           // because their torque limits are high enough to withstand issues like that (or it just wouldn't work at all...)
 
           // Reset
-          waypoint->copyJointGroupAccelerations(group->getName(), joint_accelerations);
+          std::copy(accelerations.begin() + offset, accelerations.begin() + offset + dof, joint_accelerations.begin());
 
           // Check if decreasing acceleration of this joint actually decreases joint torque. Else, increase acceleration.
-          double previous_torque = joint_torques.at(joint_idx);
+          double previous_torque = torques[offset + joint_idx];
           joint_accelerations.at(joint_idx) *= (1 + accel_limit_decrement_factor);
-          if (!dynamics_solver.getTorques(joint_positions, joint_velocities, joint_accelerations,
-                                          external_link_wrenches, joint_torques))
+          if (!inverse_dynamics.getTorques(&positions[offset], &velocities[offset], joint_accelerations.data(), 1,
+                                           wrenches, joint_torques.data()))
           {
             ROS_ERROR_STREAM_NAMED(LOGNAME, "Dynamics computation failed.");
             return false;
@@ -41,6 +41,9 @@
 // Name of logger
 const char* LOGGER_NAME = "trajectory_processing.cartesian_speed";
 
+// Below this, threads cost more than they save
+constexpr size_t MIN_PARALLEL_WAYPOINTS = 64;
+
 namespace trajectory_processing
 {
 bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, const double max_speed,
@@ -70,18 +73,18 @@ bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, c
     }
   }
 
-  // Call function for speed setting using the created link model
-  for (const auto& link : links)
-  {
-    if (!limitMaxCartesianLinkSpeed(trajectory, max_speed, link))
-      return false;
-  }
-
-  return !links.empty();
+  // Call function for speed setting using the created link models
+  return !links.empty() && limitMaxCartesianLinkSpeed(trajectory, max_speed, links);
 }
 
 bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, const double max_speed,
                                 const moveit::core::LinkModel* link_model)
+{
+  return limitMaxCartesianLinkSpeed(trajectory, max_speed, std::vector<const moveit::core::LinkModel*>{ link_model });
+}
+
+bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, const double max_speed,
+                                const std::vector<const moveit::core::LinkModel*>& link_models)
 {
   if (max_speed <= 0.0)
   {
@@ -89,22 +92,35 @@ bool limitMaxCartesianLinkSpeed(robot_trajectory::RobotTrajectory& trajectory, c
     return false;
   }
 
-  size_t num_waypoints = trajectory.getWayPointCount();
+  const size_t num_waypoints = trajectory.getWayPointCount();
   if (num_waypoints == 0)
     return false;
 
-  // do forward kinematics to get Cartesian positions of link for current waypoint
+  // do forward kinematics to get Cartesian positions of the links for all waypoints.
+  // Each thread computes the link chains in its own state, so the waypoints are not modified.
+  const size_t num_links = link_models.size();
+  std::vector<Eigen::Vector3d> link_positions(num_waypoints * num_links);
+#pragma omp parallel if (num_waypoints >= MIN_PARALLEL_WAYPOINTS)
+  {
+    moveit::core::RobotState state(trajectory.getRobotModel());
+#pragma omp for schedule(static)
+    for (long i = 0; i < static_cast<long>(num_waypoints); ++i)
+    {
+      state.setVariablePositions(trajectory.getWayPoint(i).getVariablePositions());
+      for (size_t l = 0; l < num_links; ++l)
+        link_positions[i * num_links + l] = state.getGlobalLinkTransformOnChain(link_models[l]).translation();
+    }
+  }
+
   double euclidean_distance, new_time_diff, old_time_diff;
   std::vector<double> time_diff(num_waypoints - 1, 0.0);
-
   for (size_t i = 0; i < num_waypoints - 1; i++)
   {
-    // get link state for current and next waypoint
-    const Eigen::Isometry3d& current_link_state = trajectory.getWayPointPtr(i)->getGlobalLinkTransform(link_model);
-    const Eigen::Isometry3d& next_link_state = trajectory.getWayPointPtr(i + 1)->getGlobalLinkTransform(link_model);
-
-    // get Euclidean distance between the two waypoints
-    euclidean_distance = (next_link_state.translation() - current_link_state.translation()).norm();
+    // the fastest link determines the minimum duration of the segment
+    euclidean_distance = 0.0;
+    for (size_t l = 0; l < num_links; ++l)
+      euclidean_distance = std::max(
+          euclidean_distance, (link_positions[(i + 1) * num_links + l] - link_positions[i * num_links + l]).norm());
 
     new_time_diff = (euclidean_distance / max_speed);
     old_time_diff = trajectory.getWayPointDurationFromPrevious(i + 1);
@@ -52,12 +52,13 @@ constexpr double DEFAULT_MAX_JERK = 100;         // rad/s^3
 constexpr double MAX_DURATION_EXTENSION_FACTOR = 50.0;
 constexpr double DURATION_EXTENSION_FRACTION = 1.1;
 constexpr double OVERSHOOT_CHECK_PERIOD = 0.01;  // sec
+constexpr size_t MIN_PARALLEL_SEGMENTS = 32;     // below this, threads cost more than they save
 }  // namespace
 
 bool RuckigSmoothing::applySmoothing(robot_trajectory::RobotTrajectory& trajectory,
                                      const double max_velocity_scaling_factor,
                                      const double max_acceleration_scaling_factor, const bool mitigate_overshoot,
-                                     const double overshoot_threshold)
+                                     const double overshoot_threshold, const bool parallel)
 {
   if (!validateGroup(trajectory))
   {
@@ -82,6 +83,10 @@ bool RuckigSmoothing::applySmoothing(robot_trajectory::RobotTrajectory& trajecto
     return false;
   }
 
+  if (parallel)
+  {
+    return runRuckigParallel(trajectory, ruckig_input, mitigate_overshoot, overshoot_threshold);
+  }
   return runRuckig(trajectory, ruckig_input, mitigate_overshoot, overshoot_threshold);
 }
 
@@ -89,7 +94,8 @@ bool RuckigSmoothing::applySmoothing(robot_trajectory::RobotTrajectory& trajecto
                                      const std::unordered_map<std::string, double>& velocity_limits,
                                      const std::unordered_map<std::string, double>& acceleration_limits,
                                      const std::unordered_map<std::string, double>& jerk_limits,
-                                     const bool mitigate_overshoot, const double overshoot_threshold)
+                                     const bool mitigate_overshoot, const double overshoot_threshold,
+                                     const bool parallel)
 {
   if (!validateGroup(trajectory))
   {
@@ -141,6 +147,10 @@ bool RuckigSmoothing::applySmoothing(robot_trajectory::RobotTrajectory& trajecto
     }
   }
 
+  if (parallel)
+  {
+    return runRuckigParallel(trajectory, ruckig_input, mitigate_overshoot, overshoot_threshold);
+  }
   return runRuckig(trajectory, ruckig_input, mitigate_overshoot, overshoot_threshold);
 }
 
@@ -363,6 +373,108 @@ bool RuckigSmoothing::runRuckig(robot_trajectory::RobotTrajectory& trajectory,
   return true;
 }
 
+bool RuckigSmoothing::runRuckigParallel(robot_trajectory::RobotTrajectory& trajectory,
+                                        const ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
+                                        const bool mitigate_overshoot, const double overshoot_threshold)
+{
+  const size_t num_waypoints = trajectory.getWayPointCount();
+  moveit::core::JointModelGroup const* const group = trajectory.getGroup();
+  const size_t num_dof = group->getVariableCount();
+  const std::vector<int>& move_group_idx = group->getVariableIndexList();
+
+  // This lib does not work properly when angles wrap, so we need to unwind the path first
+  trajectory.unwind();
+  const double timestep = trajectory.getAverageSegmentDuration();
+
+  // Cache the trajectory, durations are extended relative to it
+  robot_trajectory::RobotTrajectory original_trajectory =
+      robot_trajectory::RobotTrajectory(trajectory, true /* deep copy */);
+
+  // Each segment only depends on its two waypoints, so all of them can be computed independently
+  const size_t num_segments = num_waypoints - 1;
+  std::vector<char> segment_ok(num_segments, false);
+  double last_segment_duration = 0.0;
+#pragma omp parallel if (num_segments >= MIN_PARALLEL_SEGMENTS)
+  {
+    ruckig::Ruckig<ruckig::DynamicDOFs> ruckig(num_dof, timestep);
+    ruckig::InputParameter<ruckig::DynamicDOFs> input = ruckig_input;
+    ruckig::Trajectory<ruckig::DynamicDOFs, ruckig::StandardVector> ruckig_trajectory(num_dof);
+#pragma omp for schedule(dynamic, 16)
+    for (long waypoint_idx = 0; waypoint_idx < static_cast<long>(num_segments); ++waypoint_idx)
+    {
+      segment_ok[waypoint_idx] = smoothSegment(ruckig, input, ruckig_trajectory, trajectory, waypoint_idx,
+                                               mitigate_overshoot, overshoot_threshold);
+      if (waypoint_idx + 1 == static_cast<long>(num_segments))
+      {
+        last_segment_duration = ruckig_trajectory.get_duration();
+      }
+    }
+  }
+
+  // Slow down the failed segments one by one. This changes the start state of the following segment, which is then
+  // recomputed as well.
+  ruckig::Ruckig<ruckig::DynamicDOFs> ruckig(num_dof, timestep);
+  ruckig::InputParameter<ruckig::DynamicDOFs> input = ruckig_input;
+  ruckig::Trajectory<ruckig::DynamicDOFs, ruckig::StandardVector> ruckig_trajectory(num_dof);
+  for (size_t waypoint_idx = 0; waypoint_idx < num_segments; ++waypoint_idx)
+  {
+    if (segment_ok[waypoint_idx])
+    {
+      continue;
+    }
+
+    double duration_extension_factor = 1;
+    while (!segment_ok[waypoint_idx] && duration_extension_factor <= MAX_DURATION_EXTENSION_FACTOR)
+    {
+      duration_extension_factor *= DURATION_EXTENSION_FRACTION;
+      extendTrajectoryDuration(duration_extension_factor, waypoint_idx, num_dof, move_group_idx, original_trajectory,
+                               trajectory);
+      segment_ok[waypoint_idx] = smoothSegment(ruckig, input, ruckig_trajectory, trajectory, waypoint_idx,
+                                               mitigate_overshoot, overshoot_threshold);
+    }
+    if (!segment_ok[waypoint_idx])
+    {
+      ROS_ERROR_STREAM_NAMED(LOGNAME, "Ruckig extended the duration of segment "
+                                          << waypoint_idx << " to its maximum and still did not find a solution");
+      return false;
+    }
+    if (waypoint_idx + 1 == num_segments)
+    {
+      last_segment_duration = ruckig_trajectory.get_duration();
+    }
+    else
+    {
+      segment_ok[waypoint_idx + 1] = smoothSegment(ruckig, input, ruckig_trajectory, trajectory, waypoint_idx + 1,
+                                                   mitigate_overshoot, overshoot_threshold);
+      if (waypoint_idx + 2 == num_segments)
+      {
+        last_segment_duration = ruckig_trajectory.get_duration();
+      }
+    }
+  }
+
+  trajectory.setWayPointDurationFromPrevious(num_waypoints - 1, last_segment_duration);
+  return true;
+}
+
+bool RuckigSmoothing::smoothSegment(ruckig::Ruckig<ruckig::DynamicDOFs>& ruckig,
+                                    ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
+                                    ruckig::Trajectory<ruckig::DynamicDOFs, ruckig::StandardVector>& ruckig_trajectory,
+                                    robot_trajectory::RobotTrajectory& trajectory, size_t waypoint_idx,
+                                    const bool mitigate_overshoot, const double overshoot_threshold)
+{
+  getNextRuckigInput(trajectory.getWayPointPtr(waypoint_idx), trajectory.getWayPointPtr(waypoint_idx + 1),
+                     trajectory.getGroup(), ruckig_input);
+  const ruckig::Result ruckig_result = ruckig.calculate(ruckig_input, ruckig_trajectory);
+  if (ruckig_result != ruckig::Result::Working && ruckig_result != ruckig::Result::Finished)
+  {
+    return false;
+  }
+  return !mitigate_overshoot ||
+         !checkOvershoot(ruckig_trajectory, trajectory.getGroup()->getVariableCount(), ruckig_input,
+                         overshoot_threshold);
+}
+
 void RuckigSmoothing::extendTrajectoryDuration(const double duration_extension_factor, size_t waypoint_idx,
                                                const size_t num_dof, const std::vector<int>& move_group_idx,
                                                const robot_trajectory::RobotTrajectory& original_trajectory,
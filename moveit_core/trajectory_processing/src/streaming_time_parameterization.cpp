@@ -0,0 +1,257 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <moveit/trajectory_processing/ruckig_traj_smoothing.h>
+#include <moveit/trajectory_processing/streaming_time_parameterization.h>
+#include <ros/console.h>
+
+namespace trajectory_processing
+{
+namespace
+{
+const std::string LOGNAME = "moveit_trajectory_processing.streaming_time_parameterization";
+constexpr double DEFAULT_CONTROL_PERIOD = 0.01;  // sec, unused by offline Ruckig calculations
+constexpr double MIN_WAYPOINT_DISTANCE = 1e-9;   // rad, closer waypoints are dropped
+constexpr int MAX_VELOCITY_REDUCTIONS = 8;
+}  // namespace
+
+StreamingTimeParameterization::StreamingTimeParameterization(const moveit::core::JointModelGroup* group,
+                                                             std::size_t look_ahead,
+                                                             double max_velocity_scaling_factor,
+                                                             double max_acceleration_scaling_factor,
+                                                             double sample_period)
+  : group_(group)
+  , look_ahead_(std::max<std::size_t>(look_ahead, 1))
+  , sample_period_(sample_period)
+  , valid_(false)
+  , ruckig_(group->getVariableCount(), sample_period > 0.0 ? sample_period : DEFAULT_CONTROL_PERIOD)
+  , input_(group->getVariableCount())
+  , trajectory_(group->getVariableCount())
+  , started_(false)
+  , finished_(false)
+  , duration_(0.0)
+{
+  valid_ = RuckigSmoothing::getRobotModelBounds(max_velocity_scaling_factor, max_acceleration_scaling_factor, group_,
+                                                input_);
+  if (!valid_)
+    ROS_ERROR_NAMED(LOGNAME, "Error while retrieving kinematic limits (vel/accel/jerk) from RobotModel.");
+}
+
+void StreamingTimeParameterization::reset(const moveit::core::RobotState& start_state)
+{
+  const std::vector<int>& idx = group_->getVariableIndexList();
+  for (std::size_t i = 0; i < idx.size(); ++i)
+  {
+    input_.current_position[i] = start_state.getVariablePosition(idx[i]);
+    // Clamp velocities/accelerations in case they exceed the limit due to small numerical errors
+    input_.current_velocity[i] = start_state.hasVelocities() ?
+                                     std::clamp(start_state.getVariableVelocity(idx[i]), -input_.max_velocity[i],
+                                                input_.max_velocity[i]) :
+                                     0.0;
+    input_.current_acceleration[i] = start_state.hasAccelerations() ?
+                                         std::clamp(start_state.getVariableAcceleration(idx[i]),
+                                                    -input_.max_acceleration[i], input_.max_acceleration[i]) :
+                                         0.0;
+  }
+
+  reference_ = std::make_shared<moveit::core::RobotState>(start_state);
+  last_emitted_ = std::make_shared<moveit::core::RobotState>(start_state);
+  last_emitted_->setJointGroupVelocities(group_, input_.current_velocity);
+  last_emitted_->setJointGroupAccelerations(group_, input_.current_acceleration);
+  last_emitted_->update();
+
+  pending_.clear();
+  output_.clear();
+  started_ = true;
+  finished_ = false;
+  duration_ = 0.0;
+}
+
+bool StreamingTimeParameterization::addWayPoint(const moveit::core::RobotState& waypoint)
+{
+  if (!valid_ || !started_ || finished_)
+    return false;
+
+  std::vector<double> position;
+  waypoint.copyJointGroupPositions(group_, position);
+
+  // Repeated waypoints would produce zero-duration segments, which controllers reject
+  const std::vector<double>& previous = pending_.empty() ? input_.current_position : pending_.back();
+  bool moves = false;
+  for (std::size_t i = 0; i < position.size() && !moves; ++i)
+    moves = std::fabs(position[i] - previous[i]) > MIN_WAYPOINT_DISTANCE;
+  if (!moves)
+    return true;
+
+  pending_.push_back(std::move(position));
+  return process();
+}
+
+bool StreamingTimeParameterization::finish()
+{
+  if (!valid_ || !started_)
+    return false;
+  finished_ = true;
+  return process();
+}
+
+bool StreamingTimeParameterization::getSegment(robot_trajectory::RobotTrajectory& segment)
+{
+  segment.clear();
+  if (output_.empty())
+    return false;
+
+  segment.addSuffixWayPoint(last_emitted_, 0.0);
+  for (const std::pair<moveit::core::RobotStatePtr, double>& waypoint : output_)
+    segment.addSuffixWayPoint(waypoint.first, waypoint.second);
+  last_emitted_ = output_.back().first;
+  output_.clear();
+  return true;
+}
+
+bool StreamingTimeParameterization::process()
+{
+  const std::size_t num_dof = group_->getVariableCount();
+  std::vector<double> velocity(num_dof);
+  std::vector<double> position(num_dof), sample_velocity(num_dof), sample_acceleration(num_dof);
+  const std::vector<double> zero(num_dof, 0.0);
+
+  // A waypoint is final once enough waypoints follow it to decide how fast it can be passed
+  while (!pending_.empty() && (finished_ || pending_.size() > look_ahead_))
+  {
+    const std::vector<double>& target = pending_.front();
+    computeTargetVelocity(velocity);
+    std::copy(target.begin(), target.end(), input_.target_position.begin());
+    std::fill(input_.target_acceleration.begin(), input_.target_acceleration.end(), 0.0);
+
+    // Some target velocities are not reachable from the current state; passing slower always is, down to rest
+    ruckig::Result result = ruckig::Result::Error;
+    for (int attempt = 0; attempt <= MAX_VELOCITY_REDUCTIONS; ++attempt)
+    {
+      std::copy(velocity.begin(), velocity.end(), input_.target_velocity.begin());
+      result = ruckig_.calculate(input_, trajectory_);
+      if (result == ruckig::Result::Working || result == ruckig::Result::Finished)
+        break;
+      for (double& v : velocity)
+        v = attempt + 1 < MAX_VELOCITY_REDUCTIONS ? 0.5 * v : 0.0;
+    }
+    if (result != ruckig::Result::Working && result != ruckig::Result::Finished)
+    {
+      ROS_ERROR_STREAM_NAMED(LOGNAME, "Streaming time parameterization failed. Ruckig error: " << result);
+      return false;
+    }
+
+    const double duration = trajectory_.get_duration();
+    double time = 0.0;
+    if (sample_period_ > 0.0)
+    {
+      // Stop sampling short of the waypoint to avoid a vanishing last interval
+      for (; time + 1.5 * sample_period_ < duration; time += sample_period_)
+      {
+        trajectory_.at_time(time + sample_period_, position, sample_velocity, sample_acceleration);
+        addOutput(position, sample_velocity, sample_acceleration, sample_period_);
+      }
+    }
+    addOutput(target, velocity, zero, duration - time);
+
+    std::copy(target.begin(), target.end(), input_.current_position.begin());
+    std::copy(velocity.begin(), velocity.end(), input_.current_velocity.begin());
+    std::fill(input_.current_acceleration.begin(), input_.current_acceleration.end(), 0.0);
+    pending_.pop_front();
+  }
+  return true;
+}
+
+void StreamingTimeParameterization::computeTargetVelocity(std::vector<double>& velocity) const
+{
+  std::fill(velocity.begin(), velocity.end(), 0.0);
+  // The last known waypoint might be the end of the path, so it is reached at rest
+  if (pending_.size() < 2)
+    return;
+
+  const std::vector<double>& target = pending_[0];
+  const std::vector<double>& next = pending_[1];
+  double scale = std::numeric_limits<double>::infinity();
+  for (std::size_t j = 0; j < velocity.size(); ++j)
+  {
+    const double outgoing = next[j] - target[j];
+    // Joints that reverse or pause at the waypoint pass it at rest
+    if ((target[j] - input_.current_position[j]) * outgoing <= 0.0)
+      continue;
+    velocity[j] = next[j] - input_.current_position[j];
+
+    // Distance the joint keeps moving in the same direction among the known waypoints: it must be able to stop
+    // there, in case no further waypoints arrive
+    double distance = 0.0;
+    for (std::size_t k = 1; k < pending_.size(); ++k)
+    {
+      const double step = pending_[k][j] - pending_[k - 1][j];
+      if (step * outgoing <= 0.0)
+        break;
+      distance += std::fabs(step);
+    }
+    const double limit = std::min(input_.max_velocity[j], getStoppingVelocity(j, distance));
+    scale = std::min(scale, limit / std::fabs(velocity[j]));
+  }
+
+  // Scale the direction of travel uniformly, so the path shape is preserved for the moving joints
+  if (std::isfinite(scale))
+    for (double& v : velocity)
+      v *= scale;
+}
+
+double StreamingTimeParameterization::getStoppingVelocity(std::size_t joint, double distance) const
+{
+  // Stopping from v with a jerk-limited trapezoidal deceleration covers v^2 / (2 a) + v a / (2 j), which also bounds
+  // the shorter triangular profile used for small v
+  const double a = input_.max_acceleration[joint];
+  const double ramp = a / (2.0 * input_.max_jerk[joint]);
+  return a * (std::sqrt(ramp * ramp + 2.0 * distance / a) - ramp);
+}
+
+void StreamingTimeParameterization::addOutput(const std::vector<double>& position, const std::vector<double>& velocity,
+                                              const std::vector<double>& acceleration, double duration_from_previous)
+{
+  auto state = std::make_shared<moveit::core::RobotState>(*reference_);
+  state->setJointGroupPositions(group_, position);
+  state->setJointGroupVelocities(group_, velocity);
+  state->setJointGroupAccelerations(group_, acceleration);
+  state->update();
+  output_.emplace_back(state, duration_from_previous);
+  duration_ += duration_from_previous;
+}
+}  // namespace trajectory_processing
@@ -0,0 +1,110 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Throughput of the sequential and parallel Ruckig smoothing for trajectories of increasing length.
+// To run this benchmark, 'cd' to the build/moveit_core/trajectory_processing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/trajectory_processing/ruckig_traj_smoothing.h>
+#include <moveit/trajectory_processing/time_optimal_trajectory_generation.h>
+#include <moveit/utils/robot_model_test_utils.h>
+
+// Robot and planning group for benchmarks.
+constexpr char PANDA_TEST_ROBOT[] = "panda";
+constexpr char PANDA_TEST_GROUP[] = "panda_arm";
+
+struct RuckigSmoothingBenchmark : ::benchmark::Fixture
+{
+  void SetUp(const ::benchmark::State& state) override
+  {
+    // the default jerk limits are reported on every call
+    if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Error))
+      ros::console::notifyLoggerLevelsChanged();
+
+    robot_model = moveit::core::loadTestingRobotModel(PANDA_TEST_ROBOT);
+    const moveit::core::JointModelGroup* group = robot_model->getJointModelGroup(PANDA_TEST_GROUP);
+
+    // a smooth, time-optimal trajectory with the requested number of waypoints
+    trajectory = std::make_shared<robot_trajectory::RobotTrajectory>(robot_model, group);
+    moveit::core::RobotState robot_state(robot_model);
+    robot_state.setToDefaultValues();
+    std::vector<double> values(group->getVariableCount());
+    const int count = state.range(0);
+    for (int i = 0; i < count; ++i)
+    {
+      for (std::size_t j = 0; j < values.size(); ++j)
+        values[j] = 0.8 * std::sin(20.0 * M_PI * i / count + j);
+      robot_state.setJointGroupPositions(group, values);
+      trajectory->addSuffixWayPoint(robot_state, 0.0);
+    }
+    trajectory_processing::TimeOptimalTrajectoryGeneration totg(0.01, 0.01);
+    totg.computeTimeStamps(*trajectory);
+  }
+
+  moveit::core::RobotModelPtr robot_model;
+  robot_trajectory::RobotTrajectoryPtr trajectory;
+};
+
+// Benchmark smoothing one segment after the other
+BENCHMARK_DEFINE_F(RuckigSmoothingBenchmark, sequential)(benchmark::State& st)
+{
+  for (auto _ : st)
+  {
+    robot_trajectory::RobotTrajectory smoothed(*trajectory, true);
+    trajectory_processing::RuckigSmoothing::applySmoothing(smoothed);
+  }
+  st.SetItemsProcessed(st.iterations() * trajectory->getWayPointCount());
+}
+
+// Benchmark smoothing the segments in parallel
+BENCHMARK_DEFINE_F(RuckigSmoothingBenchmark, parallel)(benchmark::State& st)
+{
+  for (auto _ : st)
+  {
+    robot_trajectory::RobotTrajectory smoothed(*trajectory, true);
+    trajectory_processing::RuckigSmoothing::applySmoothing(smoothed, 1.0, 1.0, false, 0.01, true);
+  }
+  st.SetItemsProcessed(st.iterations() * trajectory->getWayPointCount());
+}
+
+BENCHMARK_REGISTER_F(RuckigSmoothingBenchmark, sequential)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(RuckigSmoothingBenchmark, parallel)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -185,6 +185,36 @@ TEST(TestCartesianSpeed, TestCartesianEndEffectorSpeed)
   }
 }
 
+TEST(TestCartesianSpeed, TestMultipleLinks)
+{
+  // Limiting several links at once is the same as limiting them one after the other
+  trajectory_processing::IterativeParabolicTimeParameterization time_parameterization;
+  EXPECT_EQ(initStraightTrajectory(TRAJECTORY), true);
+  EXPECT_TRUE(time_parameterization.computeTimeStamps(TRAJECTORY));
+  robot_trajectory::RobotTrajectory sequential(TRAJECTORY, true);
+
+  const std::vector<const moveit::core::LinkModel*> links = { RMODEL->getLinkModel("panda_link4"),
+                                                              RMODEL->getLinkModel("panda_link8") };
+  EXPECT_TRUE(trajectory_processing::limitMaxCartesianLinkSpeed(TRAJECTORY, 0.01, links));
+  for (const moveit::core::LinkModel* link : links)
+    EXPECT_TRUE(trajectory_processing::limitMaxCartesianLinkSpeed(sequential, 0.01, link));
+
+  ASSERT_EQ(TRAJECTORY.getWayPointCount(), sequential.getWayPointCount());
+  for (size_t i = 1; i < TRAJECTORY.getWayPointCount(); i++)
+  {
+    EXPECT_NEAR(TRAJECTORY.getWayPointDurationFromPrevious(i), sequential.getWayPointDurationFromPrevious(i), 1e-12);
+
+    // No link is faster than the limit
+    for (const moveit::core::LinkModel* link : links)
+    {
+      const double distance = (TRAJECTORY.getWayPointPtr(i)->getGlobalLinkTransform(link).translation() -
+                               TRAJECTORY.getWayPointPtr(i - 1)->getGlobalLinkTransform(link).translation())
+                                  .norm();
+      EXPECT_LE(distance / TRAJECTORY.getWayPointDurationFromPrevious(i), 0.01 + 1e-9);
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
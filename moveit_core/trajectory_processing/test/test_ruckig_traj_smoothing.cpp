@@ -35,6 +35,7 @@
 
 #include <gtest/gtest.h>
 #include <moveit/trajectory_processing/ruckig_traj_smoothing.h>
+#include <moveit/trajectory_processing/time_optimal_trajectory_generation.h>
 #include <moveit/robot_state/robot_state.h>
 #include <moveit/utils/robot_model_test_utils.h>
 
@@ -166,6 +167,46 @@ TEST_F(RuckigTests, single_waypoint)
   }
 }
 
+TEST_F(RuckigTests, parallel_matches_sequential)
+{
+  // Enough waypoints to smooth the segments on several threads
+  moveit::core::RobotState robot_state(robot_model_);
+  robot_state.setToDefaultValues();
+  const moveit::core::JointModelGroup* group = robot_model_->getJointModelGroup(JOINT_GROUP);
+  std::vector<double> joint_positions;
+  robot_state.copyJointGroupPositions(group, joint_positions);
+  for (size_t waypoint_idx = 0; waypoint_idx < 200; ++waypoint_idx)
+  {
+    for (size_t joint = 0; joint < joint_positions.size(); ++joint)
+    {
+      joint_positions.at(joint) = 0.5 * std::sin(0.05 * waypoint_idx + joint);
+    }
+    robot_state.setJointGroupPositions(group, joint_positions);
+    trajectory_->addSuffixWayPoint(robot_state, DEFAULT_TIMESTEP);
+  }
+  trajectory_processing::TimeOptimalTrajectoryGeneration totg;
+  ASSERT_TRUE(totg.computeTimeStamps(*trajectory_));
+
+  robot_trajectory::RobotTrajectory parallel_trajectory(*trajectory_, true /* deep copy */);
+  ASSERT_TRUE(smoother_.applySmoothing(*trajectory_));
+  ASSERT_TRUE(smoother_.applySmoothing(parallel_trajectory, 1.0, 1.0, false, 0.01, true /* parallel */));
+
+  ASSERT_EQ(trajectory_->getWayPointCount(), parallel_trajectory.getWayPointCount());
+  const std::vector<int>& idx = group->getVariableIndexList();
+  for (size_t waypoint_idx = 0; waypoint_idx < trajectory_->getWayPointCount(); ++waypoint_idx)
+  {
+    EXPECT_EQ(trajectory_->getWayPointDurationFromPrevious(waypoint_idx),
+              parallel_trajectory.getWayPointDurationFromPrevious(waypoint_idx));
+    for (int variable : idx)
+    {
+      EXPECT_EQ(trajectory_->getWayPoint(waypoint_idx).getVariablePosition(variable),
+                parallel_trajectory.getWayPoint(waypoint_idx).getVariablePosition(variable));
+      EXPECT_EQ(trajectory_->getWayPoint(waypoint_idx).getVariableVelocity(variable),
+                parallel_trajectory.getWayPoint(waypoint_idx).getVariableVelocity(variable));
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,203 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/trajectory_processing/streaming_time_parameterization.h>
+#include <moveit/robot_state/robot_state.h>
+#include <moveit/utils/robot_model_test_utils.h>
+
+namespace
+{
+constexpr char JOINT_GROUP[] = "panda_arm";
+constexpr std::size_t LOOK_AHEAD = 4;
+constexpr double EPSILON = 1e-6;
+
+class StreamingTimeParameterizationTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    group_ = robot_model_->getJointModelGroup(JOINT_GROUP);
+    start_state_ = std::make_shared<moveit::core::RobotState>(robot_model_);
+    start_state_->setToDefaultValues(group_, "ready");
+    start_state_->zeroVelocities();
+    start_state_->zeroAccelerations();
+  }
+
+  /** Waypoints moving the first joints out and the first one back again */
+  std::vector<moveit::core::RobotState> makeWayPoints(std::size_t count) const
+  {
+    std::vector<moveit::core::RobotState> waypoints(count, *start_state_);
+    std::vector<double> positions;
+    start_state_->copyJointGroupPositions(group_, positions);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      std::vector<double> p = positions;
+      const double s = static_cast<double>(i + 1) / count;
+      p[0] += 0.8 * std::sin(M_PI * s);
+      p[1] += 0.3 * s;
+      p[3] += 0.5 * s;
+      waypoints[i].setJointGroupPositions(group_, p);
+      waypoints[i].update();
+    }
+    return waypoints;
+  }
+
+  /** Stream all waypoints and collect the emitted segments */
+  std::vector<robot_trajectory::RobotTrajectory> stream(trajectory_processing::StreamingTimeParameterization& streamer,
+                                                        const std::vector<moveit::core::RobotState>& waypoints)
+  {
+    std::vector<robot_trajectory::RobotTrajectory> segments;
+    robot_trajectory::RobotTrajectory segment(robot_model_, JOINT_GROUP);
+    streamer.reset(*start_state_);
+    for (const moveit::core::RobotState& waypoint : waypoints)
+    {
+      EXPECT_TRUE(streamer.addWayPoint(waypoint));
+      if (streamer.getSegment(segment))
+        segments.push_back(segment);
+    }
+    EXPECT_TRUE(streamer.finish());
+    if (streamer.getSegment(segment))
+      segments.push_back(segment);
+    EXPECT_TRUE(streamer.isDone());
+    return segments;
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  const moveit::core::JointModelGroup* group_;
+  moveit::core::RobotStatePtr start_state_;
+};
+
+}  // namespace
+
+TEST_F(StreamingTimeParameterizationTest, emitsAfterLookAhead)
+{
+  trajectory_processing::StreamingTimeParameterization streamer(group_, LOOK_AHEAD);
+  robot_trajectory::RobotTrajectory segment(robot_model_, JOINT_GROUP);
+  const std::vector<moveit::core::RobotState> waypoints = makeWayPoints(10);
+
+  // Nothing can be emitted before a waypoint is added
+  EXPECT_FALSE(streamer.addWayPoint(waypoints[0]));
+
+  streamer.reset(*start_state_);
+  for (std::size_t i = 0; i < LOOK_AHEAD; ++i)
+  {
+    ASSERT_TRUE(streamer.addWayPoint(waypoints[i]));
+    EXPECT_FALSE(streamer.getSegment(segment));
+  }
+  ASSERT_TRUE(streamer.addWayPoint(waypoints[LOOK_AHEAD]));
+  ASSERT_TRUE(streamer.getSegment(segment));
+  // The segment starts at the start state and reaches the first waypoint in motion
+  ASSERT_EQ(segment.getWayPointCount(), 2u);
+  EXPECT_TRUE(segment.getFirstWayPoint().distance(*start_state_) < EPSILON);
+  EXPECT_TRUE(segment.getLastWayPoint().distance(waypoints[0]) < EPSILON);
+  EXPECT_GT(segment.getWayPointDurationFromPrevious(1), 0.0);
+  EXPECT_GT(std::fabs(segment.getLastWayPoint().getVariableVelocity("panda_joint1")), 0.0);
+  EXPECT_EQ(streamer.getPendingWayPointCount(), LOOK_AHEAD);
+
+  ASSERT_TRUE(streamer.finish());
+  EXPECT_FALSE(streamer.addWayPoint(waypoints[LOOK_AHEAD + 1]));
+  ASSERT_TRUE(streamer.getSegment(segment));
+  EXPECT_EQ(segment.getWayPointCount(), LOOK_AHEAD + 1);
+  EXPECT_TRUE(streamer.isDone());
+}
+
+TEST_F(StreamingTimeParameterizationTest, segmentsAreContinuousAndWithinLimits)
+{
+  trajectory_processing::StreamingTimeParameterization streamer(group_, LOOK_AHEAD);
+  const std::vector<moveit::core::RobotState> waypoints = makeWayPoints(30);
+  const std::vector<robot_trajectory::RobotTrajectory> segments = stream(streamer, waypoints);
+  ASSERT_GT(segments.size(), 1u);
+
+  double duration = 0.0;
+  std::size_t next_waypoint = 0;
+  const moveit::core::RobotState* previous_end = start_state_.get();
+  for (const robot_trajectory::RobotTrajectory& segment : segments)
+  {
+    const moveit::core::RobotState& first = segment.getFirstWayPoint();
+    EXPECT_TRUE(first.distance(*previous_end) < EPSILON);
+    for (const moveit::core::JointModel* joint : group_->getActiveJointModels())
+    {
+      const int index = joint->getFirstVariableIndex();
+      EXPECT_NEAR(first.getVariableVelocity(index), previous_end->getVariableVelocity(index), EPSILON);
+    }
+
+    for (std::size_t i = 1; i < segment.getWayPointCount(); ++i)
+    {
+      const moveit::core::RobotState& waypoint = segment.getWayPoint(i);
+      EXPECT_GT(segment.getWayPointDurationFromPrevious(i), 0.0);
+      EXPECT_TRUE(waypoint.distance(waypoints[next_waypoint++]) < EPSILON);
+      for (const moveit::core::JointModel* joint : group_->getActiveJointModels())
+      {
+        const moveit::core::VariableBounds& bounds = joint->getVariableBounds()[0];
+        EXPECT_LE(std::fabs(waypoint.getVariableVelocity(joint->getFirstVariableIndex())),
+                  bounds.max_velocity_ + EPSILON);
+      }
+    }
+    duration += segment.getDuration();
+    previous_end = &segment.getLastWayPoint();
+  }
+  EXPECT_EQ(next_waypoint, waypoints.size());
+  EXPECT_NEAR(duration, streamer.getDuration(), EPSILON);
+
+  // The path ends at rest
+  for (const moveit::core::JointModel* joint : group_->getActiveJointModels())
+    EXPECT_NEAR(previous_end->getVariableVelocity(joint->getFirstVariableIndex()), 0.0, EPSILON);
+}
+
+TEST_F(StreamingTimeParameterizationTest, sampledSegments)
+{
+  const double sample_period = 0.01;
+  trajectory_processing::StreamingTimeParameterization streamer(group_, LOOK_AHEAD, 1.0, 1.0, sample_period);
+  const std::vector<moveit::core::RobotState> waypoints = makeWayPoints(10);
+  const std::vector<robot_trajectory::RobotTrajectory> segments = stream(streamer, waypoints);
+  ASSERT_FALSE(segments.empty());
+
+  std::size_t count = 0;
+  for (const robot_trajectory::RobotTrajectory& segment : segments)
+  {
+    for (std::size_t i = 1; i < segment.getWayPointCount(); ++i)
+      EXPECT_LT(segment.getWayPointDurationFromPrevious(i), 1.5 * sample_period + EPSILON);
+    count += segment.getWayPointCount() - 1;
+  }
+  EXPECT_GT(count, waypoints.size());
+  EXPECT_TRUE(segments.back().getLastWayPoint().distance(waypoints.back()) < EPSILON);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -42,6 +42,7 @@
 #include <moveit/trajectory_processing/iterative_spline_parameterization.h>
 #include <moveit/trajectory_processing/iterative_time_parameterization.h>
 #include <moveit/utils/robot_model_test_utils.h>
+#include <random_numbers/random_numbers.h>
 
 // Static variables used in all tests
 moveit::core::RobotModelConstPtr RMODEL = moveit::core::loadTestingRobotModel("pr2");
@@ -142,6 +143,54 @@ TEST(TestTimeParameterization, TestIterativeParabolic)
   ASSERT_LT(TRAJECTORY.getWayPointDurationFromStart(TRAJECTORY.getWayPointCount() - 1), 3.0);
 }
 
+TEST(TestTimeParameterization, TestIterativeParabolicVectorizedMatchesOriginal)
+{
+  const moveit::core::JointModelGroup* group = TRAJECTORY.getGroup();
+  const std::vector<int>& idx = group->getVariableIndexList();
+  random_numbers::RandomNumberGenerator rng(0);
+
+  for (bool start_velocity : { false, true })
+  {
+    // A random walk through all joints of the group, with a repeated point
+    robot_trajectory::RobotTrajectory trajectory(RMODEL, "right_arm");
+    moveit::core::RobotState state(RMODEL);
+    state.setToDefaultValues();
+    std::vector<double> positions;
+    state.copyJointGroupPositions(group, positions);
+    for (unsigned i = 0; i < 50; ++i)
+    {
+      if (i != 20)
+        for (double& position : positions)
+          position += rng.uniformReal(-0.1, 0.1);
+      state.setJointGroupPositions(group, positions);
+      trajectory.addSuffixWayPoint(state, 0.0);
+    }
+    if (start_velocity)
+      for (int index : idx)
+        trajectory.getFirstWayPointPtr()->setVariableVelocity(index, rng.uniformReal(-0.1, 0.1));
+
+    robot_trajectory::RobotTrajectory original(trajectory, true);
+    EXPECT_TRUE(trajectory_processing::IterativeParabolicTimeParameterization(100, .01, true)
+                    .computeTimeStamps(trajectory, 0.5, 0.5));
+    EXPECT_TRUE(trajectory_processing::IterativeParabolicTimeParameterization(100, .01, false)
+                    .computeTimeStamps(original, 0.5, 0.5));
+
+    // The results are bit-identical
+    ASSERT_EQ(trajectory.getWayPointCount(), original.getWayPointCount());
+    for (std::size_t i = 0; i < trajectory.getWayPointCount(); ++i)
+    {
+      EXPECT_EQ(trajectory.getWayPointDurationFromPrevious(i), original.getWayPointDurationFromPrevious(i));
+      for (int index : idx)
+      {
+        EXPECT_EQ(trajectory.getWayPoint(i).getVariableVelocity(index),
+                  original.getWayPoint(i).getVariableVelocity(index));
+        EXPECT_EQ(trajectory.getWayPoint(i).getVariableAcceleration(index),
+                  original.getWayPoint(i).getVariableAcceleration(index));
+      }
+    }
+  }
+}
+
 TEST(TestTimeParameterization, TestIterativeSpline)
 {
   trajectory_processing::IterativeSplineParameterization time_parameterization(false);
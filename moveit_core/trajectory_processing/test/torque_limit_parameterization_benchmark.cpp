@@ -0,0 +1,162 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Benchmarks of inverse dynamics for the torque-limited time parameterization, for 500-waypoint trajectories.
+// To run this benchmark, 'cd' to the build/moveit_core/trajectory_processing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/dynamics_solver/batch_inverse_dynamics.h>
+#include <moveit/dynamics_solver/dynamics_solver.h>
+#include <moveit/trajectory_processing/iterative_torque_limit_parameterization.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <algorithm>
+
+// Robot and planning group for benchmarks.
+constexpr char PANDA_TEST_ROBOT[] = "panda";
+constexpr char PANDA_TEST_GROUP[] = "panda_arm";
+constexpr std::size_t WAYPOINT_COUNT = 500;
+
+struct TorqueLimitBenchmark : ::benchmark::Fixture
+{
+  void SetUp(const ::benchmark::State& /*state*/) override
+  {
+    if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Warn))
+      ros::console::notifyLoggerLevelsChanged();
+
+    robot_model = moveit::core::loadTestingRobotModel(PANDA_TEST_ROBOT);
+    group = robot_model->getJointModelGroup(PANDA_TEST_GROUP);
+    gravity.z = -9.81;
+    wrenches.resize(group->getLinkModels().size());
+
+    // random joint values, as they would be found in a time-parameterized trajectory
+    const std::size_t dof = group->getVariableCount();
+    moveit::core::RobotState state(robot_model);
+    random_numbers::RandomNumberGenerator rng(0);
+    positions.resize(WAYPOINT_COUNT * dof);
+    velocities.resize(WAYPOINT_COUNT * dof);
+    accelerations.resize(WAYPOINT_COUNT * dof);
+    for (std::size_t i = 0; i < WAYPOINT_COUNT; ++i)
+    {
+      state.setToRandomPositions(group, rng);
+      state.copyJointGroupPositions(group, &positions[i * dof]);
+      for (std::size_t j = 0; j < dof; ++j)
+      {
+        velocities[i * dof + j] = rng.uniformReal(-2.0, 2.0);
+        accelerations[i * dof + j] = rng.uniformReal(-5.0, 5.0);
+      }
+    }
+  }
+
+  moveit::core::RobotModelPtr robot_model;
+  const moveit::core::JointModelGroup* group;
+  geometry_msgs::Vector3 gravity;
+  std::vector<geometry_msgs::Wrench> wrenches;
+  std::vector<double> positions, velocities, accelerations;
+};
+
+// Benchmark torques of all waypoints with one KDL-based DynamicsSolver call per waypoint
+BENCHMARK_DEFINE_F(TorqueLimitBenchmark, dynamicsSolver)(benchmark::State& st)
+{
+  dynamics_solver::DynamicsSolver solver(robot_model, PANDA_TEST_GROUP, gravity);
+  const std::size_t dof = group->getVariableCount();
+  std::vector<double> q(dof), qd(dof), qdd(dof), torques(dof);
+  for (auto _ : st)
+  {
+    for (std::size_t i = 0; i < WAYPOINT_COUNT; ++i)
+    {
+      std::copy(positions.begin() + i * dof, positions.begin() + (i + 1) * dof, q.begin());
+      std::copy(velocities.begin() + i * dof, velocities.begin() + (i + 1) * dof, qd.begin());
+      std::copy(accelerations.begin() + i * dof, accelerations.begin() + (i + 1) * dof, qdd.begin());
+      solver.getTorques(q, qd, qdd, wrenches, torques);
+      benchmark::DoNotOptimize(torques);
+    }
+  }
+}
+
+// Benchmark torques of all waypoints with a single BatchInverseDynamics call
+BENCHMARK_DEFINE_F(TorqueLimitBenchmark, batchInverseDynamics)(benchmark::State& st)
+{
+  dynamics_solver::BatchInverseDynamics solver(robot_model, PANDA_TEST_GROUP, gravity);
+  std::vector<double> torques(positions.size());
+  for (auto _ : st)
+  {
+    solver.getTorques(positions.data(), velocities.data(), accelerations.data(), WAYPOINT_COUNT, wrenches,
+                      torques.data());
+    benchmark::DoNotOptimize(torques);
+  }
+}
+
+// Benchmark the torque-limited time parameterization of a path with 500 waypoints
+BENCHMARK_DEFINE_F(TorqueLimitBenchmark, computeTimeStampsWithTorqueLimits)(benchmark::State& st)
+{
+  robot_trajectory::RobotTrajectory path(robot_model, group);
+  moveit::core::RobotState state(robot_model);
+  state.setToDefaultValues();
+  const std::size_t dof = group->getVariableCount();
+  std::vector<double> values(dof);
+  for (std::size_t i = 0; i < WAYPOINT_COUNT; ++i)
+  {
+    // a smooth curve through the workspace
+    for (std::size_t j = 0; j < dof; ++j)
+      values[j] = 0.8 * std::sin(2.0 * M_PI * i / WAYPOINT_COUNT + j);
+    state.setJointGroupPositions(group, values);
+    path.addSuffixWayPoint(state, 0.0);
+  }
+
+  std::unordered_map<std::string, double> velocity_limits, acceleration_limits;
+  std::vector<double> torque_limits;
+  for (const moveit::core::JointModel* joint : group->getActiveJointModels())
+  {
+    velocity_limits[joint->getName()] = 2.0;
+    acceleration_limits[joint->getName()] = 10.0;
+    // low enough to require a few iterations: the wrist joints are weaker than the others
+    torque_limits.push_back(torque_limits.size() < 4 ? 40.0 : 6.0);
+  }
+
+  // resample_dt is chosen to yield trajectories of about 500 waypoints
+  trajectory_processing::IterativeTorqueLimitParameterization parameterization(0.1, 0.01, 0.001);
+  for (auto _ : st)
+  {
+    robot_trajectory::RobotTrajectory trajectory(path, true);
+    parameterization.computeTimeStampsWithTorqueLimits(trajectory, gravity, wrenches, torque_limits, 0.05,
+                                                       velocity_limits, acceleration_limits, 1.0, 1.0);
+    st.counters["waypoints"] = trajectory.getWayPointCount();
+  }
+}
+
+BENCHMARK_REGISTER_F(TorqueLimitBenchmark, dynamicsSolver)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(TorqueLimitBenchmark, batchInverseDynamics)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(TorqueLimitBenchmark, computeTimeStampsWithTorqueLimits)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -40,6 +40,7 @@
 #include <Eigen/Geometry>
 #include <boost/noncopyable.hpp>
 #include <moveit/macros/class_forward.h>
+#include <unordered_map>
 
 namespace moveit
 {
@@ -52,6 +53,22 @@ MOVEIT_CLASS_FORWARD(Transforms);  // Defines TransformsPtr, ConstPtr, WeakPtr..
 using FixedTransformsMap = std::map<std::string, Eigen::Isometry3d, std::less<std::string>,
                                     Eigen::aligned_allocator<std::pair<const std::string, Eigen::Isometry3d> > >;
 
+/** @brief Reference to a frame maintained by a Transforms object, resolved once from the frame's name.
+ *
+ *  Retrieving the transform of a handle needs no string lookup. The handle stays valid (and reflects later
+ *  modifications of the transform) as long as the version of the Transforms object it was obtained from is unchanged.
+ */
+struct FixedFrameHandle
+{
+  const Eigen::Isometry3d* transform = nullptr;  // nullptr if the frame is unknown
+  std::size_t version = 0;
+
+  explicit operator bool() const
+  {
+    return transform != nullptr;
+  }
+};
+
 /** @brief Provides an implementation of a snapshot of a transform tree that can be easily queried for
     transforming different quantities. Transforms are maintained as a list of transforms to a particular frame.
     All stored transforms are considered fixed. */
@@ -122,6 +139,43 @@ public:
 
   /**@}*/
 
+  /**
+   * \name Interned frames
+   */
+  /**@{*/
+
+  /**
+   * @brief Resolve a frame name to a handle for repeated transform lookups
+   * @return The handle, which evaluates to false if the frame is not known
+   */
+  FixedFrameHandle getFixedFrameHandle(const std::string& frame) const;
+
+  /**
+   * @brief Get the version of the set of frames. It changes whenever previously obtained handles become invalid.
+   */
+  std::size_t getVersion() const
+  {
+    return version_;
+  }
+
+  /**
+   * @brief Check whether a handle obtained from getFixedFrameHandle() can still be used
+   */
+  bool isValid(const FixedFrameHandle& frame) const
+  {
+    return frame.transform && frame.version == version_;
+  }
+
+  /**
+   * @brief Get the transform of a frame (w.r.t the target frame) referenced by a valid handle
+   */
+  const Eigen::Isometry3d& getTransform(const FixedFrameHandle& frame) const
+  {
+    return *frame.transform;
+  }
+
+  /**@}*/
+
   /**
    * \name Applying transforms
    */
@@ -199,6 +253,14 @@ public:
 protected:
   std::string target_frame_;
   FixedTransformsMap transforms_map_;
+
+private:
+  /** @brief Recreate the name index after transforms_map_ was replaced; invalidates all handles */
+  void rebuildFrameIndex();
+
+  // entries of transforms_map_ by name; map nodes are stable, so pointers stay valid until the map is replaced
+  std::unordered_map<std::string, const Eigen::Isometry3d*> frame_index_;
+  std::size_t version_;
 };
 }  // namespace core
 }  // namespace moveit
@@ -39,19 +39,30 @@
 #include <tf2_eigen/tf2_eigen.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <ros/console.h>
+#include <atomic>
 
 namespace moveit
 {
 namespace core
 {
-Transforms::Transforms(const std::string& target_frame) : target_frame_(target_frame)
+namespace
+{
+// versions are unique across all Transforms objects, so a handle can never be mistaken as valid for another object
+std::size_t newVersion()
+{
+  static std::atomic<std::size_t> counter(0);
+  return ++counter;
+}
+}  // namespace
+
+Transforms::Transforms(const std::string& target_frame) : target_frame_(target_frame), version_(newVersion())
 {
   boost::trim(target_frame_);
   if (target_frame_.empty())
     ROS_ERROR_NAMED("transforms", "The target frame for MoveIt Transforms cannot be empty.");
   else
   {
-    transforms_map_[target_frame_] = Eigen::Isometry3d::Identity();
+    setTransform(Eigen::Isometry3d::Identity(), target_frame_);
   }
 }
 
@@ -81,6 +92,26 @@ void Transforms::setAllTransforms(const FixedTransformsMap& transforms)
     ASSERT_ISOMETRY(t.second)  // unsanitized input, could contain a non-isometry
   }
   transforms_map_ = transforms;
+  rebuildFrameIndex();
+}
+
+void Transforms::rebuildFrameIndex()
+{
+  frame_index_.clear();
+  frame_index_.reserve(transforms_map_.size());
+  for (const auto& t : transforms_map_)
+    frame_index_.emplace(t.first, &t.second);
+  version_ = newVersion();
+}
+
+FixedFrameHandle Transforms::getFixedFrameHandle(const std::string& frame) const
+{
+  FixedFrameHandle handle;
+  handle.version = version_;
+  auto it = frame_index_.find(frame);
+  if (it != frame_index_.end())
+    handle.transform = it->second;
+  return handle;
 }
 
 bool Transforms::isFixedFrame(const std::string& frame) const
@@ -88,16 +119,16 @@ bool Transforms::isFixedFrame(const std::string& frame) const
   if (frame.empty())
     return false;
   else
-    return transforms_map_.find(frame) != transforms_map_.end();
+    return frame_index_.find(frame) != frame_index_.end();
 }
 
 const Eigen::Isometry3d& Transforms::getTransform(const std::string& from_frame) const
 {
   if (!from_frame.empty())
   {
-    FixedTransformsMap::const_iterator it = transforms_map_.find(from_frame);
-    if (it != transforms_map_.end())
-      return it->second;
+    FixedFrameHandle frame = getFixedFrameHandle(from_frame);
+    if (frame)
+      return getTransform(frame);
     // If no transform found in map, return identity
   }
 
@@ -114,7 +145,7 @@ bool Transforms::canTransform(const std::string& from_frame) const
   if (from_frame.empty())
     return false;
   else
-    return transforms_map_.find(from_frame) != transforms_map_.end();
+    return frame_index_.find(from_frame) != frame_index_.end();
 }
 
 void Transforms::setTransform(const Eigen::Isometry3d& t, const std::string& from_frame)
@@ -123,7 +154,12 @@ void Transforms::setTransform(const Eigen::Isometry3d& t, const std::string& fro
   if (from_frame.empty())
     ROS_ERROR_NAMED("transforms", "Cannot record transform with empty name");
   else
-    transforms_map_[from_frame] = t;
+  {
+    // existing entries are updated in place, so handles to them remain valid
+    Eigen::Isometry3d& transform = transforms_map_[from_frame];
+    transform = t;
+    frame_index_.emplace(from_frame, &transform);
+  }
 }
 
 void Transforms::setTransform(const geometry_msgs::TransformStamped& transform)
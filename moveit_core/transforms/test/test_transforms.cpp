@@ -61,6 +61,33 @@ TEST(Transforms, Simple)
   EXPECT_TRUE(tf.isFixedFrame("global"));
 }
 
+TEST(Transforms, FrameHandles)
+{
+  moveit::core::Transforms tf("global");
+
+  Eigen::Isometry3d t1 = Eigen::Isometry3d::Identity();
+  t1.translation() = Eigen::Vector3d(10.0, 1.0, 0.0);
+  tf.setTransform(t1, "some_frame_1");
+
+  moveit::core::FixedFrameHandle frame = tf.getFixedFrameHandle("some_frame_1");
+  ASSERT_TRUE(frame);
+  EXPECT_TRUE(frame.transform->isApprox(t1));
+  EXPECT_FALSE(tf.getFixedFrameHandle("base_footprint"));
+
+  // adding or updating frames keeps existing handles valid
+  Eigen::Isometry3d t2 = Eigen::Isometry3d::Identity();
+  t2.translation() = Eigen::Vector3d(0.0, 1.0, -1.0);
+  tf.setTransform(t2, "some_frame_2");
+  tf.setTransform(t2, "some_frame_1");
+  ASSERT_TRUE(tf.isValid(frame));
+  EXPECT_TRUE(tf.getTransform(frame).isApprox(t2));
+
+  // replacing all transforms invalidates them
+  tf.setAllTransforms(tf.getAllTransforms());
+  EXPECT_FALSE(tf.isValid(frame));
+  EXPECT_TRUE(tf.getTransform("some_frame_1").isApprox(t2));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -41,15 +41,26 @@
 #include <moveit/robot_model/robot_model.h>
 #include <tf2/LinearMath/Vector3.h>
 #include <tf2/LinearMath/Quaternion.h>
-#include <moveit/cached_ik_kinematics_plugin/detail/NearestNeighborsGNAT.h>
 #include <boost/filesystem.hpp>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <utility>
 
 namespace cached_ik_kinematics_plugin
 {
-/** \brief A cache of inverse kinematic solutions */
+/**
+  \brief A cache of inverse kinematic solutions
+
+  Entries are stored back-to-back in a fixed-capacity, append-only
+  array that is memory-mapped from the cache file, so the cache is
+  persisted as it grows and can be shared by several processes (e.g.,
+  across move_group restarts). Nearest-neighbor queries run on an
+  immutable vantage-point tree over a prefix of that array plus a
+  linear scan of the entries appended since the tree was built. Readers
+  never take a lock; updateCache() replaces the tree atomically when it
+  becomes too stale.
+*/
 class IKCache
 {
 public:
@@ -93,9 +104,9 @@ public:
   IKCache(const IKCache&) = delete;
 
   /** get the entry from the IK cache that best matches a given pose */
-  const IKEntry& getBestApproximateIKSolution(const Pose& pose) const;
+  IKEntry getBestApproximateIKSolution(const Pose& pose) const;
   /** get the entry from the IK cache that best matches a given vector of poses */
-  const IKEntry& getBestApproximateIKSolution(const std::vector<Pose>& poses) const;
+  IKEntry getBestApproximateIKSolution(const std::vector<Pose>& poses) const;
   /** initialize cache, read from disk if found */
   void initializeCache(const std::string& robot_id, const std::string& group_name, const std::string& cache_name,
                        const unsigned int num_joints, const Options& opts = Options());
@@ -113,10 +124,19 @@ public:
   void verifyCache(kdl_kinematics_plugin::KDLKinematicsPlugin& fk) const;
 
 protected:
+  /** flat entry storage, backed by a memory-mapped cache file if possible */
+  struct Storage;
+  /** immutable vantage-point tree over the first entries of a Storage */
+  struct Index;
+
   /** compute the distance between two joint configurations */
   double configDistance2(const std::vector<double>& config1, const std::vector<double>& config2) const;
-  /** save current state of cache to disk */
+  /** flush the memory-mapped cache file to disk */
   void saveCache() const;
+  /** append (poses,config) to the storage, creating the storage first if needed; requires lock_ */
+  void addEntry(const std::vector<Pose>& poses, const std::vector<double>& config) const;
+  /** build a vantage-point tree over all entries currently in storage and publish it; requires lock_ */
+  void rebuildIndex(const std::shared_ptr<Storage>& storage) const;
 
   /** number of joints in the system */
   unsigned int num_joints_;
@@ -132,16 +152,15 @@ protected:
 
   /**
     the IK methods are declared const in the base class, but the
-    wrapped methods need to modify the cache, so the next four members
+    wrapped methods need to modify the cache, so the next three members
     are mutable
-    cache of IK solutions
+    current nearest-neighbor index (which also owns the storage);
+    only accessed through std::atomic_load / std::atomic_store
   */
-  mutable std::vector<IKEntry> ik_cache_;
-  /** nearest neighbor data structure over IK cache entries */
-  mutable NearestNeighborsGNAT<IKEntry*> ik_nn_;
-  /** size of the cache when it was last saved */
+  mutable std::shared_ptr<const Index> index_;
+  /** size of the cache when it was last flushed */
   mutable unsigned int last_saved_cache_size_{ 0 };
-  /** mutex for changing IK cache */
+  /** mutex for changing IK cache (readers don't need it) */
   mutable std::mutex lock_;
 };
 
@@ -158,9 +177,8 @@ public:
     get the entry from the IK cache that best matches a given vector of
     poses, with a specified set of fixed and active tip links
   */
-  const IKEntry& getBestApproximateIKSolution(const std::vector<std::string>& fixed,
-                                              const std::vector<std::string>& active,
-                                              const std::vector<Pose>& poses) const;
+  IKEntry getBestApproximateIKSolution(const std::vector<std::string>& fixed, const std::vector<std::string>& active,
+                                       const std::vector<Pose>& poses) const;
   /**
     insert (pose,config) as an entry if it's different enough from the
     most similar cache entry
@@ -34,28 +34,349 @@
 
 /* Author: Mark Moll */
 
+
 #include <boost/filesystem/fstream.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <numeric>
+#include <type_traits>
 
 #include <moveit/cached_ik_kinematics_plugin/cached_ik_kinematics_plugin.h>
 
 namespace cached_ik_kinematics_plugin
 {
-IKCache::IKCache()
+namespace
 {
-  // set distance function for nearest-neighbor queries
-  ik_nn_.setDistanceFunction([](const IKEntry* entry1, const IKEntry* entry2) {
-    double dist = 0.;
-    for (unsigned int i = 0; i < entry1->first.size(); ++i)
-      dist += entry1->first[i].distance(entry2->first[i]);
-    return dist;
-  });
+/** "MVIKCCH2" */
+constexpr std::uint64_t CACHE_FILE_MAGIC = 0x324843434b49564dULL;
+constexpr std::uint32_t CACHE_FILE_VERSION = 1;
+/** number of doubles per end effector pose: position + quaternion */
+constexpr std::size_t POSE_SIZE = 7;
+/** rebuild the nearest-neighbor index when this many entries are only reachable by linear scan */
+constexpr std::uint32_t MAX_UNINDEXED_ENTRIES = 64;
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "IK cache files shared between processes need lock-free atomics");
+
+/** distance between two flat poses; matches IKCache::Pose::distance() */
+double poseDistance(const double* p1, const double* p2)
+{
+  const double dx = p1[0] - p2[0], dy = p1[1] - p2[1], dz = p1[2] - p2[2];
+  const double dot = p1[3] * p2[3] + p1[4] * p2[4] + p1[5] * p2[5] + p1[6] * p2[6];
+  const double norm2 = (p1[3] * p1[3] + p1[4] * p1[4] + p1[5] * p1[5] + p1[6] * p1[6]) *
+                       (p2[3] * p2[3] + p2[4] * p2[4] + p2[5] * p2[5] + p2[6] * p2[6]);
+  return std::sqrt(dx * dx + dy * dy + dz * dz) + 2. * std::acos(std::min(1., std::abs(dot) / std::sqrt(norm2)));
+}
+
+double posesDistance(const double* p1, const double* p2, std::size_t num_tips)
+{
+  double dist = 0.;
+  for (std::size_t i = 0; i < num_tips; ++i)
+    dist += poseDistance(p1 + i * POSE_SIZE, p2 + i * POSE_SIZE);
+  return dist;
+}
+
+void flattenPoses(const std::vector<IKCache::Pose>& poses, double* buffer)
+{
+  for (const auto& pose : poses)
+  {
+    for (int i = 0; i < 3; ++i)
+      *buffer++ = pose.position[i];
+    for (int i = 0; i < 4; ++i)
+      *buffer++ = pose.orientation[i];
+  }
+}
+}  // namespace
+
+/**
+  Fixed-capacity array of (poses, config) records. Entries are only
+  ever appended: a record is written first and then published by
+  incrementing the size with release semantics, so readers (in this or
+  another process) can access all entries below size() without locking.
+*/
+struct IKCache::Storage
+{
+  /** header at the start of the cache file; the entries follow it */
+  struct Header
+  {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t num_dofs;
+    std::uint32_t num_tips;
+    std::uint32_t capacity;
+    /** number of valid entries; only grows */
+    std::atomic<std::uint32_t> size;
+    char padding[36];
+  };
+  static_assert(sizeof(Header) == 64, "IK cache file header must be 64 bytes");
+  static_assert(std::is_trivially_default_constructible<Header>::value,
+                "constructing the IK cache file header must not change the file");
+
+  static std::size_t fileSize(unsigned int num_dofs, unsigned int num_tips, unsigned int capacity)
+  {
+    return sizeof(Header) + std::size_t(capacity) * (POSE_SIZE * num_tips + num_dofs) * sizeof(double);
+  }
+
+  /**
+    get the storage of a cache file. Storages are shared by all IKCache
+    instances of a process that use the same file. Otherwise, the file
+    is mapped if it exists and matches the requested layout, or it is
+    created if num_tips > 0. Returns nullptr if there is no compatible
+    file and num_tips == 0. Throws if the file can't be mapped.
+  */
+  static std::shared_ptr<Storage> acquire(const boost::filesystem::path& file_name, unsigned int num_dofs,
+                                          unsigned int num_tips, unsigned int capacity);
+  /** anonymous storage used when the cache file can't be mapped */
+  static std::shared_ptr<Storage> createInMemory(unsigned int num_dofs, unsigned int num_tips, unsigned int capacity);
+
+  bool matches(unsigned int num_dofs, unsigned int num_tips, unsigned int capacity) const
+  {
+    return this->num_dofs == num_dofs && this->capacity == capacity && (num_tips == 0 || this->num_tips == num_tips);
+  }
+
+  std::uint32_t size() const
+  {
+    return header->size.load(std::memory_order_acquire);
+  }
+  const double* poses(std::size_t i) const
+  {
+    return data + i * stride;
+  }
+  const double* config(std::size_t i) const
+  {
+    return data + i * stride + POSE_SIZE * num_tips;
+  }
+  IKEntry entry(std::size_t i) const
+  {
+    IKEntry result;
+    result.first.resize(num_tips);
+    const double* pose = poses(i);
+    for (auto& p : result.first)
+    {
+      p.position = tf2::Vector3(pose[0], pose[1], pose[2]);
+      p.orientation = tf2::Quaternion(pose[3], pose[4], pose[5], pose[6]);
+      pose += POSE_SIZE;
+    }
+    result.second.assign(config(i), config(i) + num_dofs);
+    return result;
+  }
+
+  /** append an entry, returns false if the storage is full */
+  bool append(const double* poses, const double* config)
+  {
+    std::lock_guard<std::mutex> slock(mutex);
+    std::unique_ptr<boost::interprocess::scoped_lock<boost::interprocess::file_lock>> flock;
+    if (file_lock)
+      flock = std::make_unique<boost::interprocess::scoped_lock<boost::interprocess::file_lock>>(*file_lock);
+
+    const std::uint32_t n = header->size.load(std::memory_order_acquire);
+    if (n >= capacity)
+      return false;
+    double* dest = data + n * stride;
+    std::copy(poses, poses + POSE_SIZE * num_tips, dest);
+    std::copy(config, config + num_dofs, dest + POSE_SIZE * num_tips);
+    header->size.store(n + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** schedule writing the mapped file to disk */
+  void flush()
+  {
+    if (region.get_address())
+      region.flush(0, fileSize(num_dofs, num_tips, size()), true);
+  }
+
+  boost::interprocess::mapped_region region;
+  std::vector<double> heap;  // only used for in-memory storage
+  Header* header{ nullptr };
+  double* data{ nullptr };
+  unsigned int num_dofs{ 0 };
+  unsigned int num_tips{ 0 };
+  unsigned int capacity{ 0 };
+  std::size_t stride{ 0 };
+  /** serializes appends within this process */
+  std::mutex mutex;
+  /** serializes appends of processes sharing the cache file (unset for in-memory storage) */
+  std::unique_ptr<boost::interprocess::file_lock> file_lock;
+
+private:
+  static std::shared_ptr<Storage> open(const boost::filesystem::path& file_name);
+  static std::shared_ptr<Storage> create(const boost::filesystem::path& file_name, unsigned int num_dofs,
+                                         unsigned int num_tips, unsigned int capacity);
+  void setLayout(unsigned int num_dofs, unsigned int num_tips, unsigned int capacity)
+  {
+    this->num_dofs = num_dofs;
+    this->num_tips = num_tips;
+    this->capacity = capacity;
+    stride = POSE_SIZE * num_tips + num_dofs;
+    data = reinterpret_cast<double*>(header + 1);
+  }
+};
+
+std::shared_ptr<IKCache::Storage> IKCache::Storage::acquire(const boost::filesystem::path& file_name,
+                                                            unsigned int num_dofs, unsigned int num_tips,
+                                                            unsigned int capacity)
+{
+  static std::mutex registry_lock;
+  static std::map<std::string, std::weak_ptr<Storage>> registry;
+  std::lock_guard<std::mutex> slock(registry_lock);
+
+  std::weak_ptr<Storage>& shared = registry[file_name.string()];
+  std::shared_ptr<Storage> storage = shared.lock();
+  if (storage && storage->matches(num_dofs, num_tips, capacity))
+    return storage;
+
+  storage = boost::filesystem::exists(file_name) ? open(file_name) : nullptr;
+  if (!storage || !storage->matches(num_dofs, num_tips, capacity))
+  {
+    if (num_tips == 0)
+      return nullptr;
+    storage = create(file_name, num_dofs, num_tips, capacity);
+  }
+  storage->file_lock = std::make_unique<boost::interprocess::file_lock>(file_name.string().c_str());
+  shared = storage;
+  return storage;
+}
+
+std::shared_ptr<IKCache::Storage> IKCache::Storage::open(const boost::filesystem::path& file_name)
+{
+  const std::size_t file_size = boost::filesystem::file_size(file_name);
+  if (file_size < sizeof(Header))
+    return nullptr;
+  auto storage = std::make_shared<Storage>();
+  boost::interprocess::file_mapping mapping(file_name.string().c_str(), boost::interprocess::read_write);
+  storage->region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_write);
+  // begin the lifetime of the header in the mapped file; default initialization keeps the values in the file
+  storage->header = new (storage->region.get_address()) Header;
+  const Header& header = *storage->header;
+  if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION || header.num_tips == 0 ||
+      file_size < fileSize(header.num_dofs, header.num_tips, header.capacity))
+    return nullptr;
+  storage->setLayout(header.num_dofs, header.num_tips, header.capacity);
+  return storage;
+}
+
+std::shared_ptr<IKCache::Storage> IKCache::Storage::create(const boost::filesystem::path& file_name,
+                                                           unsigned int num_dofs, unsigned int num_tips,
+                                                           unsigned int capacity)
+{
+  // initialize a temporary file and move it into place, so other processes never see a partial header
+  const boost::filesystem::path tmp_file_name = boost::filesystem::unique_path(file_name.string() + ".%%%%%%");
+  {
+    boost::filesystem::ofstream file(tmp_file_name, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+  }
+  // the file is sparse until entries are appended
+  boost::filesystem::resize_file(tmp_file_name, fileSize(num_dofs, num_tips, capacity));
+
+  auto storage = std::make_shared<Storage>();
+  boost::interprocess::file_mapping mapping(tmp_file_name.string().c_str(), boost::interprocess::read_write);
+  storage->region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_write);
+  storage->header = new (storage->region.get_address()) Header();
+  storage->header->magic = CACHE_FILE_MAGIC;
+  storage->header->version = CACHE_FILE_VERSION;
+  storage->header->num_dofs = num_dofs;
+  storage->header->num_tips = num_tips;
+  storage->header->capacity = capacity;
+  storage->header->size.store(0);
+  storage->setLayout(num_dofs, num_tips, capacity);
+  storage->region.flush(0, sizeof(Header), false);
+  boost::filesystem::rename(tmp_file_name, file_name);
+  return storage;
+}
+
+std::shared_ptr<IKCache::Storage> IKCache::Storage::createInMemory(unsigned int num_dofs, unsigned int num_tips,
+                                                                   unsigned int capacity)
+{
+  auto storage = std::make_shared<Storage>();
+  storage->heap.resize(fileSize(num_dofs, num_tips, capacity) / sizeof(double));
+  storage->header = new (storage->heap.data()) Header();
+  storage->header->num_dofs = num_dofs;
+  storage->header->num_tips = num_tips;
+  storage->header->capacity = capacity;
+  storage->header->size.store(0);
+  storage->setLayout(num_dofs, num_tips, capacity);
+  return storage;
 }
 
+/** vantage-point tree over the first size entries of a storage */
+struct IKCache::Index
+{
+  struct Node
+  {
+    std::uint32_t entry;
+    /** entries in the inside subtree are at most this far from entry, those in the outside subtree at least */
+    double radius;
+    std::int32_t inside;
+    std::int32_t outside;
+  };
+
+  /** recursively build the subtree over items[begin, end), returns the node index or -1 */
+  std::int32_t build(std::vector<std::pair<double, std::uint32_t>>& items, std::size_t begin, std::size_t end)
+  {
+    if (begin == end)
+      return -1;
+    const std::int32_t node = nodes.size();
+    nodes.push_back(Node{ items[begin].second, 0., -1, -1 });
+    if (++begin == end)
+      return node;
+
+    const double* vantage_point = storage->poses(nodes[node].entry);
+    for (std::size_t i = begin; i < end; ++i)
+      items[i].first = posesDistance(vantage_point, storage->poses(items[i].second), storage->num_tips);
+    const std::size_t median = begin + (end - begin) / 2;
+    std::nth_element(items.begin() + begin, items.begin() + median, items.begin() + end);
+    nodes[node].radius = items[median].first;
+
+    const std::int32_t inside = build(items, begin, median + 1);
+    nodes[node].inside = inside;
+    const std::int32_t outside = build(items, median + 1, end);
+    nodes[node].outside = outside;
+    return node;
+  }
+
+  void nearest(std::int32_t node, const double* query, double& best_distance, std::uint32_t& best_entry) const
+  {
+    if (node < 0)
+      return;
+    const Node& n = nodes[node];
+    const double d = posesDistance(query, storage->poses(n.entry), storage->num_tips);
+    if (d < best_distance)
+    {
+      best_distance = d;
+      best_entry = n.entry;
+    }
+    if (d <= n.radius)
+    {
+      nearest(n.inside, query, best_distance, best_entry);
+      if (d + best_distance >= n.radius)
+        nearest(n.outside, query, best_distance, best_entry);
+    }
+    else
+    {
+      nearest(n.outside, query, best_distance, best_entry);
+      if (d - best_distance <= n.radius)
+        nearest(n.inside, query, best_distance, best_entry);
+    }
+  }
+
+  std::shared_ptr<Storage> storage;
+  /** number of entries covered by the tree */
+  std::uint32_t size{ 0 };
+  /** tree nodes in pre-order, the root is at index 0 */
+  std::vector<Node> nodes;
+};
+
+IKCache::IKCache() = default;
+
 IKCache::~IKCache()
 {
-  if (!ik_cache_.empty())
-    saveCache();
+  saveCache();
 }
 
 void IKCache::initializeCache(const std::string& robot_id, const std::string& group_name, const std::string& cache_name,
@@ -63,7 +384,6 @@ void IKCache::initializeCache(const std::string& robot_id, const std::string& gr
 {
   // read ROS parameters
   max_cache_size_ = opts.max_cache_size;
-  ik_cache_.reserve(max_cache_size_);
   min_pose_distance_ = opts.min_pose_distance;
   min_config_distance2_ = opts.min_joint_config_distance;
   min_config_distance2_ *= min_config_distance2_;
@@ -71,6 +391,7 @@ void IKCache::initializeCache(const std::string& robot_id, const std::string& gr
 
   // use mutex lock for rest of initialization
   std::lock_guard<std::mutex> slock(lock_);
+  num_joints_ = num_joints;
   // determine cache file name
   boost::filesystem::path prefix(!cached_ik_path.empty() ? cached_ik_path : boost::filesystem::current_path());
   // create cache directory if necessary
@@ -80,57 +401,65 @@ void IKCache::initializeCache(const std::string& robot_id, const std::string& gr
                                std::to_string(min_pose_distance_) + "_" +
                                std::to_string(std::sqrt(min_config_distance2_)) + ".ikcache");
 
-  ik_cache_.clear();
-  ik_nn_.clear();
+  std::atomic_store(&index_, std::shared_ptr<const Index>());
   last_saved_cache_size_ = 0;
-  if (boost::filesystem::exists(cache_file_name_))
+
+  std::shared_ptr<Storage> storage;
+  try
+  {
+    storage = Storage::acquire(cache_file_name_, num_joints_, 0, max_cache_size_);
+  }
+  catch (std::exception& e)
+  {
+    ROS_WARN_NAMED("cached_ik", "Could not map %s: %s", cache_file_name_.string().c_str(), e.what());
+  }
+
+  if (storage)
+    ROS_INFO_NAMED("cached_ik", "Found %d IK solutions for a %d-dof system with %d end effectors in %s",
+                   storage->size(), storage->num_dofs, storage->num_tips, cache_file_name_.string().c_str());
+  else if (boost::filesystem::exists(cache_file_name_))
   {
-    // read cache
+    // convert a cache file in the old format: the number of entries, dofs
+    // and end effectors followed by the entries
     boost::filesystem::ifstream cache_file(cache_file_name_, std::ios_base::binary | std::ios_base::in);
-    cache_file.read((char*)&last_saved_cache_size_, sizeof(unsigned int));
-    unsigned int num_dofs;
+    unsigned int num_entries = 0, num_dofs = 0, num_tips = 0;
+    cache_file.read((char*)&num_entries, sizeof(unsigned int));
     cache_file.read((char*)&num_dofs, sizeof(unsigned int));
-    unsigned int num_tips;
     cache_file.read((char*)&num_tips, sizeof(unsigned int));
-
-    ROS_INFO_NAMED("cached_ik", "Found %d IK solutions for a %d-dof system with %d end effectors in %s",
-                   last_saved_cache_size_, num_dofs, num_tips, cache_file_name_.string().c_str());
-
-    unsigned int position_size = 3 * sizeof(tf2Scalar);
-    unsigned int orientation_size = 4 * sizeof(tf2Scalar);
-    unsigned int pose_size = position_size + orientation_size;
-    unsigned int config_size = num_dofs * sizeof(double);
-    unsigned int offset_conf = pose_size * num_tips;
-    unsigned int bufsize = offset_conf + config_size;
-    char* buffer = new char[bufsize];
-    IKEntry entry;
-    entry.first.resize(num_tips);
-    entry.second.resize(num_dofs);
-    ik_cache_.reserve(last_saved_cache_size_);
-
-    for (unsigned i = 0; i < last_saved_cache_size_; ++i)
+    if (cache_file && num_dofs == num_joints_ && num_tips > 0 && num_entries <= max_cache_size_)
     {
-      unsigned int j = 0;
-      cache_file.read(buffer, bufsize);
-      for (auto& pose : entry.first)
+      const std::size_t stride = POSE_SIZE * num_tips + num_dofs;
+      std::vector<double> entries(num_entries * stride);
+      cache_file.read((char*)entries.data(), entries.size() * sizeof(double));
+      num_entries = cache_file.gcount() / (stride * sizeof(double));
+      cache_file.close();
+      ROS_INFO_NAMED("cached_ik", "Converting %d IK solutions for a %d-dof system with %d end effectors in %s",
+                     num_entries, num_dofs, num_tips, cache_file_name_.string().c_str());
+
+      try
       {
-        memcpy(&pose.position[0], buffer + j * pose_size, position_size);
-        memcpy(&pose.orientation[0], buffer + j * pose_size + position_size, orientation_size);
-        ++j;
+        storage = Storage::acquire(cache_file_name_, num_dofs, num_tips, max_cache_size_);
       }
-      memcpy(&entry.second[0], buffer + offset_conf, config_size);
-      ik_cache_.push_back(entry);
+      catch (std::exception& e)
+      {
+        ROS_WARN_NAMED("cached_ik", "Could not map %s, keeping IK cache in memory: %s",
+                       cache_file_name_.string().c_str(), e.what());
+        storage = Storage::createInMemory(num_dofs, num_tips, max_cache_size_);
+      }
+      for (unsigned int i = 0; i < num_entries; ++i)
+        storage->append(&entries[i * stride], &entries[i * stride + POSE_SIZE * num_tips]);
+      storage->flush();
     }
-    ROS_INFO_NAMED("cached_ik", "freeing buffer");
-    delete[] buffer;
-    ROS_INFO_NAMED("cached_ik", "freed buffer");
-    std::vector<IKEntry*> ik_entry_ptrs(last_saved_cache_size_);
-    for (unsigned int i = 0; i < last_saved_cache_size_; ++i)
-      ik_entry_ptrs[i] = &ik_cache_[i];
-    ik_nn_.add(ik_entry_ptrs);
+    else
+      ROS_WARN_NAMED("cached_ik", "Ignoring incompatible cache file %s", cache_file_name_.string().c_str());
   }
+  // otherwise the file is created by the first updateCache() call, when the number of end effectors is known
 
-  num_joints_ = num_joints;
+  if (storage)
+  {
+    last_saved_cache_size_ = storage->size();
+    rebuildIndex(storage);
+  }
 
   ROS_INFO_NAMED("cached_ik", "cache file %s initialized!", cache_file_name_.string().c_str());
 }
@@ -146,105 +475,143 @@ double IKCache::configDistance2(const std::vector<double>& config1, const std::v
   return dist;
 }
 
-const IKCache::IKEntry& IKCache::getBestApproximateIKSolution(const Pose& pose) const
+IKCache::IKEntry IKCache::getBestApproximateIKSolution(const Pose& pose) const
 {
-  if (ik_cache_.empty())
-  {
-    static IKEntry dummy = std::make_pair(std::vector<Pose>(1, pose), std::vector<double>(num_joints_, 0.));
-    return dummy;
-  }
-  IKEntry query = std::make_pair(std::vector<Pose>(1, pose), std::vector<double>());
-  return *ik_nn_.nearest(&query);
+  return getBestApproximateIKSolution(std::vector<Pose>(1, pose));
 }
 
-const IKCache::IKEntry& IKCache::getBestApproximateIKSolution(const std::vector<Pose>& poses) const
+IKCache::IKEntry IKCache::getBestApproximateIKSolution(const std::vector<Pose>& poses) const
 {
-  if (ik_cache_.empty())
+  std::shared_ptr<const Index> index = std::atomic_load(&index_);
+  const std::uint32_t size = index ? index->storage->size() : 0;
+  if (size == 0 || index->storage->num_tips != poses.size())
+    return std::make_pair(poses, std::vector<double>(num_joints_, 0.));
+
+  const Storage& storage = *index->storage;
+  std::vector<double> query(POSE_SIZE * poses.size());
+  flattenPoses(poses, query.data());
+
+  double best_distance = std::numeric_limits<double>::infinity();
+  std::uint32_t best_entry = 0;
+  index->nearest(index->nodes.empty() ? -1 : 0, query.data(), best_distance, best_entry);
+  // entries appended after the index was built (possibly by another process); updateCache() refreshes the index
+  for (std::uint32_t i = index->size; i < size; ++i)
   {
-    static IKEntry dummy = std::make_pair(poses, std::vector<double>(num_joints_, 0.));
-    return dummy;
+    const double d = posesDistance(query.data(), storage.poses(i), storage.num_tips);
+    if (d < best_distance)
+    {
+      best_distance = d;
+      best_entry = i;
+    }
   }
-  IKEntry query = std::make_pair(poses, std::vector<double>());
-  return *ik_nn_.nearest(&query);
+
+  return storage.entry(best_entry);
 }
 
 void IKCache::updateCache(const IKEntry& nearest, const Pose& pose, const std::vector<double>& config) const
 {
-  if (ik_cache_.size() < ik_cache_.capacity() && (nearest.first[0].distance(pose) > min_pose_distance_ ||
-                                                  configDistance2(nearest.second, config) > min_config_distance2_))
-  {
-    std::lock_guard<std::mutex> slock(lock_);
-    ik_cache_.emplace_back(std::vector<Pose>(1u, pose), config);
-    ik_nn_.add(&ik_cache_.back());
-    if (ik_cache_.size() >= last_saved_cache_size_ + 500u || ik_cache_.size() == max_cache_size_)
-      saveCache();
-  }
+  updateCache(nearest, std::vector<Pose>(1u, pose), config);
 }
 
 void IKCache::updateCache(const IKEntry& nearest, const std::vector<Pose>& poses,
                           const std::vector<double>& config) const
 {
-  if (ik_cache_.size() < ik_cache_.capacity())
+  std::shared_ptr<const Index> index = std::atomic_load(&index_);
+  bool add_to_cache = !index || index->storage->size() < index->storage->capacity;
+  if (add_to_cache && configDistance2(nearest.second, config) <= min_config_distance2_)
   {
-    bool add_to_cache = configDistance2(nearest.second, config) > min_config_distance2_;
-    if (!add_to_cache)
+    add_to_cache = false;
+    double dist = 0.;
+    for (unsigned int i = 0; i < poses.size(); ++i)
     {
-      double dist = 0.;
-      for (unsigned int i = 0; i < poses.size(); ++i)
+      dist += nearest.first[i].distance(poses[i]);
+      if (dist > min_pose_distance_)
       {
-        dist += nearest.first[i].distance(poses[i]);
-        if (dist > min_pose_distance_)
-        {
-          add_to_cache = true;
-          break;
-        }
+        add_to_cache = true;
+        break;
       }
     }
-    if (add_to_cache)
-    {
-      std::lock_guard<std::mutex> slock(lock_);
-      ik_cache_.emplace_back(poses, config);
-      ik_nn_.add(&ik_cache_.back());
-      if (ik_cache_.size() >= last_saved_cache_size_ + 500u || ik_cache_.size() == max_cache_size_)
-        saveCache();
-    }
+  }
+  if (add_to_cache)
+  {
+    std::lock_guard<std::mutex> slock(lock_);
+    addEntry(poses, config);
+  }
+  else if (index && index->storage->size() - index->size >= MAX_UNINDEXED_ENTRIES)
+  {
+    // index the entries that other processes sharing the cache file appended
+    std::lock_guard<std::mutex> slock(lock_);
+    if (std::atomic_load(&index_) == index)
+      rebuildIndex(index->storage);
   }
 }
 
-void IKCache::saveCache() const
+void IKCache::addEntry(const std::vector<Pose>& poses, const std::vector<double>& config) const
 {
-  if (cache_file_name_.empty())
-    ROS_ERROR_NAMED("cached_ik", "can't save cache before initialization");
-
-  ROS_INFO_NAMED("cached_ik", "writing %ld IK solutions to %s", ik_cache_.size(), cache_file_name_.string().c_str());
-
-  boost::filesystem::ofstream cache_file(cache_file_name_, std::ios_base::binary | std::ios_base::out);
-  unsigned int position_size = 3 * sizeof(tf2Scalar);
-  unsigned int orientation_size = 4 * sizeof(tf2Scalar);
-  unsigned int pose_size = position_size + orientation_size;
-  unsigned int num_tips = ik_cache_[0].first.size();
-  unsigned int config_size = ik_cache_[0].second.size() * sizeof(double);
-  unsigned int offset_conf = num_tips * pose_size;
-  unsigned int bufsize = offset_conf + config_size;
-  char* buffer = new char[bufsize];
-
-  // write number of IK entries and size of each configuration first
-  last_saved_cache_size_ = ik_cache_.size();
-  cache_file.write((char*)&last_saved_cache_size_, sizeof(unsigned int));
-  unsigned int sz = ik_cache_[0].second.size();
-  cache_file.write((char*)&sz, sizeof(unsigned int));
-  cache_file.write((char*)&num_tips, sizeof(unsigned int));
-  for (const auto& entry : ik_cache_)
+  std::shared_ptr<const Index> index = std::atomic_load(&index_);
+  if (!index)
   {
-    for (unsigned int i = 0; i < num_tips; ++i)
+    if (cache_file_name_.empty())
+    {
+      ROS_ERROR_NAMED("cached_ik", "can't update cache before initialization");
+      return;
+    }
+    std::shared_ptr<Storage> storage;
+    try
+    {
+      storage = Storage::acquire(cache_file_name_, config.size(), poses.size(), max_cache_size_);
+    }
+    catch (std::exception& e)
     {
-      memcpy(buffer + i * pose_size, &entry.first[i].position[0], position_size);
-      memcpy(buffer + i * pose_size + position_size, &entry.first[i].orientation[0], orientation_size);
+      ROS_WARN_NAMED("cached_ik", "Could not map %s, keeping IK cache in memory: %s", cache_file_name_.string().c_str(),
+                     e.what());
+      storage = Storage::createInMemory(config.size(), poses.size(), max_cache_size_);
     }
-    memcpy(buffer + offset_conf, &entry.second[0], config_size);
-    cache_file.write(buffer, bufsize);
+    rebuildIndex(storage);
+    index = std::atomic_load(&index_);
   }
-  delete[] buffer;
+
+  const std::shared_ptr<Storage>& storage = index->storage;
+  if (poses.size() != storage->num_tips || config.size() != storage->num_dofs)
+  {
+    ROS_ERROR_NAMED("cached_ik", "IK cache entry does not match the layout of %s", cache_file_name_.string().c_str());
+    return;
+  }
+
+  std::vector<double> flat_poses(POSE_SIZE * poses.size());
+  flattenPoses(poses, flat_poses.data());
+  if (!storage->append(flat_poses.data(), config.data()))
+    return;
+
+  const std::uint32_t size = storage->size();
+  if (size - index->size >= MAX_UNINDEXED_ENTRIES)
+    rebuildIndex(storage);
+  if (size >= last_saved_cache_size_ + 500u || size == max_cache_size_)
+    saveCache();
+}
+
+void IKCache::rebuildIndex(const std::shared_ptr<Storage>& storage) const
+{
+  auto index = std::make_shared<Index>();
+  index->storage = storage;
+  index->size = storage->size();
+  index->nodes.reserve(index->size);
+  std::vector<std::pair<double, std::uint32_t>> items(index->size);
+  for (std::uint32_t i = 0; i < index->size; ++i)
+    items[i].second = i;
+  index->build(items, 0, items.size());
+  std::atomic_store(&index_, std::shared_ptr<const Index>(std::move(index)));
+}
+
+void IKCache::saveCache() const
+{
+  std::shared_ptr<const Index> index = std::atomic_load(&index_);
+  if (!index)
+    return;
+
+  ROS_INFO_NAMED("cached_ik", "writing %d IK solutions to %s", index->storage->size(), cache_file_name_.string().c_str());
+  last_saved_cache_size_ = index->storage->size();
+  index->storage->flush();
 }
 
 void IKCache::verifyCache(kdl_kinematics_plugin::KDLKinematicsPlugin& fk) const
@@ -253,8 +620,11 @@ void IKCache::verifyCache(kdl_kinematics_plugin::KDLKinematicsPlugin& fk) const
   std::vector<geometry_msgs::Pose> poses(tip_names.size());
   double error, max_error = 0.;
 
-  for (const auto& entry : ik_cache_)
+  std::shared_ptr<const Index> index = std::atomic_load(&index_);
+  const std::uint32_t size = index ? index->storage->size() : 0;
+  for (std::uint32_t j = 0; j < size; ++j)
   {
+    const IKEntry entry = index->storage->entry(j);
     fk.getPositionFK(tip_names, entry.second, poses);
     error = 0.;
     for (unsigned int i = 0; i < poses.size(); ++i)
@@ -293,19 +663,16 @@ IKCacheMap::~IKCacheMap()
     delete cache.second;
 }
 
-const IKCache::IKEntry& IKCacheMap::getBestApproximateIKSolution(const std::vector<std::string>& fixed,
-                                                                 const std::vector<std::string>& active,
-                                                                 const std::vector<Pose>& poses) const
+IKCache::IKEntry IKCacheMap::getBestApproximateIKSolution(const std::vector<std::string>& fixed,
+                                                          const std::vector<std::string>& active,
+                                                          const std::vector<Pose>& poses) const
 {
   auto key(getKey(fixed, active));
   auto it = find(key);
   if (it != end())
     return it->second->getBestApproximateIKSolution(poses);
   else
-  {
-    static IKEntry dummy = std::make_pair(poses, std::vector<double>(num_joints_, 0.));
-    return dummy;
-  }
+    return std::make_pair(poses, std::vector<double>(num_joints_, 0.));
 }
 
 void IKCacheMap::updateCache(const IKEntry& nearest, const std::vector<std::string>& fixed,
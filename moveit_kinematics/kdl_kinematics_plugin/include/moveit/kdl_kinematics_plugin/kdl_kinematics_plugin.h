@@ -130,6 +130,12 @@ protected:
                 KDL::JntArray& q_out, const unsigned int max_iter, const Eigen::VectorXd& joint_weights,
                 const Twist& cartesian_weights) const;
 
+  /// Solve position IK given initial joint values, using the given (thread-local) FK solver
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  int CartToJnt(KDL::ChainFkSolverPos& fk_solver, KDL::ChainIkSolverVelMimicSVD& ik_solver,
+                const KDL::JntArray& q_init, const KDL::Frame& p_in, KDL::JntArray& q_out, const unsigned int max_iter,
+                const Eigen::VectorXd& joint_weights, const Twist& cartesian_weights) const;
+
 private:
   void getJointWeights();
   bool timedOut(const ros::WallTime& start_time, double duration) const;
@@ -144,6 +150,7 @@ private:
                         const Eigen::VectorXd& solution) const;
 
   void getRandomConfiguration(Eigen::VectorXd& jnt_array) const;
+  void getRandomConfiguration(random_numbers::RandomNumberGenerator& rng, Eigen::VectorXd& jnt_array) const;
 
   /** @brief Get a random configuration within consistency limits close to the seed state
    *  @param seed_state Seed state
@@ -153,6 +160,20 @@ private:
   void getRandomConfiguration(const Eigen::VectorXd& seed_state, const std::vector<double>& consistency_limits,
                               Eigen::VectorXd& jnt_array) const;
 
+  void getRandomConfiguration(random_numbers::RandomNumberGenerator& rng, const Eigen::VectorXd& seed_state,
+                              const std::vector<double>& consistency_limits, Eigen::VectorXd& jnt_array) const;
+
+  /** @brief Race num_parallel_restarts_ random-restart loops on separate threads.
+   *
+   *  Each worker owns its FK/IK solvers and random number generator. The first solution passing the
+   *  consistency check and the solution callback wins; the other workers stop before their next restart.
+   *  Calls to solution_callback are serialized, as callbacks are generally not thread-safe. */
+  bool searchPositionIKParallel(const geometry_msgs::Pose& ik_pose, const KDL::Frame& pose_desired,
+                                const KDL::JntArray& jnt_seed_state, double timeout, const ros::WallTime& start_time,
+                                const std::vector<double>& consistency_limits_mimic, std::vector<double>& solution,
+                                const IKCallbackFn& solution_callback, moveit_msgs::MoveItErrorCodes& error_code,
+                                const kinematics::KinematicsQueryOptions& options) const;
+
   /// clip q_delta such that joint limits will not be violated
   void clipToJointLimits(const KDL::JntArray& q, KDL::JntArray& q_delta, Eigen::ArrayXd& weighting) const;
 
@@ -171,6 +192,7 @@ private:
 
   int max_solver_iterations_;
   double epsilon_;
+  unsigned int num_parallel_restarts_;  ///< number of concurrent random-restart workers in searchPositionIK
   /** weight of orientation error vs position error
    *
    * < 1.0: orientation has less importance than position
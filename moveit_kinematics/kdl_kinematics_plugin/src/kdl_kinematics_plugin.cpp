@@ -45,13 +45,17 @@
 #include <kdl/frames_io.hpp>
 #include <kdl/kinfam_io.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 // register KDLKinematics as a KinematicsBase implementation
 #include <class_loader/class_loader.hpp>
 CLASS_LOADER_REGISTER_CLASS(kdl_kinematics_plugin::KDLKinematicsPlugin, kinematics::KinematicsBase)
 
 namespace kdl_kinematics_plugin
 {
-KDLKinematicsPlugin::KDLKinematicsPlugin() : initialized_(false)
+KDLKinematicsPlugin::KDLKinematicsPlugin() : initialized_(false), num_parallel_restarts_(1)
 {
 }
 
@@ -61,6 +65,20 @@ void KDLKinematicsPlugin::getRandomConfiguration(Eigen::VectorXd& jnt_array) con
   state_->copyJointGroupPositions(joint_model_group_, &jnt_array[0]);
 }
 
+void KDLKinematicsPlugin::getRandomConfiguration(random_numbers::RandomNumberGenerator& rng,
+                                                 Eigen::VectorXd& jnt_array) const
+{
+  joint_model_group_->getVariableRandomPositions(rng, &jnt_array[0]);
+}
+
+void KDLKinematicsPlugin::getRandomConfiguration(random_numbers::RandomNumberGenerator& rng,
+                                                 const Eigen::VectorXd& seed_state,
+                                                 const std::vector<double>& consistency_limits,
+                                                 Eigen::VectorXd& jnt_array) const
+{
+  joint_model_group_->getVariableRandomPositionsNearBy(rng, &jnt_array[0], &seed_state[0], consistency_limits);
+}
+
 void KDLKinematicsPlugin::getRandomConfiguration(const Eigen::VectorXd& seed_state,
                                                  const std::vector<double>& consistency_limits,
                                                  Eigen::VectorXd& jnt_array) const
@@ -201,6 +219,12 @@ bool KDLKinematicsPlugin::initialize(const moveit::core::RobotModel& robot_model
   lookupParam("epsilon", epsilon_, 1e-5);
   lookupParam("orientation_vs_position", orientation_vs_position_weight_, 1.0);
 
+  int num_parallel_restarts;
+  lookupParam("num_parallel_restarts", num_parallel_restarts, 1);
+  num_parallel_restarts_ = static_cast<unsigned int>(std::max(1, num_parallel_restarts));
+  if (num_parallel_restarts_ > 1)
+    ROS_INFO_NAMED("kdl", "Using %u parallel random restarts", num_parallel_restarts_);
+
   bool position_ik;
   lookupParam("position_only_ik", position_ik, false);
   if (position_ik)  // position_only_ik overrules orientation_vs_position
@@ -363,7 +387,6 @@ bool KDLKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
   jnt_seed_state.data = Eigen::Map<const Eigen::VectorXd>(ik_seed_state.data(), ik_seed_state.size());
   jnt_pos_in = jnt_seed_state;
 
-  KDL::ChainIkSolverVelMimicSVD ik_solver_vel(kdl_chain_, mimic_joints_, orientation_vs_position_weight_ == 0.0);
   solution.resize(dimension_);
 
   KDL::Frame pose_desired;
@@ -374,6 +397,13 @@ bool KDLKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
                                     << " " << ik_pose.orientation.x << " " << ik_pose.orientation.y << " "
                                     << ik_pose.orientation.z << " " << ik_pose.orientation.w);
 
+  // a zero timeout requests a single attempt (getPositionIK), which gains nothing from racing
+  if (num_parallel_restarts_ > 1 && timeout > 0.0)
+    return searchPositionIKParallel(ik_pose, pose_desired, jnt_seed_state, timeout, start_time,
+                                    consistency_limits_mimic, solution, solution_callback, error_code, options);
+
+  KDL::ChainIkSolverVelMimicSVD ik_solver_vel(kdl_chain_, mimic_joints_, orientation_vs_position_weight_ == 0.0);
+
   unsigned int attempt = 0;
   do
   {
@@ -418,10 +448,107 @@ bool KDLKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
   return false;
 }
 
+bool KDLKinematicsPlugin::searchPositionIKParallel(const geometry_msgs::Pose& ik_pose, const KDL::Frame& pose_desired,
+                                                   const KDL::JntArray& jnt_seed_state, double timeout,
+                                                   const ros::WallTime& start_time,
+                                                   const std::vector<double>& consistency_limits_mimic,
+                                                   std::vector<double>& solution, const IKCallbackFn& solution_callback,
+                                                   moveit_msgs::MoveItErrorCodes& error_code,
+                                                   const kinematics::KinematicsQueryOptions& options) const
+{
+  const Eigen::Map<const Eigen::VectorXd> joint_weights(joint_weights_.data(), joint_weights_.size());
+  Eigen::Matrix<double, 6, 1> cartesian_weights;
+  cartesian_weights.topRows<3>().setConstant(1.0);
+  cartesian_weights.bottomRows<3>().setConstant(orientation_vs_position_weight_);
+
+  std::atomic<bool> found(false);
+  std::atomic<unsigned int> attempts(0);
+  std::mutex callback_mutex;  // protects solution, error_code and calls to solution_callback
+
+  auto worker = [&](unsigned int index) {
+    random_numbers::RandomNumberGenerator rng;  // independently seeded per worker
+    KDL::ChainFkSolverPos_recursive fk_solver(kdl_chain_);
+    KDL::ChainIkSolverVelMimicSVD ik_solver_vel(kdl_chain_, mimic_joints_, orientation_vs_position_weight_ == 0.0);
+    KDL::JntArray jnt_pos_in(dimension_);
+    KDL::JntArray jnt_pos_out(dimension_);
+    std::vector<double> candidate(dimension_);
+    moveit_msgs::MoveItErrorCodes candidate_error_code;
+
+    bool first = true;
+    do
+    {
+      ++attempts;
+      if (first && index == 0)  // the first worker starts from the seed, all others from random states
+        jnt_pos_in = jnt_seed_state;
+      else if (!consistency_limits_mimic.empty())
+        getRandomConfiguration(rng, jnt_seed_state.data, consistency_limits_mimic, jnt_pos_in.data);
+      else
+        getRandomConfiguration(rng, jnt_pos_in.data);
+      first = false;
+
+      int ik_valid = CartToJnt(fk_solver, ik_solver_vel, jnt_pos_in, pose_desired, jnt_pos_out,
+                               max_solver_iterations_, joint_weights, cartesian_weights);
+      if (found)  // another worker already succeeded
+        return;
+      if (ik_valid != 0 && !options.return_approximate_solution)
+        continue;
+      if (!consistency_limits_mimic.empty() &&
+          !checkConsistency(jnt_seed_state.data, consistency_limits_mimic, jnt_pos_out.data))
+        continue;
+
+      Eigen::Map<Eigen::VectorXd>(candidate.data(), candidate.size()) = jnt_pos_out.data;
+      std::lock_guard<std::mutex> lock(callback_mutex);
+      if (found)
+        return;
+      if (!solution_callback.empty())
+      {
+        solution_callback(ik_pose, candidate, candidate_error_code);
+        if (candidate_error_code.val != candidate_error_code.SUCCESS)
+          continue;
+      }
+      solution = candidate;
+      found = true;
+      return;
+    } while (!found && !timedOut(start_time, timeout));
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_parallel_restarts_ - 1);
+  for (unsigned int i = 1; i < num_parallel_restarts_; ++i)
+    threads.emplace_back(worker, i);
+  worker(0);  // the calling thread participates as well
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (found)
+  {
+    error_code.val = error_code.SUCCESS;
+    ROS_DEBUG_STREAM_NAMED("kdl", "Solved after " << (ros::WallTime::now() - start_time).toSec() << " < " << timeout
+                                                  << "s and " << attempts << " attempts on " << num_parallel_restarts_
+                                                  << " threads");
+    return true;
+  }
+
+  ROS_DEBUG_STREAM_NAMED("kdl", "IK timed out after " << (ros::WallTime::now() - start_time).toSec() << " > " << timeout
+                                                      << "s and " << attempts << " attempts on "
+                                                      << num_parallel_restarts_ << " threads");
+  error_code.val = error_code.TIMED_OUT;
+  return false;
+}
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 int KDLKinematicsPlugin::CartToJnt(KDL::ChainIkSolverVelMimicSVD& ik_solver, const KDL::JntArray& q_init,
                                    const KDL::Frame& p_in, KDL::JntArray& q_out, const unsigned int max_iter,
                                    const Eigen::VectorXd& joint_weights, const Twist& cartesian_weights) const
+{
+  return CartToJnt(*fk_solver_, ik_solver, q_init, p_in, q_out, max_iter, joint_weights, cartesian_weights);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+int KDLKinematicsPlugin::CartToJnt(KDL::ChainFkSolverPos& fk_solver, KDL::ChainIkSolverVelMimicSVD& ik_solver,
+                                   const KDL::JntArray& q_init, const KDL::Frame& p_in, KDL::JntArray& q_out,
+                                   const unsigned int max_iter, const Eigen::VectorXd& joint_weights,
+                                   const Twist& cartesian_weights) const
 {
   double last_delta_twist_norm = DBL_MAX;
   double step_size = 1.0;
@@ -438,7 +565,7 @@ int KDLKinematicsPlugin::CartToJnt(KDL::ChainIkSolverVelMimicSVD& ik_solver, con
   bool success = false;
   for (i = 0; i < max_iter; ++i)
   {
-    fk_solver_->JntToCart(q_out, f);
+    fk_solver.JntToCart(q_out, f);
     delta_twist = diff(f, p_in);
     ROS_DEBUG_STREAM_NAMED("kdl", "[" << std::setw(3) << i << "] delta_twist: " << delta_twist);
 
@@ -0,0 +1,233 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <kdl/chain.hpp>
+#include <kdl/frames.hpp>
+#include <Eigen/Core>
+#include <Eigen/SVD>
+#include <vector>
+
+namespace lma_kinematics_plugin
+{
+/**
+ * Levenberg-Marquardt position IK for a KDL::Chain with a joint count known at compile time.
+ *
+ * This follows the algorithm of KDL::ChainIkSolverPos_LMA, but the Jacobian, its SVD and all
+ * joint-space vectors are fixed-size Eigen types of DOF columns/rows. Solving does not allocate.
+ * DOF may be Eigen::Dynamic, in which case the sizes are set once in the constructor.
+ */
+template <int DOF>
+class ChainIkSolverPosLMAFixed
+{
+public:
+  using JointVector = Eigen::Matrix<double, DOF, 1>;
+  using Jacobian = Eigen::Matrix<double, 6, DOF>;
+  using CartesianVector = Eigen::Matrix<double, 6, 1>;
+
+  /// same values as KDL::ChainIkSolverPos_LMA
+  enum
+  {
+    E_NOERROR = 0,
+    E_MAX_ITERATIONS_EXCEEDED = -5,
+    E_GRADIENT_JOINTS_TOO_SMALL = -100,
+    E_INCREMENT_JOINTS_TOO_SMALL = -101
+  };
+
+  /**
+   * @param chain The chain to solve for, with DOF joints. Must outlive the solver.
+   * @param weights Weights of the Cartesian error components (translation first)
+   * @param eps Convergence threshold on the weighted Cartesian error
+   * @param max_iter Maximum number of iterations
+   * @param eps_joints Convergence threshold on the joint increment and the gradient
+   */
+  ChainIkSolverPosLMAFixed(const KDL::Chain& chain, const CartesianVector& weights, double eps = 1e-5,
+                           int max_iter = 500, double eps_joints = 1e-15)
+    : chain_(chain)
+    , weights_(weights)
+    , eps_(eps)
+    , max_iter_(max_iter)
+    , eps_joints_(eps_joints)
+    , svd_(6, chain.getNrOfJoints(), Eigen::ComputeFullU | Eigen::ComputeFullV)
+    , T_base_jointroot_(chain.getNrOfJoints())
+    , T_base_jointtip_(chain.getNrOfJoints())
+  {
+    const unsigned int n = chain.getNrOfJoints();
+    // resize() only checks the size for fixed-size types
+    jac_.resize(6, n);
+    q_.resize(n);
+    q_new_.resize(n);
+    diffq_.resize(n);
+    grad_.resize(n);
+  }
+
+  /** Solve for T_base_goal starting from q_init. Returns E_NOERROR if the weighted error dropped below eps. */
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  int CartToJnt(const JointVector& q_init, const KDL::Frame& T_base_goal, JointVector& q_out)
+  {
+    double v = 2.0;
+    double lambda = 10.0;
+
+    q_ = q_init;
+    computeFwdPos(q_);
+    computeError(T_base_goal, delta_pos_);
+    double delta_pos_norm = delta_pos_.norm();
+    if (delta_pos_norm < eps_)
+    {
+      q_out = q_;
+      return E_NOERROR;
+    }
+    computeJacobian(q_);
+
+    for (int i = 0; i < max_iter_; ++i)
+    {
+      svd_.compute(jac_);
+      const Eigen::Index rank = svd_.singularValues().size();
+      singular_values_ = svd_.singularValues();
+      for (Eigen::Index j = 0; j < rank; ++j)
+        singular_values_(j) = singular_values_(j) / (singular_values_(j) * singular_values_(j) + lambda);
+      tmp_.noalias() = svd_.matrixU().template leftCols<RANK>(rank).transpose() * delta_pos_;
+      tmp_ = singular_values_.cwiseProduct(tmp_);
+      diffq_.noalias() = svd_.matrixV().template leftCols<RANK>(rank) * tmp_;
+      grad_.noalias() = jac_.transpose() * delta_pos_;
+
+      if (diffq_.template lpNorm<Eigen::Infinity>() < eps_joints_)
+      {
+        q_out = q_;
+        return E_INCREMENT_JOINTS_TOO_SMALL;
+      }
+      if (grad_.squaredNorm() < eps_joints_ * eps_joints_)
+      {
+        q_out = q_;
+        return E_GRADIENT_JOINTS_TOO_SMALL;
+      }
+
+      q_new_ = q_ + diffq_;
+      computeFwdPos(q_new_);
+      computeError(T_base_goal, delta_pos_new_);
+      const double delta_pos_new_norm = delta_pos_new_.norm();
+      const double rho = (delta_pos_norm * delta_pos_norm - delta_pos_new_norm * delta_pos_new_norm) /
+                         diffq_.dot(lambda * diffq_ + grad_);
+      if (rho > 0)
+      {
+        q_ = q_new_;
+        delta_pos_ = delta_pos_new_;
+        delta_pos_norm = delta_pos_new_norm;
+        if (delta_pos_norm < eps_)
+        {
+          q_out = q_;
+          return E_NOERROR;
+        }
+        computeJacobian(q_new_);
+        const double t = 2 * rho - 1;
+        lambda = lambda * std::max(1 / 3.0, 1 - t * t * t);
+        v = 2;
+      }
+      else
+      {
+        lambda = lambda * v;
+        v = 2 * v;
+      }
+    }
+    q_out = q_;
+    return E_MAX_ITERATIONS_EXCEEDED;
+  }
+
+private:
+  /// number of singular values of the 6 x DOF Jacobian
+  static constexpr int RANK = DOF == Eigen::Dynamic ? Eigen::Dynamic : (DOF < 6 ? DOF : 6);
+  static constexpr int MAX_RANK = RANK == Eigen::Dynamic ? 6 : RANK;
+
+  /// update T_base_head_ and the joint frames for q
+  void computeFwdPos(const JointVector& q)
+  {
+    T_base_head_ = KDL::Frame::Identity();
+    unsigned int j = 0;
+    for (const KDL::Segment& segment : chain_.segments)
+    {
+      if (segment.getJoint().getType() != KDL::Joint::None)
+      {
+        T_base_jointroot_[j] = T_base_head_;
+        T_base_head_ = T_base_head_ * segment.pose(q(j));
+        T_base_jointtip_[j] = T_base_head_;
+        ++j;
+      }
+      else
+        T_base_head_ = T_base_head_ * segment.pose(0.0);
+    }
+  }
+
+  /// Jacobian at the configuration of the last computeFwdPos(), scaled by the Cartesian weights
+  void computeJacobian(const JointVector& q)
+  {
+    unsigned int j = 0;
+    for (const KDL::Segment& segment : chain_.segments)
+    {
+      if (segment.getJoint().getType() == KDL::Joint::None)
+        continue;
+      // twist of the tip caused by joint j, in the base frame with the tip as reference point
+      const KDL::Twist t = (T_base_jointroot_[j].M * segment.twist(q(j), 1.0))
+                               .RefPoint(T_base_head_.p - T_base_jointtip_[j].p);
+      for (int k = 0; k < 6; ++k)
+        jac_(k, j) = weights_(k) * t[k];
+      ++j;
+    }
+  }
+
+  /// weighted twist from the current tip frame to the goal
+  void computeError(const KDL::Frame& T_base_goal, CartesianVector& error) const
+  {
+    const KDL::Twist t = KDL::diff(T_base_head_, T_base_goal);
+    for (int k = 0; k < 6; ++k)
+      error(k) = weights_(k) * t[k];
+  }
+
+  const KDL::Chain& chain_;
+  const CartesianVector weights_;
+  const double eps_;
+  const int max_iter_;
+  const double eps_joints_;
+
+  Eigen::JacobiSVD<Jacobian> svd_;
+  Jacobian jac_;
+  JointVector q_, q_new_, diffq_, grad_;
+  CartesianVector delta_pos_, delta_pos_new_;
+  Eigen::Matrix<double, RANK, 1, 0, MAX_RANK, 1> singular_values_, tmp_;
+
+  KDL::Frame T_base_head_;
+  std::vector<KDL::Frame> T_base_jointroot_;
+  std::vector<KDL::Frame> T_base_jointtip_;
+};
+}  // namespace lma_kinematics_plugin
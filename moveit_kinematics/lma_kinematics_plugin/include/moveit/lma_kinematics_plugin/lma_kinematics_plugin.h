@@ -124,22 +124,34 @@ private:
    *  @param solution solution configuration
    *  @return true if check succeeds
    */
-  bool checkConsistency(const Eigen::VectorXd& seed_state, const std::vector<double>& consistency_limits,
-                        const Eigen::VectorXd& solution) const;
+  bool checkConsistency(const Eigen::Ref<const Eigen::VectorXd>& seed_state,
+                        const std::vector<double>& consistency_limits,
+                        const Eigen::Ref<const Eigen::VectorXd>& solution) const;
   /** Check whether joint values satisfy joint limits */
-  bool obeysLimits(const Eigen::VectorXd& values) const;
+  bool obeysLimits(const Eigen::Ref<const Eigen::VectorXd>& values) const;
   /** Harmonize revolute joint values into the range -2 Pi .. 2 Pi */
-  void harmonize(Eigen::VectorXd& values) const;
+  void harmonize(Eigen::Ref<Eigen::VectorXd> values) const;
 
-  void getRandomConfiguration(Eigen::VectorXd& jnt_array) const;
+  void getRandomConfiguration(Eigen::Ref<Eigen::VectorXd> jnt_array) const;
 
   /** @brief Get a random configuration within consistency limits close to the seed state
    *  @param seed_state Seed state
    *  @param consistency_limits
    *  @param jnt_array Returned random configuration
    */
-  void getRandomConfiguration(const Eigen::VectorXd& seed_state, const std::vector<double>& consistency_limits,
-                              Eigen::VectorXd& jnt_array) const;
+  void getRandomConfiguration(const Eigen::Ref<const Eigen::VectorXd>& seed_state,
+                              const std::vector<double>& consistency_limits,
+                              Eigen::Ref<Eigen::VectorXd> jnt_array) const;
+
+  /** Random restart loop of searchPositionIK() for a solver working on DOF joints (Eigen::Dynamic for any count)
+   *
+   * Solver provides CartToJnt(q_init, goal, q_out) on Eigen::Matrix<double, DOF, 1> vectors. */
+  template <int DOF, typename Solver>
+  bool searchPositionIK(Solver& ik_solver, const ros::WallTime& start_time, const geometry_msgs::Pose& ik_pose,
+                        const std::vector<double>& ik_seed_state, double timeout,
+                        const std::vector<double>& consistency_limits, std::vector<double>& solution,
+                        const IKCallbackFn& solution_callback, moveit_msgs::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& options) const;
 
   bool initialized_;  ///< Internal variable that indicates whether solver is configured and ready
 
@@ -155,6 +167,8 @@ private:
 
   int max_solver_iterations_;
   double epsilon_;
+  /** use ChainIkSolverPosLMAFixed for chains with 6 or 7 joints instead of KDL::ChainIkSolverPos_LMA */
+  bool fixed_size_solver_;
   /** weight of orientation error vs position error
    *
    * < 1.0: orientation has less importance than position
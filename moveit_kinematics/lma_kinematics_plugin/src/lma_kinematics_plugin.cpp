@@ -35,6 +35,7 @@
 /* Author: Francisco Suarez-Ruiz */
 
 #include <moveit/lma_kinematics_plugin/lma_kinematics_plugin.h>
+#include <moveit/lma_kinematics_plugin/chainiksolver_pos_lma_fixed.hpp>
 #include <kdl/chainfksolverpos_recursive.hpp>
 #include <kdl/chainiksolverpos_lma.hpp>
 
@@ -49,27 +50,54 @@ CLASS_LOADER_REGISTER_CLASS(lma_kinematics_plugin::LMAKinematicsPlugin, kinemati
 
 namespace lma_kinematics_plugin
 {
+namespace
+{
+/// KDL::ChainIkSolverPos_LMA with the Eigen interface of ChainIkSolverPosLMAFixed, used for any number of joints
+class KDLSolverAdapter
+{
+public:
+  KDLSolverAdapter(const KDL::Chain& chain, const Eigen::Matrix<double, 6, 1>& weights, double eps, int max_iter)
+    : solver_(chain, weights, eps, max_iter), q_in_(chain.getNrOfJoints()), q_out_(chain.getNrOfJoints())
+  {
+  }
+
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  int CartToJnt(const Eigen::VectorXd& q_init, const KDL::Frame& goal, Eigen::VectorXd& q_out)
+  {
+    q_in_.data = q_init;
+    const int result = solver_.CartToJnt(q_in_, goal, q_out_);
+    q_out = q_out_.data;
+    return result;
+  }
+
+private:
+  KDL::ChainIkSolverPos_LMA solver_;
+  KDL::JntArray q_in_;
+  KDL::JntArray q_out_;
+};
+}  // namespace
+
 LMAKinematicsPlugin::LMAKinematicsPlugin() : initialized_(false)
 {
 }
 
-void LMAKinematicsPlugin::getRandomConfiguration(Eigen::VectorXd& jnt_array) const
+void LMAKinematicsPlugin::getRandomConfiguration(Eigen::Ref<Eigen::VectorXd> jnt_array) const
 {
   state_->setToRandomPositions(joint_model_group_);
   state_->copyJointGroupPositions(joint_model_group_, &jnt_array[0]);
 }
 
-void LMAKinematicsPlugin::getRandomConfiguration(const Eigen::VectorXd& seed_state,
+void LMAKinematicsPlugin::getRandomConfiguration(const Eigen::Ref<const Eigen::VectorXd>& seed_state,
                                                  const std::vector<double>& consistency_limits,
-                                                 Eigen::VectorXd& jnt_array) const
+                                                 Eigen::Ref<Eigen::VectorXd> jnt_array) const
 {
   joint_model_group_->getVariableRandomPositionsNearBy(state_->getRandomNumberGenerator(), &jnt_array[0],
                                                        &seed_state[0], consistency_limits);
 }
 
-bool LMAKinematicsPlugin::checkConsistency(const Eigen::VectorXd& seed_state,
+bool LMAKinematicsPlugin::checkConsistency(const Eigen::Ref<const Eigen::VectorXd>& seed_state,
                                            const std::vector<double>& consistency_limits,
-                                           const Eigen::VectorXd& solution) const
+                                           const Eigen::Ref<const Eigen::VectorXd>& solution) const
 {
   for (std::size_t i = 0; i < dimension_; ++i)
     if (fabs(seed_state(i) - solution(i)) > consistency_limits[i])
@@ -124,6 +152,7 @@ bool LMAKinematicsPlugin::initialize(const moveit::core::RobotModel& robot_model
   lookupParam("max_solver_iterations", max_solver_iterations_, 500);
   lookupParam("epsilon", epsilon_, 1e-5);
   lookupParam("orientation_vs_position", orientation_vs_position_weight_, 0.01);
+  lookupParam("fixed_size_solver", fixed_size_solver_, true);
 
   bool position_ik;
   lookupParam("position_only_ik", position_ik, false);
@@ -189,14 +218,14 @@ bool LMAKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
                           options);
 }
 
-void LMAKinematicsPlugin::harmonize(Eigen::VectorXd& values) const
+void LMAKinematicsPlugin::harmonize(Eigen::Ref<Eigen::VectorXd> values) const
 {
   size_t i = 0;
   for (auto* jm : joints_)
     jm->harmonizePosition(&values[i++]);
 }
 
-bool LMAKinematicsPlugin::obeysLimits(const Eigen::VectorXd& values) const
+bool LMAKinematicsPlugin::obeysLimits(const Eigen::Ref<const Eigen::VectorXd>& values) const
 {
   size_t i = 0;
   for (const auto& jm : joints_)
@@ -243,13 +272,37 @@ bool LMAKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
   cartesian_weights(4) = orientation_vs_position_weight_;
   cartesian_weights(5) = orientation_vs_position_weight_;
 
-  KDL::JntArray jnt_seed_state(dimension_);
-  KDL::JntArray jnt_pos_in(dimension_);
-  KDL::JntArray jnt_pos_out(dimension_);
-  jnt_seed_state.data = Eigen::Map<const Eigen::VectorXd>(ik_seed_state.data(), ik_seed_state.size());
-  jnt_pos_in = jnt_seed_state;
+  // dispatch common arm sizes to solvers with fixed-size matrices
+  if (fixed_size_solver_ && dimension_ == 6)
+  {
+    ChainIkSolverPosLMAFixed<6> ik_solver(kdl_chain_, cartesian_weights, epsilon_, max_solver_iterations_);
+    return searchPositionIK<6>(ik_solver, start_time, ik_pose, ik_seed_state, timeout, consistency_limits, solution,
+                               solution_callback, error_code, options);
+  }
+  if (fixed_size_solver_ && dimension_ == 7)
+  {
+    ChainIkSolverPosLMAFixed<7> ik_solver(kdl_chain_, cartesian_weights, epsilon_, max_solver_iterations_);
+    return searchPositionIK<7>(ik_solver, start_time, ik_pose, ik_seed_state, timeout, consistency_limits, solution,
+                               solution_callback, error_code, options);
+  }
+  KDLSolverAdapter ik_solver(kdl_chain_, cartesian_weights, epsilon_, max_solver_iterations_);
+  return searchPositionIK<Eigen::Dynamic>(ik_solver, start_time, ik_pose, ik_seed_state, timeout, consistency_limits,
+                                          solution, solution_callback, error_code, options);
+}
+
+template <int DOF, typename Solver>
+bool LMAKinematicsPlugin::searchPositionIK(Solver& ik_solver, const ros::WallTime& start_time,
+                                           const geometry_msgs::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                                           double timeout, const std::vector<double>& consistency_limits,
+                                           std::vector<double>& solution, const IKCallbackFn& solution_callback,
+                                           moveit_msgs::MoveItErrorCodes& error_code,
+                                           const kinematics::KinematicsQueryOptions& options) const
+{
+  using JointVector = Eigen::Matrix<double, DOF, 1>;
+  JointVector jnt_seed_state = Eigen::Map<const Eigen::VectorXd>(ik_seed_state.data(), ik_seed_state.size());
+  JointVector jnt_pos_in = jnt_seed_state;
+  JointVector jnt_pos_out(dimension_);
 
-  KDL::ChainIkSolverPos_LMA ik_solver_pos(kdl_chain_, cartesian_weights, epsilon_, max_solver_iterations_);
   solution.resize(dimension_);
 
   KDL::Frame pose_desired;
@@ -266,22 +319,22 @@ bool LMAKinematicsPlugin::searchPositionIK(const geometry_msgs::Pose& ik_pose, c
     if (attempt > 1)  // randomly re-seed after first attempt
     {
       if (!consistency_limits.empty())
-        getRandomConfiguration(jnt_seed_state.data, consistency_limits, jnt_pos_in.data);
+        getRandomConfiguration(jnt_seed_state, consistency_limits, jnt_pos_in);
       else
-        getRandomConfiguration(jnt_pos_in.data);
-      ROS_DEBUG_STREAM_NAMED("lma", "New random configuration (" << attempt << "): " << jnt_pos_in);
+        getRandomConfiguration(jnt_pos_in);
+      ROS_DEBUG_STREAM_NAMED("lma", "New random configuration (" << attempt << "): " << jnt_pos_in.transpose());
     }
 
-    int ik_valid = ik_solver_pos.CartToJnt(jnt_pos_in, pose_desired, jnt_pos_out);
+    int ik_valid = ik_solver.CartToJnt(jnt_pos_in, pose_desired, jnt_pos_out);
     if (ik_valid == 0 || options.return_approximate_solution)  // found acceptable solution
     {
-      harmonize(jnt_pos_out.data);
-      if (!consistency_limits.empty() && !checkConsistency(jnt_seed_state.data, consistency_limits, jnt_pos_out.data))
+      harmonize(jnt_pos_out);
+      if (!consistency_limits.empty() && !checkConsistency(jnt_seed_state, consistency_limits, jnt_pos_out))
         continue;
-      if (!obeysLimits(jnt_pos_out.data))
+      if (!obeysLimits(jnt_pos_out))
         continue;
 
-      Eigen::Map<Eigen::VectorXd>(solution.data(), solution.size()) = jnt_pos_out.data;
+      Eigen::Map<Eigen::VectorXd>(solution.data(), solution.size()) = jnt_pos_out;
       if (!solution_callback.empty())
       {
         solution_callback(ik_pose, solution, error_code);
@@ -0,0 +1,194 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/cached_ik_kinematics_plugin/cached_ik_kinematics_plugin.h>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <thread>
+
+using cached_ik_kinematics_plugin::IKCache;
+
+namespace
+{
+constexpr std::size_t NUM_JOINTS = 3;
+}  // namespace
+
+class IKCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    cache_dir_ = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("ik_cache_%%%%%%%%");
+    options_.max_cache_size = 1000;
+    options_.min_pose_distance = 0.1;
+    options_.min_joint_config_distance = 0.1;
+    options_.cached_ik_path = cache_dir_.string();
+
+    // distinct configurations, so that each of them is added to the cache
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> position(-1., 1.);
+    std::normal_distribution<double> orientation;
+    for (unsigned int i = 0; i < 500; ++i)
+    {
+      IKCache::Pose pose;
+      pose.position = tf2::Vector3(position(rng), position(rng), position(rng));
+      pose.orientation = tf2::Quaternion(orientation(rng), orientation(rng), orientation(rng), orientation(rng));
+      pose.orientation.normalize();
+      poses_.push_back(pose);
+      configs_.push_back({ double(i), position(rng), position(rng) });
+    }
+  }
+
+  void TearDown() override
+  {
+    boost::filesystem::remove_all(cache_dir_);
+  }
+
+  void initializeCache(IKCache& cache) const
+  {
+    cache.initializeCache("robot", "group", "test", NUM_JOINTS, options_);
+  }
+
+  void insert(const IKCache& cache, std::size_t begin, std::size_t end) const
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      cache.updateCache(cache.getBestApproximateIKSolution(poses_[i]), poses_[i], configs_[i]);
+  }
+
+  /** expect the cache to return the nearest of the first \e count entries to \e pose */
+  void expectNearest(const IKCache& cache, const IKCache::Pose& pose, std::size_t count) const
+  {
+    double best_distance = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < count; ++i)
+      best_distance = std::min(best_distance, pose.distance(poses_[i]));
+
+    const IKCache::IKEntry entry = cache.getBestApproximateIKSolution(pose);
+    ASSERT_EQ(entry.first.size(), 1u);
+    ASSERT_EQ(entry.second.size(), NUM_JOINTS);
+    EXPECT_NEAR(pose.distance(entry.first[0]), best_distance, 1e-9);
+    expectStoredEntry(entry);
+  }
+
+  /** expect \e entry to be one of the inserted entries */
+  void expectStoredEntry(const IKCache::IKEntry& entry) const
+  {
+    const std::size_t i = entry.second[0];
+    ASSERT_LT(i, poses_.size());
+    EXPECT_EQ(entry.second, configs_[i]);
+    EXPECT_NEAR(entry.first[0].distance(poses_[i]), 0., 1e-6);
+  }
+
+  boost::filesystem::path cache_dir_;
+  IKCache::Options options_;
+  std::vector<IKCache::Pose> poses_;
+  std::vector<std::vector<double>> configs_;
+};
+
+TEST_F(IKCacheTest, InsertAndQuery)
+{
+  IKCache cache;
+  initializeCache(cache);
+
+  // an empty cache returns the query with a zero configuration
+  IKCache::IKEntry entry = cache.getBestApproximateIKSolution(poses_[0]);
+  EXPECT_EQ(entry.second, std::vector<double>(NUM_JOINTS, 0.));
+
+  // more entries than indexed at once, so queries use both the index and the linear scan
+  insert(cache, 0, 200);
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    entry = cache.getBestApproximateIKSolution(poses_[i]);
+    EXPECT_EQ(entry.second, configs_[i]);
+  }
+  for (std::size_t i = 200; i < poses_.size(); ++i)
+    expectNearest(cache, poses_[i], 200);
+
+}
+
+TEST_F(IKCacheTest, PersistedRoundTrip)
+{
+  {
+    IKCache cache;
+    initializeCache(cache);
+    insert(cache, 0, 300);
+  }
+  std::size_t num_files = 0;
+  for (const boost::filesystem::directory_entry& file : boost::filesystem::directory_iterator(cache_dir_))
+    num_files += file.path().extension() == ".ikcache";
+  EXPECT_EQ(num_files, 1u);
+
+  IKCache cache;
+  initializeCache(cache);
+  for (std::size_t i = 0; i < 300; ++i)
+    EXPECT_EQ(cache.getBestApproximateIKSolution(poses_[i]).second, configs_[i]);
+  for (std::size_t i = 300; i < poses_.size(); ++i)
+    expectNearest(cache, poses_[i], 300);
+
+  // the loaded cache keeps growing
+  insert(cache, 300, poses_.size());
+  for (std::size_t i = 0; i < poses_.size(); ++i)
+    EXPECT_EQ(cache.getBestApproximateIKSolution(poses_[i]).second, configs_[i]);
+}
+
+TEST_F(IKCacheTest, ConcurrentReadsDuringInserts)
+{
+  IKCache cache;
+  initializeCache(cache);
+  insert(cache, 0, 1);
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (unsigned int t = 0; t < 3; ++t)
+    readers.emplace_back([&, t] {
+      // readers only ever see complete entries
+      for (std::size_t i = t; !done; i = (i + 1) % poses_.size())
+        expectStoredEntry(cache.getBestApproximateIKSolution(poses_[i]));
+    });
+  insert(cache, 1, poses_.size());
+  done = true;
+  for (std::thread& reader : readers)
+    reader.join();
+
+  for (std::size_t i = 0; i < poses_.size(); ++i)
+    EXPECT_EQ(cache.getBestApproximateIKSolution(poses_[i]).second, configs_[i]);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
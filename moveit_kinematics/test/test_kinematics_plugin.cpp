@@ -36,6 +36,7 @@
 /* Author: Jorge Nicho, Robert Haschke */
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <pluginlib/class_loader.hpp>
@@ -800,6 +801,63 @@ TEST_F(KinematicsTest, getNearestIKSolution)
   }
 }
 
+// compare the fixed-size solver of LMAKinematicsPlugin to KDL's generic LMA solver on the same queries
+TEST_F(KinematicsTest, compareFixedSizeSolver)
+{
+  int num_tests = 0;
+  if (!getParam("num_solver_comparison_tests", num_tests) || num_tests <= 0)
+    return;
+
+  // a second instance of the plugin, configured to use the generic solver
+  std::string plugin_name;
+  ASSERT_TRUE(getParam("ik_plugin_name", plugin_name));
+  ros::NodeHandle pnh("~");
+  pnh.setParam(group_name_ + "/fixed_size_solver", false);
+  kinematics::KinematicsBasePtr generic_solver = SharedData::instance().createUniqueInstance(plugin_name);
+  ASSERT_TRUE(bool(generic_solver)) << "Failed to load plugin: " << plugin_name;
+  ASSERT_TRUE(generic_solver->initialize(*robot_model_, group_name_, root_link_, { tip_link_ },
+                                         DEFAULT_SEARCH_DISCRETIZATION) ||
+              generic_solver->initialize(ROBOT_DESCRIPTION_PARAM, group_name_, root_link_, { tip_link_ },
+                                         DEFAULT_SEARCH_DISCRETIZATION))
+      << "Solver failed to initialize";
+  pnh.deleteParam(group_name_ + "/fixed_size_solver");
+
+  std::vector<double> seed = seed_;
+  seed.resize(joints_.size(), 0.0);
+  std::vector<double> fk_values, solution;
+  moveit_msgs::MoveItErrorCodes error_code;
+  const std::vector<std::string>& fk_names = kinematics_solver_->getTipFrames();
+  moveit::core::RobotState robot_state(robot_model_);
+  robot_state.setToDefaultValues();
+
+  const kinematics::KinematicsBasePtr solvers[] = { kinematics_solver_, generic_solver };
+  unsigned int success[] = { 0, 0 };
+  std::chrono::duration<double> time[] = { std::chrono::duration<double>(0), std::chrono::duration<double>(0) };
+  for (int i = 0; i < num_tests; ++i)
+  {
+    robot_state.setToRandomPositions(jmg_, this->rng_);
+    robot_state.copyJointGroupPositions(jmg_, fk_values);
+    std::vector<geometry_msgs::Pose> poses;
+    ASSERT_TRUE(getPositionFK(fk_names, fk_values, poses, robot_state));
+
+    for (std::size_t j = 0; j < 2; ++j)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      solvers[j]->searchPositionIK(poses[0], seed, timeout_, solution, error_code);
+      time[j] += std::chrono::steady_clock::now() - start;
+      if (error_code.val == error_code.SUCCESS)
+        ++success[j];
+    }
+  }
+
+  ROS_INFO_STREAM("Fixed-size solver: success rate " << (double)success[0] / num_tests << ", "
+                                                     << time[0].count() / num_tests << "s per query");
+  ROS_INFO_STREAM("Generic solver: success rate " << (double)success[1] / num_tests << ", "
+                                                  << time[1].count() / num_tests << "s per query");
+  // both follow the same algorithm, so the fixed-size solver needs to be as reliable
+  EXPECT_GE(success[0] + 0.05 * num_tests, success[1]);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -110,6 +110,9 @@ public:
     return ompldb_filename_;
   }
 
+  /** @brief Estimate the memory used by the stored states and their connections, in bytes */
+  std::size_t getMemoryUsage() const;
+
 protected:
   std::string group_;
   std::string state_space_parameterization_;
@@ -134,6 +137,7 @@ struct ConstraintApproximationConstructionOptions
     , explicit_motions(false)
     , explicit_points_resolution(0.0)
     , max_explicit_points(0)
+    , threads(1)
   {
   }
 
@@ -144,6 +148,8 @@ struct ConstraintApproximationConstructionOptions
   bool explicit_motions;
   double explicit_points_resolution;
   unsigned int max_explicit_points;
+  /// number of threads sampling states and checking connections
+  unsigned int threads;
 };
 
 struct ConstraintApproximationConstructionResults
@@ -164,8 +170,13 @@ public:
   {
   }
 
+  /** @brief Load the approximations listed in the manifest of \e path. The state files may be in the binary format
+   *  written by saveConstraintApproximations() or in OMPL's StateStorage format. */
   void loadConstraintApproximations(const std::string& path);
 
+  /** @brief Save a manifest and one binary state file per approximation to \e path. The state files contain the
+   *  serialized states followed by the indices of the connections of each state, so that they can be memory-mapped
+   *  and loaded without parsing. */
   void saveConstraintApproximations(const std::string& path);
 
   ConstraintApproximationConstructionResults
@@ -189,6 +200,9 @@ public:
 
   const ConstraintApproximationPtr& getConstraintApproximation(const moveit_msgs::Constraints& msg) const;
 
+  /** @brief Estimate the memory used by all constraint approximations, in bytes */
+  std::size_t getMemoryUsage() const;
+
 private:
   ompl::base::StateStoragePtr
   constructConstraintApproximation(ModelBasedPlanningContext* pcontext, const moveit_msgs::Constraints& constr_sampling,
@@ -0,0 +1,130 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.h>
+#include <moveit/robot_model/joint_model_group.h>
+#include <ompl/base/PlannerTerminationCondition.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/datastructures/NearestNeighbors.h>
+#include <ompl/geometric/PathGeometric.h>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+namespace ompl_interface
+{
+MOVEIT_CLASS_FORWARD(ExperienceDatabase);  // Defines ExperienceDatabasePtr, ConstPtr, WeakPtr... etc
+
+/**
+ * @brief Solution paths of past planning queries of one group, indexed by their start and goal states.
+ *
+ * Paths are stored as the group variable values of their waypoints. The database file starts with a header
+ * (magic number, version, number of variables and group name) followed by one record per path (number of
+ * waypoints and their values). New paths are appended to the file, so it is never rewritten.
+ */
+class ExperienceDatabase
+{
+public:
+  struct Statistics
+  {
+    /// number of queries that looked up experiences
+    std::size_t queries = 0;
+    /// number of queries solved by a retrieved and repaired path first
+    std::size_t hits = 0;
+    /// sum of the planning times of queries solved from scratch
+    double scratch_time = 0.0;
+    /// sum of the planning times of queries solved from experience
+    double experience_time = 0.0;
+
+    /** @brief Estimate of the total time saved by experience: mean time from scratch minus time from experience */
+    double getTimeSaved() const;
+  };
+
+  /** @brief Open the database of \e group in \e filename, loading the paths stored in it, if any */
+  ExperienceDatabase(const moveit::core::JointModelGroup* group, const std::string& filename);
+
+  const moveit::core::JointModelGroup* getJointModelGroup() const
+  {
+    return group_;
+  }
+
+  std::size_t size() const;
+
+  /** @brief Store the path given by \e waypoints (each a vector of group variable values), unless a stored path
+   *  starts and ends within \e min_distance of it already. Returns true if the path was stored. */
+  bool addPath(const std::vector<std::vector<double>>& waypoints, double min_distance = 0.0);
+
+  /** @brief Get up to \e k stored paths with start and goal states closest to \e start and \e goal */
+  void findPaths(const std::vector<double>& start, const std::vector<double>& goal, std::size_t k,
+                 std::vector<std::vector<std::vector<double>>>& paths) const;
+
+  /** @brief Record the outcome of a query that looked up experiences */
+  void recordQuery(bool hit, double time);
+
+  Statistics getStatistics() const;
+
+  /**
+   * @brief Turn \e path into a valid path by replanning its invalid parts with a local planner.
+   *
+   * The first and last state of \e path are assumed to be valid. Invalid waypoints are dropped and each invalid
+   * motion between remaining waypoints is replaced by a path planned with RRTConnect.
+   * @return true if \e path was repaired before \e ptc terminated
+   */
+  static bool repairPath(ompl::geometric::PathGeometric& path, const ompl::base::PlannerTerminationCondition& ptc);
+
+private:
+  /** The distance between the keys of two paths, given by their indices. QUERY denotes query_key_. */
+  double keyDistance(std::size_t a, std::size_t b) const;
+  const std::vector<double>& getKey(std::size_t index) const;
+  void index(std::vector<std::vector<double>> waypoints);
+  bool load();
+
+  static constexpr std::size_t QUERY = std::numeric_limits<std::size_t>::max();
+
+  const moveit::core::JointModelGroup* group_;
+  std::string filename_;
+  std::ofstream out_;
+
+  /// the waypoints of all paths and their keys: start and goal state, concatenated
+  std::vector<std::vector<std::vector<double>>> paths_;
+  std::vector<std::vector<double>> keys_;
+  mutable std::vector<double> query_key_;
+  std::shared_ptr<ompl::NearestNeighbors<std::size_t>> nn_;
+
+  Statistics statistics_;
+  mutable std::mutex lock_;
+};
+}  // namespace ompl_interface
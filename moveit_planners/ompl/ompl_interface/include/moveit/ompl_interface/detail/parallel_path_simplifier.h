@@ -0,0 +1,74 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <ompl/base/Goal.h>
+#include <ompl/base/OptimizationObjective.h>
+#include <ompl/base/PlannerTerminationCondition.h>
+#include <ompl/geometric/PathGeometric.h>
+#include <vector>
+
+namespace ompl_interface
+{
+/**
+ * @brief Simplifies solution paths on several threads and keeps the best result.
+ *
+ * Each thread runs the randomized shortcutting and smoothing of OMPL's PathSimplifier on its own copy of one of
+ * the input paths, so that the threads explore different shortcuts. Multiple input paths, like the solutions of
+ * parallel planning, are distributed over the threads and the simplified paths are hybridized at the end. No more
+ * than \e threads threads are run; with more input paths than threads, only the best ones are simplified.
+ * State validity checking must be thread-safe, as in StateValidityChecker.
+ */
+class ParallelPathSimplifier
+{
+public:
+  /** @brief Constructor
+   *  @param objective The objective to compare paths by; path length if null */
+  ParallelPathSimplifier(const ompl::base::SpaceInformationPtr& si, const ompl::base::GoalPtr& goal,
+                         const ompl::base::OptimizationObjectivePtr& objective, unsigned int threads);
+
+  /** @brief Simplify \e paths (at least one) until \e ptc terminates or all threads converged and store the
+   *  best path in \e result. */
+  void simplify(const std::vector<ompl::geometric::PathGeometric>& paths,
+                const ompl::base::PlannerTerminationCondition& ptc, ompl::geometric::PathGeometric& result,
+                bool hybridize = true) const;
+
+private:
+  ompl::base::SpaceInformationPtr si_;
+  ompl::base::GoalPtr goal_;
+  ompl::base::OptimizationObjectivePtr objective_;
+  unsigned int threads_;
+};
+}  // namespace ompl_interface
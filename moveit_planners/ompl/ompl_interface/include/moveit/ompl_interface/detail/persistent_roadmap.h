@@ -0,0 +1,219 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/collision_detection/world.h>
+#include <moveit/planning_scene/planning_scene.h>
+#include <moveit/macros/class_forward.h>
+#include <ompl/geometric/planners/prm/LazyPRM.h>
+#include <Eigen/Geometry>
+#include <unordered_map>
+
+namespace ompl_interface
+{
+/**
+ * @brief Tracks the changes of a planning scene between planning queries and tests robot states against them.
+ *
+ * The first update() takes a snapshot of the scene. Later calls compare the world objects of the new scene to
+ * the snapshot (objects are copy-on-write, so a changed object is a different pointer) and record the bounding
+ * boxes of added and modified objects as changed regions. Removed objects only free space and are ignored.
+ * Changes that can't be localized, like a modified allowed collision matrix, different link padding, octomap
+ * updates or different attached bodies, are reported as Change::ALL.
+ */
+class RoadmapSceneTracker
+{
+public:
+  enum class Change
+  {
+    NONE,
+    LOCAL,
+    ALL
+  };
+
+  /** @brief Constructor
+   *  @param group The group whose motions are checked against changed regions
+   *  @param padding Extra distance added around changed objects, on top of the link padding of the scene */
+  RoadmapSceneTracker(const moveit::core::JointModelGroup* group, double padding = 0.0);
+
+  /** @brief Compare \e scene and the attached bodies of \e start_state with the previous snapshot and replace it */
+  Change update(const planning_scene::PlanningScene& scene, const moveit::core::RobotState& start_state);
+
+  /** @brief The regions changed by the last update() */
+  const std::vector<Eigen::AlignedBox3d>& getChangedRegions() const
+  {
+    return changed_regions_;
+  }
+
+  /** @brief Compute the world-frame bounding boxes of the links moved by the group, with their attached bodies.
+   *  \e state needs up-to-date link transforms. */
+  void computeLinkBoxes(const moveit::core::RobotState& state, std::vector<Eigen::AlignedBox3d>& boxes) const;
+
+  /** @brief Grow the link boxes of two states so that they contain the links along the joint-space interpolation
+   *  between them. Returns false if the group has joints for which this can't be bounded.
+   *  @param from, to The group variable positions of the two states */
+  bool computeMotionBoxes(const double* from, const double* to, const std::vector<Eigen::AlignedBox3d>& from_boxes,
+                          const std::vector<Eigen::AlignedBox3d>& to_boxes,
+                          std::vector<Eigen::AlignedBox3d>& boxes) const;
+
+  /** @brief True if any box intersects a changed region */
+  bool intersectsChanges(const std::vector<Eigen::AlignedBox3d>& boxes) const;
+
+private:
+  struct AttachedBodySnapshot
+  {
+    std::string id;
+    std::string link;
+    std::vector<shapes::ShapeConstPtr> shapes;
+    EigenSTL::vector_Isometry3d poses;
+  };
+
+  void updateAttachedBodies(const moveit::core::RobotState& start_state);
+
+  const moveit::core::JointModelGroup* group_;
+  double padding_;
+
+  /** Links moved by the group */
+  std::vector<const moveit::core::LinkModel*> links_;
+  /** Bounding spheres (center in link frame, radius) of the attached bodies of each link in links_ */
+  std::vector<std::vector<std::pair<Eigen::Vector3d, double>>> attached_spheres_;
+  /** For each link in links_ and active joint of the group: bound on the distance between the joint origin and the
+   *  link origin, or a negative value if the joint does not move the link */
+  std::vector<std::vector<double>> path_lengths_;
+  /** For each link in links_: bound on the distance of its geometry (and attached bodies) from the link origin */
+  std::vector<double> radii_;
+  /** For each active joint of the group: its index in the group variables */
+  std::vector<std::size_t> variable_indices_;
+  /** False if path_lengths_ could not be bounded for all joints (multi-DOF or mimic joints) */
+  bool bounded_motion_;
+
+  bool has_snapshot_ = false;
+  std::map<std::string, collision_detection::World::ObjectConstPtr> objects_;
+  std::vector<AttachedBodySnapshot> attached_bodies_;
+  moveit_msgs::AllowedCollisionMatrix acm_;
+  std::map<std::string, double> link_padding_;
+
+  std::vector<Eigen::AlignedBox3d> changed_regions_;
+};
+
+MOVEIT_CLASS_FORWARD(PersistentRoadmap);  // Defines PersistentRoadmapPtr, ConstPtr, WeakPtr... etc
+
+/** @brief Interface of roadmap planners that keep their graph across planning queries in a changing scene */
+class PersistentRoadmap
+{
+public:
+  struct UpdateStatistics
+  {
+    std::size_t vertices = 0;
+    std::size_t edges = 0;
+    /** Vertices and edges with cached validity before the update */
+    std::size_t valid_vertices = 0;
+    std::size_t valid_edges = 0;
+    std::size_t invalidated_vertices = 0;
+    std::size_t invalidated_edges = 0;
+    /** Vertices and edges removed as invalid in earlier queries and added again */
+    std::size_t restored_vertices = 0;
+    std::size_t restored_edges = 0;
+  };
+
+  virtual ~PersistentRoadmap() = default;
+
+  /** @brief Prepare the roadmap for a query in \e scene, starting from \e start_state.
+   *
+   * Vertices and edges which were validated in earlier queries and may collide with objects changed since the
+   * previous call are marked for validation again. Vertices and edges which were removed as invalid after such a
+   * change are added back if later changes may have made them valid again. */
+  virtual UpdateStatistics updateScene(const planning_scene::PlanningScene& scene,
+                                       const moveit::core::RobotState& start_state) = 0;
+};
+
+/**
+ * @brief A LazyPRM (or LazyPRMstar) whose roadmap persists across queries and is selectively invalidated.
+ *
+ * LazyPRM only validates the vertices and edges of candidate paths and remembers the outcome. In a static scene
+ * this makes the roadmap reusable as is. After scene changes, updateScene() resets the remembered validity of
+ * the parts of the roadmap close to changed objects, so all other parts need no collision checks again.
+ *
+ * LazyPRM deletes the vertices and edges it finds invalid. Those which had been valid before a scene change are
+ * remembered instead, and restored by updateScene() once the objects close to them change again.
+ */
+template <typename Base>
+class PersistentLazyRoadmap : public Base, public PersistentRoadmap
+{
+public:
+  PersistentLazyRoadmap(const ompl::base::SpaceInformationPtr& si, double padding = 0.0);
+  ~PersistentLazyRoadmap() override;
+
+  ompl::base::PlannerStatus solve(const ompl::base::PlannerTerminationCondition& ptc) override;
+
+  void clear() override;
+
+  UpdateStatistics updateScene(const planning_scene::PlanningScene& scene,
+                               const moveit::core::RobotState& start_state) override;
+
+private:
+  using Vertex = typename Base::Vertex;
+
+  /** A state of the roadmap, identified by its address in the graph, and a copy which outlives its removal */
+  struct RecordedState
+  {
+    const ompl::base::State* state;
+    ompl::base::State* copy;
+  };
+  using RecordedEdge = std::pair<RecordedState, RecordedState>;
+
+  RecordedState recordState(const ompl::base::State* state) const;
+
+  /** Find the vertex of \e recorded if it is still part of the roadmap */
+  bool findVertex(const std::unordered_map<const ompl::base::State*, Vertex>& vertices, const RecordedState& recorded,
+                  Vertex& vertex) const;
+
+  /** Forget the pending elements validated by the last query and move the ones it removed to the removed ones */
+  void updateRecords();
+
+  void freeRecords();
+
+  double padding_;
+  std::unique_ptr<RoadmapSceneTracker> tracker_;
+
+  /** Vertices and edges which had been valid before updateScene() reset their validity, and are not validated
+   *  again yet */
+  std::vector<RecordedState> pending_vertices_;
+  std::vector<RecordedEdge> pending_edges_;
+
+  /** Vertices and edges which had been valid before a scene change and were removed as invalid since */
+  std::vector<RecordedState> removed_vertices_;
+  std::vector<RecordedEdge> removed_edges_;
+};
+}  // namespace ompl_interface
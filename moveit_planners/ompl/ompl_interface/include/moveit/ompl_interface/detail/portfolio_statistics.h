@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.h>
+#include <ompl/base/Planner.h>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ompl_interface
+{
+MOVEIT_CLASS_FORWARD(PortfolioStatistics);  // Defines PortfolioStatisticsPtr, ConstPtr, WeakPtr... etc
+
+/** @brief Outcomes of planner portfolio races, shared by the planning contexts of one planner configuration.
+ *
+ * A portfolio runs different planners concurrently on the same problem and keeps the first exact solution.
+ * Tuning a portfolio means dropping planners that rarely win and adding planners for the queries it loses. */
+class PortfolioStatistics
+{
+public:
+  struct Record
+  {
+    /// number of races the planner took part in
+    std::size_t runs = 0;
+    /// number of races the planner found the first exact solution in
+    std::size_t wins = 0;
+    /// sum of the times [s] until the winning solutions of this planner
+    double win_time = 0.0;
+  };
+
+  /** @brief Record a race between \e planners, won by \e winner after \e time seconds.
+   *  An empty \e winner means that no planner found an exact solution. */
+  void recordRace(const std::vector<std::string>& planners, const std::string& winner, double time);
+
+  /** @brief Number of recorded races, including those without a winner */
+  std::size_t getRaceCount() const;
+
+  /** @brief The records of all planners that took part in a race, by planner type */
+  std::map<std::string, Record> getRecords() const;
+
+  void print(std::ostream& out) const;
+
+private:
+  mutable std::mutex lock_;
+  std::size_t races_ = 0;
+  std::map<std::string, Record> records_;
+};
+
+/** @brief Run \e planners concurrently until one of them finds an exact solution, which stops all others, or \e ptc
+ *  terminates. The planners need to be set up.
+ *  @param status Receives the status each planner returned
+ *  @param time Receives the time [s] until the first exact solution
+ *  @return The index of the planner that found the first exact solution, or planners.size() if none did */
+std::size_t racePlanners(const std::vector<ompl::base::PlannerPtr>& planners,
+                         const ompl::base::PlannerTerminationCondition& ptc,
+                         std::vector<ompl::base::PlannerStatus>& status, double& time);
+}  // namespace ompl_interface
@@ -51,7 +51,11 @@ namespace ompl_interface
 {
 class ModelBasedPlanningContext;
 
-/** ProjectionEvaluatorLinkPose */
+/** ProjectionEvaluatorLinkPose
+ *
+ * Projects states to the position of a link. The position is reused if it was memoized in the state when
+ * forward kinematics was computed for it, e.g. by the state validity checker. Otherwise only the transforms
+ * on the kinematic chain to the link are computed. */
 class ProjectionEvaluatorLinkPose : public ompl::base::ProjectionEvaluator
 {
 public:
@@ -38,7 +38,11 @@
 
 #include <moveit/ompl_interface/detail/threadsafe_state_storage.h>
 #include <moveit/collision_detection/collision_common.h>
+#include <moveit/collision_detection_fcl/collision_common.h>
+#include <moveit/planning_scene/planning_scene.h>
 #include <ompl/base/StateValidityChecker.h>
+#include <boost/thread/tss.hpp>
+#include <memory>
 
 namespace ompl_interface
 {
@@ -74,7 +78,57 @@ public:
 
   void setVerbose(bool flag);
 
+  /** @brief Check the following states of the calling thread, until endMotion(), as states along a motion.
+   *
+   * Nearby invalid states, like those along a motion, usually collide with the same obstacle. Within a motion,
+   * the shapes of the two bodies found in the last collision of the thread are tested against each other first,
+   * without a broad-phase over the scene, which finds these collisions with a few narrow-phase tests of FCL. Only
+   * if they don't collide, the state is checked against the whole scene. Unrelated states, like samples, are
+   * checked as usual. The collision memory is only used with the FCL collision detector. */
+  void beginMotion() const;
+  void endMotion() const;
+
+  /** @brief Number of states the calling thread checked against the whole scene for collisions */
+  std::size_t getSceneCollisionCheckCount() const;
+
 protected:
+  /** The shapes of one body of a remembered colliding pair */
+  struct CollisionBody
+  {
+    collision_detection::BodyType type = collision_detection::BodyTypes::ROBOT_LINK;
+    std::string name;
+    const moveit::core::LinkModel* link = nullptr;
+    /** Keeps the shapes of a world object alive */
+    collision_detection::World::ObjectConstPtr object;
+    std::vector<collision_detection::FCLGeometryConstPtr> geometry;
+    /** Index of the shape of each geometry within its body */
+    std::vector<std::size_t> shape_indices;
+  };
+
+  struct CollisionMemory
+  {
+    /** Number of nested beginMotion() calls */
+    unsigned int motions = 0;
+    std::size_t scene_checks = 0;
+    /** The remembered pair is only valid for this scene and world version */
+    const planning_scene::PlanningScene* scene = nullptr;
+    std::size_t world_version = 0;
+    bool has_pair = false;
+    CollisionBody bodies[2];
+  };
+
+  /** @brief Check \e robot_state for collisions, using the collision memory within motions */
+  bool isColliding(moveit::core::RobotState& robot_state, bool verbose) const;
+
+  /** @brief Remember the bodies of \e contact, if their collision is not allowed conditionally */
+  void rememberPair(const planning_scene::PlanningScene& scene, const moveit::core::RobotState& robot_state,
+                    const collision_detection::Contact& contact, CollisionMemory& memory) const;
+
+  /** @brief Test the shapes of the remembered pair against each other */
+  bool isPairColliding(const moveit::core::RobotState& robot_state, const CollisionMemory& memory) const;
+
+  CollisionMemory* getCollisionMemory() const;
+
   const ModelBasedPlanningContext* planning_context_;
   std::string group_name_;
   TSStateStorage tss_;
@@ -84,6 +138,9 @@ protected:
   collision_detection::CollisionRequest collision_request_with_distance_verbose_;
 
   collision_detection::CollisionRequest collision_request_with_cost_;
+  collision_detection::CollisionRequest collision_request_with_contact_;
   bool verbose_;
+
+  mutable boost::thread_specific_ptr<CollisionMemory> collision_memory_;
 };
 }  // namespace ompl_interface
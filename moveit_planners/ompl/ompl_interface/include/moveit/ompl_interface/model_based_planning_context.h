@@ -37,6 +37,8 @@
 #pragma once
 
 #include <moveit/ompl_interface/parameterization/model_based_state_space.h>
+#include <moveit/ompl_interface/detail/portfolio_statistics.h>
+#include <moveit/ompl_interface/detail/experience_database.h>
 #include <moveit/constraint_samplers/constraint_sampler_manager.h>
 #include <moveit/planning_interface/planning_interface.h>
 
@@ -45,6 +47,8 @@
 #include <ompl/tools/multiplan/ParallelPlan.h>
 #include <ompl/base/StateStorage.h>
 
+#include <atomic>
+
 namespace ompl_interface
 {
 namespace ob = ompl::base;
@@ -68,6 +72,12 @@ struct ModelBasedPlanningContextSpecification
 
   ModelBasedStateSpacePtr state_space_;
   og::SimpleSetupPtr ompl_simple_setup_;  // pass in the correct simple setup type
+
+  /// statistics of portfolio races, shared by the contexts of the same configuration
+  PortfolioStatisticsPtr portfolio_statistics_;
+
+  /// past solutions to retrieve and repair, if experience-based planning is configured
+  ExperienceDatabasePtr experience_database_;
 };
 
 class ModelBasedPlanningContext : public planning_interface::PlanningContext
@@ -275,7 +285,8 @@ public:
 
   /* @brief Solve the planning problem. Return true if the problem is solved
      @param timeout The time to spend on solving
-     @param count The number of runs to combine the paths of, in an attempt to generate better quality paths
+     @param count The number of runs to combine the paths of, in an attempt to generate better quality paths.
+     Ignored if the configuration specifies a planner portfolio, which runs each of its planners once.
   */
   const moveit_msgs::MoveItErrorCodes solve(double timeout, unsigned int count);
 
@@ -299,7 +310,8 @@ public:
     return last_simplify_time_;
   }
 
-  /* @brief Apply smoothing and try to simplify the plan
+  /* @brief Apply smoothing and try to simplify the plan. With simplification_threads set, all exact solutions are
+     simplified in parallel and the best (hybridized) path is kept.
      @param timeout The amount of time allowed to be spent on simplifying the plan*/
   void simplifySolution(double timeout);
 
@@ -312,9 +324,25 @@ public:
   void convertPath(const og::PathGeometric& pg, robot_trajectory::RobotTrajectory& traj) const;
 
   /** @brief Look up param server 'constraint_approximations' and use its value as the path to load constraint
-   * approximations to */
+   * approximations to. Approximations which were already loaded from that path are kept. */
   bool loadConstraintApproximations(const ros::NodeHandle& nh);
 
+  /** @brief Estimate the memory used by this context in bytes: its states, the constraint approximations and the
+   * states and connections its planners keep, such as persistent or multi-query roadmaps and the data of the
+   * portfolio planners */
+  std::size_t getMemoryUsage() const;
+
+  /** @brief Compute getMemoryUsage() and store the result for getStoredMemoryUsage(). This is done at the end of
+   * each solve(). */
+  std::size_t storeMemoryUsage();
+
+  /** @brief Get the estimate of getMemoryUsage() stored last, without computing it. This is safe while the context is
+   * in use. */
+  std::size_t getStoredMemoryUsage() const
+  {
+    return stored_memory_usage_;
+  }
+
   /** @brief Look up param server 'constraint_approximations' and use its value as the path to save constraint
    * approximations to */
   bool saveConstraintApproximations(const ros::NodeHandle& nh);
@@ -371,6 +399,21 @@ protected:
   void registerTerminationCondition(const ob::PlannerTerminationCondition& ptc);
   void unregisterTerminationCondition();
 
+  /** \brief Race the planners of the portfolio on the problem of ompl_simple_setup_.
+   *
+   * The first exact solution terminates the other planners. */
+  ob::PlannerStatus solvePortfolio(const ob::PlannerTerminationCondition& ptc);
+
+  /** \brief Race planning from scratch against retrieving and repairing paths from the experience database */
+  ob::PlannerStatus solveWithExperience(const ob::PlannerTerminationCondition& ptc);
+
+  /** \brief Retrieve paths for the current problem from the experience database and add the first one that can
+   * be repaired as a solution */
+  bool solveFromExperience(const ob::PlannerTerminationCondition& ptc);
+
+  /** \brief Add the current solution path to the experience database */
+  void storeExperience();
+
   /** \brief Convert OMPL PlannerStatus to moveit_msgs::msg::MoveItErrorCode */
   int32_t errorCode(const ompl::base::PlannerStatus& status);
 
@@ -399,6 +442,9 @@ protected:
   /// the time spent computing the last plan
   double last_plan_time_;
 
+  /// the estimate of getMemoryUsage() stored last
+  std::atomic<std::size_t> stored_memory_usage_;
+
   /// the time spent simplifying the last plan
   double last_simplify_time_;
 
@@ -428,6 +474,8 @@ protected:
   bool multi_query_planning_enabled_;
 
   ConstraintsLibraryPtr constraints_library_;
+  /// the path constraints_library_ was loaded from
+  std::string constraints_library_path_;
 
   bool simplify_solutions_;
 
@@ -436,5 +484,23 @@ protected:
 
   // if false parallel plan returns the first solution found
   bool hybridize_;
+
+  // if true motions are checked by LazyMotionValidator, otherwise by OMPL's DiscreteMotionValidator (default)
+  bool lazy_motion_validation_;
+
+  /// if larger than one, solution paths are simplified on this many threads and the best result is kept
+  unsigned int simplification_threads_;
+
+  /// planner types and allocators of the portfolio raced by solve(), if any
+  std::vector<std::pair<std::string, ConfiguredPlannerAllocator>> portfolio_;
+
+  /// planner instances of the portfolio, in the order of portfolio_; allocated by the first race and then reused
+  std::vector<ob::PlannerPtr> portfolio_planners_;
+
+  /// number of stored paths to try to repair per query
+  unsigned int experience_candidates_;
+
+  /// minimum distance of the start and goal states of a new path to those of stored paths
+  double experience_min_distance_;
 };
 }  // namespace ompl_interface
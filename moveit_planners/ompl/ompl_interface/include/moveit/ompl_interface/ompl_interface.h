@@ -138,6 +138,10 @@ protected:
   /** @brief Load the additional plugins for sampling constraints */
   void loadConstraintSamplers();
 
+  /** @brief Read the limits of the planning context cache and start building the contexts listed in
+   * 'warm_up_planner_configs' */
+  void loadContextCacheSettings();
+
   void configureContext(const ModelBasedPlanningContextPtr& context) const;
 
   /** \brief Configure the OMPL planning context for a new planning request */
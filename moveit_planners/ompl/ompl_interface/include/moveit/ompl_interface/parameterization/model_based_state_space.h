@@ -83,10 +83,12 @@ public:
       GOAL_DISTANCE_KNOWN = 2,
       VALIDITY_TRUE = 4,
       IS_START_STATE = 8,
-      IS_GOAL_STATE = 16
+      IS_GOAL_STATE = 16,
+      LINK_POSITION_KNOWN = 32
     };
 
-    StateType() : ompl::base::State(), values(nullptr), tag(-1), flags(0), distance(0.0)
+    StateType()
+      : ompl::base::State(), values(nullptr), tag(-1), flags(0), distance(0.0), link_position{ 0.0, 0.0, 0.0 }
     {
     }
 
@@ -160,10 +162,30 @@ public:
       flags |= IS_GOAL_STATE;
     }
 
+    bool isLinkPositionKnown() const
+    {
+      return flags & LINK_POSITION_KNOWN;
+    }
+
+    void setLinkPosition(const Eigen::Vector3d& position)
+    {
+      link_position[0] = position.x();
+      link_position[1] = position.y();
+      link_position[2] = position.z();
+      flags |= LINK_POSITION_KNOWN;
+    }
+
+    void clearLinkPosition()
+    {
+      flags &= ~LINK_POSITION_KNOWN;
+    }
+
     double* values;
     int tag;
     int flags;
     double distance;
+    /// the position of the state space's cached link, if LINK_POSITION_KNOWN is set
+    double link_position[3];
   };
 
   ModelBasedStateSpace(ModelBasedStateSpaceSpecification spec);
@@ -179,6 +201,18 @@ public:
     distance_function_ = fun;
   }
 
+  /** @brief Set the link whose global position is stored in a state whenever copyToRobotState() computes
+   *  forward kinematics for it, e.g. the link of a projection evaluator */
+  void setCachedLink(const moveit::core::LinkModel* link)
+  {
+    cached_link_ = link;
+  }
+
+  const moveit::core::LinkModel* getCachedLink() const
+  {
+    return cached_link_;
+  }
+
   ompl::base::State* allocState() const override;
   void freeState(ompl::base::State* state) const override;
   unsigned int getDimension() const override;
@@ -233,6 +267,12 @@ public:
     return spec_.joint_bounds_;
   }
 
+  /// Return true if distance() and interpolate() operate on all variables at once instead of calling the joint models
+  bool isVectorized() const
+  {
+    return vectorized_;
+  }
+
   /// Copy the data from an OMPL state to a set of joint states.
   // The joint states \b must be specified in the same order as the joint models in the constructor
   virtual void copyToRobotState(moveit::core::RobotState& rstate, const ompl::base::State* state) const;
@@ -266,6 +306,16 @@ protected:
 
   InterpolationFunction interpolation_function_;
   DistanceFunction distance_function_;
+  const moveit::core::LinkModel* cached_link_;
+
+  /// true if the group consists of single-variable revolute and prismatic joints only, without mimic joints
+  bool vectorized_;
+  /// the distance factor of each variable, if vectorized
+  std::vector<double> distance_factors_;
+  /// the wrap-around period of each variable (infinity for bounded joints), if vectorized
+  std::vector<double> periods_;
+  /// the indices of the continuous revolute joints, if vectorized
+  std::vector<unsigned int> continuous_variables_;
 
   double tag_snap_to_segment_;
   double tag_snap_to_segment_complement_;
@@ -43,8 +43,11 @@
 
 #include <ompl/base/PlannerDataStorage.h>
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <mutex>
+#include <thread>
 
 namespace ompl_interface
 {
@@ -62,16 +65,23 @@ private:
   template <typename T>
   ob::PlannerPtr allocatePlannerImpl(const ob::SpaceInformationPtr& si, const std::string& new_name,
                                      const ModelBasedPlanningContextSpecification& spec, bool load_planner_data = false,
-                                     bool store_planner_data = false, const std::string& file_path = "");
+                                     bool store_planner_data = false, const std::string& file_path = "",
+                                     bool persistent_roadmap = false, double roadmap_padding = 0.0);
 
   template <typename T>
   inline ob::Planner* allocatePersistentPlanner(const ob::PlannerData& data);
 
+  template <typename T>
+  inline ob::Planner* allocatePersistentRoadmap(const ob::SpaceInformationPtr& si, double padding);
+
   // Storing multi-query planners
   std::map<std::string, ob::PlannerPtr> planners_;
 
   std::map<std::string, std::string> planner_data_storage_paths_;
 
+  // Planning contexts are warmed up and requested concurrently
+  std::mutex planners_lock_;
+
   // Store and load planner data
   ob::PlannerDataStorage storage_;
 };
@@ -169,6 +179,32 @@ public:
     return robot_model_;
   }
 
+  /** \brief Set the maximum number of cached planning contexts, or 0 for no limit (the default).
+   *
+   * When there are more contexts, the least recently used ones that are not in use are dropped. */
+  void setMaximumCachedContexts(std::size_t count);
+
+  /** \brief Set the maximum estimated memory of the cached planning contexts in bytes, or 0 for no limit (the
+   * default). The estimate of each context is the one it stored when it was last handed out or finished solving, see
+   * ModelBasedPlanningContext::getStoredMemoryUsage(). */
+  void setMaximumCachedContextsMemory(std::size_t bytes);
+
+  /** \brief Get the estimated memory of all cached planning contexts in bytes */
+  std::size_t getCachedContextsMemory() const;
+
+  /** \brief Get the number of cached planning contexts, including the ones in use */
+  std::size_t getCachedContextsCount() const;
+
+  /** \brief Build the planning contexts of the planner configurations \e config_names in \e threads background
+   * threads, so that the first requests for them don't need to construct state spaces or load constraint
+   * approximations. The contexts may be built while other contexts are requested; a warmed up context is only handed
+   * out once it is ready. The threads use copies of the planner configurations taken by this call. */
+  void warmUpContexts(const std::vector<std::string>& config_names, const ros::NodeHandle& nh,
+                      bool use_constraints_approximations, unsigned int threads = 1);
+
+  /** \brief Wait for the contexts of previous calls to warmUpContexts() */
+  void waitForWarmUp();
+
   /** \brief Returns a planning context to OMPLInterface, which in turn passes it to OMPLPlannerManager.
    *
    * This function checks the input and reads planner specific configurations.
@@ -205,6 +241,9 @@ public:
 
   ConfiguredPlannerSelector getPlannerSelector() const;
 
+  /** \brief Get the win statistics of the planner portfolio of the configuration \e config_name, if it raced before */
+  PortfolioStatisticsConstPtr getPortfolioStatistics(const std::string& config_name) const;
+
 protected:
   ConfiguredPlannerAllocator plannerSelector(const std::string& planner) const;
 
@@ -214,6 +253,13 @@ protected:
   template <typename T>
   void registerPlannerAllocatorHelper(const std::string& planner_id);
 
+  /** \brief Build and configure the context of the planner configuration \e config */
+  void warmUpContext(const planning_interface::PlannerConfigurationSettings& config, const ros::NodeHandle& nh,
+                     bool use_constraints_approximations) const;
+
+  /** \brief Drop least recently used contexts that are not in use until the cache is within its limits */
+  void evictCachedContexts() const;
+
   /** \brief This is the function that constructs new planning contexts if no previous ones exist that are suitable */
   ModelBasedPlanningContextPtr getPlanningContext(const planning_interface::PlannerConfigurationSettings& config,
                                                   const ModelBasedStateSpaceFactoryPtr& factory) const;
@@ -261,6 +307,15 @@ protected:
   /// Multi-query planner allocator
   MultiQueryPlannerAllocator planner_allocator_;
 
+  /// maximum number of cached planning contexts; 0 for no limit
+  std::size_t max_cached_contexts_;
+
+  /// maximum estimated memory of the cached planning contexts in bytes; 0 for no limit
+  std::size_t max_cached_contexts_memory_;
+
+  std::vector<std::thread> warm_up_threads_;
+  std::atomic<bool> cancel_warm_up_;
+
 private:
   MOVEIT_STRUCT_FORWARD(CachedContexts);
   CachedContextsPtr cached_contexts_;
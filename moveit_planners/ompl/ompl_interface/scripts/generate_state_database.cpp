@@ -48,6 +48,7 @@
 
 #include <boost/math/constants/constants.hpp>
 #include <sstream>
+#include <thread>
 
 constexpr char LOGNAME[] = "generate_state_database";
 
@@ -73,6 +74,9 @@ struct GenerateStateDatabaseParameters
     construction_opts.explicit_points_resolution = nh.param("explicit_points_resolution", 0.05);
     construction_opts.max_explicit_points = nh.param("max_explicit_points", 200);
 
+    // number of threads sampling states and checking connections
+    construction_opts.threads = nh.param("threads", static_cast<int>(std::thread::hardware_concurrency()));
+
     // local planning in JointModel state space
     construction_opts.state_space_parameterization =
         nh.param<std::string>("state_space_parameterization", "JointModel");
@@ -36,9 +36,20 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <numeric>
+#include <omp.h>
 #include <moveit/ompl_interface/detail/constrained_sampler.h>
 #include <moveit/ompl_interface/detail/constraints_library.h>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
+#include <moveit/constraint_samplers/default_constraint_samplers.h>
+#include <moveit/constraint_samplers/union_constraint_sampler.h>
 #include <moveit/profiler/profiler.h>
 #include <ompl/tools/config/SelfConfig.h>
 #include <utility>
@@ -79,6 +90,164 @@ void hexToMsg(const std::string& hex, T& msg)
   ros::serialization::IStream stream_arg(buffer_arg.get(), serial_size_arg);
   ros::serialization::deserialize(stream_arg, msg);
 }
+
+// Samplers which may call an IK solver. The solver instances of a group are shared by all samplers for it and are
+// not thread-safe.
+bool usesKinematicsSolver(const constraint_samplers::ConstraintSampler& sampler)
+{
+  if (dynamic_cast<const constraint_samplers::JointConstraintSampler*>(&sampler))
+    return false;
+  if (const auto* union_sampler = dynamic_cast<const constraint_samplers::UnionConstraintSampler*>(&sampler))
+  {
+    for (const constraint_samplers::ConstraintSamplerPtr& s : union_sampler->getSamplers())
+      if (usesKinematicsSolver(*s))
+        return true;
+    return false;
+  }
+  return true;
+}
+
+// Binary state files consist of this header followed by 8-byte aligned sections:
+// the serialized states, the offsets of the connection list of each state (state_count + 1 values),
+// the connections, the offsets of the explicit motions of each state (state_count + 1 values)
+// and the explicit motions as triplets of connected state, first and last index of the stored motion states.
+struct BinaryHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t state_size;
+  std::uint64_t state_count;
+  std::uint64_t connection_count;
+  std::uint64_t motion_count;
+};
+
+constexpr char BINARY_MAGIC[8] = { 'M', 'V', 'T', 'C', 'A', 'P', 'D', 'B' };
+constexpr std::uint32_t BINARY_VERSION = 1;
+
+std::size_t alignedSize(std::size_t bytes)
+{
+  return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+bool isBinaryStateFile(const std::string& filename)
+{
+  char magic[sizeof(BINARY_MAGIC)];
+  std::ifstream fin(filename, std::ios::binary);
+  return fin.read(magic, sizeof(magic)) && memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+bool storeBinaryStateFile(const std::string& filename, const ConstraintApproximationStateStorage& storage)
+{
+  const ob::StateSpacePtr& space = storage.getStateSpace();
+  BinaryHeader header;
+  memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  header.version = BINARY_VERSION;
+  header.state_size = space->getSerializationLength();
+  header.state_count = storage.size();
+
+  std::vector<char> states(alignedSize(header.state_size * header.state_count), 0);
+  std::vector<std::uint64_t> connection_offsets(1, 0), connections, motion_offsets(1, 0), motions;
+  for (std::size_t i = 0; i < storage.size(); ++i)
+  {
+    space->serialize(states.data() + i * header.state_size, storage.getState(i));
+    const ConstrainedStateMetadata& metadata = storage.getMetadata(i);
+    connections.insert(connections.end(), metadata.first.begin(), metadata.first.end());
+    connection_offsets.push_back(connections.size());
+    for (const std::pair<const std::size_t, std::pair<std::size_t, std::size_t>>& motion : metadata.second)
+      motions.insert(motions.end(), { motion.first, motion.second.first, motion.second.second });
+    motion_offsets.push_back(motions.size() / 3);
+  }
+  header.connection_count = connections.size();
+  header.motion_count = motions.size() / 3;
+
+  std::ofstream fout(filename, std::ios::binary);
+  fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  fout.write(states.data(), states.size());
+  for (const std::vector<std::uint64_t>* section : { &connection_offsets, &connections, &motion_offsets, &motions })
+    fout.write(reinterpret_cast<const char*>(section->data()), section->size() * sizeof(std::uint64_t));
+  return fout.good();
+}
+
+bool loadBinaryStateFile(const std::string& filename, ConstraintApproximationStateStorage& storage)
+{
+  boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+  boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+  const char* data = static_cast<const char*>(region.get_address());
+
+  BinaryHeader header;
+  if (region.get_size() < sizeof(header))
+    return false;
+  memcpy(&header, data, sizeof(header));
+  const ob::StateSpacePtr& space = storage.getStateSpace();
+  if (header.version != BINARY_VERSION || header.state_size != space->getSerializationLength())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "State file '%s' has version %u and states of %u bytes, expected version %u and %u bytes",
+                    filename.c_str(), header.version, header.state_size, BINARY_VERSION,
+                    space->getSerializationLength());
+    return false;
+  }
+  // the counts of a corrupt header could overflow the expected file size
+  const std::size_t max_count = region.get_size() / sizeof(std::uint64_t);
+  if (header.state_count > max_count || header.connection_count > max_count || header.motion_count > max_count ||
+      header.state_count > region.get_size() / std::max<std::uint32_t>(header.state_size, 1))
+  {
+    ROS_ERROR_NAMED(LOGNAME, "State file '%s' is truncated or corrupt", filename.c_str());
+    return false;
+  }
+  const std::size_t states_size = alignedSize(header.state_size * header.state_count);
+  const std::size_t index_size =
+      (2 * (header.state_count + 1) + header.connection_count + 3 * header.motion_count) * sizeof(std::uint64_t);
+  if (region.get_size() != sizeof(header) + states_size + index_size)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "State file '%s' is truncated or corrupt", filename.c_str());
+    return false;
+  }
+
+  // the sections are 8-byte aligned within the page-aligned mapping
+  const char* states = data + sizeof(header);
+  const auto* connection_offsets = reinterpret_cast<const std::uint64_t*>(states + states_size);
+  const std::uint64_t* connections = connection_offsets + header.state_count + 1;
+  const std::uint64_t* motion_offsets = connections + header.connection_count;
+  const std::uint64_t* motions = motion_offsets + header.state_count + 1;
+
+  // offsets need to partition their section, and all indices need to refer to stored states
+  const auto valid_offsets = [&header](const std::uint64_t* offsets, std::uint64_t count) {
+    if (offsets[0] != 0 || offsets[header.state_count] != count)
+      return false;
+    for (std::size_t i = 0; i < header.state_count; ++i)
+      if (offsets[i + 1] < offsets[i])
+        return false;
+    return true;
+  };
+  bool valid = valid_offsets(connection_offsets, header.connection_count) &&
+               valid_offsets(motion_offsets, header.motion_count);
+  for (std::size_t i = 0; valid && i < header.connection_count; ++i)
+    valid = connections[i] < header.state_count;
+  for (std::size_t i = 0; valid && i < header.motion_count; ++i)
+  {
+    const std::uint64_t* motion = motions + 3 * i;
+    valid = motion[0] < header.state_count && motion[1] <= motion[2] && motion[2] <= header.state_count;
+  }
+  if (!valid)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "State file '%s' has invalid connections or motions", filename.c_str());
+    return false;
+  }
+
+  ob::State* state = space->allocState();
+  for (std::size_t i = 0; i < header.state_count; ++i)
+  {
+    space->deserialize(state, states + i * header.state_size);
+    storage.addState(state);
+    ConstrainedStateMetadata& metadata = storage.getMetadata(i);
+    metadata.first.assign(connections + connection_offsets[i], connections + connection_offsets[i + 1]);
+    for (const std::uint64_t* motion = motions + 3 * motion_offsets[i]; motion != motions + 3 * motion_offsets[i + 1];
+         motion += 3)
+      metadata.second.emplace_hint(metadata.second.end(), motion[0], std::make_pair(motion[1], motion[2]));
+  }
+  space->freeState(state);
+  return true;
+}
 }  // namespace
 
 class ConstraintApproximationStateSampler : public ob::StateSampler
@@ -222,6 +391,21 @@ ompl_interface::ConstraintApproximation::ConstraintApproximation(
     milestones_ = state_storage_->size();
 }
 
+std::size_t ompl_interface::ConstraintApproximation::getMemoryUsage() const
+{
+  // the states, the pointers to them, and the indices of connected states in their metadata
+  const std::size_t state_bytes = state_storage_->getStateSpace()->getSerializationLength() +
+                                  sizeof(ompl::base::State*) + sizeof(ConstrainedStateMetadata);
+  std::size_t bytes = sizeof(*this) + state_storage_->size() * state_bytes;
+  for (std::size_t i = 0; i < state_storage_->size(); ++i)
+  {
+    const ConstrainedStateMetadata& metadata = state_storage_->getMetadata(i);
+    bytes += metadata.first.size() * sizeof(std::size_t) +
+             metadata.second.size() * (sizeof(std::size_t) * 3 + 4 * sizeof(void*));
+  }
+  return bytes;
+}
+
 ompl::base::StateSamplerAllocator
 ompl_interface::ConstraintApproximation::getStateSamplerAllocator(const moveit_msgs::Constraints& /*unused*/) const
 {
@@ -328,10 +512,26 @@ void ompl_interface::ConstraintsLibrary::loadConstraintApproximations(const std:
     moveit_msgs::Constraints msg;
     hexToMsg(serialization, msg);
     auto* cass = new ConstraintApproximationStateStorage(context_->getOMPLSimpleSetup()->getStateSpace());
-    cass->load((std::string{ path }.append("/").append(filename)).c_str());
+    ompl::base::StateStoragePtr storage(cass);
+    const std::string state_file = std::string{ path }.append("/").append(filename);
+    if (!isBinaryStateFile(state_file))
+      cass->load(state_file.c_str());
+    else
+    {
+      bool loaded = false;
+      try
+      {
+        loaded = loadBinaryStateFile(state_file, *cass);
+      }
+      catch (boost::interprocess::interprocess_exception& ex)
+      {
+        ROS_ERROR_NAMED(LOGNAME, "Unable to map '%s': %s", state_file.c_str(), ex.what());
+      }
+      if (!loaded)
+        continue;
+    }
     ConstraintApproximationPtr cap(new ConstraintApproximation(group, state_space_parameterization, explicit_motions,
-                                                               msg, filename, ompl::base::StateStoragePtr(cass),
-                                                               milestones));
+                                                               msg, filename, storage, milestones));
     if (constraint_approximations_.find(cap->getName()) != constraint_approximations_.end())
       ROS_WARN_NAMED(LOGNAME, "Overwriting constraint approximation named '%s'", cap->getName().c_str());
     constraint_approximations_[cap->getName()] = cap;
@@ -373,8 +573,11 @@ void ompl_interface::ConstraintsLibrary::saveConstraintApproximations(const std:
       msgToHex(it->second->getConstraintsMsg(), serialization);
       fout << serialization << std::endl;
       fout << it->second->getFilename() << std::endl;
-      if (it->second->getStateStorage())
-        it->second->getStateStorage()->store((path + "/" + it->second->getFilename()).c_str());
+      if (it->second->getStateStorage() &&
+          !storeBinaryStateFile(path + "/" + it->second->getFilename(),
+                                *static_cast<ConstraintApproximationStateStorage*>(it->second->getStateStorage().get())))
+        ROS_ERROR_NAMED(LOGNAME, "Unable to save the states of constraint approximation '%s'",
+                        it->second->getName().c_str());
     }
   else
     ROS_ERROR_NAMED(LOGNAME, "Unable to save constraint approximation to '%s'", path.c_str());
@@ -400,6 +603,15 @@ void ompl_interface::ConstraintsLibrary::printConstraintApproximations(std::ostr
   }
 }
 
+std::size_t ompl_interface::ConstraintsLibrary::getMemoryUsage() const
+{
+  std::size_t bytes = 0;
+  for (const std::pair<const std::string, ConstraintApproximationPtr>& constraint_approximation :
+       constraint_approximations_)
+    bytes += constraint_approximation.second->getMemoryUsage();
+  return bytes;
+}
+
 const ompl_interface::ConstraintApproximationPtr&
 ompl_interface::ConstraintsLibrary::getConstraintApproximation(const moveit_msgs::Constraints& msg) const
 {
@@ -470,81 +682,115 @@ ompl::base::StateStoragePtr ompl_interface::ConstraintsLibrary::constructConstra
   ConstraintApproximationStateStorage* cass = new ConstraintApproximationStateStorage(pcontext->getOMPLStateSpace());
   ob::StateStoragePtr state_storage(cass);
 
-  // construct a sampler for the sampling constraints
-  kinematic_constraints::KinematicConstraintSet kset(pcontext->getRobotModel());
+  // the IK solvers of the group are shared, so only joint space planning can sample and interpolate in parallel
+  int threads = std::max(1u, options.threads);
+  if (threads > 1 && pcontext->getOMPLStateSpace()->getParameterizationType() !=
+                         JointModelStateSpace::PARAMETERIZATION_TYPE)
+  {
+    ROS_INFO_NAMED(LOGNAME, "State space '%s' uses IK. Constructing the approximation in a single thread.",
+                   pcontext->getOMPLStateSpace()->getParameterizationType().c_str());
+    threads = 1;
+  }
   moveit::core::Transforms no_transforms(pcontext->getRobotModel()->getModelFrame());
-  kset.add(constr_hard, no_transforms);
-
   const moveit::core::RobotState& default_state = pcontext->getCompleteInitialRobotState();
 
-  unsigned int attempts = 0;
-
   double bounds_val = std::numeric_limits<double>::max() / 2.0 - 1.0;
   pcontext->getOMPLStateSpace()->setPlanningVolume(-bounds_val, bounds_val, -bounds_val, bounds_val, -bounds_val,
                                                    bounds_val);
   pcontext->getOMPLStateSpace()->setup();
 
-  // construct the constrained states
-
-  moveit::core::RobotState robot_state(default_state);
+  // construct the constrained states; each thread has its own sampler and keeps its states until all are done
   const constraint_samplers::ConstraintSamplerManagerPtr& csmng = pcontext->getConstraintSamplerManager();
-  ConstrainedSampler* constrained_sampler = nullptr;
-  if (csmng)
+  int sampling_threads = threads;
+  if (csmng && sampling_threads > 1)
   {
-    constraint_samplers::ConstraintSamplerPtr constraint_sampler =
-        csmng->selectSampler(pcontext->getPlanningScene(), pcontext->getJointModelGroup()->getName(), constr_sampling);
-    if (constraint_sampler)
-      constrained_sampler = new ConstrainedSampler(pcontext, constraint_sampler);
+    constraint_samplers::ConstraintSamplerPtr constraint_sampler = csmng->selectSampler(
+        pcontext->getPlanningScene(), pcontext->getJointModelGroup()->getName(), constr_sampling);
+    if (constraint_sampler && usesKinematicsSolver(*constraint_sampler))
+    {
+      ROS_INFO_NAMED(LOGNAME, "Constraint sampler '%s' uses IK. Sampling states in a single thread.",
+                     constraint_sampler->getName().c_str());
+      sampling_threads = 1;
+    }
   }
-
-  ob::StateSamplerPtr ss(constrained_sampler ? ob::StateSamplerPtr(constrained_sampler) :
-                                               pcontext->getOMPLStateSpace()->allocDefaultStateSampler());
-
-  ompl::base::ScopedState<> temp(pcontext->getOMPLStateSpace());
-  int done = -1;
-  bool slow_warn = false;
+  std::vector<std::vector<ob::State*>> sampled_states(sampling_threads);
+  std::vector<double> sampling_rates;
+  std::atomic<unsigned int> attempts(0);
+  std::atomic<unsigned int> accepted(0);
+  std::atomic<int> sampling_done(-1);
+  std::atomic<bool> slow_warn(false);
+  std::atomic<bool> failed(false);
   ompl::time::point start = ompl::time::now();
-  while (state_storage->size() < options.samples)
+#pragma omp parallel num_threads(sampling_threads)
   {
-    ++attempts;
-    int done_now = 100 * state_storage->size() / options.samples;
-    if (done != done_now)
+    kinematic_constraints::KinematicConstraintSet kset(pcontext->getRobotModel());
+    moveit::core::RobotState robot_state(default_state);
+    ConstrainedSampler* constrained_sampler = nullptr;
+    ob::StateSamplerPtr ss;
+#pragma omp critical
     {
-      done = done_now;
-      ROS_INFO_NAMED(LOGNAME, "%d%% complete (kept %0.1lf%% sampled states)", done,
-                     100.0 * (double)state_storage->size() / (double)attempts);
+      kset.add(constr_hard, no_transforms);
+      if (csmng)
+      {
+        constraint_samplers::ConstraintSamplerPtr constraint_sampler = csmng->selectSampler(
+            pcontext->getPlanningScene(), pcontext->getJointModelGroup()->getName(), constr_sampling);
+        if (constraint_sampler)
+          constrained_sampler = new ConstrainedSampler(pcontext, constraint_sampler);
+      }
+      ss = constrained_sampler ? ob::StateSamplerPtr(constrained_sampler) :
+                                 pcontext->getOMPLStateSpace()->allocDefaultStateSampler();
     }
 
-    if (!slow_warn && attempts > 10 && attempts > state_storage->size() * 100)
+    std::vector<ob::State*>& states = sampled_states[omp_get_thread_num()];
+    ompl::base::ScopedState<> temp(pcontext->getOMPLStateSpace());
+    while (!failed && accepted < options.samples)
     {
-      slow_warn = true;
-      ROS_WARN_NAMED(LOGNAME, "Computation of valid state database is very slow...");
+      const unsigned int attempt = ++attempts;
+      const unsigned int kept = std::min<unsigned int>(accepted, options.samples);
+      int done_before = sampling_done;
+      int done_now = 100 * kept / options.samples;
+      if (done_now > done_before && sampling_done.compare_exchange_strong(done_before, done_now))
+        ROS_INFO_NAMED(LOGNAME, "%d%% complete (kept %0.1lf%% sampled states)", done_now,
+                       100.0 * (double)kept / (double)attempt);
+
+      if (attempt > 10 && attempt > kept * 100 && !slow_warn.exchange(true))
+        ROS_WARN_NAMED(LOGNAME, "Computation of valid state database is very slow...");
+
+      if (attempt > options.samples && kept == 0)
+      {
+        if (!failed.exchange(true))
+          ROS_ERROR_NAMED(LOGNAME, "Unable to generate any samples");
+        break;
+      }
+
+      ss->sampleUniform(temp.get());
+      pcontext->getOMPLStateSpace()->copyToRobotState(robot_state, temp.get());
+      if (kset.decide(robot_state).satisfied && accepted++ < options.samples)
+        states.push_back(pcontext->getOMPLStateSpace()->cloneState(temp.get()));
     }
 
-    if (attempts > options.samples && state_storage->size() == 0)
+    if (constrained_sampler)
     {
-      ROS_ERROR_NAMED(LOGNAME, "Unable to generate any samples");
-      break;
+#pragma omp critical
+      sampling_rates.push_back(constrained_sampler->getConstrainedSamplingRate());
     }
+  }
 
-    ss->sampleUniform(temp.get());
-    pcontext->getOMPLStateSpace()->copyToRobotState(robot_state, temp.get());
-    if (kset.decide(robot_state).satisfied)
+  for (const std::vector<ob::State*>& states : sampled_states)
+    for (ob::State* state : states)
     {
-      if (state_storage->size() < options.samples)
-      {
-        temp->as<ModelBasedStateSpace::StateType>()->tag = state_storage->size();
-        state_storage->addState(temp.get());
-      }
+      state->as<ModelBasedStateSpace::StateType>()->tag = state_storage->size();
+      state_storage->addState(state);
+      pcontext->getOMPLStateSpace()->freeState(state);
     }
-  }
 
   result.state_sampling_time = ompl::time::seconds(ompl::time::now() - start);
   ROS_INFO_NAMED(LOGNAME, "Generated %u states in %lf seconds", (unsigned int)state_storage->size(),
                  result.state_sampling_time);
-  if (constrained_sampler)
+  if (!sampling_rates.empty())
   {
-    result.sampling_success_rate = constrained_sampler->getConstrainedSamplingRate();
+    result.sampling_success_rate =
+        std::accumulate(sampling_rates.begin(), sampling_rates.end(), 0.0) / sampling_rates.size();
     ROS_INFO_NAMED(LOGNAME, "Constrained sampling rate: %lf", result.sampling_success_rate);
   }
 
@@ -556,13 +802,48 @@ ompl::base::StateStoragePtr ompl_interface::ConstraintsLibrary::constructConstra
     // construct connections
     const ob::StateSpacePtr& space = pcontext->getOMPLSimpleSetup()->getStateSpace();
     unsigned int milestones = state_storage->size();
-    std::vector<ob::State*> int_states(options.max_explicit_points, nullptr);
-    pcontext->getOMPLSimpleSetup()->getSpaceInformation()->allocStates(int_states);
+
+    // every thread checks motions with its own constraints, robot state and intermediate states
+    std::vector<kinematic_constraints::KinematicConstraintSetPtr> ksets(threads);
+    std::vector<moveit::core::RobotState> robot_states(threads, default_state);
+    std::vector<std::vector<ob::State*>> int_states(threads);
+    for (int t = 0; t < threads; ++t)
+    {
+      ksets[t] = std::make_shared<kinematic_constraints::KinematicConstraintSet>(pcontext->getRobotModel());
+      ksets[t]->add(constr_hard, no_transforms);
+      int_states[t].resize(options.max_explicit_points, nullptr);
+      pcontext->getOMPLSimpleSetup()->getSpaceInformation()->allocStates(int_states[t]);
+    }
+
+    // interpolate the motion from milestone i to milestone j in isteps steps and check the constraints along it
+    auto check_motion = [&](std::size_t i, std::size_t j, unsigned int isteps, int thread) {
+      if (isteps == 0)
+        return true;
+      std::vector<ob::State*>& states = int_states[thread];
+      const ob::State* sj = state_storage->getState(j);
+      double step = 1.0 / (double)isteps;
+      space->interpolate(state_storage->getState(i), sj, step, states[0]);
+      for (unsigned int k = 1; k < isteps; ++k)
+      {
+        double this_step = step / (1.0 - (k - 1) * step);
+        space->interpolate(states[k - 1], sj, this_step, states[k]);
+        pcontext->getOMPLStateSpace()->copyToRobotState(robot_states[thread], states[k]);
+        if (!ksets[thread]->decide(robot_states[thread]).satisfied)
+          return false;
+      }
+      return true;
+    };
 
     ompl::time::point start = ompl::time::now();
     int good = 0;
     int done = -1;
 
+    // the candidate connections of each milestone are checked in parallel in batches and added in order,
+    // so the resulting graph does not depend on the number of threads
+    const std::size_t batch_size = 4 * threads;
+    std::vector<std::size_t> batch;
+    std::vector<unsigned int> batch_steps;
+    std::vector<char> batch_valid;
     for (std::size_t j = 0; j < milestones; ++j)
     {
       int done_now = 100 * j / milestones;
@@ -571,55 +852,53 @@ ompl::base::StateStoragePtr ompl_interface::ConstraintsLibrary::constructConstra
         done = done_now;
         ROS_INFO_NAMED(LOGNAME, "%d%% complete", done);
       }
-      if (cass->getMetadata(j).first.size() >= options.edges_per_sample)
-        continue;
 
       const ob::State* sj = state_storage->getState(j);
-
-      for (std::size_t i = j + 1; i < milestones; ++i)
+      std::size_t i = j + 1;
+      while (i < milestones && cass->getMetadata(j).first.size() < options.edges_per_sample)
       {
-        if (cass->getMetadata(i).first.size() >= options.edges_per_sample)
-          continue;
-        double d = space->distance(state_storage->getState(i), sj);
-        if (d >= options.max_edge_length)
-          continue;
-        unsigned int isteps =
-            std::min<unsigned int>(options.max_explicit_points, d / options.explicit_points_resolution);
-        double step = 1.0 / (double)isteps;
-        bool ok = true;
-        space->interpolate(state_storage->getState(i), sj, step, int_states[0]);
-        for (unsigned int k = 1; k < isteps; ++k)
+        batch.clear();
+        batch_steps.clear();
+        for (; i < milestones && batch.size() < batch_size; ++i)
         {
-          double this_step = step / (1.0 - (k - 1) * step);
-          space->interpolate(int_states[k - 1], sj, this_step, int_states[k]);
-          pcontext->getOMPLStateSpace()->copyToRobotState(robot_state, int_states[k]);
-          if (!kset.decide(robot_state).satisfied)
-          {
-            ok = false;
-            break;
-          }
+          if (cass->getMetadata(i).first.size() >= options.edges_per_sample)
+            continue;
+          double d = space->distance(state_storage->getState(i), sj);
+          if (d >= options.max_edge_length)
+            continue;
+          batch.push_back(i);
+          batch_steps.push_back(
+              std::min<unsigned int>(options.max_explicit_points, d / options.explicit_points_resolution));
         }
 
-        if (ok)
+        batch_valid.assign(batch.size(), 0);
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+        for (int b = 0; b < static_cast<int>(batch.size()); ++b)
+          batch_valid[b] = check_motion(batch[b], j, batch_steps[b], omp_get_thread_num());
+
+        for (std::size_t b = 0; b < batch.size() && cass->getMetadata(j).first.size() < options.edges_per_sample; ++b)
         {
-          cass->getMetadata(i).first.push_back(j);
-          cass->getMetadata(j).first.push_back(i);
+          if (!batch_valid[b])
+            continue;
+          const std::size_t other = batch[b];
+          cass->getMetadata(other).first.push_back(j);
+          cass->getMetadata(j).first.push_back(other);
 
           if (options.explicit_motions)
           {
-            cass->getMetadata(i).second[j].first = state_storage->size();
-            for (unsigned int k = 0; k < isteps; ++k)
+            // the intermediate states may have been computed by another thread
+            check_motion(other, j, batch_steps[b], 0);
+            cass->getMetadata(other).second[j].first = state_storage->size();
+            for (unsigned int k = 0; k < batch_steps[b]; ++k)
             {
-              int_states[k]->as<ModelBasedStateSpace::StateType>()->tag = -1;
-              state_storage->addState(int_states[k]);
+              int_states[0][k]->as<ModelBasedStateSpace::StateType>()->tag = -1;
+              state_storage->addState(int_states[0][k]);
             }
-            cass->getMetadata(i).second[j].second = state_storage->size();
-            cass->getMetadata(j).second[i] = cass->getMetadata(i).second[j];
+            cass->getMetadata(other).second[j].second = state_storage->size();
+            cass->getMetadata(j).second[other] = cass->getMetadata(other).second[j];
           }
 
           good++;
-          if (cass->getMetadata(j).first.size() >= options.edges_per_sample)
-            break;
         }
       }
     }
@@ -627,7 +906,8 @@ ompl::base::StateStoragePtr ompl_interface::ConstraintsLibrary::constructConstra
     result.state_connection_time = ompl::time::seconds(ompl::time::now() - start);
     ROS_INFO_NAMED(LOGNAME, "Computed possible connections in %lf seconds. Added %d connections",
                    result.state_connection_time, good);
-    pcontext->getOMPLSimpleSetup()->getSpaceInformation()->freeStates(int_states);
+    for (std::vector<ob::State*>& states : int_states)
+      pcontext->getOMPLSimpleSetup()->getSpaceInformation()->freeStates(states);
 
     return state_storage;
   }
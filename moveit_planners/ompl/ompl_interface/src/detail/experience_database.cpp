@@ -0,0 +1,272 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/experience_database.h>
+#include <ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h>
+#include <ompl/geometric/planners/rrt/RRTConnect.h>
+#include <ros/console.h>
+#include <cstdint>
+#include <cstring>
+
+namespace ompl_interface
+{
+constexpr char LOGNAME[] = "experience_database";
+
+namespace
+{
+constexpr char MAGIC[4] = { 'M', 'X', 'D', 'B' };
+constexpr std::uint32_t VERSION = 1;
+
+template <typename T>
+bool read(std::istream& in, T& value)
+{
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+void write(std::ostream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+double ExperienceDatabase::Statistics::getTimeSaved() const
+{
+  const std::size_t misses = queries - hits;
+  if (hits == 0 || misses == 0)
+    return 0.0;
+  return hits * (scratch_time / misses) - experience_time;
+}
+
+ExperienceDatabase::ExperienceDatabase(const moveit::core::JointModelGroup* group, const std::string& filename)
+  : group_(group), filename_(filename)
+{
+  nn_ = std::make_shared<ompl::NearestNeighborsGNATNoThreadSafety<std::size_t>>();
+  nn_->setDistanceFunction([this](std::size_t a, std::size_t b) { return keyDistance(a, b); });
+  if (load())
+    out_.open(filename_, std::ios::binary | std::ios::app);
+}
+
+const std::vector<double>& ExperienceDatabase::getKey(std::size_t index) const
+{
+  return index == QUERY ? query_key_ : keys_[index];
+}
+
+double ExperienceDatabase::keyDistance(std::size_t a, std::size_t b) const
+{
+  const std::vector<double>& key_a = getKey(a);
+  const std::vector<double>& key_b = getKey(b);
+  const std::size_t dof = group_->getVariableCount();
+  return group_->distance(key_a.data(), key_b.data()) + group_->distance(key_a.data() + dof, key_b.data() + dof);
+}
+
+bool ExperienceDatabase::load()
+{
+  const std::uint32_t dof = group_->getVariableCount();
+  const std::string& name = group_->getName();
+  std::ifstream in(filename_, std::ios::binary);
+  if (!in.good())
+  {
+    // create a new database
+    std::ofstream out(filename_, std::ios::binary);
+    if (!out.good())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Cannot create experience database '%s'", filename_.c_str());
+      return false;
+    }
+    out.write(MAGIC, sizeof(MAGIC));
+    write(out, VERSION);
+    write(out, dof);
+    write(out, static_cast<std::uint32_t>(name.size()));
+    out.write(name.data(), name.size());
+    return out.good();
+  }
+
+  char magic[sizeof(MAGIC)];
+  std::uint32_t version, file_dof, name_size;
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !read(in, version) ||
+      version != VERSION || !read(in, file_dof) || !read(in, name_size))
+  {
+    ROS_ERROR_NAMED(LOGNAME, "'%s' is not an experience database", filename_.c_str());
+    return false;
+  }
+  std::string file_name(name_size, '\0');
+  if (!in.read(&file_name[0], name_size) || file_name != name || file_dof != dof)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Experience database '%s' does not belong to group '%s' with %u variables",
+                    filename_.c_str(), name.c_str(), dof);
+    return false;
+  }
+
+  std::uint32_t count;
+  while (read(in, count))
+  {
+    std::vector<std::vector<double>> waypoints(count, std::vector<double>(dof));
+    for (std::vector<double>& waypoint : waypoints)
+      if (!in.read(reinterpret_cast<char*>(waypoint.data()), dof * sizeof(double)))
+      {
+        // a truncated record from an interrupted write
+        ROS_WARN_NAMED(LOGNAME, "Ignoring incomplete path at the end of '%s'", filename_.c_str());
+        return true;
+      }
+    if (count >= 2)
+      index(std::move(waypoints));
+  }
+  ROS_INFO_NAMED(LOGNAME, "Loaded %zu paths from experience database '%s'", paths_.size(), filename_.c_str());
+  return true;
+}
+
+void ExperienceDatabase::index(std::vector<std::vector<double>> waypoints)
+{
+  std::vector<double> key = waypoints.front();
+  key.insert(key.end(), waypoints.back().begin(), waypoints.back().end());
+  keys_.push_back(std::move(key));
+  paths_.push_back(std::move(waypoints));
+  nn_->add(paths_.size() - 1);
+}
+
+std::size_t ExperienceDatabase::size() const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  return paths_.size();
+}
+
+bool ExperienceDatabase::addPath(const std::vector<std::vector<double>>& waypoints, double min_distance)
+{
+  if (waypoints.size() < 2)
+    return false;
+  const std::size_t dof = group_->getVariableCount();
+  for (const std::vector<double>& waypoint : waypoints)
+    if (waypoint.size() != dof)
+      return false;
+
+  std::lock_guard<std::mutex> slock(lock_);
+  if (nn_->size() > 0)
+  {
+    query_key_ = waypoints.front();
+    query_key_.insert(query_key_.end(), waypoints.back().begin(), waypoints.back().end());
+    if (keyDistance(nn_->nearest(QUERY), QUERY) <= min_distance)
+      return false;
+  }
+
+  if (out_.is_open())
+  {
+    write(out_, static_cast<std::uint32_t>(waypoints.size()));
+    for (const std::vector<double>& waypoint : waypoints)
+      out_.write(reinterpret_cast<const char*>(waypoint.data()), dof * sizeof(double));
+    out_.flush();
+  }
+  index(waypoints);
+  return true;
+}
+
+void ExperienceDatabase::findPaths(const std::vector<double>& start, const std::vector<double>& goal, std::size_t k,
+                                   std::vector<std::vector<std::vector<double>>>& paths) const
+{
+  paths.clear();
+  std::lock_guard<std::mutex> slock(lock_);
+  if (nn_->size() == 0)
+    return;
+  query_key_ = start;
+  query_key_.insert(query_key_.end(), goal.begin(), goal.end());
+  std::vector<std::size_t> nearest;
+  nn_->nearestK(QUERY, k, nearest);
+  for (std::size_t index : nearest)
+    paths.push_back(paths_[index]);
+}
+
+void ExperienceDatabase::recordQuery(bool hit, double time)
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  ++statistics_.queries;
+  if (hit)
+  {
+    ++statistics_.hits;
+    statistics_.experience_time += time;
+  }
+  else
+    statistics_.scratch_time += time;
+}
+
+ExperienceDatabase::Statistics ExperienceDatabase::getStatistics() const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  return statistics_;
+}
+
+bool ExperienceDatabase::repairPath(ompl::geometric::PathGeometric& path,
+                                    const ompl::base::PlannerTerminationCondition& ptc)
+{
+  const ompl::base::SpaceInformationPtr& si = path.getSpaceInformation();
+  std::vector<ompl::base::State*>& states = path.getStates();
+
+  // drop invalid waypoints, keeping the first and the last state
+  for (std::size_t i = 1; i + 1 < states.size();)
+    if (!si->isValid(states[i]))
+    {
+      si->freeState(states[i]);
+      states.erase(states.begin() + i);
+    }
+    else
+      ++i;
+
+  // replan invalid motions between the remaining waypoints
+  std::vector<ompl::base::State*> repaired;
+  repaired.push_back(states.front());
+  bool success = true;
+  for (std::size_t i = 1; i < states.size(); ++i)
+  {
+    if (success && !ptc() && !si->checkMotion(states[i - 1], states[i]))
+    {
+      auto pdef = std::make_shared<ompl::base::ProblemDefinition>(si);
+      pdef->setStartAndGoalStates(states[i - 1], states[i]);
+      ompl::geometric::RRTConnect planner(si);
+      planner.setProblemDefinition(pdef);
+      planner.setup();
+      if (planner.solve(ptc) == ompl::base::PlannerStatus::EXACT_SOLUTION)
+      {
+        // copy the states between the two waypoints
+        const auto& segment = *pdef->getSolutionPath()->as<ompl::geometric::PathGeometric>();
+        for (std::size_t j = 1; j + 1 < segment.getStateCount(); ++j)
+          repaired.push_back(si->cloneState(segment.getState(j)));
+      }
+      else
+        success = false;
+    }
+    repaired.push_back(states[i]);
+  }
+  states.swap(repaired);
+  return success && !ptc();
+}
+}  // namespace ompl_interface
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/lazy_motion_validator.h>
+#include <moveit/ompl_interface/detail/state_validity_checker.h>
+
+namespace ompl_interface
+{
+namespace
+{
+/** Enables the collision memory of the StateValidityChecker of \e si for the calling thread while in scope */
+class MotionScope
+{
+public:
+  MotionScope(const ompl::base::SpaceInformation& si)
+    : checker_(dynamic_cast<const StateValidityChecker*>(si.getStateValidityChecker().get()))
+  {
+    if (checker_)
+      checker_->beginMotion();
+  }
+
+  ~MotionScope()
+  {
+    if (checker_)
+      checker_->endMotion();
+  }
+
+private:
+  const StateValidityChecker* checker_;
+};
+}  // namespace
+
+LazyMotionValidator::LazyMotionValidator(const ompl::base::SpaceInformationPtr& si)
+  : ompl::base::DiscreteMotionValidator(si)
+{
+}
+
+bool LazyMotionValidator::checkMotion(const ompl::base::State* s1, const ompl::base::State* s2) const
+{
+  MotionScope scope(*si_);
+  return ompl::base::DiscreteMotionValidator::checkMotion(s1, s2);
+}
+
+bool LazyMotionValidator::checkMotion(const ompl::base::State* s1, const ompl::base::State* s2,
+                                      std::pair<ompl::base::State*, double>& last_valid) const
+{
+  MotionScope scope(*si_);
+  return ompl::base::DiscreteMotionValidator::checkMotion(s1, s2, last_valid);
+}
+}  // namespace ompl_interface
@@ -0,0 +1,112 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.h>
+#include <ompl/base/objectives/PathLengthOptimizationObjective.h>
+#include <ompl/geometric/PathHybridization.h>
+#include <ompl/geometric/PathSimplifier.h>
+#include <algorithm>
+#include <thread>
+
+namespace ompl_interface
+{
+ParallelPathSimplifier::ParallelPathSimplifier(const ompl::base::SpaceInformationPtr& si,
+                                               const ompl::base::GoalPtr& goal,
+                                               const ompl::base::OptimizationObjectivePtr& objective,
+                                               unsigned int threads)
+  : si_(si)
+  , goal_(goal)
+  , objective_(objective ? objective : std::make_shared<ompl::base::PathLengthOptimizationObjective>(si))
+  , threads_(std::max(1u, threads))
+{
+}
+
+void ParallelPathSimplifier::simplify(const std::vector<ompl::geometric::PathGeometric>& paths,
+                                      const ompl::base::PlannerTerminationCondition& ptc,
+                                      ompl::geometric::PathGeometric& result, bool hybridize) const
+{
+  // never run more than threads_ threads: with more input paths than threads, only the best ones are simplified
+  std::vector<std::pair<ompl::base::Cost, const ompl::geometric::PathGeometric*>> inputs;
+  inputs.reserve(paths.size());
+  for (const ompl::geometric::PathGeometric& path : paths)
+    inputs.emplace_back(path.cost(objective_), &path);
+  if (inputs.size() > threads_)
+  {
+    std::partial_sort(inputs.begin(), inputs.begin() + threads_, inputs.end(),
+                      [this](const auto& a, const auto& b) { return objective_->isCostBetterThan(a.first, b.first); });
+    inputs.resize(threads_);
+  }
+
+  std::vector<ompl::geometric::PathGeometric> simplified;
+  simplified.reserve(threads_);
+  for (unsigned int i = 0; i < threads_; ++i)
+    simplified.push_back(*inputs[i % inputs.size()].second);
+
+  std::vector<std::thread> threads;
+  threads.reserve(simplified.size());
+  for (ompl::geometric::PathGeometric& path : simplified)
+    threads.emplace_back([this, &path, &ptc] {
+      // each simplifier has its own random number generator
+      ompl::geometric::PathSimplifier simplifier(si_, goal_, objective_);
+      simplifier.simplify(path, ptc);
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  const ompl::geometric::PathGeometric* best = &simplified.front();
+  for (const ompl::geometric::PathGeometric& path : simplified)
+    if (objective_->isCostBetterThan(path.cost(objective_), best->cost(objective_)))
+      best = &path;
+
+  // combine the best parts of the simplified paths
+  if (hybridize && simplified.size() > 1 && !ptc())
+  {
+    ompl::geometric::PathHybridization hybridization(si_);
+    for (const ompl::geometric::PathGeometric& path : simplified)
+      hybridization.recordPath(std::make_shared<ompl::geometric::PathGeometric>(path), false);
+    hybridization.computeHybridPath();
+    const ompl::base::PathPtr& hybrid = hybridization.getHybridPath();
+    if (hybrid)
+    {
+      const auto& hybrid_path = *hybrid->as<ompl::geometric::PathGeometric>();
+      if (objective_->isCostBetterThan(hybrid_path.cost(objective_), best->cost(objective_)))
+      {
+        result = hybrid_path;
+        return;
+      }
+    }
+  }
+  result = *best;
+}
+}  // namespace ompl_interface
@@ -0,0 +1,551 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/persistent_roadmap.h>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
+#include <geometric_shapes/shape_operations.h>
+#include <ompl/geometric/planners/prm/LazyPRMstar.h>
+#include <boost/range/iterator_range.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace ompl_interface
+{
+constexpr char LOGNAME[] = "persistent_roadmap";
+
+namespace
+{
+/** The box of a sphere at \e center */
+Eigen::AlignedBox3d sphereBox(const Eigen::Vector3d& center, double radius)
+{
+  const Eigen::Vector3d r = Eigen::Vector3d::Constant(radius);
+  return Eigen::AlignedBox3d(center - r, center + r);
+}
+
+/** The distance a single-DOF joint can move the origin of its child link away from the joint origin */
+bool jointExtent(const moveit::core::JointModel* joint, double& extent)
+{
+  switch (joint->getType())
+  {
+    case moveit::core::JointModel::FIXED:
+    case moveit::core::JointModel::REVOLUTE:
+      extent = 0.0;
+      return true;
+    case moveit::core::JointModel::PRISMATIC:
+    {
+      const moveit::core::VariableBounds& bounds = joint->getVariableBounds()[0];
+      extent = std::max(std::abs(bounds.min_position_), std::abs(bounds.max_position_));
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+RoadmapSceneTracker::RoadmapSceneTracker(const moveit::core::JointModelGroup* group, double padding)
+  : group_(group), padding_(padding), links_(group->getUpdatedLinkModels()), bounded_motion_(true)
+{
+  const std::vector<const moveit::core::JointModel*>& joints = group_->getActiveJointModels();
+  if (!group_->getMimicJointModels().empty())
+    bounded_motion_ = false;
+  for (const moveit::core::JointModel* joint : joints)
+  {
+    if (joint->getVariableCount() != 1)
+      bounded_motion_ = false;
+    variable_indices_.push_back(group_->getVariableGroupIndex(joint->getName()));
+  }
+
+  // walk up from each link towards the root, summing the lengths of the joint origins passed on the way
+  path_lengths_.assign(links_.size(), std::vector<double>(joints.size(), -1.0));
+  for (std::size_t k = 0; k < links_.size(); ++k)
+  {
+    double length = 0.0;
+    bool unbounded = false;
+    for (const moveit::core::LinkModel* link = links_[k]; link && link->getParentJointModel();
+         link = link->getParentJointModel()->getParentLinkModel())
+    {
+      const moveit::core::JointModel* joint = link->getParentJointModel();
+      auto it = std::find(joints.begin(), joints.end(), joint);
+      if (it != joints.end())
+      {
+        // a joint of unknown extent between this joint and the link, e.g. a planar joint outside of the group
+        if (unbounded)
+          bounded_motion_ = false;
+        path_lengths_[k][it - joints.begin()] = length;
+      }
+      double extent;
+      if (jointExtent(joint, extent))
+        length += link->getJointOriginTransform().translation().norm() + extent;
+      else
+        unbounded = true;
+    }
+  }
+  attached_spheres_.resize(links_.size());
+  radii_.resize(links_.size());
+}
+
+void RoadmapSceneTracker::updateAttachedBodies(const moveit::core::RobotState& start_state)
+{
+  for (std::size_t k = 0; k < links_.size(); ++k)
+  {
+    const moveit::core::LinkModel* link = links_[k];
+    radii_[k] = link->getShapes().empty() ?
+                    0.0 :
+                    link->getCenteredBoundingBoxOffset().norm() + 0.5 * link->getShapeExtentsAtOrigin().norm();
+
+    attached_spheres_[k].clear();
+    std::vector<const moveit::core::AttachedBody*> bodies;
+    start_state.getAttachedBodies(bodies, link);
+    for (const moveit::core::AttachedBody* body : bodies)
+      for (std::size_t i = 0; i < body->getShapes().size(); ++i)
+      {
+        Eigen::Vector3d center;
+        double radius;
+        shapes::computeShapeBoundingSphere(body->getShapes()[i].get(), center, radius);
+        center = body->getShapePosesInLinkFrame()[i] * center;
+        attached_spheres_[k].emplace_back(center, radius);
+        radii_[k] = std::max(radii_[k], center.norm() + radius);
+      }
+  }
+}
+
+RoadmapSceneTracker::Change RoadmapSceneTracker::update(const planning_scene::PlanningScene& scene,
+                                                        const moveit::core::RobotState& start_state)
+{
+  Change change = has_snapshot_ ? Change::NONE : Change::ALL;
+  changed_regions_.clear();
+
+  // changes of the robot or of the collision rules can't be localized
+  moveit_msgs::AllowedCollisionMatrix acm;
+  scene.getAllowedCollisionMatrix().getMessage(acm);
+  const std::map<std::string, double>& link_padding = scene.getCollisionEnv()->getLinkPadding();
+
+  std::vector<const moveit::core::AttachedBody*> bodies;
+  start_state.getAttachedBodies(bodies);
+  std::vector<AttachedBodySnapshot> attached_bodies;
+  for (const moveit::core::AttachedBody* body : bodies)
+    attached_bodies.push_back(
+        { body->getName(), body->getAttachedLinkName(), body->getShapes(), body->getShapePosesInLinkFrame() });
+  std::sort(attached_bodies.begin(), attached_bodies.end(),
+            [](const AttachedBodySnapshot& a, const AttachedBodySnapshot& b) { return a.id < b.id; });
+
+  auto same_body = [](const AttachedBodySnapshot& a, const AttachedBodySnapshot& b) {
+    if (a.id != b.id || a.link != b.link || a.shapes != b.shapes || a.poses.size() != b.poses.size())
+      return false;
+    for (std::size_t i = 0; i < a.poses.size(); ++i)
+      if (!a.poses[i].isApprox(b.poses[i]))
+        return false;
+    return true;
+  };
+  if (acm != acm_ || link_padding != link_padding_ || attached_bodies.size() != attached_bodies_.size() ||
+      !std::equal(attached_bodies.begin(), attached_bodies.end(), attached_bodies_.begin(), same_body))
+    change = Change::ALL;
+  if (change == Change::ALL)
+    updateAttachedBodies(start_state);
+
+  double padding = padding_;
+  for (const std::pair<const std::string, double>& entry : link_padding)
+    padding = std::max(padding, padding_ + entry.second);
+
+  std::map<std::string, collision_detection::World::ObjectConstPtr> objects;
+  for (const std::pair<const std::string, collision_detection::World::ObjectPtr>& entry : *scene.getWorld())
+  {
+    objects.emplace(entry.first, entry.second);
+    if (change == Change::ALL)
+      continue;
+
+    // objects are copied on write, so unchanged objects are shared with the snapshot
+    auto it = objects_.find(entry.first);
+    if (it != objects_.end() && it->second == entry.second)
+      continue;
+
+    const collision_detection::World::Object& object = *entry.second;
+    for (std::size_t i = 0; i < object.shapes_.size(); ++i)
+    {
+      const shapes::ShapeType type = object.shapes_[i]->type;
+      if (type == shapes::OCTREE || type == shapes::PLANE)
+      {
+        change = Change::ALL;
+        break;
+      }
+      Eigen::Vector3d center;
+      double radius;
+      shapes::computeShapeBoundingSphere(object.shapes_[i].get(), center, radius);
+      changed_regions_.push_back(sphereBox(object.global_shape_poses_[i] * center, radius + padding));
+      change = Change::LOCAL;
+    }
+  }
+
+  if (change == Change::ALL)
+    changed_regions_.clear();
+  objects_.swap(objects);
+  attached_bodies_.swap(attached_bodies);
+  acm_ = acm;
+  link_padding_ = link_padding;
+  has_snapshot_ = true;
+  return change;
+}
+
+void RoadmapSceneTracker::computeLinkBoxes(const moveit::core::RobotState& state,
+                                           std::vector<Eigen::AlignedBox3d>& boxes) const
+{
+  boxes.resize(links_.size());
+  for (std::size_t k = 0; k < links_.size(); ++k)
+  {
+    const moveit::core::LinkModel* link = links_[k];
+    boxes[k].setEmpty();
+    if (link->getShapes().empty() && attached_spheres_[k].empty())
+      continue;
+    const Eigen::Isometry3d& transform = state.getGlobalLinkTransform(link);
+    if (!link->getShapes().empty())
+    {
+      const Eigen::Vector3d center = transform * link->getCenteredBoundingBoxOffset();
+      const Eigen::Vector3d half = transform.linear().cwiseAbs() * (0.5 * link->getShapeExtentsAtOrigin());
+      boxes[k].extend(Eigen::AlignedBox3d(center - half, center + half));
+    }
+    for (const std::pair<Eigen::Vector3d, double>& sphere : attached_spheres_[k])
+      boxes[k].extend(sphereBox(transform * sphere.first, sphere.second));
+  }
+}
+
+bool RoadmapSceneTracker::computeMotionBoxes(const double* from, const double* to,
+                                             const std::vector<Eigen::AlignedBox3d>& from_boxes,
+                                             const std::vector<Eigen::AlignedBox3d>& to_boxes,
+                                             std::vector<Eigen::AlignedBox3d>& boxes) const
+{
+  if (!bounded_motion_)
+    return false;
+
+  // Along the interpolation, a point of link k moves at most sum_i |dq_i| * r_ik, where r_ik bounds its distance
+  // from the axis of revolute joint i (1 for prismatic joints). Any point on a path of that length lies within
+  // half of it from one of the path ends, which are covered by the link boxes of the two states.
+  const std::vector<const moveit::core::JointModel*>& joints = group_->getActiveJointModels();
+  boxes.resize(links_.size());
+  for (std::size_t k = 0; k < links_.size(); ++k)
+  {
+    boxes[k] = from_boxes[k];
+    boxes[k].extend(to_boxes[k]);
+    if (boxes[k].isEmpty())
+      continue;
+    double travel = 0.0;
+    for (std::size_t i = 0; i < joints.size(); ++i)
+    {
+      if (path_lengths_[k][i] < 0.0)
+        continue;
+      const std::size_t v = variable_indices_[i];
+      const double dq = joints[i]->distance(from + v, to + v);
+      travel += dq * (joints[i]->getType() == moveit::core::JointModel::PRISMATIC ? 1.0 :
+                                                                                    path_lengths_[k][i] + radii_[k]);
+    }
+    const Eigen::Vector3d grow = Eigen::Vector3d::Constant(0.5 * travel);
+    boxes[k].min() -= grow;
+    boxes[k].max() += grow;
+  }
+  return true;
+}
+
+bool RoadmapSceneTracker::intersectsChanges(const std::vector<Eigen::AlignedBox3d>& boxes) const
+{
+  for (const Eigen::AlignedBox3d& region : changed_regions_)
+    for (const Eigen::AlignedBox3d& box : boxes)
+      if (region.intersects(box))
+        return true;
+  return false;
+}
+
+template <typename Base>
+PersistentLazyRoadmap<Base>::PersistentLazyRoadmap(const ompl::base::SpaceInformationPtr& si, double padding)
+  : Base(si), padding_(padding)
+{
+}
+
+template <typename Base>
+PersistentLazyRoadmap<Base>::~PersistentLazyRoadmap()
+{
+  freeRecords();
+}
+
+template <typename Base>
+ompl::base::PlannerStatus PersistentLazyRoadmap<Base>::solve(const ompl::base::PlannerTerminationCondition& ptc)
+{
+  ompl::base::PlannerStatus status = Base::solve(ptc);
+  updateRecords();
+  return status;
+}
+
+template <typename Base>
+void PersistentLazyRoadmap<Base>::clear()
+{
+  Base::clear();
+  freeRecords();
+}
+
+template <typename Base>
+typename PersistentLazyRoadmap<Base>::RecordedState
+PersistentLazyRoadmap<Base>::recordState(const ompl::base::State* state) const
+{
+  return { state, this->si_->cloneState(state) };
+}
+
+template <typename Base>
+bool PersistentLazyRoadmap<Base>::findVertex(const std::unordered_map<const ompl::base::State*, Vertex>& vertices,
+                                             const RecordedState& recorded, Vertex& vertex) const
+{
+  // the address of a removed state may be reused by a new one
+  auto it = vertices.find(recorded.state);
+  if (it == vertices.end() || !this->si_->equalStates(this->stateProperty_[it->second], recorded.copy))
+    return false;
+  vertex = it->second;
+  return true;
+}
+
+template <typename Base>
+void PersistentLazyRoadmap<Base>::updateRecords()
+{
+  if (pending_vertices_.empty() && pending_edges_.empty())
+    return;
+
+  std::unordered_map<const ompl::base::State*, Vertex> vertices;
+  for (Vertex v : boost::make_iterator_range(boost::vertices(this->g_)))
+    vertices.emplace(this->stateProperty_[v], v);
+
+  // LazyPRM only removes the vertices and edges it found invalid
+  std::vector<RecordedState> pending_vertices;
+  for (const RecordedState& recorded : pending_vertices_)
+  {
+    Vertex v;
+    if (!findVertex(vertices, recorded, v))
+      removed_vertices_.push_back(recorded);
+    else if (this->vertexValidityProperty_[v] & Base::VALIDITY_TRUE)
+      this->si_->freeState(recorded.copy);
+    else
+      pending_vertices.push_back(recorded);
+  }
+  pending_vertices_.swap(pending_vertices);
+
+  std::vector<RecordedEdge> pending_edges;
+  for (const RecordedEdge& recorded : pending_edges_)
+  {
+    Vertex a, b;
+    bool keep = false;
+    // the edges of removed vertices are restored along with them
+    if (findVertex(vertices, recorded.first, a) && findVertex(vertices, recorded.second, b))
+    {
+      const auto edge = boost::edge(a, b, this->g_);
+      if (!edge.second)
+      {
+        removed_edges_.push_back(recorded);
+        continue;
+      }
+      keep = !(this->edgeValidityProperty_[edge.first] & Base::VALIDITY_TRUE);
+    }
+    if (keep)
+      pending_edges.push_back(recorded);
+    else
+    {
+      this->si_->freeState(recorded.first.copy);
+      this->si_->freeState(recorded.second.copy);
+    }
+  }
+  pending_edges_.swap(pending_edges);
+}
+
+template <typename Base>
+void PersistentLazyRoadmap<Base>::freeRecords()
+{
+  for (std::vector<RecordedState>* states : { &pending_vertices_, &removed_vertices_ })
+  {
+    for (const RecordedState& recorded : *states)
+      this->si_->freeState(recorded.copy);
+    states->clear();
+  }
+  for (std::vector<RecordedEdge>* edges : { &pending_edges_, &removed_edges_ })
+  {
+    for (const RecordedEdge& recorded : *edges)
+    {
+      this->si_->freeState(recorded.first.copy);
+      this->si_->freeState(recorded.second.copy);
+    }
+    edges->clear();
+  }
+}
+
+template <typename Base>
+PersistentRoadmap::UpdateStatistics PersistentLazyRoadmap<Base>::updateScene(const planning_scene::PlanningScene& scene,
+                                                                            const moveit::core::RobotState& start_state)
+{
+  const ModelBasedStateSpace* space = this->si_->getStateSpace()->template as<ModelBasedStateSpace>();
+  if (!tracker_)
+    tracker_ = std::make_unique<RoadmapSceneTracker>(space->getJointModelGroup(), padding_);
+
+  UpdateStatistics stats;
+  stats.vertices = boost::num_vertices(this->g_);
+  stats.edges = boost::num_edges(this->g_);
+  for (Vertex v : boost::make_iterator_range(boost::vertices(this->g_)))
+    if (this->vertexValidityProperty_[v] & Base::VALIDITY_TRUE)
+      ++stats.valid_vertices;
+  for (const auto& e : boost::make_iterator_range(boost::edges(this->g_)))
+    if (this->edgeValidityProperty_[e] & Base::VALIDITY_TRUE)
+      ++stats.valid_edges;
+
+  const RoadmapSceneTracker::Change change = tracker_->update(scene, start_state);
+  if (change == RoadmapSceneTracker::Change::NONE)
+    return stats;
+
+  // link boxes of all roadmap states, if changes are local
+  moveit::core::RobotState state(start_state);
+  std::unordered_map<Vertex, std::vector<Eigen::AlignedBox3d>> boxes;
+  if (change == RoadmapSceneTracker::Change::LOCAL)
+  {
+    for (Vertex v : boost::make_iterator_range(boost::vertices(this->g_)))
+    {
+      space->copyToRobotState(state, this->stateProperty_[v]);
+      tracker_->computeLinkBoxes(state, boxes[v]);
+    }
+  }
+
+  for (Vertex v : boost::make_iterator_range(boost::vertices(this->g_)))
+  {
+    unsigned int& validity = this->vertexValidityProperty_[v];
+    if ((validity & Base::VALIDITY_TRUE) &&
+        (change == RoadmapSceneTracker::Change::ALL || tracker_->intersectsChanges(boxes[v])))
+    {
+      validity = Base::VALIDITY_UNKNOWN;
+      pending_vertices_.push_back(recordState(this->stateProperty_[v]));
+      ++stats.invalidated_vertices;
+    }
+  }
+
+  // motion bounds only hold for joint-space interpolation
+  const bool joint_space = space->getParameterizationType() == JointModelStateSpace::PARAMETERIZATION_TYPE;
+  std::vector<Eigen::AlignedBox3d> motion_boxes;
+  auto motion_changed = [&](const ompl::base::State* a, const ompl::base::State* b,
+                            const std::vector<Eigen::AlignedBox3d>& a_boxes,
+                            const std::vector<Eigen::AlignedBox3d>& b_boxes) {
+    return change == RoadmapSceneTracker::Change::ALL || !joint_space ||
+           !tracker_->computeMotionBoxes(a->as<ModelBasedStateSpace::StateType>()->values,
+                                         b->as<ModelBasedStateSpace::StateType>()->values, a_boxes, b_boxes,
+                                         motion_boxes) ||
+           tracker_->intersectsChanges(motion_boxes);
+  };
+  for (const auto& e : boost::make_iterator_range(boost::edges(this->g_)))
+  {
+    unsigned int& validity = this->edgeValidityProperty_[e];
+    if (!(validity & Base::VALIDITY_TRUE))
+      continue;
+    const Vertex a = boost::source(e, this->g_);
+    const Vertex b = boost::target(e, this->g_);
+    if (motion_changed(this->stateProperty_[a], this->stateProperty_[b], boxes[a], boxes[b]))
+    {
+      validity = Base::VALIDITY_UNKNOWN;
+      pending_edges_.emplace_back(recordState(this->stateProperty_[a]), recordState(this->stateProperty_[b]));
+      ++stats.invalidated_edges;
+    }
+  }
+
+  // restore the vertices and edges removed since an earlier change, if the objects close to them changed again;
+  // new vertices are connected by the planner, so this needs a planner which is set up
+  if (this->isSetup())
+  {
+    std::vector<Eigen::AlignedBox3d> a_boxes, b_boxes;
+    std::vector<RecordedState> removed_vertices;
+    for (const RecordedState& recorded : removed_vertices_)
+    {
+      if (change == RoadmapSceneTracker::Change::LOCAL)
+      {
+        space->copyToRobotState(state, recorded.copy);
+        tracker_->computeLinkBoxes(state, a_boxes);
+        if (!tracker_->intersectsChanges(a_boxes))
+        {
+          removed_vertices.push_back(recorded);
+          continue;
+        }
+      }
+      // the planner owns the state it is given and connects it to its neighbors with edges of unknown validity
+      const Vertex v = this->addMilestone(this->si_->cloneState(recorded.copy));
+      pending_vertices_.push_back({ this->stateProperty_[v], recorded.copy });
+      ++stats.restored_vertices;
+    }
+    removed_vertices_.swap(removed_vertices);
+
+    std::unordered_map<const ompl::base::State*, Vertex> vertices;
+    if (!removed_edges_.empty())
+      for (Vertex v : boost::make_iterator_range(boost::vertices(this->g_)))
+        vertices.emplace(this->stateProperty_[v], v);
+    std::vector<RecordedEdge> removed_edges;
+    for (const RecordedEdge& recorded : removed_edges_)
+    {
+      Vertex a, b;
+      if (!findVertex(vertices, recorded.first, a) || !findVertex(vertices, recorded.second, b) ||
+          boost::edge(a, b, this->g_).second)
+      {
+        this->si_->freeState(recorded.first.copy);
+        this->si_->freeState(recorded.second.copy);
+        continue;
+      }
+      if (change == RoadmapSceneTracker::Change::LOCAL)
+      {
+        space->copyToRobotState(state, recorded.first.copy);
+        tracker_->computeLinkBoxes(state, a_boxes);
+        space->copyToRobotState(state, recorded.second.copy);
+        tracker_->computeLinkBoxes(state, b_boxes);
+      }
+      if (!motion_changed(recorded.first.copy, recorded.second.copy, a_boxes, b_boxes))
+      {
+        removed_edges.push_back(recorded);
+        continue;
+      }
+      const ompl::base::Cost weight = this->opt_->motionCost(this->stateProperty_[a], this->stateProperty_[b]);
+      const typename Base::Edge e =
+          boost::add_edge(a, b, typename Base::Graph::edge_property_type(weight), this->g_).first;
+      this->edgeValidityProperty_[e] = Base::VALIDITY_UNKNOWN;
+      this->uniteComponents(a, b);
+      pending_edges_.push_back(recorded);
+      ++stats.restored_edges;
+    }
+    removed_edges_.swap(removed_edges);
+  }
+
+  ROS_DEBUG_NAMED(LOGNAME,
+                  "Marked %zu of %zu vertices and %zu of %zu edges of roadmap '%s' for validation, restored %zu "
+                  "vertices and %zu edges",
+                  stats.invalidated_vertices, stats.vertices, stats.invalidated_edges, stats.edges,
+                  this->getName().c_str(), stats.restored_vertices, stats.restored_edges);
+  return stats;
+}
+
+template class PersistentLazyRoadmap<ompl::geometric::LazyPRM>;
+template class PersistentLazyRoadmap<ompl::geometric::LazyPRMstar>;
+}  // namespace ompl_interface
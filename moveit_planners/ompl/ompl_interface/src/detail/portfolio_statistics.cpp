@@ -0,0 +1,111 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/portfolio_statistics.h>
+#include <ompl/util/Time.h>
+#include <atomic>
+#include <thread>
+
+namespace ompl_interface
+{
+void PortfolioStatistics::recordRace(const std::vector<std::string>& planners, const std::string& winner, double time)
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  ++races_;
+  for (const std::string& planner : planners)
+    ++records_[planner].runs;
+  if (!winner.empty())
+  {
+    Record& record = records_[winner];
+    ++record.wins;
+    record.win_time += time;
+  }
+}
+
+std::size_t PortfolioStatistics::getRaceCount() const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  return races_;
+}
+
+std::map<std::string, PortfolioStatistics::Record> PortfolioStatistics::getRecords() const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  return records_;
+}
+
+void PortfolioStatistics::print(std::ostream& out) const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  out << races_ << " races" << std::endl;
+  for (const std::pair<const std::string, Record>& entry : records_)
+  {
+    const Record& record = entry.second;
+    out << "  " << entry.first << ": won " << record.wins << " of " << record.runs;
+    if (record.wins > 0)
+      out << ", in " << record.win_time / record.wins << "s on average";
+    out << std::endl;
+  }
+}
+
+std::size_t racePlanners(const std::vector<ompl::base::PlannerPtr>& planners,
+                         const ompl::base::PlannerTerminationCondition& ptc,
+                         std::vector<ompl::base::PlannerStatus>& status, double& time)
+{
+  // the first exact solution terminates all other planners
+  std::atomic<bool> solved(false);
+  std::size_t winner = planners.size();
+  time = 0.0;
+  const ompl::time::point start = ompl::time::now();
+  const ompl::base::PlannerTerminationCondition race_ptc = ompl::base::plannerOrTerminationCondition(
+      ptc, ompl::base::PlannerTerminationCondition([&solved] { return solved.load(); }));
+
+  status.assign(planners.size(), ompl::base::PlannerStatus::UNKNOWN);
+  std::vector<std::thread> threads;
+  threads.reserve(planners.size());
+  for (std::size_t i = 0; i < planners.size(); ++i)
+    threads.emplace_back([&, i] {
+      status[i] = planners[i]->solve(race_ptc);
+      bool expected = false;
+      if (status[i] == ompl::base::PlannerStatus::EXACT_SOLUTION && solved.compare_exchange_strong(expected, true))
+      {
+        winner = i;
+        time = ompl::time::seconds(ompl::time::now() - start);
+      }
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  return winner;
+}
+}  // namespace ompl_interface
@@ -47,6 +47,9 @@ ompl_interface::ProjectionEvaluatorLinkPose::ProjectionEvaluatorLinkPose(const M
   , link_(planning_context_->getJointModelGroup()->getLinkModel(link))
   , tss_(planning_context_->getCompleteInitialRobotState())
 {
+  // have the state space memoize the link position whenever it computes forward kinematics
+  if (!planning_context_->getOMPLStateSpace()->getCachedLink())
+    planning_context_->getOMPLStateSpace()->setCachedLink(link_);
 }
 
 unsigned int ompl_interface::ProjectionEvaluatorLinkPose::getDimension() const
@@ -65,13 +68,26 @@ void ompl_interface::ProjectionEvaluatorLinkPose::defaultCellSizes()
 void ompl_interface::ProjectionEvaluatorLinkPose::project(const ompl::base::State* state,
                                                           OMPLProjection projection) const
 {
-  moveit::core::RobotState* s = tss_.getStateStorage();
-  planning_context_->getOMPLStateSpace()->copyToRobotState(*s, state);
-
-  const Eigen::Vector3d& o = s->getGlobalLinkTransform(link_).translation();
-  projection(0) = o.x();
-  projection(1) = o.y();
-  projection(2) = o.z();
+  const auto* model_state = state->as<ModelBasedStateSpace::StateType>();
+  const bool memoized = planning_context_->getOMPLStateSpace()->getCachedLink() == link_;
+  if (!memoized || !model_state->isLinkPositionKnown())
+  {
+    // compute the transforms along the chain only, not the full forward kinematics
+    moveit::core::RobotState* s = tss_.getStateStorage();
+    s->setJointGroupPositions(planning_context_->getJointModelGroup(), model_state->values);
+    const Eigen::Isometry3d& pose = s->getGlobalLinkTransformOnChain(link_);
+    if (!memoized)
+    {
+      projection(0) = pose.translation().x();
+      projection(1) = pose.translation().y();
+      projection(2) = pose.translation().z();
+      return;
+    }
+    const_cast<ModelBasedStateSpace::StateType*>(model_state)->setLinkPosition(pose.translation());
+  }
+  projection(0) = model_state->link_position[0];
+  projection(1) = model_state->link_position[1];
+  projection(2) = model_state->link_position[2];
 }
 
 ompl_interface::ProjectionEvaluatorJointValue::ProjectionEvaluatorJointValue(const ModelBasedPlanningContext* pc,
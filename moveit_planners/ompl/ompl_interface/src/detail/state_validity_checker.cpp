@@ -36,6 +36,7 @@
 
 #include <moveit/ompl_interface/detail/state_validity_checker.h>
 #include <moveit/ompl_interface/model_based_planning_context.h>
+#include <moveit/collision_detection_fcl/collision_env_fcl.h>
 #include <moveit/profiler/profiler.h>
 #include <ros/ros.h>
 
@@ -66,6 +67,10 @@ ompl_interface::StateValidityChecker::StateValidityChecker(const ModelBasedPlann
 
   collision_request_with_distance_verbose_ = collision_request_with_distance_;
   collision_request_with_distance_verbose_.verbose = true;
+
+  collision_request_with_contact_ = collision_request_simple_;
+  collision_request_with_contact_.contacts = true;
+  collision_request_with_contact_.max_contacts = 1;
 }
 
 void ompl_interface::StateValidityChecker::setVerbose(bool flag)
@@ -73,6 +78,188 @@ void ompl_interface::StateValidityChecker::setVerbose(bool flag)
   verbose_ = flag;
 }
 
+ompl_interface::StateValidityChecker::CollisionMemory* ompl_interface::StateValidityChecker::getCollisionMemory() const
+{
+  CollisionMemory* memory = collision_memory_.get();
+  if (!memory)
+  {
+    memory = new CollisionMemory();
+    collision_memory_.reset(memory);
+  }
+  return memory;
+}
+
+void ompl_interface::StateValidityChecker::beginMotion() const
+{
+  ++getCollisionMemory()->motions;
+}
+
+void ompl_interface::StateValidityChecker::endMotion() const
+{
+  --getCollisionMemory()->motions;
+}
+
+std::size_t ompl_interface::StateValidityChecker::getSceneCollisionCheckCount() const
+{
+  return getCollisionMemory()->scene_checks;
+}
+
+bool ompl_interface::StateValidityChecker::isColliding(moveit::core::RobotState& robot_state, bool verbose) const
+{
+  const planning_scene::PlanningSceneConstPtr& scene = planning_context_->getPlanningScene();
+  CollisionMemory* memory = getCollisionMemory();
+  const bool within_motion = !verbose && memory->motions > 0;
+
+  // test the pair that collided last, only
+  if (within_motion && memory->has_pair)
+  {
+    if (memory->scene == scene.get() && memory->world_version == scene->getWorld()->getVersion())
+    {
+      robot_state.updateCollisionBodyTransforms();
+      if (isPairColliding(robot_state, *memory))
+        return true;
+    }
+    else
+      memory->has_pair = false;
+  }
+
+  ++memory->scene_checks;
+  collision_detection::CollisionResult res;
+  scene->checkCollision(verbose ? collision_request_simple_verbose_ : collision_request_simple_, res, robot_state);
+  if (!res.collision || !within_motion)
+    return res.collision;
+
+  // find the colliding pair to remember
+  ++memory->scene_checks;
+  res.clear();
+  scene->checkCollision(collision_request_with_contact_, res, robot_state);
+  if (!res.contacts.empty() && !res.contacts.begin()->second.empty())
+    rememberPair(*scene, robot_state, res.contacts.begin()->second.front(), *memory);
+  return true;
+}
+
+void ompl_interface::StateValidityChecker::rememberPair(const planning_scene::PlanningScene& scene,
+                                                        const moveit::core::RobotState& robot_state,
+                                                        const collision_detection::Contact& contact,
+                                                        CollisionMemory& memory) const
+{
+  memory.has_pair = false;
+
+  // the pair is tested with FCL, so it needs to agree with the collision detector of the scene
+  const bool self_collision = contact.body_type_1 != collision_detection::BodyTypes::WORLD_OBJECT &&
+                              contact.body_type_2 != collision_detection::BodyTypes::WORLD_OBJECT;
+  const collision_detection::CollisionEnvConstPtr& env =
+      self_collision ? scene.getCollisionEnvUnpadded() : scene.getCollisionEnv();
+  if (!dynamic_cast<const collision_detection::CollisionEnvFCL*>(env.get()))
+    return;
+
+  // conditionally allowed collisions are decided by checking the whole scene
+  collision_detection::AllowedCollision::Type type;
+  if (scene.getAllowedCollisionMatrix().getAllowedCollision(contact.body_name_1, contact.body_name_2, type) &&
+      type != collision_detection::AllowedCollision::NEVER)
+    return;
+
+  const std::pair<const std::string*, collision_detection::BodyType> names[2] = {
+    { &contact.body_name_1, contact.body_type_1 }, { &contact.body_name_2, contact.body_type_2 }
+  };
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    CollisionBody& body = memory.bodies[i];
+    body.type = names[i].second;
+    body.name = *names[i].first;
+    body.link = nullptr;
+    body.object.reset();
+    body.geometry.clear();
+    body.shape_indices.clear();
+
+    const std::vector<shapes::ShapeConstPtr>* shapes = nullptr;
+    const moveit::core::AttachedBody* attached_body = nullptr;
+    if (body.type == collision_detection::BodyTypes::ROBOT_LINK)
+    {
+      body.link = robot_state.getRobotModel()->getLinkModel(body.name);
+      if (body.link)
+        shapes = &body.link->getShapes();
+    }
+    else if (body.type == collision_detection::BodyTypes::ROBOT_ATTACHED)
+    {
+      attached_body = robot_state.getAttachedBody(body.name);
+      if (attached_body)
+        shapes = &attached_body->getShapes();
+    }
+    else
+    {
+      body.object = scene.getWorld()->getObject(body.name);
+      if (body.object)
+        shapes = &body.object->shapes_;
+    }
+    if (!shapes)
+      return;
+
+    // create the geometry the way the collision environment does
+    for (std::size_t j = 0; j < shapes->size(); ++j)
+    {
+      collision_detection::FCLGeometryConstPtr geometry;
+      if (body.link)
+        geometry = collision_detection::createCollisionGeometry((*shapes)[j], env->getLinkScale(body.name),
+                                                               env->getLinkPadding(body.name), body.link, j);
+      else if (attached_body)
+        geometry = collision_detection::createCollisionGeometry(
+            (*shapes)[j], env->getLinkScale(attached_body->getAttachedLinkName()),
+            env->getLinkPadding(attached_body->getAttachedLinkName()), attached_body, j);
+      else
+        geometry = collision_detection::createCollisionGeometry((*shapes)[j], body.object.get());
+      if (geometry)
+      {
+        body.geometry.push_back(geometry);
+        body.shape_indices.push_back(j);
+      }
+    }
+  }
+
+  memory.scene = &scene;
+  memory.world_version = scene.getWorld()->getVersion();
+  memory.has_pair = true;
+}
+
+bool ompl_interface::StateValidityChecker::isPairColliding(const moveit::core::RobotState& robot_state,
+                                                           const CollisionMemory& memory) const
+{
+  const moveit::core::AttachedBody* attached_bodies[2] = { nullptr, nullptr };
+  for (std::size_t i = 0; i < 2; ++i)
+    if (memory.bodies[i].type == collision_detection::BodyTypes::ROBOT_ATTACHED)
+    {
+      attached_bodies[i] = robot_state.getAttachedBody(memory.bodies[i].name);
+      if (!attached_bodies[i])
+        return false;
+    }
+
+  // the current global pose of the j-th geometry of body i
+  auto shape_pose = [&robot_state, &memory, &attached_bodies](std::size_t i, std::size_t j) {
+    const CollisionBody& body = memory.bodies[i];
+    const std::size_t index = body.shape_indices[j];
+    if (body.link)
+      return collision_detection::transform2fcl(robot_state.getCollisionBodyTransform(body.link, index));
+    if (attached_bodies[i])
+      return collision_detection::transform2fcl(attached_bodies[i]->getGlobalCollisionBodyTransforms()[index]);
+    return collision_detection::transform2fcl(body.object->global_shape_poses_[index]);
+  };
+
+  // a boolean test of each pair of shapes, without contact information
+  fcl::CollisionRequestd request;
+  for (std::size_t j = 0; j < memory.bodies[0].geometry.size(); ++j)
+  {
+    const fcl::Transform3d first_pose = shape_pose(0, j);
+    for (std::size_t k = 0; k < memory.bodies[1].geometry.size(); ++k)
+    {
+      fcl::CollisionResultd result;
+      if (fcl::collide(memory.bodies[0].geometry[j]->collision_geometry_.get(), first_pose,
+                       memory.bodies[1].geometry[k]->collision_geometry_.get(), shape_pose(1, k), request, result) > 0)
+        return true;
+    }
+  }
+  return false;
+}
+
 bool ompl_interface::StateValidityChecker::isValid(const ompl::base::State* state, bool verbose) const
 {
   // Use cached validity if it is available
@@ -106,10 +293,8 @@ bool ompl_interface::StateValidityChecker::isValid(const ompl::base::State* stat
   }
 
   // check collision avoidance
-  collision_detection::CollisionResult res;
-  planning_context_->getPlanningScene()->checkCollision(
-      verbose ? collision_request_simple_verbose_ : collision_request_simple_, res, *robot_state);
-  if (!res.collision)
+  bool collision = isColliding(*robot_state, verbose);
+  if (!collision)
   {
     const_cast<ob::State*>(state)->as<ModelBasedStateSpace::StateType>()->markValid();
   }
@@ -117,7 +302,7 @@ bool ompl_interface::StateValidityChecker::isValid(const ompl::base::State* stat
   {
     const_cast<ob::State*>(state)->as<ModelBasedStateSpace::StateType>()->markInvalid();
   }
-  return !res.collision;
+  return !collision;
 }
 
 bool ompl_interface::StateValidityChecker::isValid(const ompl::base::State* state, double& dist, bool verbose) const
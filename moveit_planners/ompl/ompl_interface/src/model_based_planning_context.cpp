@@ -44,13 +44,21 @@
 #include <moveit/ompl_interface/detail/goal_union.h>
 #include <moveit/ompl_interface/detail/projection_evaluators.h>
 #include <moveit/ompl_interface/detail/constraints_library.h>
+#include <moveit/ompl_interface/detail/lazy_motion_validator.h>
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.h>
+#include <moveit/ompl_interface/detail/persistent_roadmap.h>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
 
 #include <moveit/kinematic_constraints/utils.h>
 #include <moveit/profiler/profiler.h>
 #include <moveit/utils/lexical_casts.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include <ompl/config.h>
 #include <ompl/base/samplers/UniformValidStateSampler.h>
+#include <ompl/base/DiscreteMotionValidator.h>
 #include <ompl/base/goals/GoalLazySamples.h>
 #include <ompl/tools/config/SelfConfig.h>
 #include <ompl/base/spaces/SE3StateSpace.h>
@@ -71,10 +79,28 @@
 #include "ompl/base/objectives/StateCostIntegralObjective.h"
 #include "ompl/base/objectives/MaximizeMinClearanceObjective.h"
 #include <ompl/geometric/planners/prm/LazyPRM.h>
+#include <ompl/base/PlannerData.h>
 
 namespace ompl_interface
 {
 constexpr char LOGNAME[] = "model_based_planning_context";
+
+namespace
+{
+// Estimate the memory of the states and connections a planner keeps, e.g. the roadmap of a multi-query planner
+std::size_t getPlannerMemoryUsage(const ob::Planner& planner)
+{
+  if (!planner.isSetup())
+    return 0;
+  const ob::SpaceInformationPtr& si = planner.getSpaceInformation();
+  ob::PlannerData data(si);
+  planner.getPlannerData(data);
+  const std::size_t vertex_bytes = si->getStateSpace()->getSerializationLength() + sizeof(ob::PlannerDataVertex) +
+                                   sizeof(ob::State*) + sizeof(void*);
+  const std::size_t edge_bytes = sizeof(ob::PlannerDataEdge) + 4 * sizeof(void*);
+  return data.numVertices() * vertex_bytes + data.numEdges() * edge_bytes;
+}
+}  // namespace
 }  // namespace ompl_interface
 
 ompl_interface::ModelBasedPlanningContext::ModelBasedPlanningContext(const std::string& name,
@@ -87,6 +113,7 @@ ompl_interface::ModelBasedPlanningContext::ModelBasedPlanningContext(const std::
   , ompl_parallel_plan_(ompl_simple_setup_->getProblemDefinition())
   , ptc_(nullptr)
   , last_plan_time_(0.0)
+  , stored_memory_usage_(0)
   , last_simplify_time_(0.0)
   , max_goal_samples_(0)
   , max_state_sampling_attempts_(0)
@@ -98,6 +125,10 @@ ompl_interface::ModelBasedPlanningContext::ModelBasedPlanningContext(const std::
   , simplify_solutions_(true)
   , interpolate_(true)
   , hybridize_(true)
+  , lazy_motion_validation_(false)
+  , simplification_threads_(1)
+  , experience_candidates_(3)
+  , experience_min_distance_(0.1)
 {
   complete_initial_robot_state_.update();
 
@@ -110,6 +141,7 @@ void ompl_interface::ModelBasedPlanningContext::configure(const ros::NodeHandle&
   if (!use_constraints_approximations)
   {
     setConstraintsApproximations(ConstraintsLibraryPtr());
+    constraints_library_path_.clear();
   }
   complete_initial_robot_state_.update();
   ompl_simple_setup_->getStateSpace()->computeSignature(space_signature_);
@@ -134,6 +166,14 @@ void ompl_interface::ModelBasedPlanningContext::configure(const ros::NodeHandle&
   }
 
   useConfig();
+
+  // optionally check the last colliding pair of bodies first along motions
+  const ob::SpaceInformationPtr& si = ompl_simple_setup_->getSpaceInformation();
+  if (lazy_motion_validation_)
+    si->setMotionValidator(std::make_shared<LazyMotionValidator>(si));
+  else
+    si->setMotionValidator(std::make_shared<ob::DiscreteMotionValidator>(si));
+
   if (ompl_simple_setup_->getGoal())
     ompl_simple_setup_->setup();
 }
@@ -256,6 +296,8 @@ ompl_interface::ModelBasedPlanningContext::allocPathConstrainedSampler(const omp
 void ompl_interface::ModelBasedPlanningContext::useConfig()
 {
   const std::map<std::string, std::string>& config = spec_.config_;
+  portfolio_.clear();
+  portfolio_planners_.clear();
   if (config.empty())
     return;
   std::map<std::string, std::string> cfg = config;
@@ -340,6 +382,10 @@ void ompl_interface::ModelBasedPlanningContext::useConfig()
   it = cfg.find("multi_query_planning_enabled");
   if (it != cfg.end())
     multi_query_planning_enabled_ = boost::lexical_cast<bool>(it->second);
+  // persistent roadmaps are multi-query planners as well
+  it = cfg.find("persistent_roadmap");
+  if (it != cfg.end() && boost::lexical_cast<bool>(it->second))
+    multi_query_planning_enabled_ = true;
 
   // check whether the path returned by the planner should be interpolated
   it = cfg.find("interpolate");
@@ -349,6 +395,14 @@ void ompl_interface::ModelBasedPlanningContext::useConfig()
     cfg.erase(it);
   }
 
+  // check whether motions should be validated by LazyMotionValidator
+  it = cfg.find("lazy_motion_validation");
+  if (it != cfg.end())
+  {
+    lazy_motion_validation_ = boost::lexical_cast<bool>(it->second);
+    cfg.erase(it);
+  }
+
   // check whether solution paths from parallel planning should be hybridized
   it = cfg.find("hybridize");
   if (it != cfg.end())
@@ -357,6 +411,54 @@ void ompl_interface::ModelBasedPlanningContext::useConfig()
     cfg.erase(it);
   }
 
+  // number of threads simplifying solution paths in parallel
+  it = cfg.find("simplification_threads");
+  if (it != cfg.end())
+  {
+    simplification_threads_ = boost::lexical_cast<unsigned int>(it->second);
+    cfg.erase(it);
+  }
+
+  // the experience database is opened by the PlanningContextManager
+  it = cfg.find("experience_database");
+  if (it != cfg.end())
+    cfg.erase(it);
+  it = cfg.find("experience_candidates");
+  if (it != cfg.end())
+  {
+    experience_candidates_ = boost::lexical_cast<unsigned int>(it->second);
+    cfg.erase(it);
+  }
+  it = cfg.find("experience_min_distance");
+  if (it != cfg.end())
+  {
+    experience_min_distance_ = moveit::core::toDouble(it->second);
+    cfg.erase(it);
+  }
+
+  // race a portfolio of different planner types, e.g. "geometric::RRTConnect geometric::BiTRRT geometric::KPIECE"
+  it = cfg.find("portfolio");
+  if (it != cfg.end())
+  {
+    std::vector<std::string> planner_types;
+    boost::split(planner_types, it->second, boost::is_any_of(", "), boost::token_compress_on);
+    for (const std::string& planner_type : planner_types)
+    {
+      if (planner_type.empty())
+        continue;
+      ConfiguredPlannerAllocator allocator = spec_.planner_selector_(planner_type);
+      if (allocator)
+        portfolio_.emplace_back(planner_type, allocator);
+    }
+    if (multi_query_planning_enabled_ && !portfolio_.empty())
+    {
+      ROS_WARN_NAMED(LOGNAME, "%s: Planner portfolios don't support multi-query planning. Ignoring the portfolio.",
+                     name_.c_str());
+      portfolio_.clear();
+    }
+    cfg.erase(it);
+  }
+
   // remove the 'type' parameter; the rest are parameters for the planner itself
   it = cfg.find("type");
   if (it == cfg.end())
@@ -407,8 +509,34 @@ void ompl_interface::ModelBasedPlanningContext::simplifySolution(double timeout)
   ompl::time::point start = ompl::time::now();
   ob::PlannerTerminationCondition ptc = constructPlannerTerminationCondition(timeout, start);
   registerTerminationCondition(ptc);
-  ompl_simple_setup_->simplifySolution(ptc);
-  last_simplify_time_ = ompl_simple_setup_->getLastSimplificationTime();
+
+  // collect the exact solutions, e.g. of all planners run by ParallelPlan
+  std::vector<og::PathGeometric> paths;
+  if (simplification_threads_ > 1)
+  {
+    const ob::ProblemDefinitionPtr& pdef = ompl_simple_setup_->getProblemDefinition();
+    for (const ob::PlannerSolution& solution : pdef->getSolutions())
+      if (!solution.approximate_)
+        paths.push_back(*solution.path_->as<og::PathGeometric>());
+  }
+
+  if (paths.empty())
+  {
+    ompl_simple_setup_->simplifySolution(ptc);
+    last_simplify_time_ = ompl_simple_setup_->getLastSimplificationTime();
+  }
+  else
+  {
+    unsigned int threads = simplification_threads_;
+    if (max_planning_threads_ > 0)
+      threads = std::min(threads, max_planning_threads_);
+    ParallelPathSimplifier simplifier(ompl_simple_setup_->getSpaceInformation(), ompl_simple_setup_->getGoal(),
+                                      ompl_simple_setup_->getProblemDefinition()->getOptimizationObjective(), threads);
+    simplifier.simplify(paths, ptc, ompl_simple_setup_->getSolutionPath(), hybridize_);
+    last_simplify_time_ = ompl::time::seconds(ompl::time::now() - start);
+    ROS_DEBUG_NAMED(LOGNAME, "%s: Simplified %zu solution path(s) on %u threads in %lf seconds", name_.c_str(),
+                    paths.size(), threads, last_simplify_time_);
+  }
   unregisterTerminationCondition();
 }
 
@@ -570,8 +698,10 @@ void ompl_interface::ModelBasedPlanningContext::clear()
     // This means that we need to reset the validity flags for every node and edge in
     // the roadmap. For PRM and PRMstar we assume that the environment is static. If
     // this is not the case, then multi-query planning should not be enabled.
+    // Persistent roadmaps track the scene changes themselves and only reset the validity of the parts close to
+    // changed objects, see PlanningContextManager::getPlanningContext().
     auto planner = dynamic_cast<ompl::geometric::LazyPRM*>(ompl_simple_setup_->getPlanner().get());
-    if (planner != nullptr)
+    if (planner != nullptr && dynamic_cast<PersistentRoadmap*>(planner) == nullptr)
       planner->clearValidity();
   }
 #endif
@@ -678,6 +808,9 @@ void ompl_interface::ModelBasedPlanningContext::postSolve()
   int v = ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->getValidMotionCount();
   int iv = ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->getInvalidMotionCount();
   ROS_DEBUG_NAMED(LOGNAME, "There were %d valid motions and %d invalid motions.", v, iv);
+
+  // planners may have grown their roadmaps
+  storeMemoryUsage();
 }
 
 bool ompl_interface::ModelBasedPlanningContext::solve(planning_interface::MotionPlanResponse& res)
@@ -691,6 +824,7 @@ bool ompl_interface::ModelBasedPlanningContext::solve(planning_interface::Motion
       simplifySolution(request_.allowed_planning_time - ptime);
       ptime += getLastSimplifyTime();
     }
+    storeExperience();
 
     if (interpolate_)
       interpolateSolution();
@@ -736,6 +870,7 @@ bool ompl_interface::ModelBasedPlanningContext::solve(planning_interface::Motion
       res.trajectory_.back() = std::make_shared<robot_trajectory::RobotTrajectory>(getRobotModel(), getGroupName());
       getSolutionPath(*res.trajectory_.back());
     }
+    storeExperience();
 
     if (interpolate_)
     {
@@ -769,11 +904,26 @@ const moveit_msgs::MoveItErrorCodes ompl_interface::ModelBasedPlanningContext::s
   result.val = moveit_msgs::MoveItErrorCodes::FAILURE;
   ob::PlannerTerminationCondition ptc = constructPlannerTerminationCondition(timeout, start);
   registerTerminationCondition(ptc);
-  if (count <= 1 || multi_query_planning_enabled_)  // multi-query planners should always run in single instances
+  if (!portfolio_.empty())
+  {
+    ROS_DEBUG_NAMED(LOGNAME, "%s: Racing a portfolio of %zu planners...", name_.c_str(), portfolio_.size());
+    result.val = errorCode(solvePortfolio(ptc));
+    last_plan_time_ = ompl::time::seconds(ompl::time::now() - start);
+  }
+  else if (count <= 1 || multi_query_planning_enabled_)  // multi-query planners should always run in single instances
   {
     ROS_DEBUG_NAMED(LOGNAME, "%s: Solving the planning problem once...", name_.c_str());
-    result.val = errorCode(ompl_simple_setup_->solve(ptc));
-    last_plan_time_ = ompl_simple_setup_->getLastPlanComputationTime();
+    if (spec_.experience_database_ &&
+        spec_.state_space_->getParameterizationType() == JointModelStateSpace::PARAMETERIZATION_TYPE)
+    {
+      result.val = errorCode(solveWithExperience(ptc));
+      last_plan_time_ = ompl::time::seconds(ompl::time::now() - start);
+    }
+    else
+    {
+      result.val = errorCode(ompl_simple_setup_->solve(ptc));
+      last_plan_time_ = ompl_simple_setup_->getLastPlanComputationTime();
+    }
   }
   else
   {
@@ -811,6 +961,164 @@ const moveit_msgs::MoveItErrorCodes ompl_interface::ModelBasedPlanningContext::s
   return result;
 }
 
+ompl::base::PlannerStatus
+ompl_interface::ModelBasedPlanningContext::solveWithExperience(const ob::PlannerTerminationCondition& ptc)
+{
+  const ExperienceDatabasePtr& database = spec_.experience_database_;
+  std::atomic<bool> solved_from_experience(false);
+  std::atomic<bool> solved_from_scratch(false);
+  const ompl::time::point start = ompl::time::now();
+
+  const ob::PlannerTerminationCondition experience_ptc = ob::plannerOrTerminationCondition(
+      ptc, ob::PlannerTerminationCondition([&solved_from_scratch] { return solved_from_scratch.load(); }));
+  std::thread experience_thread([this, &experience_ptc, &solved_from_experience] {
+    if (solveFromExperience(experience_ptc))
+      solved_from_experience = true;
+  });
+
+  const ob::PlannerTerminationCondition scratch_ptc = ob::plannerOrTerminationCondition(
+      ptc, ob::PlannerTerminationCondition([&solved_from_experience] { return solved_from_experience.load(); }));
+  ob::PlannerStatus status = ompl_simple_setup_->solve(scratch_ptc);
+  solved_from_scratch = true;
+  experience_thread.join();
+
+  const bool hit = solved_from_experience && status != ob::PlannerStatus::EXACT_SOLUTION;
+  const double time = ompl::time::seconds(ompl::time::now() - start);
+  database->recordQuery(hit, time);
+  const ExperienceDatabase::Statistics stats = database->getStatistics();
+  if (hit)
+  {
+    ROS_INFO_NAMED(LOGNAME,
+                   "%s: Solved from experience in %f seconds (%zu of %zu queries, about %f seconds saved in total)",
+                   name_.c_str(), time, stats.hits, stats.queries, stats.getTimeSaved());
+    status = ob::PlannerStatus::EXACT_SOLUTION;
+  }
+  else
+    ROS_DEBUG_NAMED(LOGNAME, "%s: Solved from scratch in %f seconds (experience hit rate %zu of %zu queries)",
+                    name_.c_str(), time, stats.hits, stats.queries);
+  return status;
+}
+
+bool ompl_interface::ModelBasedPlanningContext::solveFromExperience(const ob::PlannerTerminationCondition& ptc)
+{
+  const ob::SpaceInformationPtr& si = ompl_simple_setup_->getSpaceInformation();
+  const ob::ProblemDefinitionPtr& pdef = ompl_simple_setup_->getProblemDefinition();
+  const ob::State* start = pdef->getStartState(0);
+  if (!start || !pdef->getGoal() || !pdef->getGoal()->hasType(ob::GOAL_SAMPLEABLE_REGION))
+    return false;
+
+  // goals are sampled in the background, wait for the first sample
+  const auto* goal = pdef->getGoal()->as<ob::GoalSampleableRegion>();
+  while (goal->maxSampleCount() == 0 && goal->canSample() && !ptc())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  if (goal->maxSampleCount() == 0 || ptc())
+    return false;
+  ob::ScopedState<> goal_state(si);
+  goal->sampleGoal(goal_state.get());
+
+  const std::size_t dof = getJointModelGroup()->getVariableCount();
+  const double* start_values = start->as<ModelBasedStateSpace::StateType>()->values;
+  const double* goal_values = goal_state->as<ModelBasedStateSpace::StateType>()->values;
+  std::vector<std::vector<std::vector<double>>> paths;
+  spec_.experience_database_->findPaths(std::vector<double>(start_values, start_values + dof),
+                                        std::vector<double>(goal_values, goal_values + dof), experience_candidates_,
+                                        paths);
+
+  ob::ScopedState<> waypoint_state(si);
+  for (const std::vector<std::vector<double>>& waypoints : paths)
+  {
+    if (ptc())
+      return false;
+    auto path = std::make_shared<og::PathGeometric>(si);
+    path->append(start);
+    for (const std::vector<double>& waypoint : waypoints)
+    {
+      waypoint_state->as<ModelBasedStateSpace::StateType>()->clearKnownInformation();
+      std::copy(waypoint.begin(), waypoint.end(), waypoint_state->as<ModelBasedStateSpace::StateType>()->values);
+      path->append(waypoint_state.get());
+    }
+    path->append(goal_state.get());
+    if (ExperienceDatabase::repairPath(*path, ptc))
+    {
+      pdef->addSolutionPath(path, false, 0.0, "ExperienceRepair");
+      return true;
+    }
+  }
+  return false;
+}
+
+void ompl_interface::ModelBasedPlanningContext::storeExperience()
+{
+  if (!spec_.experience_database_ || !ompl_simple_setup_->haveExactSolutionPath() ||
+      spec_.state_space_->getParameterizationType() != JointModelStateSpace::PARAMETERIZATION_TYPE)
+    return;
+
+  const og::PathGeometric& path = ompl_simple_setup_->getSolutionPath();
+  const std::size_t dof = getJointModelGroup()->getVariableCount();
+  std::vector<std::vector<double>> waypoints;
+  waypoints.reserve(path.getStateCount());
+  for (const ob::State* state : path.getStates())
+  {
+    const double* values = state->as<ModelBasedStateSpace::StateType>()->values;
+    waypoints.emplace_back(values, values + dof);
+  }
+  if (spec_.experience_database_->addPath(waypoints, experience_min_distance_))
+    ROS_DEBUG_NAMED(LOGNAME, "%s: Stored solution with %zu states as experience", name_.c_str(), waypoints.size());
+}
+
+ompl::base::PlannerStatus
+ompl_interface::ModelBasedPlanningContext::solvePortfolio(const ob::PlannerTerminationCondition& ptc)
+{
+  ompl_simple_setup_->setup();
+  const ob::SpaceInformationPtr& si = ompl_simple_setup_->getSpaceInformation();
+  const ob::ProblemDefinitionPtr& pdef = ompl_simple_setup_->getProblemDefinition();
+  const std::string planner_name = getGroupName() + "/" + name_;
+
+  // planners are allocated by the first race and reused by the following ones, like the planner of
+  // ompl_simple_setup_
+  if (portfolio_planners_.empty())
+    for (const std::pair<std::string, ConfiguredPlannerAllocator>& entry : portfolio_)
+      portfolio_planners_.push_back(entry.second(si, planner_name + "/" + entry.first, spec_));
+  std::vector<std::string> planner_types;
+  for (std::size_t i = 0; i < portfolio_planners_.size(); ++i)
+  {
+    const ob::PlannerPtr& planner = portfolio_planners_[i];
+    planner->clear();
+    planner->setProblemDefinition(pdef);
+    if (!planner->isSetup())
+      planner->setup();
+    planner_types.push_back(portfolio_[i].first);
+  }
+  const std::vector<ob::PlannerPtr>& planners = portfolio_planners_;
+
+  std::vector<ob::PlannerStatus> status;
+  double win_time = 0.0;
+  const std::size_t winner = racePlanners(planners, ptc, status, win_time);
+
+  if (spec_.portfolio_statistics_)
+  {
+    spec_.portfolio_statistics_->recordRace(planner_types, winner < planners.size() ? planner_types[winner] : "",
+                                            win_time);
+    std::stringstream ss;
+    spec_.portfolio_statistics_->print(ss);
+    ROS_DEBUG_STREAM_NAMED(LOGNAME, name_ << ": Portfolio statistics after " << ss.str());
+  }
+  if (winner < planners.size())
+  {
+    ROS_DEBUG_NAMED(LOGNAME, "%s: Planner '%s' won the race after %f seconds", name_.c_str(),
+                    planner_types[winner].c_str(), win_time);
+    return ob::PlannerStatus::EXACT_SOLUTION;
+  }
+
+  // report the most informative failure
+  if (pdef->hasApproximateSolution())
+    return ob::PlannerStatus::APPROXIMATE_SOLUTION;
+  for (const ob::PlannerStatus& s : status)
+    if (s != ob::PlannerStatus::TIMEOUT && s != ob::PlannerStatus::UNKNOWN)
+      return s;
+  return ob::PlannerStatus::TIMEOUT;
+}
+
 void ompl_interface::ModelBasedPlanningContext::registerTerminationCondition(const ob::PlannerTerminationCondition& ptc)
 {
   std::unique_lock<std::mutex> slock(ptc_lock_);
@@ -896,7 +1204,13 @@ bool ompl_interface::ModelBasedPlanningContext::loadConstraintApproximations(con
   std::string constraint_path;
   if (nh.getParam("constraint_approximations_path", constraint_path))
   {
+    // reconfiguring a cached context doesn't need to load the approximations again
+    if (constraints_library_ && constraint_path == constraints_library_path_)
+      return true;
+    if (!constraints_library_)
+      constraints_library_ = std::make_shared<ConstraintsLibrary>(this);
     constraints_library_->loadConstraintApproximations(constraint_path);
+    constraints_library_path_ = constraint_path;
     std::stringstream ss;
     constraints_library_->printConstraintApproximations(ss);
     ROS_INFO_STREAM(ss.str());
@@ -904,3 +1218,26 @@ bool ompl_interface::ModelBasedPlanningContext::loadConstraintApproximations(con
   }
   return false;
 }
+
+std::size_t ompl_interface::ModelBasedPlanningContext::storeMemoryUsage()
+{
+  stored_memory_usage_ = getMemoryUsage();
+  return stored_memory_usage_;
+}
+
+std::size_t ompl_interface::ModelBasedPlanningContext::getMemoryUsage() const
+{
+  const moveit::core::RobotModel& robot_model = *getRobotModel();
+  // a RobotState stores positions, velocities, accelerations and efforts, and the transforms of joints and links
+  const std::size_t robot_state_bytes = 4 * robot_model.getVariableCount() * sizeof(double) +
+                                        (robot_model.getJointModelCount() + 2 * robot_model.getLinkModelCount()) *
+                                            sizeof(Eigen::Isometry3d);
+  std::size_t bytes = sizeof(*this) + robot_state_bytes;
+  if (constraints_library_)
+    bytes += constraints_library_->getMemoryUsage();
+  if (const ob::PlannerPtr& planner = ompl_simple_setup_->getPlanner())
+    bytes += getPlannerMemoryUsage(*planner);
+  for (const ob::PlannerPtr& planner : portfolio_planners_)
+    bytes += getPlannerMemoryUsage(*planner);
+  return bytes;
+}
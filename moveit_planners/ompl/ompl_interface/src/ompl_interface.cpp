@@ -58,6 +58,7 @@ ompl_interface::OMPLInterface::OMPLInterface(const moveit::core::RobotModelConst
   ROS_DEBUG_NAMED(LOGNAME, "Initializing OMPL interface using ROS parameters");
   loadPlannerConfigurations();
   loadConstraintSamplers();
+  loadContextCacheSettings();
 }
 
 ompl_interface::OMPLInterface::OMPLInterface(const moveit::core::RobotModelConstPtr& robot_model,
@@ -73,6 +74,7 @@ ompl_interface::OMPLInterface::OMPLInterface(const moveit::core::RobotModelConst
   ROS_DEBUG_NAMED(LOGNAME, "Initializing OMPL interface using specified configuration");
   setPlannerConfigurations(pconfig);
   loadConstraintSamplers();
+  loadContextCacheSettings();
 }
 
 ompl_interface::OMPLInterface::~OMPLInterface() = default;
@@ -126,6 +128,26 @@ void ompl_interface::OMPLInterface::loadConstraintSamplers()
       std::make_shared<constraint_sampler_manager_loader::ConstraintSamplerManagerLoader>(constraint_sampler_manager_);
 }
 
+void ompl_interface::OMPLInterface::loadContextCacheSettings()
+{
+  int max_cached_contexts;
+  if (nh_.getParam("max_cached_contexts", max_cached_contexts) && max_cached_contexts > 0)
+    context_manager_.setMaximumCachedContexts(max_cached_contexts);
+  double max_cached_contexts_memory;
+  if (nh_.getParam("max_cached_contexts_memory", max_cached_contexts_memory) && max_cached_contexts_memory > 0.0)
+    context_manager_.setMaximumCachedContextsMemory(static_cast<std::size_t>(max_cached_contexts_memory * 1024 * 1024));
+
+  // planner configuration names, like "panda_arm" or "panda_arm[RRTConnect]"
+  std::vector<std::string> warm_up_configs;
+  if (!nh_.getParam("warm_up_planner_configs", warm_up_configs) || warm_up_configs.empty())
+    return;
+  int warm_up_threads = 1;
+  nh_.getParam("warm_up_threads", warm_up_threads);
+  ROS_INFO_NAMED(LOGNAME, "Warming up %zu planning contexts", warm_up_configs.size());
+  context_manager_.warmUpContexts(warm_up_configs, nh_, use_constraints_approximations_,
+                                  static_cast<unsigned int>(std::max(1, warm_up_threads)));
+}
+
 bool ompl_interface::OMPLInterface::loadPlannerConfiguration(
     const std::string& group_name, const std::string& planner_id,
     const std::map<std::string, std::string>& group_params,
@@ -35,15 +35,29 @@
 /* Author: Ioan Sucan */
 
 #include <moveit/ompl_interface/parameterization/model_based_state_space.h>
+#include <boost/math/constants/constants.hpp>
+#include <Eigen/Core>
+#include <limits>
 #include <utility>
 
 namespace ompl_interface
 {
 constexpr char LOGNAME[] = "model_based_state_space";
+
+namespace
+{
+// linear interpolation of count values, vectorized by Eigen
+void interpolateValues(const double* from, const double* to, double t, double* state, unsigned int count)
+{
+  Eigen::Map<const Eigen::ArrayXd> from_values(from, count);
+  Eigen::Map<const Eigen::ArrayXd> to_values(to, count);
+  Eigen::Map<Eigen::ArrayXd>(state, count) = from_values + (to_values - from_values) * t;
+}
+}  // namespace
 }  // namespace ompl_interface
 
 ompl_interface::ModelBasedStateSpace::ModelBasedStateSpace(ModelBasedStateSpaceSpecification spec)
-  : ompl::base::StateSpace(), spec_(std::move(spec))
+  : ompl::base::StateSpace(), spec_(std::move(spec)), cached_link_(nullptr)
 {
   // set the state space name
   setName(spec_.joint_model_group_->getName());
@@ -71,6 +85,33 @@ ompl_interface::ModelBasedStateSpace::ModelBasedStateSpace(ModelBasedStateSpaceS
     spec_.joint_bounds_[i] = &joint_bounds_storage_[i];
   }
 
+  // groups of single-variable revolute and prismatic joints without mimic joints store one value per joint,
+  // so distance() and interpolate() can process all values at once instead of dispatching per joint
+  vectorized_ = spec_.joint_model_group_->getMimicJointModels().empty() &&
+                joint_model_vector_.size() == variable_count_ && variable_count_ > 0;
+  for (unsigned int i = 0; vectorized_ && i < joint_model_vector_.size(); ++i)
+  {
+    const moveit::core::JointModel* joint = joint_model_vector_[i];
+    if (joint->getType() == moveit::core::JointModel::REVOLUTE &&
+        static_cast<const moveit::core::RevoluteJointModel*>(joint)->isContinuous())
+    {
+      periods_.push_back(2.0 * boost::math::constants::pi<double>());
+      continuous_variables_.push_back(i);
+    }
+    else if (joint->getType() == moveit::core::JointModel::REVOLUTE ||
+             joint->getType() == moveit::core::JointModel::PRISMATIC)
+      periods_.push_back(std::numeric_limits<double>::infinity());
+    else
+      vectorized_ = false;
+    distance_factors_.push_back(joint->getDistanceFactor());
+  }
+  if (!vectorized_)
+  {
+    distance_factors_.clear();
+    periods_.clear();
+    continuous_variables_.clear();
+  }
+
   // default settings
   setTagSnapToSegment(0.95);
 
@@ -121,6 +162,8 @@ void ompl_interface::ModelBasedStateSpace::copyState(ompl::base::State* destinat
   destination->as<StateType>()->tag = source->as<StateType>()->tag;
   destination->as<StateType>()->flags = source->as<StateType>()->flags;
   destination->as<StateType>()->distance = source->as<StateType>()->distance;
+  memcpy(destination->as<StateType>()->link_position, source->as<StateType>()->link_position,
+         sizeof(source->as<StateType>()->link_position));
 }
 
 unsigned int ompl_interface::ModelBasedStateSpace::getSerializationLength() const
@@ -138,6 +181,7 @@ void ompl_interface::ModelBasedStateSpace::deserialize(ompl::base::State* state,
 {
   state->as<StateType>()->tag = *reinterpret_cast<const int*>(serialization);
   memcpy(state->as<StateType>()->values, reinterpret_cast<const char*>(serialization) + sizeof(int), state_values_size_);
+  state->as<StateType>()->clearLinkPosition();
 }
 
 unsigned int ompl_interface::ModelBasedStateSpace::getDimension() const
@@ -171,8 +215,26 @@ double ompl_interface::ModelBasedStateSpace::distance(const ompl::base::State* s
 {
   if (distance_function_)
     return distance_function_(state1, state2);
-  else
-    return spec_.joint_model_group_->distance(state1->as<StateType>()->values, state2->as<StateType>()->values);
+
+  const double* values1 = state1->as<StateType>()->values;
+  const double* values2 = state2->as<StateType>()->values;
+  if (vectorized_)
+  {
+    // min(d, period - d) only wraps correctly for differences up to one period
+    bool in_range = true;
+    for (unsigned int i : continuous_variables_)
+      in_range &= fabs(values1[i] - values2[i]) <= 2.0 * boost::math::constants::pi<double>();
+    if (in_range)
+    {
+      Eigen::Map<const Eigen::ArrayXd> periods(periods_.data(), variable_count_);
+      Eigen::Map<const Eigen::ArrayXd> factors(distance_factors_.data(), variable_count_);
+      const auto d = (Eigen::Map<const Eigen::ArrayXd>(values1, variable_count_) -
+                      Eigen::Map<const Eigen::ArrayXd>(values2, variable_count_))
+                         .abs();
+      return (factors * d.min(periods - d)).sum();
+    }
+  }
+  return spec_.joint_model_group_->distance(values1, values2);
 }
 
 bool ompl_interface::ModelBasedStateSpace::equalStates(const ompl::base::State* state1,
@@ -187,7 +249,8 @@ bool ompl_interface::ModelBasedStateSpace::equalStates(const ompl::base::State*
 
 void ompl_interface::ModelBasedStateSpace::enforceBounds(ompl::base::State* state) const
 {
-  spec_.joint_model_group_->enforcePositionBounds(state->as<StateType>()->values, spec_.joint_bounds_);
+  if (spec_.joint_model_group_->enforcePositionBounds(state->as<StateType>()->values, spec_.joint_bounds_))
+    state->as<StateType>()->clearLinkPosition();
 }
 
 bool ompl_interface::ModelBasedStateSpace::satisfiesBounds(const ompl::base::State* state) const
@@ -205,8 +268,23 @@ void ompl_interface::ModelBasedStateSpace::interpolate(const ompl::base::State*
   if (!interpolation_function_ || !interpolation_function_(from, to, t, state))
   {
     // perform the actual interpolation
-    spec_.joint_model_group_->interpolate(from->as<StateType>()->values, to->as<StateType>()->values, t,
-                                          state->as<StateType>()->values);
+    const double* from_values = from->as<StateType>()->values;
+    const double* to_values = to->as<StateType>()->values;
+    double* values = state->as<StateType>()->values;
+    if (vectorized_)
+    {
+      // interpolate the runs of bounded joints at once, continuous joints need to wrap around
+      unsigned int begin = 0;
+      for (unsigned int i : continuous_variables_)
+      {
+        interpolateValues(from_values + begin, to_values + begin, t, values + begin, i - begin);
+        joint_model_vector_[i]->interpolate(from_values + i, to_values + i, t, values + i);
+        begin = i + 1;
+      }
+      interpolateValues(from_values + begin, to_values + begin, t, values + begin, variable_count_ - begin);
+    }
+    else
+      spec_.joint_model_group_->interpolate(from_values, to_values, t, values);
 
     // compute tag
     if (from->as<StateType>()->tag >= 0 && t < 1.0 - tag_snap_to_segment_)
@@ -223,6 +301,8 @@ double* ompl_interface::ModelBasedStateSpace::getValueAddressAtIndex(ompl::base:
 {
   if (index >= variable_count_)
     return nullptr;
+  // the values may be written through the returned address, so the memoized link position can become stale
+  state->as<StateType>()->clearLinkPosition();
   return state->as<StateType>()->values + index;
 }
 
@@ -323,6 +403,11 @@ void ompl_interface::ModelBasedStateSpace::copyToRobotState(moveit::core::RobotS
 {
   rstate.setJointGroupPositions(spec_.joint_model_group_, state->as<StateType>()->values);
   rstate.update();
+
+  // memoize the position of the cached link, so projections do not need to compute it again
+  if (cached_link_ && !state->as<StateType>()->isLinkPositionKnown())
+    const_cast<ompl::base::State*>(state)->as<StateType>()->setLinkPosition(
+        rstate.getGlobalLinkTransform(cached_link_).translation());
 }
 
 void ompl_interface::ModelBasedStateSpace::copyToOMPLState(ompl::base::State* state,
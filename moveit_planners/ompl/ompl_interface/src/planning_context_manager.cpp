@@ -35,6 +35,7 @@
 /* Author: Ioan Sucan */
 
 #include <moveit/ompl_interface/planning_context_manager.h>
+#include <moveit/ompl_interface/detail/persistent_roadmap.h>
 #include <moveit/robot_state/conversions.h>
 #include <moveit/profiler/profiler.h>
 #include <utility>
@@ -69,6 +70,7 @@
 #include <ompl/geometric/planners/prm/LazyPRMstar.h>
 #include <ompl/geometric/planners/prm/SPARS.h>
 #include <ompl/geometric/planners/prm/SPARStwo.h>
+
 // TODO: remove when ROS Melodic and older are no longer supported
 #if OMPL_VERSION_VALUE >= 1005000
 #include <ompl/geometric/planners/informedtrees/AITstar.h>
@@ -88,7 +90,18 @@ constexpr char LOGNAME[] = "planning_context_manager";
 
 struct PlanningContextManager::CachedContexts
 {
-  std::map<std::pair<std::string, std::string>, std::vector<ModelBasedPlanningContextPtr> > contexts_;
+  struct Entry
+  {
+    ModelBasedPlanningContextPtr context_;
+    /// value of use_count_ when the context was last handed out
+    std::size_t last_use_;
+  };
+
+  std::map<std::pair<std::string, std::string>, std::vector<Entry> > contexts_;
+  std::map<std::string, PortfolioStatisticsPtr> portfolio_statistics_;
+  /// experience databases by file name
+  std::map<std::string, ExperienceDatabasePtr> experience_databases_;
+  std::size_t use_count_ = 0;
   std::mutex lock_;
 };
 
@@ -119,8 +132,25 @@ ompl::base::PlannerPtr ompl_interface::MultiQueryPlannerAllocator::allocatePlann
     multi_query_planning_enabled = boost::lexical_cast<bool>(it->second);
     cfg.erase(it);
   }
-  if (multi_query_planning_enabled)
+  // Persistent roadmaps are kept across queries and selectively revalidated when the planning scene changes.
+  // The parameter 'roadmap_padding' adds a safety distance around changed objects.
+  it = cfg.find("persistent_roadmap");
+  bool persistent_roadmap = false;
+  if (it != cfg.end())
   {
+    persistent_roadmap = boost::lexical_cast<bool>(it->second);
+    cfg.erase(it);
+  }
+  it = cfg.find("roadmap_padding");
+  double roadmap_padding = 0.0;
+  if (it != cfg.end())
+  {
+    roadmap_padding = boost::lexical_cast<double>(it->second);
+    cfg.erase(it);
+  }
+  if (multi_query_planning_enabled || persistent_roadmap)
+  {
+    std::unique_lock<std::mutex> slock(planners_lock_);
     // If we already have an instance, use that one
     auto planner_map_it = planners_.find(new_name);
     if (planner_map_it != planners_.end())
@@ -154,7 +184,8 @@ ompl::base::PlannerPtr ompl_interface::MultiQueryPlannerAllocator::allocatePlann
     }
     // Store planner instance for multi-query use
     planners_[new_name] =
-        allocatePlannerImpl<T>(si, new_name, spec, load_planner_data, store_planner_data, planner_data_path);
+        allocatePlannerImpl<T>(si, new_name, spec, load_planner_data, store_planner_data, planner_data_path,
+                               persistent_roadmap, roadmap_padding);
     return planners_[new_name];
   }
   else
@@ -167,9 +198,23 @@ ompl::base::PlannerPtr ompl_interface::MultiQueryPlannerAllocator::allocatePlann
 template <typename T>
 ompl::base::PlannerPtr ompl_interface::MultiQueryPlannerAllocator::allocatePlannerImpl(
     const ob::SpaceInformationPtr& si, const std::string& new_name, const ModelBasedPlanningContextSpecification& spec,
-    bool load_planner_data, bool store_planner_data, const std::string& file_path)
+    bool load_planner_data, bool store_planner_data, const std::string& file_path, bool persistent_roadmap,
+    double roadmap_padding)
 {
   ob::PlannerPtr planner;
+  if (persistent_roadmap)
+  {
+    if (load_planner_data)
+      ROS_WARN_NAMED(LOGNAME, "Loading planner data is not supported for persistent roadmaps. Ignoring it for '%s'.",
+                     new_name.c_str());
+    load_planner_data = false;
+    planner = std::shared_ptr<ob::Planner>{ allocatePersistentRoadmap<T>(si, roadmap_padding) };
+    if (!planner)
+      ROS_ERROR_NAMED(LOGNAME,
+                      "Persistent roadmaps are only supported by LazyPRM and LazyPRMstar. "
+                      "Going to create a regular '%s' planner.",
+                      new_name.c_str());
+  }
   // Try to initialize planner with loaded planner data
   if (load_planner_data)
   {
@@ -199,7 +244,7 @@ inline ompl::base::Planner*
 ompl_interface::MultiQueryPlannerAllocator::allocatePersistentPlanner(const ob::PlannerData& /*data*/)
 {
   return nullptr;
-};
+}
 // TODO: remove when ROS Melodic and older are no longer supported
 // namespace is scoped instead of global because of GCC bug 56480
 #if OMPL_VERSION_VALUE >= 1005000
@@ -210,28 +255,54 @@ inline ompl::base::Planner*
 MultiQueryPlannerAllocator::allocatePersistentPlanner<ompl::geometric::PRM>(const ob::PlannerData& data)
 {
   return new og::PRM(data);
-};
+}
 template <>
 inline ompl::base::Planner*
 MultiQueryPlannerAllocator::allocatePersistentPlanner<ompl::geometric::PRMstar>(const ob::PlannerData& data)
 {
   return new og::PRMstar(data);
-};
+}
 template <>
 inline ompl::base::Planner*
 MultiQueryPlannerAllocator::allocatePersistentPlanner<ompl::geometric::LazyPRM>(const ob::PlannerData& data)
 {
   return new og::LazyPRM(data);
-};
+}
 template <>
 inline ompl::base::Planner*
 MultiQueryPlannerAllocator::allocatePersistentPlanner<ompl::geometric::LazyPRMstar>(const ob::PlannerData& data)
 {
   return new og::LazyPRMstar(data);
-};
+}
 }  // namespace ompl_interface
 #endif
 
+// default implementation, only lazy planners support persistent roadmaps
+template <typename T>
+inline ompl::base::Planner*
+ompl_interface::MultiQueryPlannerAllocator::allocatePersistentRoadmap(const ob::SpaceInformationPtr& /*si*/,
+                                                                      double /*padding*/)
+{
+  return nullptr;
+}
+namespace ompl_interface
+{
+template <>
+inline ompl::base::Planner*
+MultiQueryPlannerAllocator::allocatePersistentRoadmap<ompl::geometric::LazyPRM>(const ob::SpaceInformationPtr& si,
+                                                                              double padding)
+{
+  return new PersistentLazyRoadmap<og::LazyPRM>(si, padding);
+}
+template <>
+inline ompl::base::Planner*
+MultiQueryPlannerAllocator::allocatePersistentRoadmap<ompl::geometric::LazyPRMstar>(const ob::SpaceInformationPtr& si,
+                                                                                  double padding)
+{
+  return new PersistentLazyRoadmap<og::LazyPRMstar>(si, padding);
+}
+}  // namespace ompl_interface
+
 ompl_interface::PlanningContextManager::PlanningContextManager(moveit::core::RobotModelConstPtr robot_model,
                                                                constraint_samplers::ConstraintSamplerManagerPtr csm)
   : robot_model_(std::move(robot_model))
@@ -242,13 +313,154 @@ ompl_interface::PlanningContextManager::PlanningContextManager(moveit::core::Rob
   , max_planning_threads_(4)
   , max_solution_segment_length_(0.0)
   , minimum_waypoint_count_(2)
+  , max_cached_contexts_(0)
+  , max_cached_contexts_memory_(0)
+  , cancel_warm_up_(false)
 {
   cached_contexts_ = std::make_shared<CachedContexts>();
   registerDefaultPlanners();
   registerDefaultStateSpaces();
 }
 
-ompl_interface::PlanningContextManager::~PlanningContextManager() = default;
+ompl_interface::PlanningContextManager::~PlanningContextManager()
+{
+  cancel_warm_up_ = true;
+  waitForWarmUp();
+}
+
+void ompl_interface::PlanningContextManager::setMaximumCachedContexts(std::size_t count)
+{
+  max_cached_contexts_ = count;
+  evictCachedContexts();
+}
+
+void ompl_interface::PlanningContextManager::setMaximumCachedContextsMemory(std::size_t bytes)
+{
+  max_cached_contexts_memory_ = bytes;
+  evictCachedContexts();
+}
+
+std::size_t ompl_interface::PlanningContextManager::getCachedContextsMemory() const
+{
+  std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
+  std::size_t bytes = 0;
+  for (auto& cached_contexts : cached_contexts_->contexts_)
+    for (CachedContexts::Entry& entry : cached_contexts.second)
+      bytes += entry.context_->getStoredMemoryUsage();
+  return bytes;
+}
+
+std::size_t ompl_interface::PlanningContextManager::getCachedContextsCount() const
+{
+  std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
+  std::size_t count = 0;
+  for (const auto& cached_contexts : cached_contexts_->contexts_)
+    count += cached_contexts.second.size();
+  return count;
+}
+
+void ompl_interface::PlanningContextManager::evictCachedContexts() const
+{
+  if (max_cached_contexts_ == 0 && max_cached_contexts_memory_ == 0)
+    return;
+
+  // the memory estimates are stored by the contexts when they are handed out or finish solving, computing them
+  // here would copy the data of their planners while holding the lock
+  std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  for (const auto& cached_contexts : cached_contexts_->contexts_)
+    for (const CachedContexts::Entry& entry : cached_contexts.second)
+    {
+      ++count;
+      bytes += entry.context_->getStoredMemoryUsage();
+    }
+
+  while ((max_cached_contexts_ > 0 && count > max_cached_contexts_) ||
+         (max_cached_contexts_memory_ > 0 && bytes > max_cached_contexts_memory_))
+  {
+    // find the least recently used context that is not in use
+    std::vector<CachedContexts::Entry>* lru_list = nullptr;
+    std::size_t lru_index = 0;
+    for (auto& cached_contexts : cached_contexts_->contexts_)
+      for (std::size_t i = 0; i < cached_contexts.second.size(); ++i)
+        if (cached_contexts.second[i].context_.unique() &&
+            (!lru_list || cached_contexts.second[i].last_use_ < (*lru_list)[lru_index].last_use_))
+        {
+          lru_list = &cached_contexts.second;
+          lru_index = i;
+        }
+    if (!lru_list)
+      break;
+
+    const CachedContexts::Entry& lru = (*lru_list)[lru_index];
+    ROS_DEBUG_NAMED(LOGNAME, "Dropping cached planning context '%s'", lru.context_->getName().c_str());
+    --count;
+    bytes -= lru.context_->getStoredMemoryUsage();
+    lru_list->erase(lru_list->begin() + lru_index);
+  }
+}
+
+void ompl_interface::PlanningContextManager::warmUpContexts(const std::vector<std::string>& config_names,
+                                                            const ros::NodeHandle& nh,
+                                                            bool use_constraints_approximations, unsigned int threads)
+{
+  // the threads use copies of the configurations, which may change while they run
+  auto configs = std::make_shared<std::vector<planning_interface::PlannerConfigurationSettings>>();
+  for (const std::string& config_name : config_names)
+  {
+    auto pc = planner_configs_.find(config_name);
+    if (pc == planner_configs_.end())
+      ROS_ERROR_NAMED(LOGNAME, "Cannot warm up the context of unknown planner configuration '%s'", config_name.c_str());
+    else
+      configs->push_back(pc->second);
+  }
+  if (configs->empty())
+    return;
+
+  auto next = std::make_shared<std::atomic<std::size_t>>(0);
+  threads = std::max(1u, std::min<unsigned int>(threads, configs->size()));
+  for (unsigned int i = 0; i < threads; ++i)
+    warm_up_threads_.emplace_back([this, configs, nh, use_constraints_approximations, next] {
+      for (std::size_t j = (*next)++; j < configs->size() && !cancel_warm_up_; j = (*next)++)
+        warmUpContext((*configs)[j], nh, use_constraints_approximations);
+    });
+}
+
+void ompl_interface::PlanningContextManager::waitForWarmUp()
+{
+  for (std::thread& thread : warm_up_threads_)
+    thread.join();
+  warm_up_threads_.clear();
+}
+
+void ompl_interface::PlanningContextManager::warmUpContext(
+    const planning_interface::PlannerConfigurationSettings& config, const ros::NodeHandle& nh,
+    bool use_constraints_approximations) const
+{
+  ompl::time::point start = ompl::time::now();
+  const ModelBasedStateSpaceFactoryPtr& factory = getStateSpaceFactory(JointModelStateSpace::PARAMETERIZATION_TYPE);
+  if (!factory)
+    return;
+  ModelBasedPlanningContextPtr context = getPlanningContext(config, factory);
+
+  moveit::core::RobotState default_state(robot_model_);
+  default_state.setToDefaultValues();
+  context->setCompleteInitialState(default_state);
+  try
+  {
+    context->configure(nh, use_constraints_approximations);
+    // the space information is set up lazily otherwise
+    context->getOMPLSimpleSetup()->getSpaceInformation()->setup();
+  }
+  catch (ompl::Exception& ex)
+  {
+    ROS_ERROR_NAMED(LOGNAME, "OMPL encountered an error while warming up '%s': %s", config.name.c_str(), ex.what());
+    return;
+  }
+  ROS_DEBUG_NAMED(LOGNAME, "Warmed up planning context '%s' in %f seconds (%zu bytes)", config.name.c_str(),
+                  ompl::time::seconds(ompl::time::now() - start), context->storeMemoryUsage());
+}
 
 ompl_interface::ConfiguredPlannerAllocator
 ompl_interface::PlanningContextManager::plannerSelector(const std::string& planner) const
@@ -335,11 +547,12 @@ ompl_interface::ModelBasedPlanningContextPtr ompl_interface::PlanningContextMana
     auto cached_contexts = cached_contexts_->contexts_.find(std::make_pair(config.name, factory->getType()));
     if (cached_contexts != cached_contexts_->contexts_.end())
     {
-      for (const ModelBasedPlanningContextPtr& cached_context : cached_contexts->second)
-        if (cached_context.unique())
+      for (CachedContexts::Entry& cached_context : cached_contexts->second)
+        if (cached_context.context_.unique())
         {
           ROS_DEBUG_NAMED(LOGNAME, "Reusing cached planning context");
-          context = cached_context;
+          context = cached_context.context_;
+          cached_context.last_use_ = ++cached_contexts_->use_count_;
           break;
         }
     }
@@ -359,11 +572,34 @@ ompl_interface::ModelBasedPlanningContextPtr ompl_interface::PlanningContextMana
     context_spec.ompl_simple_setup_ = std::make_shared<ompl::geometric::SimpleSetup>(context_spec.state_space_);
 
     ROS_DEBUG_NAMED(LOGNAME, "Creating new planning context");
+    {
+      std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
+      PortfolioStatisticsPtr& statistics = cached_contexts_->portfolio_statistics_[config.name];
+      if (!statistics)
+        statistics = std::make_shared<PortfolioStatistics>();
+      context_spec.portfolio_statistics_ = statistics;
+
+      auto database_file = config.config.find("experience_database");
+      if (database_file != config.config.end())
+      {
+        const moveit::core::JointModelGroup* group = robot_model_->getJointModelGroup(config.group);
+        ExperienceDatabasePtr& database = cached_contexts_->experience_databases_[database_file->second];
+        if (!database)
+          database = std::make_shared<ExperienceDatabase>(group, database_file->second);
+        if (database->getJointModelGroup() == group)
+          context_spec.experience_database_ = database;
+        else
+          ROS_ERROR_NAMED(LOGNAME, "Experience database '%s' is already used by group '%s'",
+                          database_file->second.c_str(), database->getJointModelGroup()->getName().c_str());
+      }
+    }
     context = std::make_shared<ModelBasedPlanningContext>(config.name, context_spec);
     {
       std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
-      cached_contexts_->contexts_[std::make_pair(config.name, factory->getType())].push_back(context);
+      cached_contexts_->contexts_[std::make_pair(config.name, factory->getType())].push_back(
+          { context, ++cached_contexts_->use_count_ });
     }
+    evictCachedContexts();
   }
 
   context->setMaximumPlanningThreads(max_planning_threads_);
@@ -379,6 +615,16 @@ ompl_interface::ModelBasedPlanningContextPtr ompl_interface::PlanningContextMana
   return context;
 }
 
+ompl_interface::PortfolioStatisticsConstPtr
+ompl_interface::PlanningContextManager::getPortfolioStatistics(const std::string& config_name) const
+{
+  std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
+  auto it = cached_contexts_->portfolio_statistics_.find(config_name);
+  if (it == cached_contexts_->portfolio_statistics_.end())
+    return PortfolioStatisticsConstPtr();
+  return it->second;
+}
+
 const ompl_interface::ModelBasedStateSpaceFactoryPtr&
 ompl_interface::PlanningContextManager::getStateSpaceFactory(const std::string& factory_type) const
 {
@@ -518,6 +764,16 @@ ompl_interface::ModelBasedPlanningContextPtr ompl_interface::PlanningContextMana
     try
     {
       context->configure(nh, use_constraints_approximation);
+      // revalidate the parts of a persistent roadmap affected by changes of the scene since its last query
+      if (auto roadmap = std::dynamic_pointer_cast<PersistentRoadmap>(context->getOMPLSimpleSetup()->getPlanner()))
+      {
+        PersistentRoadmap::UpdateStatistics stats =
+            roadmap->updateScene(*planning_scene, context->getCompleteInitialRobotState());
+        ROS_DEBUG_NAMED(LOGNAME, "%s: Reusing roadmap with %zu vertices and %zu edges, %zu and %zu to revalidate",
+                        context->getName().c_str(), stats.vertices, stats.edges, stats.invalidated_vertices,
+                        stats.invalidated_edges);
+      }
+      context->storeMemoryUsage();
       ROS_DEBUG_NAMED(LOGNAME, "%s: New planning context is set.", context->getName().c_str());
       error_code.val = moveit_msgs::MoveItErrorCodes::SUCCESS;
     }
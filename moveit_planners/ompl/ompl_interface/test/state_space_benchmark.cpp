@@ -0,0 +1,182 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Compares the vectorized distance and interpolation of ModelBasedStateSpace to the per-joint implementation of
+// JointModelGroup, both directly and as the distance of a nearest neighbor search.
+// To run this benchmark, 'cd' to the build/moveit_planners_ompl directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h>
+
+namespace
+{
+class StateSpaceBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const benchmark::State& st) override
+  {
+    // panda_arm has bounded joints only, pr2's right_arm has two continuous joints
+    if (st.range(0) == 0)
+      robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    else
+      robot_model_ = moveit::core::loadTestingRobotModel("pr2");
+    ompl_interface::ModelBasedStateSpaceSpecification spec(robot_model_, st.range(0) == 0 ? "panda_arm" : "right_arm");
+    space_ = std::make_shared<ompl_interface::JointModelStateSpace>(spec);
+    space_->setup();
+    jmg_ = space_->getJointModelGroup();
+
+    ompl::base::StateSamplerPtr sampler = space_->allocStateSampler();
+    states_.resize(1000);
+    for (ompl::base::State*& state : states_)
+    {
+      state = space_->allocState();
+      sampler->sampleUniform(state);
+    }
+  }
+
+  void TearDown(const benchmark::State& /*st*/) override
+  {
+    for (ompl::base::State* state : states_)
+      space_->freeState(state);
+    states_.clear();
+  }
+
+  double genericDistance(const ompl::base::State* a, const ompl::base::State* b) const
+  {
+    return jmg_->distance(a->as<ompl_interface::ModelBasedStateSpace::StateType>()->values,
+                          b->as<ompl_interface::ModelBasedStateSpace::StateType>()->values);
+  }
+
+  void nearestNeighbors(benchmark::State& st, bool vectorized)
+  {
+    ompl::NearestNeighborsGNATNoThreadSafety<ompl::base::State*> nn;
+    if (vectorized)
+      nn.setDistanceFunction(
+          [this](const ompl::base::State* a, const ompl::base::State* b) { return space_->distance(a, b); });
+    else
+      nn.setDistanceFunction(
+          [this](const ompl::base::State* a, const ompl::base::State* b) { return genericDistance(a, b); });
+    nn.add(states_);
+
+    ompl::base::State* query = space_->allocState();
+    ompl::base::StateSamplerPtr sampler = space_->allocStateSampler();
+    std::vector<ompl::base::State*> neighbors;
+    for (auto _ : st)
+    {
+      sampler->sampleUniform(query);
+      nn.nearestK(query, 10, neighbors);
+      benchmark::DoNotOptimize(neighbors.data());
+    }
+    st.SetItemsProcessed(st.iterations());
+    space_->freeState(query);
+  }
+
+protected:
+  moveit::core::RobotModelPtr robot_model_;
+  std::shared_ptr<ompl_interface::JointModelStateSpace> space_;
+  const moveit::core::JointModelGroup* jmg_;
+  std::vector<ompl::base::State*> states_;
+};
+}  // namespace
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, distanceGeneric)(benchmark::State& st)
+{
+  std::size_t i = 0;
+  for (auto _ : st)
+  {
+    benchmark::DoNotOptimize(genericDistance(states_[i % states_.size()], states_[(i + 1) % states_.size()]));
+    ++i;
+  }
+}
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, distanceVectorized)(benchmark::State& st)
+{
+  std::size_t i = 0;
+  for (auto _ : st)
+  {
+    benchmark::DoNotOptimize(space_->distance(states_[i % states_.size()], states_[(i + 1) % states_.size()]));
+    ++i;
+  }
+}
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, interpolateGeneric)(benchmark::State& st)
+{
+  ompl::base::State* state = space_->allocState();
+  double* values = state->as<ompl_interface::ModelBasedStateSpace::StateType>()->values;
+  std::size_t i = 0;
+  for (auto _ : st)
+  {
+    jmg_->interpolate(states_[i % states_.size()]->as<ompl_interface::ModelBasedStateSpace::StateType>()->values,
+                      states_[(i + 1) % states_.size()]->as<ompl_interface::ModelBasedStateSpace::StateType>()->values,
+                      0.3, values);
+    benchmark::DoNotOptimize(values);
+    ++i;
+  }
+  space_->freeState(state);
+}
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, interpolateVectorized)(benchmark::State& st)
+{
+  ompl::base::State* state = space_->allocState();
+  std::size_t i = 0;
+  for (auto _ : st)
+  {
+    space_->interpolate(states_[i % states_.size()], states_[(i + 1) % states_.size()], 0.3, state);
+    benchmark::DoNotOptimize(state);
+    ++i;
+  }
+  space_->freeState(state);
+}
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, nearestNeighborsGeneric)(benchmark::State& st)
+{
+  nearestNeighbors(st, false);
+}
+
+BENCHMARK_DEFINE_F(StateSpaceBenchmark, nearestNeighborsVectorized)(benchmark::State& st)
+{
+  nearestNeighbors(st, true);
+}
+
+// argument 0 selects panda_arm, 1 selects pr2's right_arm
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, distanceGeneric)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, distanceVectorized)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, interpolateGeneric)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, interpolateVectorized)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, nearestNeighborsGeneric)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(StateSpaceBenchmark, nearestNeighborsVectorized)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,204 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/constraints_library.h>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
+#include <moveit/planning_scene/planning_scene.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <ompl/geometric/SimpleSetup.h>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <fstream>
+
+class ConstraintsLibraryTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    ompl_interface::ModelBasedStateSpaceSpecification space_spec(robot_model_, "panda_arm");
+    state_space_ = std::make_shared<ompl_interface::JointModelStateSpace>(space_spec);
+    state_space_->computeLocations();
+
+    ompl_interface::ModelBasedPlanningContextSpecification spec;
+    spec.state_space_ = state_space_;
+    spec.ompl_simple_setup_ = std::make_shared<ompl::geometric::SimpleSetup>(state_space_);
+    context_ = std::make_shared<ompl_interface::ModelBasedPlanningContext>("panda_arm", spec);
+    context_->setPlanningScene(std::make_shared<planning_scene::PlanningScene>(robot_model_));
+
+    path_ = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("constraints_library_%%%%%%%%");
+  }
+
+  void TearDown() override
+  {
+    boost::filesystem::remove_all(path_);
+  }
+
+  /** An approximation with 4 milestones, connected in a cycle, and one explicit motion of 2 states */
+  ompl_interface::ConstraintApproximationPtr createApproximation()
+  {
+    auto* cass = new ompl_interface::ConstraintApproximationStateStorage(state_space_);
+    ompl::base::StateStoragePtr storage(cass);
+    random_numbers::RandomNumberGenerator rng(7);
+    moveit::core::RobotState robot_state(robot_model_);
+    ompl::base::ScopedState<> state(state_space_);
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+      robot_state.setToRandomPositions(robot_model_->getJointModelGroup("panda_arm"), rng);
+      state_space_->copyToOMPLState(state.get(), robot_state);
+      state->as<ompl_interface::ModelBasedStateSpace::StateType>()->tag = i < 4 ? i : -1;
+      ompl_interface::ConstrainedStateMetadata metadata;
+      if (i < 4)
+        metadata.first = { (i + 1) % 4, (i + 3) % 4 };
+      cass->addState(state.get(), metadata);
+    }
+    cass->getMetadata(0).second[1] = std::make_pair(4, 6);
+    cass->getMetadata(1).second[0] = std::make_pair(4, 6);
+
+    moveit_msgs::Constraints msg;
+    msg.name = "cycle";
+    return std::make_shared<ompl_interface::ConstraintApproximation>("panda_arm", state_space_->getParameterizationType(),
+                                                                     true, msg, "cycle.ompldb", storage, 4);
+  }
+
+  void expectEqual(const ompl_interface::ConstraintApproximation& expected,
+                   const ompl_interface::ConstraintApproximation& actual)
+  {
+    EXPECT_EQ(actual.getGroup(), expected.getGroup());
+    EXPECT_EQ(actual.getStateSpaceParameterization(), expected.getStateSpaceParameterization());
+    EXPECT_EQ(actual.hasExplicitMotions(), expected.hasExplicitMotions());
+    EXPECT_EQ(actual.getMilestoneCount(), expected.getMilestoneCount());
+    EXPECT_EQ(actual.getSpaceSignature(), expected.getSpaceSignature());
+
+    const auto& expected_states =
+        static_cast<const ompl_interface::ConstraintApproximationStateStorage&>(*expected.getStateStorage());
+    const auto& actual_states =
+        static_cast<const ompl_interface::ConstraintApproximationStateStorage&>(*actual.getStateStorage());
+    ASSERT_EQ(actual_states.size(), expected_states.size());
+    for (std::size_t i = 0; i < expected_states.size(); ++i)
+    {
+      EXPECT_TRUE(state_space_->equalStates(actual_states.getState(i), expected_states.getState(i))) << i;
+      EXPECT_EQ(actual_states.getState(i)->as<ompl_interface::ModelBasedStateSpace::StateType>()->tag,
+                expected_states.getState(i)->as<ompl_interface::ModelBasedStateSpace::StateType>()->tag);
+      EXPECT_EQ(actual_states.getMetadata(i), expected_states.getMetadata(i)) << i;
+    }
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  ompl_interface::ModelBasedStateSpacePtr state_space_;
+  ompl_interface::ModelBasedPlanningContextPtr context_;
+  boost::filesystem::path path_;
+};
+
+TEST_F(ConstraintsLibraryTest, BinaryRoundTrip)
+{
+  ompl_interface::ConstraintApproximationPtr approx = createApproximation();
+  ompl_interface::ConstraintsLibrary library(context_.get());
+  library.registerConstraintApproximation(approx);
+  library.saveConstraintApproximations(path_.string());
+
+  ompl_interface::ConstraintsLibrary loaded(context_.get());
+  loaded.loadConstraintApproximations(path_.string());
+  const ompl_interface::ConstraintApproximationPtr& result = loaded.getConstraintApproximation(approx->getConstraintsMsg());
+  ASSERT_TRUE(result);
+  expectEqual(*approx, *result);
+
+  // a damaged file is rejected instead of being loaded partially
+  boost::filesystem::resize_file(path_ / approx->getFilename(),
+                                 boost::filesystem::file_size(path_ / approx->getFilename()) - 1);
+  loaded.loadConstraintApproximations(path_.string());
+  EXPECT_FALSE(loaded.getConstraintApproximation(approx->getConstraintsMsg()));
+}
+
+TEST_F(ConstraintsLibraryTest, RejectsCorruptIndices)
+{
+  ompl_interface::ConstraintApproximationPtr approx = createApproximation();
+  ompl_interface::ConstraintsLibrary library(context_.get());
+  library.registerConstraintApproximation(approx);
+  library.saveConstraintApproximations(path_.string());
+
+  // the file ends with 7 connection offsets, 8 connections, 7 motion offsets and 2 motion triplets
+  const boost::filesystem::path filename = path_ / approx->getFilename();
+  const boost::filesystem::path original = path_ / "original.ompldb";
+  boost::filesystem::copy_file(filename, original);
+  const auto load_corrupted = [&](std::size_t index_from_end, std::uint64_t value) {
+    boost::filesystem::copy_file(original, filename, boost::filesystem::copy_option::overwrite_if_exists);
+    std::fstream file(filename.string(), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-static_cast<std::streamoff>(index_from_end * sizeof(value)), std::ios::end);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    file.close();
+
+    ompl_interface::ConstraintsLibrary loaded(context_.get());
+    loaded.loadConstraintApproximations(path_.string());
+    return static_cast<bool>(loaded.getConstraintApproximation(approx->getConstraintsMsg()));
+  };
+
+  // an unchanged value still loads
+  EXPECT_TRUE(load_corrupted(6 + 7 + 8, 1));
+  // a connection to a state past the stored ones
+  EXPECT_FALSE(load_corrupted(6 + 7 + 8, 6));
+  // connection offsets that do not start at 0
+  EXPECT_FALSE(load_corrupted(6 + 7 + 8 + 7, 1));
+  // connection offsets that decrease
+  EXPECT_FALSE(load_corrupted(6 + 7 + 8 + 6, 5));
+  // motion offsets that end past the motions
+  EXPECT_FALSE(load_corrupted(6 + 1, 3));
+  // a motion with states past the stored ones
+  EXPECT_FALSE(load_corrupted(1, 7));
+}
+
+TEST_F(ConstraintsLibraryTest, LoadsStateStorageFormat)
+{
+  ompl_interface::ConstraintApproximationPtr approx = createApproximation();
+  ompl_interface::ConstraintsLibrary library(context_.get());
+  library.registerConstraintApproximation(approx);
+  library.saveConstraintApproximations(path_.string());
+
+  // replace the binary state file by the format written before
+  approx->getStateStorage()->store((path_ / approx->getFilename()).c_str());
+
+  ompl_interface::ConstraintsLibrary loaded(context_.get());
+  loaded.loadConstraintApproximations(path_.string());
+  const ompl_interface::ConstraintApproximationPtr& result = loaded.getConstraintApproximation(approx->getConstraintsMsg());
+  ASSERT_TRUE(result);
+  expectEqual(*approx, *result);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
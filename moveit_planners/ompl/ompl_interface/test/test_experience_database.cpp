@@ -0,0 +1,116 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/experience_database.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <cstdio>
+
+using ompl_interface::ExperienceDatabase;
+
+class ExperienceDatabaseTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    group_ = robot_model_->getJointModelGroup("panda_arm");
+    std::remove(FILENAME);
+  }
+
+  void TearDown() override
+  {
+    std::remove(FILENAME);
+  }
+
+  std::vector<std::vector<double>> makePath(double start, double goal) const
+  {
+    const std::size_t dof = group_->getVariableCount();
+    return { std::vector<double>(dof, start), std::vector<double>(dof, 0.5 * (start + goal)),
+             std::vector<double>(dof, goal) };
+  }
+
+  static constexpr const char* FILENAME = "test_experience_database.db";
+  moveit::core::RobotModelPtr robot_model_;
+  const moveit::core::JointModelGroup* group_;
+};
+
+TEST_F(ExperienceDatabaseTest, FindsNearestPaths)
+{
+  ExperienceDatabase database(group_, FILENAME);
+  EXPECT_EQ(database.size(), 0u);
+  EXPECT_TRUE(database.addPath(makePath(0.0, 1.0)));
+  EXPECT_TRUE(database.addPath(makePath(-1.0, 0.5)));
+  // too close to the first path
+  EXPECT_FALSE(database.addPath(makePath(0.01, 1.0), 0.1));
+  EXPECT_EQ(database.size(), 2u);
+
+  const std::size_t dof = group_->getVariableCount();
+  std::vector<std::vector<std::vector<double>>> paths;
+  database.findPaths(std::vector<double>(dof, -0.9), std::vector<double>(dof, 0.4), 1, paths);
+  ASSERT_EQ(paths.size(), 1u);
+  EXPECT_EQ(paths[0], makePath(-1.0, 0.5));
+}
+
+TEST_F(ExperienceDatabaseTest, PersistsPaths)
+{
+  {
+    ExperienceDatabase database(group_, FILENAME);
+    database.addPath(makePath(0.0, 1.0));
+    database.addPath(makePath(-1.0, 0.5));
+  }
+  ExperienceDatabase database(group_, FILENAME);
+  EXPECT_EQ(database.size(), 2u);
+
+  // the database of another group is rejected
+  ExperienceDatabase other(robot_model_->getJointModelGroup("hand"), FILENAME);
+  EXPECT_EQ(other.size(), 0u);
+}
+
+TEST(ExperienceStatistics, TimeSaved)
+{
+  ExperienceDatabase::Statistics stats;
+  stats.queries = 4;
+  stats.hits = 2;
+  stats.scratch_time = 2.0;
+  stats.experience_time = 0.5;
+  EXPECT_DOUBLE_EQ(stats.getTimeSaved(), 1.5);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/lazy_motion_validator.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+
+using ompl_interface::LazyMotionValidator;
+
+TEST(LazyMotionValidator, FindsObstacles)
+{
+  auto space = std::make_shared<ompl::base::RealVectorStateSpace>(1);
+  space->setBounds(0.0, 1.0);
+  auto si = std::make_shared<ompl::base::SpaceInformation>(space);
+  // a thin obstacle between 0.3 and 0.31
+  si->setStateValidityChecker([](const ompl::base::State* state) {
+    const double x = state->as<ompl::base::RealVectorStateSpace::StateType>()->values[0];
+    return x < 0.3 || x > 0.31;
+  });
+  si->setStateValidityCheckingResolution(0.001);
+  auto validator = std::make_shared<LazyMotionValidator>(si);
+  si->setMotionValidator(validator);
+  si->setup();
+
+  ompl::base::ScopedState<ompl::base::RealVectorStateSpace> a(space), b(space), c(space);
+  a->values[0] = 0.0;
+  b->values[0] = 1.0;
+  c->values[0] = 0.29;
+  EXPECT_FALSE(validator->checkMotion(a.get(), b.get()));
+  EXPECT_TRUE(validator->checkMotion(a.get(), c.get()));
+
+  std::pair<ompl::base::State*, double> last_valid(nullptr, 0.0);
+  EXPECT_FALSE(validator->checkMotion(a.get(), b.get(), last_valid));
+  EXPECT_NEAR(last_valid.second, 0.3, 0.002);
+  EXPECT_EQ(validator->getValidMotionCount(), 1u);
+  EXPECT_EQ(validator->getInvalidMotionCount(), 2u);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
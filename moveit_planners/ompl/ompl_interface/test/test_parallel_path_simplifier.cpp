@@ -0,0 +1,158 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.h>
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/objectives/PathLengthOptimizationObjective.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/geometric/PathSimplifier.h>
+#include <ompl/util/RandomNumbers.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ob = ompl::base;
+namespace og = ompl::geometric;
+
+class ParallelPathSimplifierTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // a square with a disc shaped obstacle in its center
+    auto space = std::make_shared<ob::RealVectorStateSpace>(2);
+    space->setBounds(0.0, 10.0);
+    si_ = std::make_shared<ob::SpaceInformation>(space);
+    si_->setStateValidityChecker([](const ob::State* state) {
+      const double* values = state->as<ob::RealVectorStateSpace::StateType>()->values;
+      return std::hypot(values[0] - 5.0, values[1] - 5.0) > 2.0;
+    });
+    si_->setStateValidityCheckingResolution(0.002);
+    si_->setup();
+    objective_ = std::make_shared<ob::PathLengthOptimizationObjective>(si_);
+  }
+
+  /** a valid detour around the obstacle from (1, 5) to (9, 5), passing through \e waypoints */
+  og::PathGeometric makePath(const std::vector<std::pair<double, double>>& waypoints) const
+  {
+    og::PathGeometric path(si_);
+    ob::ScopedState<ob::RealVectorStateSpace> state(si_);
+    for (const auto& waypoint : waypoints)
+    {
+      state->values[0] = waypoint.first;
+      state->values[1] = waypoint.second;
+      path.append(state.get());
+    }
+    path.interpolate(100);
+    EXPECT_TRUE(path.check());
+    return path;
+  }
+
+  og::PathGeometric makeUpperPath() const
+  {
+    return makePath(
+        { { 1.0, 5.0 }, { 1.0, 9.0 }, { 3.0, 8.0 }, { 5.0, 9.5 }, { 7.0, 8.0 }, { 9.0, 9.0 }, { 9.0, 5.0 } });
+  }
+
+  og::PathGeometric makeLowerPath() const
+  {
+    return makePath(
+        { { 1.0, 5.0 }, { 2.0, 1.0 }, { 4.0, 2.5 }, { 5.0, 0.5 }, { 6.0, 2.5 }, { 8.0, 1.0 }, { 9.0, 5.0 } });
+  }
+
+  void expectSameEndpoints(const og::PathGeometric& a, const og::PathGeometric& b) const
+  {
+    EXPECT_TRUE(si_->equalStates(a.getState(0), b.getState(0)));
+    EXPECT_TRUE(si_->equalStates(a.getState(a.getStateCount() - 1), b.getState(b.getStateCount() - 1)));
+  }
+
+  double cost(const og::PathGeometric& path) const
+  {
+    return path.cost(objective_).value();
+  }
+
+  ob::SpaceInformationPtr si_;
+  ob::OptimizationObjectivePtr objective_;
+};
+
+TEST_F(ParallelPathSimplifierTest, MatchesSequentialSimplifier)
+{
+  const og::PathGeometric input = makeUpperPath();
+
+  og::PathGeometric sequential(input);
+  og::PathSimplifier(si_, ob::GoalPtr(), objective_).simplify(sequential, ob::timedPlannerTerminationCondition(5.0));
+
+  og::PathGeometric parallel(si_);
+  ompl_interface::ParallelPathSimplifier(si_, ob::GoalPtr(), objective_, 4)
+      .simplify({ input }, ob::timedPlannerTerminationCondition(5.0), parallel);
+
+  // both simplify to a valid path between the same states, which is as good as the sequential result
+  EXPECT_TRUE(sequential.check());
+  EXPECT_TRUE(parallel.check());
+  expectSameEndpoints(input, sequential);
+  expectSameEndpoints(input, parallel);
+  EXPECT_LT(cost(sequential), cost(input));
+  EXPECT_LE(cost(parallel), cost(sequential) * 1.02);
+}
+
+TEST_F(ParallelPathSimplifierTest, SimplifiesBestOfMorePathsThanThreads)
+{
+  const og::PathGeometric upper = makeUpperPath();
+  const og::PathGeometric lower = makeLowerPath();
+  ASSERT_LT(cost(upper), cost(lower));
+
+  // a single thread simplifies the better path only, as the sequential simplifier would
+  og::PathGeometric parallel(si_);
+  ompl_interface::ParallelPathSimplifier(si_, ob::GoalPtr(), objective_, 1)
+      .simplify({ lower, upper }, ob::timedPlannerTerminationCondition(5.0), parallel);
+  og::PathGeometric sequential(upper);
+  og::PathSimplifier(si_, ob::GoalPtr(), objective_).simplify(sequential, ob::timedPlannerTerminationCondition(5.0));
+
+  EXPECT_TRUE(parallel.check());
+  expectSameEndpoints(upper, parallel);
+  EXPECT_NEAR(cost(parallel), cost(sequential), 0.02 * cost(sequential));
+  // the simplified path still passes above the obstacle
+  double max_y = 0.0;
+  for (std::size_t i = 0; i < parallel.getStateCount(); ++i)
+    max_y = std::max(max_y, parallel.getState(i)->as<ob::RealVectorStateSpace::StateType>()->values[1]);
+  EXPECT_GT(max_y, 7.0);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ompl::RNG::setSeed(42);
+  return RUN_ALL_TESTS();
+}
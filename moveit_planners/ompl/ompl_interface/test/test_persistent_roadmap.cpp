@@ -0,0 +1,96 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/persistent_roadmap.h>
+#include <moveit/utils/robot_model_test_utils.h>
+
+using ompl_interface::RoadmapSceneTracker;
+
+class RoadmapSceneTrackerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    scene_ = std::make_shared<planning_scene::PlanningScene>(robot_model_);
+    state_ = std::make_shared<moveit::core::RobotState>(robot_model_);
+    state_->setToDefaultValues();
+    state_->update();
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  planning_scene::PlanningScenePtr scene_;
+  moveit::core::RobotStatePtr state_;
+};
+
+TEST_F(RoadmapSceneTrackerTest, MotionBoxesContainIntermediateStates)
+{
+  const moveit::core::JointModelGroup* group = robot_model_->getJointModelGroup("panda_arm");
+  RoadmapSceneTracker tracker(group);
+  tracker.update(*scene_, *state_);
+
+  random_numbers::RandomNumberGenerator rng(42);
+  moveit::core::RobotState from(*state_), to(*state_), between(*state_);
+  std::vector<double> from_values, to_values;
+  std::vector<Eigen::AlignedBox3d> from_boxes, to_boxes, motion_boxes, between_boxes;
+  for (int i = 0; i < 100; ++i)
+  {
+    from.setToRandomPositions(group, rng);
+    to.setToRandomPositions(group, rng);
+    from.update();
+    to.update();
+    from.copyJointGroupPositions(group, from_values);
+    to.copyJointGroupPositions(group, to_values);
+    tracker.computeLinkBoxes(from, from_boxes);
+    tracker.computeLinkBoxes(to, to_boxes);
+    ASSERT_TRUE(tracker.computeMotionBoxes(from_values.data(), to_values.data(), from_boxes, to_boxes, motion_boxes));
+
+    for (double t = 0.1; t < 1.0; t += 0.1)
+    {
+      from.interpolate(to, t, between, group);
+      between.update();
+      tracker.computeLinkBoxes(between, between_boxes);
+      for (std::size_t k = 0; k < between_boxes.size(); ++k)
+        EXPECT_TRUE(between_boxes[k].isEmpty() || motion_boxes[k].contains(between_boxes[k]));
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -57,12 +57,14 @@
 #include <tf2_eigen/tf2_eigen.h>
 
 #include <moveit/ompl_interface/planning_context_manager.h>
+#include <moveit/ompl_interface/detail/persistent_roadmap.h>
 #include <moveit/planning_scene/planning_scene.h>
 #include <moveit/planning_interface/planning_request.h>
 #include <moveit/robot_state/conversions.h>
 #include <moveit/kinematic_constraints/utils.h>
 #include <moveit/constraint_samplers/constraint_sampler_manager.h>
 #include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
+#include <geometric_shapes/shapes.h>
 
 /** \brief Generic implementation of the tests that can be executed on different robots. **/
 class TestPlanningContext : public ompl_interface_testing::LoadTestRobot, public testing::Test
@@ -204,6 +206,152 @@ public:
     }
   }
 
+  void testPersistentRoadmap(const std::vector<double>& start, const std::vector<double>& goal)
+  {
+    planning_interface::PlannerConfigurationSettings pconfig_settings;
+    pconfig_settings.group = group_name_;
+    pconfig_settings.name = group_name_;
+    pconfig_settings.config = { { "enforce_joint_model_state_space", "0" },
+                                { "type", "geometric::LazyPRM" },
+                                { "persistent_roadmap", "1" } };
+
+    planning_interface::PlannerConfigurationMap pconfig_map{ { pconfig_settings.name, pconfig_settings } };
+    moveit_msgs::MoveItErrorCodes error_code;
+    planning_interface::MotionPlanRequest request = createRequest(start, goal);
+
+    ompl_interface::PlanningContextManager pcm(robot_model_, constraint_sampler_manager_);
+    pcm.setPlannerConfigurations(pconfig_map);
+
+    // the roadmap caches the validity of the vertices and edges of the solution of the first query
+    auto pc = pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false);
+    ASSERT_NE(pc, nullptr);
+    auto roadmap = std::dynamic_pointer_cast<ompl_interface::PersistentRoadmap>(pc->getOMPLSimpleSetup()->getPlanner());
+    ASSERT_NE(roadmap, nullptr);
+    planning_interface::MotionPlanDetailedResponse response;
+    ASSERT_TRUE(pc->solve(response));
+
+    ompl_interface::PersistentRoadmap::UpdateStatistics stats =
+        roadmap->updateScene(*planning_scene_, pc->getCompleteInitialRobotState());
+    const std::size_t valid_edges = stats.valid_edges;
+    EXPECT_GT(valid_edges, 0u);
+    pc.reset();
+
+    // an object far away from the robot changes none of the validated edges
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    pose.translation() = Eigen::Vector3d(10.0, 10.0, 10.0);
+    planning_scene_->getWorldNonConst()->addToObject("far", std::make_shared<shapes::Box>(0.1, 0.1, 0.1), pose);
+    stats = roadmap->updateScene(*planning_scene_, planning_scene_->getCurrentState());
+    EXPECT_EQ(stats.valid_edges, valid_edges);
+    EXPECT_EQ(stats.invalidated_edges, 0u);
+
+    // next queries start from the cached validity, which is neither reset when the context is cleared nor by
+    // solving
+    for (int query = 0; query < 2; ++query)
+    {
+      pc = pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false);
+      ASSERT_NE(pc, nullptr);
+      ASSERT_EQ(pc->getOMPLSimpleSetup()->getPlanner(), std::dynamic_pointer_cast<ompl::base::Planner>(roadmap));
+      stats = roadmap->updateScene(*planning_scene_, pc->getCompleteInitialRobotState());
+      EXPECT_GE(stats.valid_edges, valid_edges);
+
+      planning_interface::MotionPlanDetailedResponse query_response;
+      ASSERT_TRUE(pc->solve(query_response));
+      stats = roadmap->updateScene(*planning_scene_, pc->getCompleteInitialRobotState());
+      EXPECT_GE(stats.valid_edges, valid_edges);
+      pc.reset();
+    }
+  }
+
+  void testContextCache(const std::vector<double>& start, const std::vector<double>& goal)
+  {
+    ompl_interface::PlanningContextManager pcm(robot_model_, constraint_sampler_manager_);
+    pcm.setPlannerConfigurations(createCacheConfigurations());
+    planning_interface::MotionPlanRequest request = createRequest(start, goal);
+    moveit_msgs::MoveItErrorCodes error_code;
+    auto get_context = [&](const std::string& planner_id) {
+      request.planner_id = planner_id;
+      return pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false);
+    };
+
+    // least recently used contexts are dropped first
+    pcm.setMaximumCachedContexts(2);
+    std::weak_ptr<ompl_interface::ModelBasedPlanningContext> rrt_connect = get_context("RRTConnect");
+    std::weak_ptr<ompl_interface::ModelBasedPlanningContext> rrt = get_context("RRT");
+    ASSERT_FALSE(rrt_connect.expired());
+    ASSERT_FALSE(rrt.expired());
+    ompl_interface::ModelBasedPlanningContextPtr pc = get_context("RRTConnect");
+    EXPECT_EQ(pc, rrt_connect.lock());
+    pc.reset();
+    pc = get_context("LazyPRM");
+    EXPECT_EQ(pcm.getCachedContextsCount(), 2u);
+    EXPECT_TRUE(rrt.expired());
+    EXPECT_FALSE(rrt_connect.expired());
+
+    // contexts in use are kept
+    pcm.setMaximumCachedContexts(1);
+    EXPECT_EQ(pcm.getCachedContextsCount(), 1u);
+    EXPECT_TRUE(rrt_connect.expired());
+
+    // the roadmap of a persistent planner is part of the memory of its context
+    pc.reset();
+    const std::size_t memory = pcm.getCachedContextsMemory();
+    EXPECT_GT(memory, 0u);
+    pc = get_context("LazyPRM");
+    EXPECT_EQ(pcm.getCachedContextsCount(), 1u);
+    planning_interface::MotionPlanDetailedResponse response;
+    ASSERT_TRUE(pc->solve(response));
+    pc.reset();
+    EXPECT_GT(pcm.getCachedContextsMemory(), memory);
+
+    pcm.setMaximumCachedContexts(0);
+    pcm.setMaximumCachedContextsMemory(1);
+    EXPECT_EQ(pcm.getCachedContextsCount(), 0u);
+    EXPECT_EQ(pcm.getCachedContextsMemory(), 0u);
+  }
+
+  void testWarmUp(const std::vector<double>& start, const std::vector<double>& goal)
+  {
+    ompl_interface::PlanningContextManager pcm(robot_model_, constraint_sampler_manager_);
+    pcm.setPlannerConfigurations(createCacheConfigurations());
+    planning_interface::MotionPlanRequest request = createRequest(start, goal);
+    moveit_msgs::MoveItErrorCodes error_code;
+
+    // the persistent roadmap is shared by all contexts of its configuration, also if they are built concurrently.
+    // Three requests and two warmed up contexts are in use at most at the same time, so there are five contexts of
+    // the roadmap configuration and one of RRTConnect.
+    const std::string rrt_connect = group_name_ + "[RRTConnect]";
+    const std::string lazy_prm = group_name_ + "[LazyPRM]";
+    pcm.warmUpContexts({ rrt_connect, lazy_prm, lazy_prm }, node_handle_, false, 3);
+    request.planner_id = "LazyPRM";
+    std::vector<ompl_interface::ModelBasedPlanningContextPtr> contexts;
+    for (int i = 0; i < 3; ++i)
+    {
+      contexts.push_back(pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false));
+      ASSERT_NE(contexts.back(), nullptr);
+    }
+    pcm.waitForWarmUp();
+    // the warmed up contexts are not in use anymore and are handed out again
+    for (int i = 0; i < 2; ++i)
+    {
+      contexts.push_back(pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false));
+      ASSERT_NE(contexts.back(), nullptr);
+    }
+    EXPECT_EQ(pcm.getCachedContextsCount(), 6u);
+    for (const ompl_interface::ModelBasedPlanningContextPtr& pc : contexts)
+      EXPECT_EQ(pc->getOMPLSimpleSetup()->getPlanner(), contexts.front()->getOMPLSimpleSetup()->getPlanner());
+    contexts.clear();
+
+    // requests use the warmed up contexts
+    request.planner_id = "RRTConnect";
+    ompl_interface::ModelBasedPlanningContextPtr pc =
+        pcm.getPlanningContext(planning_scene_, request, error_code, node_handle_, false);
+    ASSERT_NE(pc, nullptr);
+    EXPECT_EQ(pc->getName(), rrt_connect);
+    EXPECT_EQ(pcm.getCachedContextsCount(), 6u);
+    planning_interface::MotionPlanDetailedResponse response;
+    EXPECT_TRUE(pc->solve(response));
+  }
+
   // /***************************************************************************
   //  * END Test implementation
   //  * ************************************************************************/
@@ -245,6 +393,25 @@ protected:
     return request;
   }
 
+  /** Create joint space configurations of RRTConnect, RRT and a persistent LazyPRM roadmap. **/
+  planning_interface::PlannerConfigurationMap createCacheConfigurations() const
+  {
+    planning_interface::PlannerConfigurationMap pconfig_map;
+    for (const std::pair<std::string, std::string>& planner :
+         { std::make_pair("RRTConnect", "geometric::RRTConnect"), std::make_pair("RRT", "geometric::RRT"),
+           std::make_pair("LazyPRM", "geometric::LazyPRM") })
+    {
+      planning_interface::PlannerConfigurationSettings pconfig_settings;
+      pconfig_settings.group = group_name_;
+      pconfig_settings.name = group_name_ + "[" + planner.first + "]";
+      pconfig_settings.config = { { "enforce_joint_model_state_space", "1" }, { "type", planner.second } };
+      if (planner.first == "LazyPRM")
+        pconfig_settings.config["persistent_roadmap"] = "1";
+      pconfig_map[pconfig_settings.name] = pconfig_settings;
+    }
+    return pconfig_map;
+  }
+
   /** \brief Helper function to create a position constraint. **/
   moveit_msgs::PositionConstraint createPositionConstraint(std::array<double, 3> position,
                                                            std::array<double, 3> dimensions)
@@ -324,6 +491,21 @@ TEST_F(PandaTestPlanningContext, testPathConstraints)
   testPathConstraints({ 0, -0.785, 0, -2.356, 0, 1.571, 0.785 }, { 0, -0.785, 0, -2.356, 0, 1.571, 0.685 });
 }
 
+TEST_F(PandaTestPlanningContext, testPersistentRoadmap)
+{
+  testPersistentRoadmap({ 0, -0.785, 0, -2.356, 0, 1.571, 0.785 }, { 0, -0.785, 0, -2.356, 0, 1.571, 0.685 });
+}
+
+TEST_F(PandaTestPlanningContext, testContextCache)
+{
+  testContextCache({ 0, -0.785, 0, -2.356, 0, 1.571, 0.785 }, { 0, -0.785, 0, -2.356, 0, 1.571, 0.685 });
+}
+
+TEST_F(PandaTestPlanningContext, testWarmUp)
+{
+  testWarmUp({ 0, -0.785, 0, -2.356, 0, 1.571, 0.785 }, { 0, -0.785, 0, -2.356, 0, 1.571, 0.685 });
+}
+
 /***************************************************************************
  * Run all tests on the Fanuc robot
  * ************************************************************************/
@@ -345,6 +527,21 @@ TEST_F(FanucTestPlanningContext, testPathConstraints)
   testPathConstraints({ 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0.1 });
 }
 
+TEST_F(FanucTestPlanningContext, testPersistentRoadmap)
+{
+  testPersistentRoadmap({ 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0.1 });
+}
+
+TEST_F(FanucTestPlanningContext, testContextCache)
+{
+  testContextCache({ 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0.1 });
+}
+
+TEST_F(FanucTestPlanningContext, testWarmUp)
+{
+  testWarmUp({ 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0.1 });
+}
+
 /***************************************************************************
  * MAIN
  * ************************************************************************/
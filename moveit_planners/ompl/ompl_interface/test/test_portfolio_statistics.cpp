@@ -0,0 +1,204 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/portfolio_statistics.h>
+#include <ompl/base/ScopedState.h>
+#include <ompl/base/goals/GoalState.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/geometric/PathGeometric.h>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace ob = ompl::base;
+using ompl_interface::PortfolioStatistics;
+
+TEST(PortfolioStatistics, RecordsRaces)
+{
+  PortfolioStatistics statistics;
+  statistics.recordRace({ "RRTConnect", "KPIECE" }, "RRTConnect", 1.0);
+  statistics.recordRace({ "RRTConnect", "KPIECE" }, "KPIECE", 4.0);
+  statistics.recordRace({ "RRTConnect", "KPIECE", "BiTRRT" }, "RRTConnect", 2.0);
+  statistics.recordRace({ "RRTConnect", "KPIECE", "BiTRRT" }, "", 0.0);
+
+  EXPECT_EQ(statistics.getRaceCount(), 4u);
+  const std::map<std::string, PortfolioStatistics::Record> records = statistics.getRecords();
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_EQ(records.at("RRTConnect").runs, 4u);
+  EXPECT_EQ(records.at("RRTConnect").wins, 2u);
+  EXPECT_DOUBLE_EQ(records.at("RRTConnect").win_time, 3.0);
+  EXPECT_EQ(records.at("KPIECE").runs, 4u);
+  EXPECT_EQ(records.at("KPIECE").wins, 1u);
+  EXPECT_DOUBLE_EQ(records.at("KPIECE").win_time, 4.0);
+  EXPECT_EQ(records.at("BiTRRT").runs, 2u);
+  EXPECT_EQ(records.at("BiTRRT").wins, 0u);
+
+  std::stringstream ss;
+  statistics.print(ss);
+  EXPECT_NE(ss.str().find("4 races"), std::string::npos);
+  EXPECT_NE(ss.str().find("RRTConnect: won 2 of 4, in 1.5s on average"), std::string::npos);
+  EXPECT_NE(ss.str().find("BiTRRT: won 0 of 2\n"), std::string::npos);
+}
+
+TEST(PortfolioStatistics, RecordsConcurrentRaces)
+{
+  PortfolioStatistics statistics;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&statistics] {
+      for (int j = 0; j < 100; ++j)
+        statistics.recordRace({ "RRTConnect", "KPIECE" }, j % 2 ? "RRTConnect" : "", 0.1);
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(statistics.getRaceCount(), 400u);
+  EXPECT_EQ(statistics.getRecords().at("RRTConnect").runs, 400u);
+  EXPECT_EQ(statistics.getRecords().at("RRTConnect").wins, 200u);
+  EXPECT_EQ(statistics.getRecords().at("KPIECE").wins, 0u);
+}
+
+/** A planner that returns \e result after \e delay seconds, unless terminated before */
+class DelayedPlanner : public ob::Planner
+{
+public:
+  DelayedPlanner(const ob::SpaceInformationPtr& si, double delay, ob::PlannerStatus result)
+    : ob::Planner(si, "DelayedPlanner"), delay_(delay), result_(result)
+  {
+  }
+
+  using ob::Planner::solve;
+  ob::PlannerStatus solve(const ob::PlannerTerminationCondition& ptc) override
+  {
+    checkValidity();
+    const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(delay_);
+    while (std::chrono::steady_clock::now() < end)
+    {
+      if (ptc())
+        return ob::PlannerStatus::TIMEOUT;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto path = std::make_shared<ompl::geometric::PathGeometric>(si_, pdef_->getStartState(0),
+                                                                 pdef_->getGoal()->as<ob::GoalState>()->getState());
+    if (result_ == ob::PlannerStatus::EXACT_SOLUTION)
+      pdef_->addSolutionPath(path, false, 0.0, getName());
+    else if (result_ == ob::PlannerStatus::APPROXIMATE_SOLUTION)
+      pdef_->addSolutionPath(path, true, 1.0, getName());
+    return result_;
+  }
+
+private:
+  double delay_;
+  ob::PlannerStatus result_;
+};
+
+class RacePlannersTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    auto space = std::make_shared<ob::RealVectorStateSpace>(1);
+    space->setBounds(0.0, 1.0);
+    si_ = std::make_shared<ob::SpaceInformation>(space);
+    si_->setStateValidityChecker([](const ob::State* /*state*/) { return true; });
+    si_->setup();
+
+    ob::ScopedState<ob::RealVectorStateSpace> start(space), goal(space);
+    start->values[0] = 0.0;
+    goal->values[0] = 1.0;
+    pdef_ = std::make_shared<ob::ProblemDefinition>(si_);
+    pdef_->setStartAndGoalStates(start, goal);
+  }
+
+  ob::PlannerPtr makePlanner(double delay, ob::PlannerStatus result)
+  {
+    auto planner = std::make_shared<DelayedPlanner>(si_, delay, result);
+    planner->setProblemDefinition(pdef_);
+    planner->setup();
+    return planner;
+  }
+
+  ob::SpaceInformationPtr si_;
+  ob::ProblemDefinitionPtr pdef_;
+};
+
+TEST_F(RacePlannersTest, FirstExactSolutionWins)
+{
+  const std::vector<ob::PlannerPtr> planners = { makePlanner(0.0, ob::PlannerStatus::APPROXIMATE_SOLUTION),
+                                                 makePlanner(60.0, ob::PlannerStatus::EXACT_SOLUTION),
+                                                 makePlanner(0.1, ob::PlannerStatus::EXACT_SOLUTION) };
+  std::vector<ob::PlannerStatus> status;
+  double time = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t winner =
+      ompl_interface::racePlanners(planners, ob::timedPlannerTerminationCondition(60.0), status, time);
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // the winner stops the slow planner, approximate solutions don't
+  EXPECT_EQ(winner, 2u);
+  EXPECT_GE(time, 0.1);
+  EXPECT_LT(elapsed, 10.0);
+  ASSERT_EQ(status.size(), 3u);
+  EXPECT_EQ(status[0], ob::PlannerStatus::APPROXIMATE_SOLUTION);
+  EXPECT_EQ(status[1], ob::PlannerStatus::TIMEOUT);
+  EXPECT_EQ(status[2], ob::PlannerStatus::EXACT_SOLUTION);
+  EXPECT_TRUE(pdef_->hasExactSolution());
+}
+
+TEST_F(RacePlannersTest, NoWinnerWithoutExactSolution)
+{
+  const std::vector<ob::PlannerPtr> planners = { makePlanner(0.0, ob::PlannerStatus::APPROXIMATE_SOLUTION),
+                                                 makePlanner(60.0, ob::PlannerStatus::EXACT_SOLUTION) };
+  std::vector<ob::PlannerStatus> status;
+  double time = 1.0;
+  const std::size_t winner =
+      ompl_interface::racePlanners(planners, ob::timedPlannerTerminationCondition(0.2), status, time);
+
+  EXPECT_EQ(winner, planners.size());
+  EXPECT_EQ(time, 0.0);
+  ASSERT_EQ(status.size(), 2u);
+  EXPECT_EQ(status[0], ob::PlannerStatus::APPROXIMATE_SOLUTION);
+  EXPECT_EQ(status[1], ob::PlannerStatus::TIMEOUT);
+  EXPECT_FALSE(pdef_->hasExactSolution());
+  EXPECT_TRUE(pdef_->hasApproximateSolution());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -38,6 +38,9 @@
 
 #include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.h>
 #include <moveit/ompl_interface/parameterization/work_space/pose_model_state_space.h>
+#include <moveit/ompl_interface/model_based_planning_context.h>
+#include <moveit/ompl_interface/detail/projection_evaluators.h>
+#include <ompl/geometric/SimpleSetup.h>
 
 #include <urdf_parser/urdf_parser.h>
 
@@ -184,6 +187,129 @@ TEST_F(LoadPlanningModelsPr2, StateSpaceCopy)
   joint_model_state_space.freeState(state);
 }
 
+// The vectorized distance and interpolation must match the per-joint implementation of the group
+TEST_F(LoadPlanningModelsPr2, VectorizedDistanceAndInterpolation)
+{
+  ompl_interface::ModelBasedStateSpaceSpecification spec(robot_model_, "right_arm");
+  ompl_interface::JointModelStateSpace ss(spec);
+  ss.setup();
+  ASSERT_TRUE(ss.isVectorized());
+  const moveit::core::JointModelGroup* jmg = ss.getJointModelGroup();
+
+  // the whole body contains a planar joint and needs the generic implementation
+  ompl_interface::ModelBasedStateSpaceSpecification whole_body_spec(robot_model_, "whole_body");
+  EXPECT_FALSE(ompl_interface::JointModelStateSpace(whole_body_spec).isVectorized());
+
+  ompl::base::StateSamplerPtr sampler = ss.allocStateSampler();
+  ompl::base::State* from = ss.allocState();
+  ompl::base::State* to = ss.allocState();
+  ompl::base::State* state = ss.allocState();
+  std::vector<double> expected(jmg->getVariableCount());
+  const int forearm_roll = jmg->getVariableGroupIndex("r_forearm_roll_joint");
+  const int wrist_roll = jmg->getVariableGroupIndex("r_wrist_roll_joint");
+  for (int i = 0; i < 100; ++i)
+  {
+    sampler->sampleUniform(from);
+    sampler->sampleUniform(to);
+    double* from_values = from->as<ompl_interface::ModelBasedStateSpace::StateType>()->values;
+    double* to_values = to->as<ompl_interface::ModelBasedStateSpace::StateType>()->values;
+    // make the continuous forearm roll joint wrap around, and the wrist roll joint exceed one period
+    from_values[forearm_roll] = 3.0;
+    to_values[forearm_roll] = -3.0;
+    if (i % 2)
+      to_values[wrist_roll] = from_values[wrist_roll] + 3.0 * M_PI;
+
+    EXPECT_NEAR(ss.distance(from, to), jmg->distance(from_values, to_values), 1e-12);
+    for (double t : { 0.0, 0.3, 0.5, 1.0 })
+    {
+      ss.interpolate(from, to, t, state);
+      jmg->interpolate(from_values, to_values, t, expected.data());
+      for (std::size_t j = 0; j < expected.size(); ++j)
+        EXPECT_EQ(state->as<ompl_interface::ModelBasedStateSpace::StateType>()->values[j], expected[j]);
+    }
+  }
+  ss.freeState(from);
+  ss.freeState(to);
+  ss.freeState(state);
+}
+
+// Memoized link positions must be forgotten whenever the values of a state change
+TEST_F(LoadPlanningModelsPr2, MemoizedProjectionMatchesForwardKinematics)
+{
+  ompl_interface::ModelBasedStateSpaceSpecification space_spec(robot_model_, "right_arm");
+  auto ss = std::make_shared<ompl_interface::JointModelStateSpace>(space_spec);
+  ss->setup();
+  ompl_interface::ModelBasedPlanningContextSpecification spec;
+  spec.state_space_ = ss;
+  spec.ompl_simple_setup_ = std::make_shared<ompl::geometric::SimpleSetup>(ss);
+  ompl_interface::ModelBasedPlanningContext context("right_arm", spec);
+  moveit::core::RobotState robot_state(robot_model_);
+  robot_state.setToDefaultValues();
+  context.setCompleteInitialState(robot_state);
+
+  const moveit::core::LinkModel* link = robot_model_->getLinkModel("r_wrist_roll_link");
+  ompl_interface::ProjectionEvaluatorLinkPose projection(&context, link->getName());
+  ASSERT_EQ(ss->getCachedLink(), link);
+
+  // compare the projection to the position computed by a full forward kinematics update
+  const auto expect_uncached = [&](const ompl::base::State* state) {
+    robot_state.setJointGroupPositions(ss->getJointModelGroup(),
+                                       state->as<ompl_interface::ModelBasedStateSpace::StateType>()->values);
+    robot_state.update();
+    Eigen::VectorXd position(3);
+    projection.project(state, position);
+    EXPECT_TRUE(position.isApprox(robot_state.getGlobalLinkTransform(link).translation(), 1e-9))
+        << position.transpose() << " != " << robot_state.getGlobalLinkTransform(link).translation().transpose();
+  };
+  const auto memoize = [&](const ompl::base::State* state) {
+    Eigen::VectorXd position(3);
+    projection.project(state, position);
+    ASSERT_TRUE(state->as<ompl_interface::ModelBasedStateSpace::StateType>()->isLinkPositionKnown());
+  };
+
+  ompl::base::StateSamplerPtr sampler = ss->allocStateSampler();
+  ompl::base::State* state = ss->allocState();
+  ompl::base::State* other = ss->allocState();
+  std::vector<unsigned char> serialization(ss->getSerializationLength());
+  const moveit::core::VariableBounds& bounds = robot_model_->getVariableBounds("r_shoulder_pan_joint");
+  const int shoulder_pan = ss->getJointModelGroup()->getVariableGroupIndex("r_shoulder_pan_joint");
+  for (int i = 0; i < 10; ++i)
+  {
+    sampler->sampleUniform(state);
+    sampler->sampleUniform(other);
+    expect_uncached(state);
+
+    // copying takes over the position memoized in the source, or its absence
+    memoize(state);
+    ss->copyState(state, other);
+    expect_uncached(state);
+    sampler->sampleUniform(other);
+    memoize(other);
+    ss->copyState(state, other);
+    expect_uncached(state);
+
+    // values clamped to the bounds
+    memoize(state);
+    state->as<ompl_interface::ModelBasedStateSpace::StateType>()->values[shoulder_pan] = bounds.max_position_ + 0.5;
+    ss->enforceBounds(state);
+    expect_uncached(state);
+
+    // values read from a serialization
+    sampler->sampleUniform(other);
+    ss->serialize(serialization.data(), other);
+    memoize(state);
+    ss->deserialize(state, serialization.data());
+    expect_uncached(state);
+
+    // values written through their address
+    memoize(state);
+    *ss->getValueAddressAtIndex(state, shoulder_pan) = bounds.min_position_;
+    expect_uncached(state);
+  }
+  ss->freeState(state);
+  ss->freeState(other);
+}
+
 // Run the OMPL sanity checks on the diff drive model
 TEST(TestDiffDrive, TestStateSpace)
 {
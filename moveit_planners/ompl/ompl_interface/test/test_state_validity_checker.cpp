@@ -148,6 +148,51 @@ public:
     EXPECT_TRUE(robot_state_->satisfiesBounds());
   }
 
+  /** Within a motion, the pair of bodies of the last collision is checked first. This must not change results. **/
+  void testCollisionMemory(const std::vector<double>& position_in_self_collision,
+                           const std::vector<double>& position_valid)
+  {
+    auto checker = std::make_shared<ompl_interface::StateValidityChecker>(planning_context_.get());
+
+    ompl::base::ScopedState<> colliding_state(state_space_);
+    robot_state_->setJointGroupPositions(joint_model_group_, position_in_self_collision);
+    state_space_->copyToOMPLState(colliding_state.get(), *robot_state_);
+    ompl::base::ScopedState<> valid_state(state_space_);
+    robot_state_->setJointGroupPositions(joint_model_group_, position_valid);
+    state_space_->copyToOMPLState(valid_state.get(), *robot_state_);
+
+    checker->beginMotion();
+    for (int i = 0; i < 3; ++i)
+    {
+      // forget the cached validity, so the states are checked again
+      colliding_state->as<ompl_interface::JointModelStateSpace::StateType>()->clearKnownInformation();
+      valid_state->as<ompl_interface::JointModelStateSpace::StateType>()->clearKnownInformation();
+      EXPECT_FALSE(checker->isValid(colliding_state.get()));
+      EXPECT_TRUE(checker->isValid(valid_state.get()));
+    }
+    checker->endMotion();
+
+    // outside of motions, each state is checked against the whole scene
+    std::size_t checks = checker->getSceneCollisionCheckCount();
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      colliding_state->as<ompl_interface::JointModelStateSpace::StateType>()->clearKnownInformation();
+      EXPECT_FALSE(checker->isValid(colliding_state.get()));
+    }
+    EXPECT_EQ(checker->getSceneCollisionCheckCount() - checks, 10u);
+
+    // within motions, the remembered pair is found colliding without checking the whole scene
+    checks = checker->getSceneCollisionCheckCount();
+    checker->beginMotion();
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      colliding_state->as<ompl_interface::JointModelStateSpace::StateType>()->clearKnownInformation();
+      EXPECT_FALSE(checker->isValid(colliding_state.get()));
+    }
+    checker->endMotion();
+    EXPECT_LE(checker->getSceneCollisionCheckCount() - checks, 2u);
+  }
+
   void testPathConstraints(const std::vector<double>& position_in_joint_limits)
   {
     ASSERT_NE(planning_context_, nullptr) << "Initialize planning context before adding path constraints.";
@@ -290,6 +335,12 @@ TEST_F(PandaValidity, testSelfCollision)
   testSelfCollision({ 2.31827, -0.169668, 2.5225, -2.98568, -0.36355, 0.808339, 0.0843406 });
 }
 
+TEST_F(PandaValidity, testCollisionMemory)
+{
+  testCollisionMemory({ 2.31827, -0.169668, 2.5225, -2.98568, -0.36355, 0.808339, 0.0843406 },
+                      { 0, -0.785, 0, -2.356, 0, 1.571, 0.785 });
+}
+
 TEST_F(PandaValidity, testPathConstraints)
 {
   // use the panda "ready" state from the srdf config
@@ -57,6 +57,13 @@ public:
 
   bool sendTrajectory(const moveit_msgs::RobotTrajectory& trajectory) override;
 
+  bool supportsTrajectorySplicing() const override
+  {
+    return true;
+  }
+
+  bool spliceTrajectory(const moveit_msgs::RobotTrajectory& trajectory) override;
+
   void configure(XmlRpc::XmlRpcValue& config) override;
 
 protected:
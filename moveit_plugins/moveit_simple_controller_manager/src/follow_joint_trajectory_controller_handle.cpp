@@ -70,6 +70,26 @@ bool FollowJointTrajectoryControllerHandle::sendTrajectory(const moveit_msgs::Ro
   return true;
 }
 
+bool FollowJointTrajectoryControllerHandle::spliceTrajectory(const moveit_msgs::RobotTrajectory& trajectory)
+{
+  if (done_)
+  {
+    ROS_WARN_STREAM_NAMED(LOGNAME, "Cannot splice trajectory for " << name_ << ": no trajectory is being executed");
+    return false;
+  }
+  if (trajectory.joint_trajectory.header.stamp.isZero())
+  {
+    ROS_WARN_STREAM_NAMED(LOGNAME, "Cannot splice trajectory for " << name_ << ": splice time is not specified");
+    return false;
+  }
+
+  // A goal whose header stamp lies in the future replaces the active trajectory of a joint_trajectory_controller from
+  // that instant on, without stopping. The preempted goal is not tracked anymore, so done_ remains false.
+  ROS_DEBUG_STREAM_NAMED(LOGNAME, "splicing trajectory for " << name_ << " at t = "
+                                                             << trajectory.joint_trajectory.header.stamp.toSec());
+  return sendTrajectory(trajectory);
+}
+
 void FollowJointTrajectoryControllerHandle::configure(XmlRpc::XmlRpcValue& config)
 {
   if (config.hasMember("path_tolerance"))
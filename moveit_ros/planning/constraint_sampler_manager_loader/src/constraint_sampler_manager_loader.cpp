@@ -38,6 +38,7 @@
 #include <pluginlib/class_loader.hpp>
 #include <ros/ros.h>
 #include <boost/tokenizer.hpp>
+#include <map>
 #include <memory>
 
 namespace constraint_sampler_manager_loader
@@ -78,6 +79,26 @@ public:
         }
       }
     }
+
+    // precomputed reachability maps, given as a dictionary from group name to file name
+    std::map<std::string, std::string> reachability_maps;
+    if (nh_.getParam("reachability_maps", reachability_maps))
+      for (const std::pair<const std::string, std::string>& entry : reachability_maps)
+      {
+        auto map = std::make_shared<reachability_map::ReachabilityMap>();
+        if (!map->load(entry.second))
+          ROS_ERROR("Unable to load reachability map for group '%s' from '%s'", entry.first.c_str(),
+                    entry.second.c_str());
+        else if (map->getGroupName() != entry.first)
+          ROS_ERROR("Reachability map '%s' was computed for group '%s', not '%s'", entry.second.c_str(),
+                    map->getGroupName().c_str(), entry.first.c_str());
+        else
+        {
+          csm->registerReachabilityMap(map);
+          ROS_INFO("Loaded reachability map for group '%s' (%zu reachable cells)", entry.first.c_str(),
+                   map->getReachableCellCount());
+        }
+      }
   }
 
 private:
@@ -0,0 +1,137 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.h>
+#include <moveit/planning_scene/planning_scene.h>
+#include <moveit/robot_trajectory/robot_trajectory.h>
+#include <eigen_stl_containers/eigen_stl_vector_container.h>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <vector>
+
+namespace plan_execution
+{
+MOVEIT_CLASS_FORWARD(IncrementalPathValidityChecker);  // Defines IncrementalPathValidityCheckerPtr, ConstPtr, ...
+
+/** \brief Validity checking of the remaining waypoints of executed trajectories, reusing earlier results.
+
+    Waypoints found valid are cached. After a change of the world, only waypoints whose swept bounding boxes (the
+    bounding boxes of each link while moving towards the next waypoint) intersect the changed regions are checked
+    again. Moved, added or removed objects are found by comparing the world of the checked scene with the objects seen
+    in the previous check, whenever the world's version differs. This also covers worlds replaced in the meantime, e.g.
+    by PlanningScene::clearDiffs(). Octree updates are reported by addChangedVoxels(). Changes of the state feasibility
+    predicate are not tracked. The checked scene and the world passed to start() must not be modified during the
+    calls, e.g. by holding a read lock of the planning scene. */
+class IncrementalPathValidityChecker
+{
+public:
+  IncrementalPathValidityChecker();
+  ~IncrementalPathValidityChecker();
+
+  /** \brief Forget all cached results and start tracking changes relative to \e world (if given, otherwise relative to
+      the world of the first checked scene) */
+  void start(const collision_detection::WorldConstPtr& world = collision_detection::WorldConstPtr());
+
+  /** \brief Stop tracking changes and forget all cached results */
+  void stop();
+
+  /** \brief Report a changed region of the world, in the planning frame */
+  void addChangedRegion(const Eigen::AlignedBox3d& region);
+
+  /** \brief Report octree voxels (given by their centers in the planning frame) whose occupancy changed */
+  void addChangedVoxels(const EigenSTL::vector_Vector3d& centers, double resolution);
+
+  /** \brief Consider the whole world changed, i.e. check all waypoints again */
+  void invalidate();
+
+  /** \brief Check the waypoints of \e trajectory starting at \e first_waypoint for collisions and feasibility.
+
+      \e trajectory_index identifies the trajectory among the ones checked since start(); cached results of a
+      trajectory are only valid as long as it is not modified. */
+  bool isPathValid(const planning_scene::PlanningScene& scene, const robot_trajectory::RobotTrajectory& trajectory,
+                   std::size_t trajectory_index, const collision_detection::AllowedCollisionMatrix* acm,
+                   std::size_t first_waypoint);
+
+  /** \brief Number of waypoints checked since start() */
+  std::size_t getCheckCount() const;
+
+  /** \brief Number of waypoints whose cached validity was reused since start() */
+  std::size_t getSkipCount() const;
+
+private:
+  struct TrajectoryCache
+  {
+    /// swept bounding box of all links, per waypoint
+    std::vector<Eigen::AlignedBox3d> waypoint_boxes_;
+    /// swept bounding boxes of each link (and all attached bodies), stored consecutively per waypoint
+    std::vector<Eigen::AlignedBox3d> link_boxes_;
+    std::size_t boxes_per_waypoint_;
+    /// waypoints known to be valid
+    std::vector<bool> valid_;
+  };
+
+  void buildCache(const robot_trajectory::RobotTrajectory& trajectory, TrajectoryCache& cache) const;
+  void markChanged(const Eigen::AlignedBox3d& region);
+  void applyChanges();
+  void takeSnapshot(const collision_detection::World& world);
+  void updateSnapshot(const collision_detection::World& world);
+  static Eigen::AlignedBox3d computeObjectBox(const collision_detection::World::Object& object);
+
+  mutable boost::mutex lock_;
+  bool active_;
+
+  struct ObjectSnapshot
+  {
+    /// objects are copied on modification while referenced here, so an unchanged pointer means an unchanged object
+    collision_detection::World::ObjectConstPtr object_;
+    Eigen::AlignedBox3d box_;
+  };
+
+  /// the objects of the world seen last, and its version
+  std::map<std::string, ObjectSnapshot> objects_;
+  std::size_t world_version_;
+  bool has_snapshot_;
+
+  std::vector<TrajectoryCache> caches_;
+  std::vector<Eigen::AlignedBox3d> changed_regions_;
+  Eigen::AlignedBox3d changed_bounds_;
+  bool changed_all_;
+
+  std::size_t check_count_;
+  std::size_t skip_count_;
+};
+}  // namespace plan_execution
@@ -38,6 +38,7 @@
 
 #include <moveit/macros/class_forward.h>
 #include <moveit/plan_execution/plan_representation.h>
+#include <moveit/plan_execution/incremental_path_validity_checker.h>
 #include <moveit/trajectory_execution_manager/trajectory_execution_manager.h>
 #include <moveit/planning_scene_monitor/planning_scene_monitor.h>
 #include <moveit/planning_scene_monitor/trajectory_monitor.h>
@@ -139,6 +140,12 @@ public:
 
   void stop();
 
+  /** \brief Get the checker used to validate the remaining path during execution, e.g. to inspect its check counts */
+  const IncrementalPathValidityChecker& getPathValidityChecker() const
+  {
+    return path_validity_checker_;
+  }
+
 private:
   void planAndExecuteHelper(ExecutableMotionPlan& plan, const Options& opt);
   bool isRemainingPathValid(const ExecutableMotionPlan& plan, const std::pair<int, int>& path_segment);
@@ -174,6 +181,7 @@ private:
   } preempt_;
 
   bool new_scene_update_;
+  IncrementalPathValidityChecker path_validity_checker_;
 
   bool execution_complete_;
   bool path_became_invalid_;
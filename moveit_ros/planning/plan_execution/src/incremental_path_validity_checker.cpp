@@ -0,0 +1,358 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/plan_execution/incremental_path_validity_checker.h>
+#include <moveit/robot_model/aabb.h>
+#include <geometric_shapes/shape_operations.h>
+
+namespace plan_execution
+{
+// beyond this number of changed regions, checking all waypoints is cheaper than testing for intersections
+static const std::size_t MAX_CHANGED_REGIONS = 10000;
+
+IncrementalPathValidityChecker::IncrementalPathValidityChecker()
+  : active_(false), world_version_(0), has_snapshot_(false), changed_all_(false), check_count_(0), skip_count_(0)
+{
+}
+
+IncrementalPathValidityChecker::~IncrementalPathValidityChecker()
+{
+  stop();
+}
+
+void IncrementalPathValidityChecker::start(const collision_detection::WorldConstPtr& world)
+{
+  stop();
+
+  boost::mutex::scoped_lock slock(lock_);
+  active_ = true;
+  check_count_ = 0;
+  skip_count_ = 0;
+  if (world)
+    takeSnapshot(*world);
+}
+
+void IncrementalPathValidityChecker::stop()
+{
+  boost::mutex::scoped_lock slock(lock_);
+  objects_.clear();
+  has_snapshot_ = false;
+  caches_.clear();
+  changed_regions_.clear();
+  changed_bounds_.setEmpty();
+  changed_all_ = false;
+  active_ = false;
+}
+
+void IncrementalPathValidityChecker::addChangedRegion(const Eigen::AlignedBox3d& region)
+{
+  boost::mutex::scoped_lock slock(lock_);
+  if (active_)
+    markChanged(region);
+}
+
+void IncrementalPathValidityChecker::addChangedVoxels(const EigenSTL::vector_Vector3d& centers, double resolution)
+{
+  boost::mutex::scoped_lock slock(lock_);
+  if (!active_)
+    return;
+  const Eigen::Vector3d half_size = Eigen::Vector3d::Constant(0.5 * resolution);
+  for (const Eigen::Vector3d& center : centers)
+    markChanged(Eigen::AlignedBox3d(center - half_size, center + half_size));
+}
+
+void IncrementalPathValidityChecker::invalidate()
+{
+  boost::mutex::scoped_lock slock(lock_);
+  changed_all_ = true;
+  changed_regions_.clear();
+  changed_bounds_.setEmpty();
+}
+
+std::size_t IncrementalPathValidityChecker::getCheckCount() const
+{
+  boost::mutex::scoped_lock slock(lock_);
+  return check_count_;
+}
+
+std::size_t IncrementalPathValidityChecker::getSkipCount() const
+{
+  boost::mutex::scoped_lock slock(lock_);
+  return skip_count_;
+}
+
+void IncrementalPathValidityChecker::markChanged(const Eigen::AlignedBox3d& region)
+{
+  // lock_ needs to be held by the caller
+  if (changed_all_ || region.isEmpty())
+    return;
+  if (changed_regions_.size() >= MAX_CHANGED_REGIONS)
+  {
+    changed_all_ = true;
+    changed_regions_.clear();
+    changed_bounds_.setEmpty();
+    return;
+  }
+  changed_regions_.push_back(region);
+  changed_bounds_.extend(region);
+}
+
+void IncrementalPathValidityChecker::takeSnapshot(const collision_detection::World& world)
+{
+  // lock_ needs to be held by the caller
+  objects_.clear();
+  for (const auto& object : world)
+    objects_[object.first] = ObjectSnapshot{ object.second, computeObjectBox(*object.second) };
+  world_version_ = world.getVersion();
+  has_snapshot_ = true;
+}
+
+void IncrementalPathValidityChecker::updateSnapshot(const collision_detection::World& world)
+{
+  // lock_ needs to be held by the caller
+  if (!has_snapshot_)
+  {
+    // nothing is known about the world the cached results were computed for
+    changed_all_ = true;
+    takeSnapshot(world);
+    return;
+  }
+  if (world.getVersion() == world_version_)
+    return;
+
+  // The version also changes when the world is replaced, e.g. by PlanningScene::clearDiffs(). The objects of a
+  // replaced world are shared with its predecessor, so only objects modified since the last snapshot differ.
+  std::map<std::string, ObjectSnapshot> objects;
+  for (const auto& object : world)
+  {
+    auto it = objects_.find(object.first);
+    if (it != objects_.end() && it->second.object_ == object.second)
+    {
+      objects.insert(objects.end(), *it);
+      objects_.erase(it);
+      continue;
+    }
+
+    // a new or moved octree affects the whole world, voxel updates are reported by addChangedVoxels()
+    if (object.first == planning_scene::PlanningScene::OCTOMAP_NS)
+      changed_all_ = true;
+
+    // both, the region the object occupied before and the one it occupies now, changed
+    ObjectSnapshot snapshot{ object.second, computeObjectBox(*object.second) };
+    if (it != objects_.end())
+    {
+      markChanged(it->second.box_);
+      objects_.erase(it);
+    }
+    markChanged(snapshot.box_);
+    objects.insert(objects.end(), std::make_pair(object.first, snapshot));
+  }
+
+  // the remaining objects were removed
+  for (const auto& object : objects_)
+  {
+    if (object.first == planning_scene::PlanningScene::OCTOMAP_NS)
+      changed_all_ = true;
+    markChanged(object.second.box_);
+  }
+
+  objects_.swap(objects);
+  world_version_ = world.getVersion();
+}
+
+Eigen::AlignedBox3d IncrementalPathValidityChecker::computeObjectBox(const collision_detection::World::Object& object)
+{
+  // the octree is not bounded by a box, its changes are tracked separately
+  Eigen::AlignedBox3d box;
+  if (object.id_ == planning_scene::PlanningScene::OCTOMAP_NS)
+    return box;
+
+  // bounding spheres are conservative for all shape types, including meshes not centered at their origin
+  for (std::size_t i = 0; i < object.shapes_.size(); ++i)
+  {
+    Eigen::Vector3d center;
+    double radius;
+    shapes::computeShapeBoundingSphere(object.shapes_[i].get(), center, radius);
+    center = object.global_shape_poses_[i] * center;
+    box.extend(center - Eigen::Vector3d::Constant(radius));
+    box.extend(center + Eigen::Vector3d::Constant(radius));
+  }
+  return box;
+}
+
+void IncrementalPathValidityChecker::buildCache(const robot_trajectory::RobotTrajectory& trajectory,
+                                                TrajectoryCache& cache) const
+{
+  const std::vector<const moveit::core::LinkModel*>& links =
+      trajectory.getRobotModel()->getLinkModelsWithCollisionGeometry();
+  const std::size_t wpc = trajectory.getWayPointCount();
+  const std::size_t n = links.size() + 1;  // the last box covers all attached bodies
+
+  cache.boxes_per_waypoint_ = n;
+  cache.link_boxes_.assign(wpc * n, Eigen::AlignedBox3d());
+  cache.waypoint_boxes_.assign(wpc, Eigen::AlignedBox3d());
+  cache.valid_.assign(wpc, false);
+
+  std::vector<const moveit::core::AttachedBody*> attached_bodies;
+  for (std::size_t i = 0; i < wpc; ++i)
+  {
+    moveit::core::RobotState state(trajectory.getWayPoint(i));
+    state.updateCollisionBodyTransforms();
+    for (std::size_t k = 0; k < links.size(); ++k)
+    {
+      moveit::core::AABB box;
+      Eigen::Isometry3d transform = state.getGlobalLinkTransform(links[k]);  // intentional copy, we will translate
+      transform.translate(links[k]->getCenteredBoundingBoxOffset());
+      box.extendWithTransformedBox(transform, links[k]->getShapeExtentsAtOrigin());
+      cache.link_boxes_[i * n + k] = box;
+    }
+
+    Eigen::AlignedBox3d& attached_box = cache.link_boxes_[i * n + n - 1];
+    state.getAttachedBodies(attached_bodies);
+    for (const moveit::core::AttachedBody* attached_body : attached_bodies)
+    {
+      const EigenSTL::vector_Isometry3d& transforms = attached_body->getGlobalCollisionBodyTransforms();
+      const std::vector<shapes::ShapeConstPtr>& shapes = attached_body->getShapes();
+      for (std::size_t j = 0; j < shapes.size(); ++j)
+      {
+        Eigen::Vector3d center;
+        double radius;
+        shapes::computeShapeBoundingSphere(shapes[j].get(), center, radius);
+        center = transforms[j] * center;
+        attached_box.extend(center - Eigen::Vector3d::Constant(radius));
+        attached_box.extend(center + Eigen::Vector3d::Constant(radius));
+      }
+    }
+  }
+
+  // sweep the boxes of each waypoint towards the next one
+  for (std::size_t i = 0; i < wpc; ++i)
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      Eigen::AlignedBox3d& box = cache.link_boxes_[i * n + k];
+      if (i + 1 < wpc)
+        box.extend(cache.link_boxes_[(i + 1) * n + k]);
+      cache.waypoint_boxes_[i].extend(box);
+    }
+}
+
+void IncrementalPathValidityChecker::applyChanges()
+{
+  // lock_ needs to be held by the caller
+  if (changed_all_)
+  {
+    for (TrajectoryCache& cache : caches_)
+      std::fill(cache.valid_.begin(), cache.valid_.end(), false);
+  }
+  else if (!changed_regions_.empty())
+  {
+    for (TrajectoryCache& cache : caches_)
+      for (std::size_t i = 0; i < cache.valid_.size(); ++i)
+      {
+        if (!cache.valid_[i] || !cache.waypoint_boxes_[i].intersects(changed_bounds_))
+          continue;
+        for (const Eigen::AlignedBox3d& region : changed_regions_)
+        {
+          if (!cache.waypoint_boxes_[i].intersects(region))
+            continue;
+          const std::size_t n = cache.boxes_per_waypoint_;
+          for (std::size_t k = 0; k < n && cache.valid_[i]; ++k)
+            if (cache.link_boxes_[i * n + k].intersects(region))
+              cache.valid_[i] = false;
+          if (!cache.valid_[i])
+            break;
+        }
+      }
+  }
+  changed_regions_.clear();
+  changed_bounds_.setEmpty();
+  changed_all_ = false;
+}
+
+bool IncrementalPathValidityChecker::isPathValid(const planning_scene::PlanningScene& scene,
+                                                 const robot_trajectory::RobotTrajectory& trajectory,
+                                                 std::size_t trajectory_index,
+                                                 const collision_detection::AllowedCollisionMatrix* acm,
+                                                 std::size_t first_waypoint)
+{
+  boost::mutex::scoped_lock slock(lock_);
+
+  // without tracking changes, cached results cannot be trusted
+  if (!active_)
+    changed_all_ = true;
+  else
+    updateSnapshot(*scene.getWorld());
+  applyChanges();
+
+  if (trajectory_index >= caches_.size())
+    caches_.resize(trajectory_index + 1);
+  TrajectoryCache& cache = caches_[trajectory_index];
+  if (cache.valid_.size() != trajectory.getWayPointCount())
+    buildCache(trajectory, cache);
+
+  collision_detection::CollisionRequest req;
+  req.group_name = trajectory.getGroupName();
+  for (std::size_t i = first_waypoint; i < cache.valid_.size(); ++i)
+  {
+    if (cache.valid_[i])
+    {
+      ++skip_count_;
+      continue;
+    }
+
+    ++check_count_;
+    const moveit::core::RobotState& waypoint = trajectory.getWayPoint(i);
+    collision_detection::CollisionResult res;
+    if (acm)
+      scene.checkCollisionUnpadded(req, res, waypoint, *acm);
+    else
+      scene.checkCollisionUnpadded(req, res, waypoint);
+
+    if (res.collision || !scene.isStateFeasible(waypoint, false))
+    {
+      // call the same functions again, in verbose mode, to show what issues have been detected
+      scene.isStateFeasible(waypoint, true);
+      req.verbose = true;
+      res.clear();
+      if (acm)
+        scene.checkCollisionUnpadded(req, res, waypoint, *acm);
+      else
+        scene.checkCollisionUnpadded(req, res, waypoint);
+      return false;
+    }
+    cache.valid_[i] = true;
+  }
+  return true;
+}
+}  // namespace plan_execution
@@ -90,6 +90,10 @@ plan_execution::PlanExecution::PlanExecution(
   planning_scene_monitor_->addUpdateCallback([this](planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType type) {
     planningSceneUpdatedCallback(type);
   });
+  // and where the octomap changed, so that only the affected parts of the remaining path are checked again
+  planning_scene_monitor_->addOctomapChangeCallback([this](const EigenSTL::vector_Vector3d& voxels, double resolution) {
+    path_validity_checker_.addChangedVoxels(voxels, resolution);
+  });
 
   // start the dynamic-reconfigure server
   reconfigure_impl_ = new DynamicReconfigureImpl(this);
@@ -256,30 +260,9 @@ bool plan_execution::PlanExecution::isRemainingPathValid(const ExecutableMotionP
     const robot_trajectory::RobotTrajectory& t = *plan.plan_components_[path_segment.first].trajectory_;
     const collision_detection::AllowedCollisionMatrix* acm =
         plan.plan_components_[path_segment.first].allowed_collision_matrix_.get();
-    std::size_t wpc = t.getWayPointCount();
-    collision_detection::CollisionRequest req;
-    req.group_name = t.getGroupName();
-    for (std::size_t i = std::max(path_segment.second - 1, 0); i < wpc; ++i)
-    {
-      collision_detection::CollisionResult res;
-      if (acm)
-        plan.planning_scene_->checkCollisionUnpadded(req, res, t.getWayPoint(i), *acm);
-      else
-        plan.planning_scene_->checkCollisionUnpadded(req, res, t.getWayPoint(i));
-
-      if (res.collision || !plan.planning_scene_->isStateFeasible(t.getWayPoint(i), false))
-      {
-        // call the same functions again, in verbose mode, to show what issues have been detected
-        plan.planning_scene_->isStateFeasible(t.getWayPoint(i), true);
-        req.verbose = true;
-        res.clear();
-        if (acm)
-          plan.planning_scene_->checkCollisionUnpadded(req, res, t.getWayPoint(i), *acm);
-        else
-          plan.planning_scene_->checkCollisionUnpadded(req, res, t.getWayPoint(i));
-        return false;
-      }
-    }
+    // only waypoints affected by world changes since the last check are checked again
+    return path_validity_checker_.isPathValid(*plan.planning_scene_, t, path_segment.first, acm,
+                                              std::max(path_segment.second - 1, 0));
   }
   return true;
 }
@@ -377,6 +360,12 @@ moveit_msgs::MoveItErrorCodes plan_execution::PlanExecution::executeAndMonitor(E
   if (trajectory_monitor_)
     trajectory_monitor_->startTrajectoryMonitor();
 
+  // start tracking changes of the monitored world to check the remaining path incrementally
+  {
+    planning_scene_monitor::LockedPlanningSceneRW lscene(planning_scene_monitor_);
+    path_validity_checker_.start(lscene->getWorld());
+  }
+
   // start a trajectory execution thread
   trajectory_execution_manager_->execute(
       [this](const moveit_controller_manager::ExecutionStatus& status) { doneWithTrajectoryExecution(status); },
@@ -427,6 +416,13 @@ moveit_msgs::MoveItErrorCodes plan_execution::PlanExecution::executeAndMonitor(E
     trajectory_execution_manager_->stopExecution();
   }
 
+  {
+    planning_scene_monitor::LockedPlanningSceneRW lscene(planning_scene_monitor_);
+    ROS_DEBUG_NAMED("plan_execution", "Remaining path validity: %zu waypoints checked, %zu cached results reused",
+                    path_validity_checker_.getCheckCount(), path_validity_checker_.getSkipCount());
+    path_validity_checker_.stop();
+  }
+
   // stop recording trajectory states
   if (trajectory_monitor_)
   {
@@ -463,6 +459,10 @@ moveit_msgs::MoveItErrorCodes plan_execution::PlanExecution::executeAndMonitor(E
 void plan_execution::PlanExecution::planningSceneUpdatedCallback(
     const planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType update_type)
 {
+  // a new scene might change anything, e.g. the allowed collision matrix
+  if ((update_type & planning_scene_monitor::PlanningSceneMonitor::UPDATE_SCENE) ==
+      planning_scene_monitor::PlanningSceneMonitor::UPDATE_SCENE)
+    path_validity_checker_.invalidate();
   if (update_type & (planning_scene_monitor::PlanningSceneMonitor::UPDATE_GEOMETRY |
                      planning_scene_monitor::PlanningSceneMonitor::UPDATE_TRANSFORMS))
     new_scene_update_ = true;
@@ -0,0 +1,282 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <moveit/plan_execution/incremental_path_validity_checker.h>
+#include <moveit/planning_scene_monitor/planning_scene_monitor.h>
+#include <moveit/utils/robot_model_test_utils.h>
+#include <geometric_shapes/shapes.h>
+#include <octomap/octomap.h>
+
+#include <functional>
+
+static const std::size_t WAYPOINTS = 10;
+
+/** rotate the arm around its base, from the "ready" pose */
+static robot_trajectory::RobotTrajectoryPtr createTrajectory(const moveit::core::RobotModelConstPtr& robot_model,
+                                                             Eigen::Vector3d& last_hand_position)
+{
+  moveit::core::RobotState state(robot_model);
+  state.setToDefaultValues();
+  state.setToDefaultValues(robot_model->getJointModelGroup("panda_arm"), "ready");
+  auto trajectory = std::make_shared<robot_trajectory::RobotTrajectory>(robot_model, "panda_arm");
+  for (std::size_t i = 0; i < WAYPOINTS; ++i)
+  {
+    state.setVariablePosition("panda_joint1", -0.5 + i / (WAYPOINTS - 1.0));
+    state.update();
+    trajectory->addSuffixWayPoint(state, 0.1);
+  }
+  last_hand_position = state.getGlobalLinkTransform("panda_hand").translation();
+  return trajectory;
+}
+
+class IncrementalPathValidityCheckerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("panda");
+    scene_ = std::make_shared<planning_scene::PlanningScene>(robot_model_);
+    trajectory_ = createTrajectory(robot_model_, last_hand_position_);
+
+    checker_.start(scene_->getWorldNonConst());
+    ASSERT_TRUE(checkPath());
+    ASSERT_EQ(checker_.getCheckCount(), WAYPOINTS);
+  }
+
+  bool checkPath(std::size_t first_waypoint = 0)
+  {
+    return checker_.isPathValid(*scene_, *trajectory_, 0, nullptr, first_waypoint);
+  }
+
+  /** check the path and return the number of waypoints that were checked again */
+  std::size_t countRechecks()
+  {
+    const std::size_t checks = checker_.getCheckCount();
+    EXPECT_TRUE(checkPath());
+    return checker_.getCheckCount() - checks;
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  planning_scene::PlanningScenePtr scene_;
+  robot_trajectory::RobotTrajectoryPtr trajectory_;
+  Eigen::Vector3d last_hand_position_;
+  plan_execution::IncrementalPathValidityChecker checker_;
+};
+
+TEST_F(IncrementalPathValidityCheckerTest, CountsCheckedAndSkippedWaypoints)
+{
+  EXPECT_EQ(checker_.getSkipCount(), 0u);
+
+  // without changes of the world, all waypoints are known to be valid
+  EXPECT_EQ(countRechecks(), 0u);
+  EXPECT_EQ(checker_.getSkipCount(), WAYPOINTS);
+  ASSERT_TRUE(checkPath(4));
+  EXPECT_EQ(checker_.getCheckCount(), WAYPOINTS);
+  EXPECT_EQ(checker_.getSkipCount(), 2 * WAYPOINTS - 4);
+
+  // a modified trajectory is checked again
+  trajectory_->addSuffixWayPoint(trajectory_->getLastWayPoint(), 0.1);
+  EXPECT_EQ(countRechecks(), WAYPOINTS + 1);
+
+  checker_.invalidate();
+  EXPECT_EQ(countRechecks(), WAYPOINTS + 1);
+
+  // restarting resets the counts
+  checker_.start(scene_->getWorldNonConst());
+  EXPECT_EQ(checker_.getCheckCount(), 0u);
+  EXPECT_EQ(checker_.getSkipCount(), 0u);
+}
+
+TEST_F(IncrementalPathValidityCheckerTest, MovedObjectsInvalidateAffectedWaypoints)
+{
+  // objects away from the path don't invalidate cached results
+  collision_detection::World& world = *scene_->getWorldNonConst();
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(5.0, 5.0, 5.0);
+  world.addToObject("box", pose, std::make_shared<shapes::Box>(0.05, 0.05, 0.05), Eigen::Isometry3d::Identity());
+  EXPECT_EQ(countRechecks(), 0u);
+  pose.translation() = Eigen::Vector3d(5.0, -5.0, 5.0);
+  ASSERT_TRUE(world.setObjectPose("box", pose));
+  EXPECT_EQ(countRechecks(), 0u);
+
+  // moving the object onto the last waypoint makes the path invalid
+  pose.translation() = last_hand_position_;
+  ASSERT_TRUE(world.setObjectPose("box", pose));
+  std::size_t checks = checker_.getCheckCount();
+  EXPECT_FALSE(checkPath());
+  EXPECT_GE(checker_.getCheckCount() - checks, 1u);
+
+  // the region the object leaves changes as well, waypoints away from it are not checked again
+  pose.translation() = Eigen::Vector3d(5.0, 5.0, 5.0);
+  ASSERT_TRUE(world.setObjectPose("box", pose));
+  checks = checker_.getCheckCount();
+  EXPECT_TRUE(checkPath());
+  EXPECT_GE(checker_.getCheckCount() - checks, 1u);
+  EXPECT_LT(checker_.getCheckCount() - checks, WAYPOINTS);
+
+  // so does the region of a removed object
+  pose.translation() = last_hand_position_;
+  ASSERT_TRUE(world.setObjectPose("box", pose));
+  EXPECT_FALSE(checkPath());
+  ASSERT_TRUE(world.removeObject("box"));
+  EXPECT_TRUE(checkPath());
+}
+
+TEST_F(IncrementalPathValidityCheckerTest, ChangedVoxelsInvalidateAffectedWaypoints)
+{
+  // voxels away from the path don't invalidate cached results
+  checker_.addChangedVoxels({ Eigen::Vector3d(5.0, 5.0, 5.0), Eigen::Vector3d(-5.0, 5.0, 0.0) }, 0.05);
+  EXPECT_EQ(countRechecks(), 0u);
+
+  // a voxel at the last waypoint invalidates the waypoints close to it
+  checker_.addChangedVoxels({ last_hand_position_ }, 0.05);
+  const std::size_t rechecks = countRechecks();
+  EXPECT_GE(rechecks, 1u);
+  EXPECT_LT(rechecks, WAYPOINTS);
+
+  // a new octree changes the whole world
+  auto octree = std::make_shared<octomap::OcTree>(0.05);
+  octree->updateNode(5.0, 5.0, 5.0, true);
+  scene_->processOctomapPtr(octree, Eigen::Isometry3d::Identity());
+  EXPECT_EQ(countRechecks(), WAYPOINTS);
+}
+
+TEST_F(IncrementalPathValidityCheckerTest, TracksReplacedWorlds)
+{
+  // clearing the diffs of a scene replaces its world by a copy of the parent's one
+  scene_ = scene_->diff();
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(5.0, 5.0, 5.0);
+  scene_->getWorldNonConst()->addToObject("box", pose, std::make_shared<shapes::Box>(0.05, 0.05, 0.05),
+                                          Eigen::Isometry3d::Identity());
+  EXPECT_EQ(countRechecks(), 0u);
+  scene_->pushDiffs(scene_->getParent());
+  scene_->clearDiffs();
+  EXPECT_EQ(countRechecks(), 0u);
+
+  // changes of the replaced world are found
+  pose.translation() = last_hand_position_;
+  ASSERT_TRUE(scene_->getWorldNonConst()->setObjectPose("box", pose));
+  EXPECT_FALSE(checkPath());
+  scene_->clearDiffs();
+  EXPECT_TRUE(checkPath());
+}
+
+static moveit_msgs::PlanningScene createBoxSceneMsg(const std::string& frame_id, const Eigen::Vector3d& position,
+                                                    bool is_diff)
+{
+  moveit_msgs::CollisionObject box;
+  box.id = "box";
+  box.header.frame_id = frame_id;
+  box.primitives.resize(1);
+  box.primitives[0].type = shape_msgs::SolidPrimitive::BOX;
+  box.primitives[0].dimensions.assign(3, 0.05);
+  box.primitive_poses.resize(1);
+  box.primitive_poses[0].position.x = position.x();
+  box.primitive_poses[0].position.y = position.y();
+  box.primitive_poses[0].position.z = position.z();
+  box.primitive_poses[0].orientation.w = 1.0;
+  box.operation = moveit_msgs::CollisionObject::ADD;
+
+  moveit_msgs::PlanningScene msg;
+  msg.is_diff = msg.robot_state.is_diff = is_diff;
+  msg.world.collision_objects.push_back(box);
+  return msg;
+}
+
+static bool waitForWorld(const planning_scene_monitor::PlanningSceneMonitorPtr& psm,
+                         const std::function<bool(const collision_detection::World&)>& predicate)
+{
+  const ros::WallTime timeout = ros::WallTime::now() + ros::WallDuration(5.0);
+  while (ros::WallTime::now() < timeout)
+  {
+    if (predicate(*planning_scene_monitor::LockedPlanningSceneRO(psm)->getWorld()))
+      return true;
+    ros::WallDuration(0.01).sleep();
+  }
+  return false;
+}
+
+// the scene publishing thread of the monitor clears the diffs of the monitored scene after every update
+TEST(IncrementalPathValidityCheckerMonitorTest, TracksWorldsOfMonitoredScene)
+{
+  auto psm = std::make_shared<planning_scene_monitor::PlanningSceneMonitor>("robot_description");
+  ASSERT_TRUE(psm->getPlanningScene());
+  psm->monitorDiffs(true);
+  psm->startPublishingPlanningScene(planning_scene_monitor::PlanningSceneMonitor::UPDATE_SCENE);
+  const std::string& frame_id = psm->getRobotModel()->getModelFrame();
+
+  Eigen::Vector3d last_hand_position;
+  robot_trajectory::RobotTrajectoryPtr trajectory = createTrajectory(psm->getRobotModel(), last_hand_position);
+  plan_execution::IncrementalPathValidityChecker checker;
+  auto check_path = [&psm, &trajectory, &checker] {
+    planning_scene_monitor::LockedPlanningSceneRO lscene(psm);
+    return checker.isPathValid(*lscene, *trajectory, 0, nullptr, 0);
+  };
+  checker.start(planning_scene_monitor::LockedPlanningSceneRO(psm)->getWorld());
+  ASSERT_TRUE(check_path());
+  ASSERT_EQ(checker.getCheckCount(), WAYPOINTS);
+
+  // an object away from the path, published and replaced by a copy in the monitored scene
+  const collision_detection::World* world = planning_scene_monitor::LockedPlanningSceneRO(psm)->getWorld().get();
+  ASSERT_TRUE(psm->newPlanningSceneMessage(createBoxSceneMsg(frame_id, Eigen::Vector3d(5.0, 5.0, 5.0), true)));
+  ASSERT_TRUE(waitForWorld(psm, [world](const collision_detection::World& w) { return &w != world; }));
+  EXPECT_TRUE(check_path());
+  EXPECT_EQ(checker.getCheckCount(), WAYPOINTS);
+
+  // moving the object onto the path is noticed in the replaced world
+  world = planning_scene_monitor::LockedPlanningSceneRO(psm)->getWorld().get();
+  ASSERT_TRUE(psm->newPlanningSceneMessage(createBoxSceneMsg(frame_id, last_hand_position, true)));
+  EXPECT_FALSE(check_path());
+  ASSERT_TRUE(waitForWorld(psm, [world](const collision_detection::World& w) { return &w != world; }));
+  EXPECT_FALSE(check_path());
+
+  // so is a full scene without the object
+  moveit_msgs::PlanningScene msg = createBoxSceneMsg(frame_id, last_hand_position, false);
+  msg.world.collision_objects.clear();
+  ASSERT_TRUE(psm->newPlanningSceneMessage(msg));
+  ASSERT_TRUE(waitForWorld(psm, [](const collision_detection::World& w) { return !w.hasObject("box"); }));
+  EXPECT_TRUE(check_path());
+
+  psm->stopPublishingPlanningScene();
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_incremental_path_validity_checker");
+  return RUN_ALL_TESTS();
+}
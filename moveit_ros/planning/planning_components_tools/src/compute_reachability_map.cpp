@@ -0,0 +1,108 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/robot_model_loader/robot_model_loader.h>
+#include <moveit/reachability_map/reachability_map.h>
+#include <ros/ros.h>
+#include <boost/lexical_cast.hpp>
+
+static const std::string ROBOT_DESCRIPTION = "robot_description";
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "compute_reachability_map");
+
+  if (argc < 4)
+  {
+    ROS_ERROR("Usage: moveit_compute_reachability_map <group> <samples> <output file> [position resolution]");
+    return 1;
+  }
+
+  robot_model_loader::RobotModelLoader rml(ROBOT_DESCRIPTION);
+  const moveit::core::RobotModelConstPtr& model = rml.getModel();
+  if (!model)
+    return 1;
+
+  const std::string group = argv[1];
+  const moveit::core::JointModelGroup* jmg = model->getJointModelGroup(group);
+  if (!jmg)
+  {
+    ROS_ERROR_STREAM("Unknown group " << group);
+    return 1;
+  }
+  const kinematics::KinematicsBaseConstPtr& solver = jmg->getSolverInstance();
+  if (!solver)
+  {
+    ROS_ERROR_STREAM("No kinematics solver specified for group " << group);
+    return 1;
+  }
+
+  std::size_t samples;
+  reachability_map::ReachabilityMap::Parameters params;
+  try
+  {
+    samples = boost::lexical_cast<std::size_t>(argv[2]);
+    if (argc > 4)
+      params.position_resolution = boost::lexical_cast<double>(argv[4]);
+  }
+  catch (boost::bad_lexical_cast& e)
+  {
+    ROS_ERROR_STREAM("Invalid argument: " << e.what());
+    return 1;
+  }
+
+  // map the poses of the IK tip relative to the IK base, as this is what the IK samplers query
+  std::string base_frame = solver->getBaseFrame();
+  std::string tip_frame = solver->getTipFrame();
+  if (!base_frame.empty() && base_frame[0] == '/')
+    base_frame.erase(0, 1);
+  if (!tip_frame.empty() && tip_frame[0] == '/')
+    tip_frame.erase(0, 1);
+  ROS_INFO_STREAM("Sampling " << samples << " configurations of " << group << " for tip " << tip_frame
+                              << " in frame " << base_frame);
+
+  reachability_map::ReachabilityMap map;
+  ros::WallTime start = ros::WallTime::now();
+  if (!map.compute(model, group, base_frame, tip_frame, samples, params))
+    return 1;
+  ROS_INFO("Computed map in %.2fs: %zu of %zu cells reachable", (ros::WallTime::now() - start).toSec(),
+           map.getReachableCellCount(), map.getCellCount());
+
+  if (!map.save(argv[3]))
+  {
+    ROS_ERROR("Unable to write %s", argv[3]);
+    return 1;
+  }
+  return 0;
+}
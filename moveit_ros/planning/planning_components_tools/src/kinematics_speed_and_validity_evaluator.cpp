@@ -39,6 +39,8 @@
 #include <moveit/profiler/profiler.h>
 #include <ros/ros.h>
 
+#include <algorithm>
+
 static const std::string ROBOT_DESCRIPTION = "robot_description";
 
 int main(int argc, char** argv)
@@ -83,6 +85,8 @@ int main(int argc, char** argv)
 
         ROS_INFO("Running %u tests", test_count);
 
+        std::vector<double> latencies;
+        latencies.reserve(test_count);
         moveit::tools::Profiler::Start();
         for (unsigned int i = 0; i < test_count; ++i)
         {
@@ -91,7 +95,9 @@ int main(int argc, char** argv)
           Eigen::Isometry3d pose = state.getGlobalLinkTransform(tip);
           state.setToRandomPositions(jmg);
           moveit::tools::Profiler::Begin("IK");
+          ros::WallTime start = ros::WallTime::now();
           state.setFromIK(jmg, pose);
+          latencies.push_back((ros::WallTime::now() - start).toSec());
           moveit::tools::Profiler::End("IK");
           // getGlobalLinkTransform() returns a valid isometry by contract
           const Eigen::Isometry3d& pose_upd = state.getGlobalLinkTransform(tip);
@@ -113,6 +119,17 @@ int main(int argc, char** argv)
         }
         moveit::tools::Profiler::Stop();
         moveit::tools::Profiler::Status();
+
+        // report the latency distribution: the mean alone hides slow random restarts near joint limits
+        if (!latencies.empty())
+        {
+          std::sort(latencies.begin(), latencies.end());
+          auto percentile = [&latencies](double p) {
+            return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))] * 1000.0;
+          };
+          ROS_INFO("IK latency [ms]: p50 %.3f, p90 %.3f, p99 %.3f, max %.3f", percentile(0.5), percentile(0.9),
+                   percentile(0.99), latencies.back() * 1000.0);
+        }
       }
       else
         ROS_ERROR_STREAM("No kinematics solver specified for group " << group);
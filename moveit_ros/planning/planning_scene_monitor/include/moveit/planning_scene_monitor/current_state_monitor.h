@@ -39,10 +39,14 @@
 #include <ros/ros.h>
 #include <tf2_ros/buffer.h>
 #include <moveit/robot_state/robot_state.h>
+#include <moveit/planning_scene_monitor/joint_state_history.h>
 #include <sensor_msgs/JointState.h>
 #include <boost/function.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <memory>
 
 namespace planning_scene_monitor
 {
@@ -54,6 +58,16 @@ class CurrentStateMonitor
   using TFConnection = boost::signals2::connection;
 
 public:
+  /** @brief Statistics on the latency from the start of processing a joint state message until the updated state is
+   *  available to readers. It is measured with a steady clock, independent of simulated time, and does not include
+   *  the time the message waited in the subscriber queue. */
+  struct UpdateLatency
+  {
+    std::size_t samples = 0;
+    ros::Duration mean;
+    ros::Duration max;
+  };
+
   /**
    * @brief Constructor
    * @param robot_model The current kinematic model to build on
@@ -151,6 +165,8 @@ public:
   }
 
   /** @brief Get the current state
+   *
+   *  Unless copying of dynamics is enabled, this does not block on incoming joint state updates.
    *  @return Returns the current state */
   moveit::core::RobotStatePtr getCurrentState() const;
 
@@ -173,6 +189,22 @@ public:
    *  @return Returns a pair of the current state and its time stamp */
   std::pair<moveit::core::RobotStatePtr, ros::Time> getCurrentStateAndTime(const std::string& group = "") const;
 
+  /** @brief Get the state of the robot at time \e t, interpolated from the recorded history of joint states.
+   *
+   *  This does not block on incoming joint state updates. Joints never received before \e t keep their default values.
+   *  @return False (leaving \e state untouched) if \e t lies outside the recorded time range */
+  bool getStateAtTime(const ros::Time& t, moveit::core::RobotState& state) const;
+
+  /** @brief Get the state of the robot at time \e t, interpolated from the recorded history of joint states.
+   *  @return The interpolated state or nullptr if \e t lies outside the recorded time range */
+  moveit::core::RobotStatePtr getStateAtTime(const ros::Time& t) const;
+
+  /** @brief Get the history of time-stamped states used by getStateAtTime() */
+  const JointStateHistory& getStateHistory() const
+  {
+    return state_history_;
+  }
+
   /** @brief Get the current state values as a map from joint names to joint state values
    *  @return Returns the map from joint names to joint state values*/
   std::map<std::string, double> getCurrentStateValues() const;
@@ -196,7 +228,10 @@ public:
     return monitor_start_time_;
   }
 
-  /** @brief Add a function that will be called whenever the joint state is updated*/
+  /** @brief Add a function that will be called whenever the joint state is updated
+   *
+   *  Update callbacks are called from the thread processing the joint state message, unless asynchronous update
+   *  callbacks are enabled, see enableAsyncUpdateCallbacks(). */
   void addUpdateCallback(const JointStateUpdateCallback& fn);
 
   /** @brief Clear the functions to be called when an update to the joint state is received */
@@ -228,6 +263,23 @@ public:
     copy_dynamics_ = enabled;
   }
 
+  /** @brief Run the update callbacks asynchronously, so that slow callbacks do not delay incoming joint states
+   *
+   *  If enabled, startStateMonitor() starts a dispatch thread, which calls the update callbacks until
+   *  stopStateMonitor(). Consecutive updates arriving while the callbacks are busy are merged into the latest one.
+   *  Callbacks must not be added or cleared while the monitor is active. Disabled by default; changes take effect
+   *  when the monitor is started the next time. */
+  void enableAsyncUpdateCallbacks(bool enabled)
+  {
+    async_update_callbacks_ = enabled;
+  }
+
+  /** @brief Get the latency statistics of joint state updates since the monitor was started */
+  UpdateLatency getUpdateLatency() const;
+
+  /** @brief Reset the latency statistics of joint state updates */
+  void resetUpdateLatency();
+
 private:
   /**
    * Lock-free method that is used by @ref getCurrentStateTime and @ref getCurrentStateAndTime methods.
@@ -236,6 +288,28 @@ private:
   bool haveCompleteStateHelper(const ros::Time& oldest_allowed_update_time, std::vector<std::string>* missing_joints,
                                const std::string& group) const;
 
+  /** Joint models corresponding to a particular ordering of names in joint state messages */
+  struct JointStateLayout
+  {
+    std::vector<std::string> names;
+    std::vector<const moveit::core::JointModel*> joints;  // nullptr for names not to be read
+  };
+
+  const std::vector<const moveit::core::JointModel*>& getJointStateLayout(const std::vector<std::string>& names);
+  void resetJointTimes();
+  void setJointTime(const moveit::core::JointModel* joint, const ros::Time& time);
+
+  /** Make the positions of robot_state_ available to lock-free readers. Called with state_update_lock_ held. */
+  void publishPositions();
+  /** Copy the latest published positions, retrying while they are being written. */
+  void readPositions(std::vector<double>& positions) const;
+
+  /** Run the update callbacks for \e joint_state (if not null) and notify waiting threads afterwards */
+  void dispatchUpdate(const sensor_msgs::JointStateConstPtr& joint_state);
+  void runUpdateCallbacks(const sensor_msgs::JointStateConstPtr& joint_state);
+  void dispatchUpdateCallbacks();
+  void stopUpdateDispatch();
+
   void jointStateCallback(const sensor_msgs::JointStateConstPtr& joint_state);
   void tfCallback();
 
@@ -243,9 +317,13 @@ private:
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   moveit::core::RobotModelConstPtr robot_model_;
   moveit::core::RobotState robot_state_;
-  std::map<const moveit::core::JointModel*, ros::Time> joint_time_;
+  std::vector<ros::Time> joint_time_;  // indexed by joint index
+  std::vector<bool> joint_time_known_;
+  std::vector<JointStateLayout> joint_state_layouts_;
+  JointStateHistory state_history_;  // written under state_update_lock_, read lock-free
   bool state_monitor_started_;
-  bool copy_dynamics_;  // Copy velocity and effort from joint_state
+  bool copy_dynamics_;           // Copy velocity and effort from joint_state
+  bool async_update_callbacks_;  // Call update callbacks from dispatch_thread_
   ros::Time monitor_start_time_;
   double error_;
   ros::Subscriber joint_state_subscriber_;
@@ -254,6 +332,19 @@ private:
   mutable boost::condition_variable state_update_condition_;
   std::vector<JointStateUpdateCallback> update_callbacks_;
 
+  // seqlock-protected copy of the positions of robot_state_: odd sequence numbers indicate a write in progress
+  std::atomic<std::uint64_t> positions_sequence_;
+  std::unique_ptr<std::atomic<double>[]> published_positions_;
+
+  UpdateLatency update_latency_;  // guarded by state_update_lock_
+
+  boost::mutex dispatch_lock_;
+  boost::condition_variable dispatch_condition_;
+  sensor_msgs::JointStateConstPtr pending_update_;  // latest update not yet passed to the update callbacks
+  bool dispatch_pending_;
+  bool dispatch_running_;
+  std::unique_ptr<boost::thread> dispatch_thread_;
+
   std::shared_ptr<TFConnection> tf_connection_;
 };
 
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <ros/time.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace planning_scene_monitor
+{
+/** @brief Fixed-capacity ring buffer of time-stamped joint positions.
+ *
+ *  Samples are written by a single thread and can be read concurrently by any number of threads without locking:
+ *  each slot is protected by a sequence counter, so readers detect (and skip) samples that are overwritten while being
+ *  read. Samples must be pushed in strictly increasing time order, which allows time lookups by binary search. */
+class JointStateHistory
+{
+public:
+  /** @brief Constructor
+   *  @param variable_count The number of variables stored per sample
+   *  @param capacity The maximal number of samples kept. Once full, the oldest sample is overwritten. */
+  JointStateHistory(std::size_t variable_count, std::size_t capacity);
+
+  std::size_t getVariableCount() const
+  {
+    return variable_count_;
+  }
+
+  std::size_t getCapacity() const
+  {
+    return capacity_;
+  }
+
+  /** @brief Append a sample. Must only be called from a single writer thread at a time.
+   *  @return False (and store nothing) if \e stamp is not newer than the newest sample */
+  bool push(const ros::Time& stamp, const double* positions);
+
+  /** @brief Forget all samples, e.g. when time jumped backwards. Must only be called from the writer thread. */
+  void clear();
+
+  /** @brief Get the stamps of the oldest and newest sample.
+   *  @return False if the history is empty */
+  bool getTimeRange(ros::Time& oldest, ros::Time& newest) const;
+
+  /** @brief Get the two samples bracketing time \e t.
+   *
+   *  On success, \e t lies within [stamp(\e before), stamp(\e after)] and \e fraction is its relative position in
+   *  that interval. Both arrays need to hold getVariableCount() values.
+   *  @return False if \e t is outside the recorded time range */
+  bool getSamplesAround(const ros::Time& t, double* before, double* after, double& fraction) const;
+
+private:
+  /** Read the sample with logical index \e index. Fail if the slot does not hold that sample (anymore). */
+  bool readSample(std::uint64_t index, std::uint64_t& stamp, double* positions) const;
+
+  /** Check that clear() was not called since \e clear_count was read. */
+  bool isUnchanged(std::uint64_t clear_count) const;
+
+  std::size_t variable_count_;
+  std::size_t capacity_;
+
+  // per slot: sequence counter (2 * index + 1 while writing sample #index, 2 * index + 2 once written),
+  // stamp in nanoseconds and positions
+  std::unique_ptr<std::atomic<std::uint64_t>[]> sequence_;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> stamps_;
+  std::unique_ptr<std::atomic<double>[]> positions_;
+
+  // logical indices of the oldest valid sample and one past the newest sample
+  std::atomic<std::uint64_t> begin_;
+  std::atomic<std::uint64_t> end_;
+  std::atomic<std::uint64_t> clear_count_;
+
+  // stamp of the newest sample, only accessed by the writer
+  std::uint64_t newest_stamp_;
+};
+}  // namespace planning_scene_monitor
@@ -46,8 +46,10 @@
 #include <moveit/planning_scene_monitor/current_state_monitor.h>
 #include <moveit/collision_plugin_loader/collision_plugin_loader.h>
 #include <moveit_msgs/GetPlanningScene.h>
+#include <eigen_stl_containers/eigen_stl_vector_container.h>
 #include <boost/noncopyable.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 #include <memory>
 
@@ -372,6 +374,16 @@ public:
   /** @brief Clear the functions to be called when an update to the scene is received */
   void clearUpdateCallbacks();
 
+  /** @brief Add a function to be called with the centers (in the planning frame) and the resolution of all octree
+   *  voxels whose occupancy changed with an octomap update.
+   *
+   *  This enables change detection on the monitored octree. The function is called while the planning scene is
+   *  locked for writing, before update callbacks are triggered, and must not lock the scene itself. */
+  void addOctomapChangeCallback(const boost::function<void(const EigenSTL::vector_Vector3d&, double)>& fn);
+
+  /** @brief Clear the functions to be called when octree voxels changed */
+  void clearOctomapChangeCallbacks();
+
   /** @brief Get the topic names that the monitor is listening to */
   void getMonitoredTopics(std::vector<std::string>& topics) const;
 
@@ -534,6 +546,10 @@ protected:
   std::vector<boost::function<void(SceneUpdateType)> > update_callbacks_;  /// List of callbacks to trigger when updates
                                                                            /// are received
 
+  /// lock access to octomap_change_callbacks_
+  boost::mutex octomap_change_lock_;
+  std::vector<boost::function<void(const EigenSTL::vector_Vector3d&, double)> > octomap_change_callbacks_;
+
 private:
   void getUpdatedFrameTransforms(std::vector<geometry_msgs::TransformStamped>& transforms);
 
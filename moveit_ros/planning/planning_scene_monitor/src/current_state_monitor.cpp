@@ -37,12 +37,19 @@
 #include <moveit/planning_scene_monitor/current_state_monitor.h>
 
 #include <boost/algorithm/string/join.hpp>
+#include <chrono>
 #include <limits>
 #include <tf2_eigen/tf2_eigen.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 constexpr char LOGNAME[] = "current_state_monitor";
 
+// number of full states kept for getStateAtTime()
+constexpr std::size_t STATE_HISTORY_LENGTH = 1024;
+
+// number of distinct name orderings of joint state messages whose joint lookup is cached
+constexpr std::size_t MAX_JOINT_STATE_LAYOUTS = 8;
+
 namespace planning_scene_monitor
 {
 CurrentStateMonitor::CurrentStateMonitor(const moveit::core::RobotModelConstPtr& robot_model,
@@ -57,11 +64,20 @@ CurrentStateMonitor::CurrentStateMonitor(const moveit::core::RobotModelConstPtr&
   , tf_buffer_(tf_buffer)
   , robot_model_(robot_model)
   , robot_state_(robot_model)
+  , joint_time_(robot_model->getJointModelCount())
+  , joint_time_known_(robot_model->getJointModelCount(), false)
+  , state_history_(robot_model->getVariableCount(), STATE_HISTORY_LENGTH)
   , state_monitor_started_(false)
   , copy_dynamics_(false)
+  , async_update_callbacks_(false)
   , error_(std::numeric_limits<double>::epsilon())
+  , positions_sequence_(0)
+  , published_positions_(std::make_unique<std::atomic<double>[]>(robot_model->getVariableCount()))
+  , dispatch_pending_(false)
+  , dispatch_running_(false)
 {
   robot_state_.setToDefaultValues();
+  publishPositions();
 }
 
 CurrentStateMonitor::~CurrentStateMonitor()
@@ -69,8 +85,50 @@ CurrentStateMonitor::~CurrentStateMonitor()
   stopStateMonitor();
 }
 
+void CurrentStateMonitor::publishPositions()
+{
+  const std::uint64_t sequence = positions_sequence_.load(std::memory_order_relaxed);
+  positions_sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const double* positions = robot_state_.getVariablePositions();
+  for (std::size_t i = 0, n = robot_model_->getVariableCount(); i < n; ++i)
+    published_positions_[i].store(positions[i], std::memory_order_relaxed);
+
+  positions_sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void CurrentStateMonitor::readPositions(std::vector<double>& positions) const
+{
+  const std::size_t n = robot_model_->getVariableCount();
+  positions.resize(n);
+  while (true)
+  {
+    const std::uint64_t sequence = positions_sequence_.load(std::memory_order_acquire);
+    if (sequence % 2 == 1)
+    {
+      boost::this_thread::yield();  // the writer is about to finish
+      continue;
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      positions[i] = published_positions_[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (positions_sequence_.load(std::memory_order_relaxed) == sequence)
+      return;
+  }
+}
+
 moveit::core::RobotStatePtr CurrentStateMonitor::getCurrentState() const
 {
+  if (!copy_dynamics_)
+  {
+    std::vector<double> positions;
+    readPositions(positions);
+    auto result = std::make_shared<moveit::core::RobotState>(robot_model_);
+    result->setVariablePositions(positions);
+    return result;
+  }
+
   boost::mutex::scoped_lock slock(state_update_lock_);
   moveit::core::RobotState* result = new moveit::core::RobotState(robot_state_);
   return moveit::core::RobotStatePtr(result);
@@ -95,8 +153,8 @@ ros::Time CurrentStateMonitor::getCurrentStateTimeHelper(const std::string& grou
   auto oldest_state_time = ros::Time();
   for (const moveit::core::JointModel* joint : *active_joints)
   {
-    auto it = joint_time_.find(joint);
-    if (it == joint_time_.end())
+    const int index = joint->getJointIndex();
+    if (!joint_time_known_[index])
     {
       ROS_DEBUG_NAMED(LOGNAME, "Joint '%s' has never been updated", joint->getName().c_str());
     }
@@ -104,11 +162,11 @@ ros::Time CurrentStateMonitor::getCurrentStateTimeHelper(const std::string& grou
     {
       if (!oldest_state_time.isZero())
       {
-        oldest_state_time = std::min(oldest_state_time, it->second);
+        oldest_state_time = std::min(oldest_state_time, joint_time_[index]);
       }
       else
       {
-        oldest_state_time = it->second;
+        oldest_state_time = joint_time_[index];
       }
     }
   }
@@ -129,12 +187,41 @@ CurrentStateMonitor::getCurrentStateAndTime(const std::string& group) const
   return std::make_pair(moveit::core::RobotStatePtr(result), getCurrentStateTimeHelper(group));
 }
 
+bool CurrentStateMonitor::getStateAtTime(const ros::Time& t, moveit::core::RobotState& state) const
+{
+  const std::size_t n = state_history_.getVariableCount();
+  std::vector<double> before(n), after(n);
+  double fraction;
+  if (!state_history_.getSamplesAround(t, before.data(), after.data(), fraction))
+    return false;
+
+  // interpolate joint-wise to respect continuous joints and orientations of multi-dof joints
+  std::vector<double> positions(n);
+  for (const moveit::core::JointModel* joint : robot_model_->getJointModels())
+  {
+    if (joint->getVariableCount() == 0)
+      continue;
+    const int index = joint->getFirstVariableIndex();
+    joint->interpolate(&before[index], &after[index], fraction, &positions[index]);
+  }
+  state.setVariablePositions(positions);
+  return true;
+}
+
+moveit::core::RobotStatePtr CurrentStateMonitor::getStateAtTime(const ros::Time& t) const
+{
+  auto state = std::make_shared<moveit::core::RobotState>(robot_model_);
+  if (!getStateAtTime(t, *state))
+    return moveit::core::RobotStatePtr();
+  return state;
+}
+
 std::map<std::string, double> CurrentStateMonitor::getCurrentStateValues() const
 {
   std::map<std::string, double> m;
-  boost::mutex::scoped_lock slock(state_update_lock_);
-  const double* pos = robot_state_.getVariablePositions();
-  const std::vector<std::string>& names = robot_state_.getVariableNames();
+  std::vector<double> pos;
+  readPositions(pos);
+  const std::vector<std::string>& names = robot_model_->getVariableNames();
   for (std::size_t i = 0; i < names.size(); ++i)
     m[names[i]] = pos[i];
   return m;
@@ -142,6 +229,14 @@ std::map<std::string, double> CurrentStateMonitor::getCurrentStateValues() const
 
 void CurrentStateMonitor::setToCurrentState(moveit::core::RobotState& upd) const
 {
+  if (!copy_dynamics_)
+  {
+    std::vector<double> pos;
+    readPositions(pos);
+    upd.setVariablePositions(pos);
+    return;
+  }
+
   boost::mutex::scoped_lock slock(state_update_lock_);
   const double* pos = robot_state_.getVariablePositions();
   upd.setVariablePositions(pos);
@@ -176,11 +271,94 @@ void CurrentStateMonitor::clearUpdateCallbacks()
   update_callbacks_.clear();
 }
 
+void CurrentStateMonitor::dispatchUpdate(const sensor_msgs::JointStateConstPtr& joint_state)
+{
+  {
+    boost::mutex::scoped_lock lock(dispatch_lock_);
+    if (dispatch_running_)
+    {
+      if (joint_state)
+        pending_update_ = joint_state;
+      dispatch_pending_ = true;
+      dispatch_condition_.notify_one();
+      return;
+    }
+  }
+  runUpdateCallbacks(joint_state);
+}
+
+void CurrentStateMonitor::runUpdateCallbacks(const sensor_msgs::JointStateConstPtr& joint_state)
+{
+  if (joint_state)
+    for (JointStateUpdateCallback& update_callback : update_callbacks_)
+      update_callback(joint_state);
+
+  // notify waitForCurrentState() *after* potential update callbacks
+  state_update_condition_.notify_all();
+}
+
+void CurrentStateMonitor::dispatchUpdateCallbacks()
+{
+  boost::mutex::scoped_lock lock(dispatch_lock_);
+  while (true)
+  {
+    dispatch_condition_.wait(lock, [this] { return dispatch_pending_ || !dispatch_running_; });
+    if (!dispatch_pending_)
+      return;
+
+    sensor_msgs::JointStateConstPtr joint_state;
+    joint_state.swap(pending_update_);
+    dispatch_pending_ = false;
+    lock.unlock();
+    runUpdateCallbacks(joint_state);
+    lock.lock();
+  }
+}
+
+void CurrentStateMonitor::stopUpdateDispatch()
+{
+  {
+    boost::mutex::scoped_lock lock(dispatch_lock_);
+    dispatch_running_ = false;
+    dispatch_condition_.notify_one();
+  }
+  if (dispatch_thread_)
+  {
+    dispatch_thread_->join();
+    dispatch_thread_.reset();
+  }
+}
+
+CurrentStateMonitor::UpdateLatency CurrentStateMonitor::getUpdateLatency() const
+{
+  boost::mutex::scoped_lock slock(state_update_lock_);
+  return update_latency_;
+}
+
+void CurrentStateMonitor::resetUpdateLatency()
+{
+  boost::mutex::scoped_lock slock(state_update_lock_);
+  update_latency_ = UpdateLatency();
+}
+
 void CurrentStateMonitor::startStateMonitor(const std::string& joint_states_topic)
 {
   if (!state_monitor_started_ && robot_model_)
   {
-    joint_time_.clear();
+    {
+      boost::mutex::scoped_lock slock(state_update_lock_);
+      resetJointTimes();
+      state_history_.clear();
+      update_latency_ = UpdateLatency();
+    }
+    if (async_update_callbacks_)
+    {
+      {
+        boost::mutex::scoped_lock lock(dispatch_lock_);
+        dispatch_running_ = true;
+      }
+      dispatch_thread_ = std::make_unique<boost::thread>([this] { dispatchUpdateCallbacks(); });
+    }
     if (joint_states_topic.empty())
       ROS_ERROR_NAMED(LOGNAME, "The joint states topic cannot be an empty string");
     else
@@ -211,6 +389,8 @@ void CurrentStateMonitor::stopStateMonitor()
       tf_buffer_->_removeTransformsChangedListener(*tf_connection_);
       tf_connection_.reset();
     }
+    // pending updates are still passed to the callbacks before the thread exits
+    stopUpdateDispatch();
     ROS_DEBUG_NAMED(LOGNAME, "No longer listening for joint states");
     state_monitor_started_ = false;
   }
@@ -249,15 +429,15 @@ bool CurrentStateMonitor::haveCompleteStateHelper(const ros::Time& oldest_allowe
   boost::mutex::scoped_lock slock(state_update_lock_);
   for (const moveit::core::JointModel* joint : *active_joints)
   {
-    std::map<const moveit::core::JointModel*, ros::Time>::const_iterator it = joint_time_.find(joint);
-    if (it == joint_time_.end())
+    const int index = joint->getJointIndex();
+    if (!joint_time_known_[index])
     {
       ROS_DEBUG_NAMED(LOGNAME, "Joint '%s' has never been updated", joint->getName().c_str());
     }
-    else if (it->second < oldest_allowed_update_time)
+    else if (joint_time_[index] < oldest_allowed_update_time)
     {
       ROS_DEBUG_NAMED(LOGNAME, "Joint '%s' was last updated %0.3lf seconds before requested time",
-                      joint->getName().c_str(), (oldest_allowed_update_time - it->second).toSec());
+                      joint->getName().c_str(), (oldest_allowed_update_time - joint_time_[index]).toSec());
     }
     else
       continue;
@@ -323,8 +503,47 @@ bool CurrentStateMonitor::waitForCompleteState(const std::string& group, double
   return true;
 }
 
+void CurrentStateMonitor::resetJointTimes()
+{
+  std::fill(joint_time_.begin(), joint_time_.end(), ros::Time());
+  std::fill(joint_time_known_.begin(), joint_time_known_.end(), false);
+}
+
+void CurrentStateMonitor::setJointTime(const moveit::core::JointModel* joint, const ros::Time& time)
+{
+  joint_time_[joint->getJointIndex()] = time;
+  joint_time_known_[joint->getJointIndex()] = true;
+}
+
+const std::vector<const moveit::core::JointModel*>&
+CurrentStateMonitor::getJointStateLayout(const std::vector<std::string>& names)
+{
+  // publishers keep the order of names fixed, so joints only need to be resolved once per layout
+  for (const JointStateLayout& layout : joint_state_layouts_)
+    if (layout.names == names)
+      return layout.joints;
+
+  if (joint_state_layouts_.size() >= MAX_JOINT_STATE_LAYOUTS)
+    joint_state_layouts_.erase(joint_state_layouts_.begin());
+
+  JointStateLayout layout;
+  layout.names = names;
+  layout.joints.reserve(names.size());
+  for (const std::string& name : names)
+  {
+    const moveit::core::JointModel* jm = robot_model_->getJointModel(name);
+    // ignore fixed joints, multi-dof joints (they should not even be in the message)
+    if (jm && jm->getVariableCount() != 1)
+      jm = nullptr;
+    layout.joints.push_back(jm);
+  }
+  joint_state_layouts_.push_back(std::move(layout));
+  return joint_state_layouts_.back().joints;
+}
+
 void CurrentStateMonitor::jointStateCallback(const sensor_msgs::JointStateConstPtr& joint_state)
 {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
   if (joint_state->name.size() != joint_state->position.size())
   {
     ROS_ERROR_THROTTLE_NAMED(
@@ -337,28 +556,27 @@ void CurrentStateMonitor::jointStateCallback(const sensor_msgs::JointStateConstP
 
   {
     boost::mutex::scoped_lock _(state_update_lock_);
+    const std::vector<const moveit::core::JointModel*>& joints = getJointStateLayout(joint_state->name);
     // read the received values, and update their time stamps
     std::size_t n = joint_state->name.size();
     for (std::size_t i = 0; i < n; ++i)
     {
-      const moveit::core::JointModel* jm = robot_model_->getJointModel(joint_state->name[i]);
+      const moveit::core::JointModel* jm = joints[i];
       if (!jm)
         continue;
-      // ignore fixed joints, multi-dof joints (they should not even be in the message)
-      if (jm->getVariableCount() != 1)
-        continue;
 
-      if (auto& joint_time{ joint_time_[jm] }; joint_time < joint_state->header.stamp)
+      if (joint_time_[jm->getJointIndex()] < joint_state->header.stamp)
       {
-        joint_time = joint_state->header.stamp;
+        setJointTime(jm, joint_state->header.stamp);
       }
       else
       {
         ROS_WARN_STREAM_NAMED(LOGNAME, "New joint state for joint '"
                                            << jm->getName()
                                            << "' is not newer than the previous state. Assuming your rosbag looped.");
-        joint_time_.clear();
-        joint_time_[jm] = joint_state->header.stamp;
+        resetJointTimes();
+        setJointTime(jm, joint_state->header.stamp);
+        state_history_.clear();
       }
 
       if (robot_state_.getJointPositions(jm)[0] != joint_state->position[i])
@@ -402,15 +620,27 @@ void CurrentStateMonitor::jointStateCallback(const sensor_msgs::JointStateConstP
         }
       }
     }
+
+    if (update)
+      publishPositions();
+
+    // record the full state, unless it is older than the latest one (partial states from another source)
+    if (!joint_state->header.stamp.isZero())
+      state_history_.push(joint_state->header.stamp, robot_state_.getVariablePositions());
+
+    const double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ++update_latency_.samples;
+    update_latency_.mean.fromSec(update_latency_.mean.toSec() +
+                                 (latency - update_latency_.mean.toSec()) / update_latency_.samples);
+    if (latency > update_latency_.max.toSec())
+      update_latency_.max.fromSec(latency);
   }
 
   // callbacks, if needed
-  if (update)
-    for (JointStateUpdateCallback& update_callback : update_callbacks_)
-      update_callback(joint_state);
-
-  // notify waitForCurrentState() *after* potential update callbacks
-  state_update_condition_.notify_all();
+  if (update_callbacks_.empty())
+    state_update_condition_.notify_all();
+  else
+    dispatchUpdate(update ? joint_state : sensor_msgs::JointStateConstPtr());
 }
 
 void CurrentStateMonitor::tfCallback()
@@ -422,6 +652,7 @@ void CurrentStateMonitor::tfCallback()
   bool changes = false;
   {
     boost::mutex::scoped_lock _(state_update_lock_);
+    ros::Time latest_update_time;
 
     for (const moveit::core::JointModel* joint : multi_dof_joints)
     {
@@ -446,9 +677,9 @@ void CurrentStateMonitor::tfCallback()
       }
 
       // allow update if time is more recent or if it is a static transform (time = 0)
-      if (latest_common_time <= joint_time_[joint] && latest_common_time > ros::Time(0))
+      if (latest_common_time <= joint_time_[joint->getJointIndex()] && latest_common_time > ros::Time(0))
         continue;
-      joint_time_[joint] = latest_common_time;
+      setJointTime(joint, latest_common_time);
 
       std::vector<double> new_values(joint->getStateSpaceDimension());
       const moveit::core::LinkModel* link = joint->getChildLinkModel();
@@ -465,24 +696,29 @@ void CurrentStateMonitor::tfCallback()
 
       robot_state_.setJointPositions(joint, new_values.data());
       update = true;
+      latest_update_time = std::max(latest_update_time, latest_common_time);
     }
+
+    if (update)
+      publishPositions();
+    if (!latest_update_time.isZero())
+      state_history_.push(latest_update_time, robot_state_.getVariablePositions());
   }
 
+  if (!update)
+    return;
+
   // callbacks, if needed
-  if (changes)
+  if (update_callbacks_.empty())
+    state_update_condition_.notify_all();
+  else if (changes)
   {
     // stub joint state: multi-dof joints are not modelled in the message,
     // but we should still trigger the update callbacks
-    sensor_msgs::JointStatePtr joint_state(new sensor_msgs::JointState);
-    for (JointStateUpdateCallback& update_callback : update_callbacks_)
-      update_callback(joint_state);
-  }
-
-  if (update)
-  {
-    // notify waitForCurrentState() *after* potential update callbacks
-    state_update_condition_.notify_all();
+    dispatchUpdate(sensor_msgs::JointStatePtr(new sensor_msgs::JointState));
   }
+  else
+    dispatchUpdate(sensor_msgs::JointStateConstPtr());
 }
 
 }  // namespace planning_scene_monitor
@@ -0,0 +1,197 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt maintainers
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/planning_scene_monitor/joint_state_history.h>
+#include <algorithm>
+
+namespace planning_scene_monitor
+{
+namespace
+{
+// number of attempts for a lookup racing with the writer before giving up
+constexpr int MAX_READ_ATTEMPTS = 4;
+}  // namespace
+
+JointStateHistory::JointStateHistory(std::size_t variable_count, std::size_t capacity)
+  : variable_count_(variable_count)
+  , capacity_(std::max<std::size_t>(capacity, 2))
+  , sequence_(std::make_unique<std::atomic<std::uint64_t>[]>(capacity_))
+  , stamps_(std::make_unique<std::atomic<std::uint64_t>[]>(capacity_))
+  , positions_(std::make_unique<std::atomic<double>[]>(capacity_ * variable_count_))
+  , begin_(0)
+  , end_(0)
+  , clear_count_(0)
+  , newest_stamp_(0)
+{
+}
+
+bool JointStateHistory::push(const ros::Time& stamp, const double* positions)
+{
+  const std::uint64_t stamp_ns = stamp.toNSec();
+  const std::uint64_t index = end_.load(std::memory_order_relaxed);
+  if (index != begin_.load(std::memory_order_relaxed) && stamp_ns <= newest_stamp_)
+    return false;
+
+  const std::size_t slot = index % capacity_;
+  sequence_[slot].store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  stamps_[slot].store(stamp_ns, std::memory_order_relaxed);
+  std::atomic<double>* values = &positions_[slot * variable_count_];
+  for (std::size_t i = 0; i < variable_count_; ++i)
+    values[i].store(positions[i], std::memory_order_relaxed);
+
+  sequence_[slot].store(2 * index + 2, std::memory_order_release);
+  end_.store(index + 1, std::memory_order_release);
+  if (index + 1 - begin_.load(std::memory_order_relaxed) > capacity_)
+    begin_.store(index + 1 - capacity_, std::memory_order_release);
+  newest_stamp_ = stamp_ns;
+  return true;
+}
+
+void JointStateHistory::clear()
+{
+  clear_count_.store(clear_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  begin_.store(end_.load(std::memory_order_relaxed), std::memory_order_release);
+  newest_stamp_ = 0;
+}
+
+bool JointStateHistory::readSample(std::uint64_t index, std::uint64_t& stamp, double* positions) const
+{
+  const std::size_t slot = index % capacity_;
+  const std::uint64_t expected = 2 * index + 2;
+  if (sequence_[slot].load(std::memory_order_acquire) != expected)
+    return false;
+
+  stamp = stamps_[slot].load(std::memory_order_relaxed);
+  if (positions)
+  {
+    const std::atomic<double>* values = &positions_[slot * variable_count_];
+    for (std::size_t i = 0; i < variable_count_; ++i)
+      positions[i] = values[i].load(std::memory_order_relaxed);
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return sequence_[slot].load(std::memory_order_relaxed) == expected;
+}
+
+bool JointStateHistory::isUnchanged(std::uint64_t clear_count) const
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return clear_count_.load(std::memory_order_relaxed) == clear_count;
+}
+
+bool JointStateHistory::getTimeRange(ros::Time& oldest, ros::Time& newest) const
+{
+  for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+  {
+    const std::uint64_t clear_count = clear_count_.load(std::memory_order_acquire);
+    std::uint64_t begin = begin_.load(std::memory_order_acquire);
+    const std::uint64_t end = end_.load(std::memory_order_acquire);
+    if (begin == end)
+      return false;
+    begin = std::max(begin, end - std::min<std::uint64_t>(end, capacity_));
+
+    std::uint64_t oldest_ns, newest_ns;
+    if (readSample(begin, oldest_ns, nullptr) && readSample(end - 1, newest_ns, nullptr) &&
+        isUnchanged(clear_count))
+    {
+      oldest.fromNSec(oldest_ns);
+      newest.fromNSec(newest_ns);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool JointStateHistory::getSamplesAround(const ros::Time& t, double* before, double* after, double& fraction) const
+{
+  const std::uint64_t t_ns = t.toNSec();
+  for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+  {
+    const std::uint64_t clear_count = clear_count_.load(std::memory_order_acquire);
+    std::uint64_t begin = begin_.load(std::memory_order_acquire);
+    const std::uint64_t end = end_.load(std::memory_order_acquire);
+    if (begin == end)
+      return false;
+    begin = std::max(begin, end - std::min<std::uint64_t>(end, capacity_));
+
+    // find the first sample newer than t
+    std::uint64_t lo = begin;
+    std::uint64_t hi = end;
+    std::uint64_t stamp;
+    bool overwritten = false;
+    while (lo < hi)
+    {
+      const std::uint64_t mid = lo + (hi - lo) / 2;
+      if (!readSample(mid, stamp, nullptr))
+      {
+        overwritten = true;
+        break;
+      }
+      if (stamp <= t_ns)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (overwritten)
+      continue;
+    if (lo == begin)
+      return false;  // t is older than all samples
+
+    std::uint64_t before_stamp, after_stamp;
+    if (!readSample(lo - 1, before_stamp, before))
+      continue;
+    if (lo == end)
+    {
+      // t is not older than the newest sample: only an exact match can be served
+      if (before_stamp != t_ns)
+        return false;
+      std::copy(before, before + variable_count_, after);
+      fraction = 0.0;
+    }
+    else
+    {
+      if (!readSample(lo, after_stamp, after))
+        continue;
+      fraction = static_cast<double>(t_ns - before_stamp) / static_cast<double>(after_stamp - before_stamp);
+    }
+
+    // samples from before and after a clear() must not be mixed
+    if (isUnchanged(clear_count))
+      return true;
+  }
+  return false;
+}
+}  // namespace planning_scene_monitor
@@ -1110,6 +1110,13 @@ void PlanningSceneMonitor::startWorldGeometryMonitor(const std::string& collisio
             return getShapeTransformCache(frame, stamp, cache);
           });
       octomap_monitor_->setUpdateCallback([this] { octomapUpdateCallback(); });
+
+      boost::mutex::scoped_lock lock(octomap_change_lock_);
+      if (!octomap_change_callbacks_.empty())
+      {
+        collision_detection::OccMapTree::WriteLock tree_lock = octomap_monitor_->getOcTreePtr()->writing();
+        octomap_monitor_->getOcTreePtr()->enableChangeDetection(true);
+      }
     }
     octomap_monitor_->startMonitor();
   }
@@ -1253,6 +1260,30 @@ void PlanningSceneMonitor::octomapUpdateCallback()
       octomap_monitor_->getOcTreePtr()->unlockRead();  // unlock and rethrow
       throw;
     }
+
+    // report voxels that changed since the last update while the scene is still locked, so that readers of the
+    // updated scene can rely on having received the changes
+    boost::mutex::scoped_lock lock(octomap_change_lock_);
+    if (!octomap_change_callbacks_.empty())
+    {
+      EigenSTL::vector_Vector3d changed_voxels;
+      double resolution;
+      {
+        const collision_detection::OccMapTreePtr& tree = octomap_monitor_->getOcTreePtr();
+        collision_detection::OccMapTree::WriteLock tree_lock = tree->writing();
+        resolution = tree->getResolution();
+        changed_voxels.reserve(tree->numChangesDetected());
+        for (octomap::KeyBoolMap::const_iterator it = tree->changedKeysBegin(); it != tree->changedKeysEnd(); ++it)
+        {
+          const octomap::point3d center = tree->keyToCoord(it->first);
+          changed_voxels.emplace_back(center.x(), center.y(), center.z());
+        }
+        tree->resetChangeDetection();
+      }
+      if (!changed_voxels.empty())
+        for (boost::function<void(const EigenSTL::vector_Vector3d&, double)>& callback : octomap_change_callbacks_)
+          callback(changed_voxels, resolution);
+    }
   }
   triggerSceneUpdateEvent(UPDATE_GEOMETRY);
 }
@@ -1321,6 +1352,32 @@ void PlanningSceneMonitor::clearUpdateCallbacks()
   update_callbacks_.clear();
 }
 
+void PlanningSceneMonitor::addOctomapChangeCallback(
+    const boost::function<void(const EigenSTL::vector_Vector3d&, double)>& fn)
+{
+  boost::mutex::scoped_lock lock(octomap_change_lock_);
+  if (!fn)
+    return;
+  octomap_change_callbacks_.push_back(fn);
+  if (octomap_monitor_)
+  {
+    collision_detection::OccMapTree::WriteLock tree_lock = octomap_monitor_->getOcTreePtr()->writing();
+    octomap_monitor_->getOcTreePtr()->enableChangeDetection(true);
+  }
+}
+
+void PlanningSceneMonitor::clearOctomapChangeCallbacks()
+{
+  boost::mutex::scoped_lock lock(octomap_change_lock_);
+  octomap_change_callbacks_.clear();
+  if (octomap_monitor_)
+  {
+    collision_detection::OccMapTree::WriteLock tree_lock = octomap_monitor_->getOcTreePtr()->writing();
+    octomap_monitor_->getOcTreePtr()->enableChangeDetection(false);
+    octomap_monitor_->getOcTreePtr()->resetChangeDetection();
+  }
+}
+
 void PlanningSceneMonitor::setPlanningScenePublishingFrequency(double hz)
 {
   publish_planning_scene_frequency_ = hz;
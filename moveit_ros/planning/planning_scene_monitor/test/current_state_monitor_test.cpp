@@ -47,6 +47,7 @@
 #include <moveit/planning_scene_monitor/current_state_monitor.h>
 #include <sensor_msgs/JointState.h>
 
+#include <atomic>
 #include <future>
 
 class CurrentStateMonitorTest : public ::testing::Test
@@ -188,6 +189,82 @@ TEST_F(CurrentStateMonitorTest, NonMonotonicTimeStampsDueToPartialJoints)
       << "older partial joint state was ignored in current state retrieval!";
 }
 
+TEST_F(CurrentStateMonitorTest, StateAtTime)
+{
+  EXPECT_FALSE(csm->getStateAtTime(js_ab.header.stamp)) << "empty history provided a state";
+
+  sendJointStateAndWait(js_ab);
+  moveit::core::RobotStatePtr state = csm->getStateAtTime(js_ab.header.stamp);
+  ASSERT_TRUE(state) << "state at the stamp of the only received message is not available";
+  EXPECT_EQ(js_ab.position[1], state->getVariablePosition("b-c-joint"));
+
+  js_ab.position = { 0.5, 0.7 };
+  js_ab.header.stamp = ros::Time{ 12.0 };
+  sendJointStateAndWait(js_ab);
+  state = csm->getStateAtTime(ros::Time{ 11.5 });
+  ASSERT_TRUE(state);
+  EXPECT_NEAR(0.4, state->getVariablePosition("a-b-joint"), 1e-9);
+  EXPECT_NEAR(0.5, state->getVariablePosition("b-c-joint"), 1e-9);
+
+  EXPECT_FALSE(csm->getStateAtTime(ros::Time{ 10.0 })) << "extrapolated before the oldest state";
+  EXPECT_FALSE(csm->getStateAtTime(ros::Time{ 12.5 })) << "extrapolated beyond the newest state";
+
+  // jumping back in time for a known joint resets the history
+  sendJointStateAndWait(js_b);
+  EXPECT_FALSE(csm->getStateAtTime(ros::Time{ 11.5 })) << "history was kept although time jumped back";
+  state = csm->getStateAtTime(js_b.header.stamp);
+  ASSERT_TRUE(state);
+  EXPECT_EQ(js_b.position[0], state->getVariablePosition("b-c-joint"));
+}
+
+TEST_F(CurrentStateMonitorTest, UpdateLatency)
+{
+  EXPECT_EQ(0u, csm->getUpdateLatency().samples);
+
+  sendJointStateAndWait(js_a);
+  sendJointStateAndWait(js_ab);
+  planning_scene_monitor::CurrentStateMonitor::UpdateLatency latency = csm->getUpdateLatency();
+  EXPECT_EQ(2u, latency.samples);
+  EXPECT_LE(latency.mean, latency.max);
+
+  csm->resetUpdateLatency();
+  EXPECT_EQ(0u, csm->getUpdateLatency().samples);
+}
+
+TEST_F(CurrentStateMonitorTest, AsyncUpdateCallbacks)
+{
+  csm->stopStateMonitor();
+  csm->enableAsyncUpdateCallbacks(true);
+
+  // a busy update callback doesn't delay incoming joint states
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> calls{ 0 };
+  csm->addUpdateCallback([&calls, released](const sensor_msgs::JointStateConstPtr& /*unused*/) {
+    ++calls;
+    released.wait();
+  });
+  csm->startStateMonitor();
+
+  auto wait_for_position = [this](double position) {
+    const ros::WallTime timeout = ros::WallTime::now() + ros::WallDuration(1.0);
+    while (csm->getCurrentState()->getVariablePosition("a-b-joint") != position && ros::WallTime::now() < timeout)
+      ros::WallDuration(0.01).sleep();
+    return csm->getCurrentState()->getVariablePosition("a-b-joint") == position;
+  };
+  joint_state_pub_.publish(js_a);
+  EXPECT_TRUE(wait_for_position(js_a.position[0]));
+  joint_state_pub_.publish(js_ab);
+  EXPECT_TRUE(wait_for_position(js_ab.position[0]));
+
+  // updates arriving while the callback is busy are merged
+  release.set_value();
+  csm->stopStateMonitor();
+  EXPECT_GE(calls, 1);
+  EXPECT_LE(calls, 2);
+  csm->clearUpdateCallbacks();
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
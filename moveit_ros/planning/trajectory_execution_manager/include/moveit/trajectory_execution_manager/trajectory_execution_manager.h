@@ -88,6 +88,12 @@ public:
   TrajectoryExecutionManager(const moveit::core::RobotModelConstPtr& robot_model,
                              const planning_scene_monitor::CurrentStateMonitorPtr& csm, bool manage_controllers);
 
+  /// Use the passed controller manager instead of loading the plugin, start listening for events on a topic.
+  TrajectoryExecutionManager(const moveit::core::RobotModelConstPtr& robot_model,
+                             const planning_scene_monitor::CurrentStateMonitorPtr& csm,
+                             const moveit_controller_manager::MoveItControllerManagerPtr& controller_manager,
+                             bool manage_controllers);
+
   /// Destructor. Cancels all running trajectories (if any)
   ~TrajectoryExecutionManager();
 
@@ -177,6 +183,16 @@ public:
   /// pushAndExecute().
   std::pair<int, int> getCurrentExpectedTrajectoryIndex() const;
 
+  /// Replace the not yet executed tail of the trajectory currently being executed, starting at the future instant
+  /// splice_time, without stopping the robot. The first point of the passed trajectory describes the state at
+  /// splice_time and needs to match the active trajectory at that instant in position and velocity (within the allowed
+  /// start and splice velocity tolerances). The trajectory must actuate the same joints as the active one and all
+  /// involved controllers must support splicing. A splice_time at the end of the active trajectory appends to it, e.g.
+  /// the segments of a trajectory_processing::StreamingTimeParameterization. Return false if the trajectory could not
+  /// be spliced; the active execution then continues unchanged, unless controllers failed after having spliced, which
+  /// aborts execution.
+  bool splice(const moveit_msgs::RobotTrajectory& trajectory, const ros::Time& splice_time);
+
   /// Return the controller status for the last attempted execution
   moveit_controller_manager::ExecutionStatus getLastExecutionStatus() const;
 
@@ -205,6 +221,9 @@ public:
   /// Set joint-value tolerance for validating trajectory's start point against current robot state
   void setAllowedStartTolerance(double tolerance);
 
+  /// Set joint-velocity tolerance for validating a spliced trajectory's first point against the active trajectory
+  void setAllowedSpliceVelocityTolerance(double tolerance);
+
   /// Enable or disable waiting for trajectory completion
   void setWaitForTrajectoryCompletion(bool flag);
 
@@ -233,6 +252,9 @@ private:
   bool validate(const TrajectoryExecutionContext& context) const;
   bool configure(TrajectoryExecutionContext& context, const moveit_msgs::RobotTrajectory& trajectory,
                  const std::vector<std::string>& controllers);
+  /// Validate first points of spliced trajectory parts against the active trajectory parts at splice_time
+  bool validateSplice(const TrajectoryExecutionContext& context, const std::vector<moveit_msgs::RobotTrajectory>& parts,
+                      const ros::Time& start_time, const ros::Time& splice_time) const;
 
   void updateControllersState(const ros::Duration& age);
   void updateControllerState(const std::string& controller, const ros::Duration& age);
@@ -266,6 +288,8 @@ private:
   void loadControllerParams();
 
   double getJointAllowedStartTolerance(std::string const& jointName) const;
+  double getAllowedExecutionDurationScaling(const std::string& controller) const;
+  double getAllowedGoalDurationMargin(const std::string& controller) const;
   void updateJointsAllowedStartTolerance();
 
   moveit::core::RobotModelConstPtr robot_model_;
@@ -291,6 +315,8 @@ private:
   int current_context_;
   std::vector<ros::Time> time_index_;  // used to find current expected trajectory location
   mutable boost::mutex time_index_mutex_;
+  ros::Time part_start_time_;     // time at which the current context was sent to the controllers
+  ros::Time execution_deadline_;  // time at which execution of the current context is considered timed out
   bool execution_complete_;
 
   std::vector<TrajectoryExecutionContext*> trajectories_;
@@ -315,6 +341,7 @@ private:
   double allowed_start_tolerance_;  // joint tolerance for validate(): radians for revolute joints
   // tolerance per joint, overrides global allowed_start_tolerance_.
   std::map<std::string, double> joints_allowed_start_tolerance_;
+  double allowed_splice_velocity_tolerance_;  // joint velocity tolerance for validateSplice()
   double execution_velocity_scaling_;
   bool wait_for_trajectory_completion_;
 };
@@ -100,6 +100,18 @@ TrajectoryExecutionManager::TrajectoryExecutionManager(const moveit::core::Robot
   initialize();
 }
 
+TrajectoryExecutionManager::TrajectoryExecutionManager(
+    const moveit::core::RobotModelConstPtr& robot_model, const planning_scene_monitor::CurrentStateMonitorPtr& csm,
+    const moveit_controller_manager::MoveItControllerManagerPtr& controller_manager, bool manage_controllers)
+  : robot_model_(robot_model)
+  , csm_(csm)
+  , node_handle_("~")
+  , manage_controllers_(manage_controllers)
+  , controller_manager_(controller_manager)
+{
+  initialize();
+}
+
 TrajectoryExecutionManager::~TrajectoryExecutionManager()
 {
   stopExecution(true);
@@ -117,6 +129,7 @@ void TrajectoryExecutionManager::initialize()
   execution_velocity_scaling_ = 1.0;
   allowed_start_tolerance_ = 0.01;
   joints_allowed_start_tolerance_.clear();
+  allowed_splice_velocity_tolerance_ = 0.01;
 
   allowed_execution_duration_scaling_ = DEFAULT_CONTROLLER_GOAL_DURATION_SCALING;
   allowed_goal_duration_margin_ = DEFAULT_CONTROLLER_GOAL_DURATION_MARGIN;
@@ -124,49 +137,52 @@ void TrajectoryExecutionManager::initialize()
   // load controller-specific values for allowed_execution_duration_scaling and allowed_goal_duration_margin
   loadControllerParams();
 
-  // load the controller manager plugin
-  try
-  {
-    controller_manager_loader_ =
-        std::make_unique<pluginlib::ClassLoader<moveit_controller_manager::MoveItControllerManager>>(
-            "moveit_core", "moveit_controller_manager::MoveItControllerManager");
-  }
-  catch (pluginlib::PluginlibException& ex)
-  {
-    ROS_FATAL_STREAM_NAMED(LOGNAME, "Exception while creating controller manager plugin loader: " << ex.what());
-    return;
-  }
-
-  if (controller_manager_loader_)
+  // load the controller manager plugin, unless one was passed to the constructor
+  if (!controller_manager_)
   {
-    std::string controller;
-    if (!node_handle_.getParam("moveit_controller_manager", controller))
+    try
     {
-      const std::vector<std::string>& classes = controller_manager_loader_->getDeclaredClasses();
-      if (classes.size() == 1)
-      {
-        controller = classes[0];
-        ROS_WARN_NAMED(LOGNAME,
-                       "Parameter '~moveit_controller_manager' is not specified but only one "
-                       "matching plugin was found: '%s'. Using that one.",
-                       controller.c_str());
-      }
-      else
-        ROS_FATAL_NAMED(LOGNAME, "Parameter '~moveit_controller_manager' not specified. This is needed to "
-                                 "identify the plugin to use for interacting with controllers. No paths can "
-                                 "be executed.");
+      controller_manager_loader_ =
+          std::make_unique<pluginlib::ClassLoader<moveit_controller_manager::MoveItControllerManager>>(
+              "moveit_core", "moveit_controller_manager::MoveItControllerManager");
+    }
+    catch (pluginlib::PluginlibException& ex)
+    {
+      ROS_FATAL_STREAM_NAMED(LOGNAME, "Exception while creating controller manager plugin loader: " << ex.what());
+      return;
     }
 
-    if (!controller.empty())
-      try
-      {
-        controller_manager_ = controller_manager_loader_->createUniqueInstance(controller);
-      }
-      catch (pluginlib::PluginlibException& ex)
+    if (controller_manager_loader_)
+    {
+      std::string controller;
+      if (!node_handle_.getParam("moveit_controller_manager", controller))
       {
-        ROS_FATAL_STREAM_NAMED(LOGNAME,
-                               "Exception while loading controller manager '" << controller << "': " << ex.what());
+        const std::vector<std::string>& classes = controller_manager_loader_->getDeclaredClasses();
+        if (classes.size() == 1)
+        {
+          controller = classes[0];
+          ROS_WARN_NAMED(LOGNAME,
+                         "Parameter '~moveit_controller_manager' is not specified but only one "
+                         "matching plugin was found: '%s'. Using that one.",
+                         controller.c_str());
+        }
+        else
+          ROS_FATAL_NAMED(LOGNAME, "Parameter '~moveit_controller_manager' not specified. This is needed to "
+                                   "identify the plugin to use for interacting with controllers. No paths can "
+                                   "be executed.");
       }
+
+      if (!controller.empty())
+        try
+        {
+          controller_manager_ = controller_manager_loader_->createUniqueInstance(controller);
+        }
+        catch (pluginlib::PluginlibException& ex)
+        {
+          ROS_FATAL_STREAM_NAMED(LOGNAME,
+                                 "Exception while loading controller manager '" << controller << "': " << ex.what());
+        }
+    }
   }
 
   // other configuration steps
@@ -210,6 +226,11 @@ void TrajectoryExecutionManager::setAllowedStartTolerance(double tolerance)
   allowed_start_tolerance_ = tolerance;
 }
 
+void TrajectoryExecutionManager::setAllowedSpliceVelocityTolerance(double tolerance)
+{
+  allowed_splice_velocity_tolerance_ = tolerance;
+}
+
 void TrajectoryExecutionManager::setWaitForTrajectoryCompletion(bool flag)
 {
   wait_for_trajectory_completion_ = flag;
@@ -819,6 +840,133 @@ bool TrajectoryExecutionManager::validate(const TrajectoryExecutionContext& cont
   return true;
 }
 
+namespace
+{
+// Sample positions and velocities of a joint trajectory at time t after its start. Like most trajectory controllers,
+// interpolate cubically between waypoints specifying velocities and linearly otherwise.
+void sampleJointTrajectory(const trajectory_msgs::JointTrajectory& trajectory, const ros::Duration& t,
+                           std::vector<double>& positions, std::vector<double>& velocities)
+{
+  const std::vector<trajectory_msgs::JointTrajectoryPoint>& points = trajectory.points;
+  auto next = std::lower_bound(points.begin(), points.end(), t,
+                               [](const trajectory_msgs::JointTrajectoryPoint& point, const ros::Duration& time) {
+                                 return point.time_from_start < time;
+                               });
+  if (next == points.begin() || next == points.end())
+  {
+    const trajectory_msgs::JointTrajectoryPoint& point = next == points.end() ? points.back() : *next;
+    positions = point.positions;
+    velocities = point.velocities;
+    velocities.resize(positions.size(), 0.0);
+    return;
+  }
+
+  const trajectory_msgs::JointTrajectoryPoint& prev = *(next - 1);
+  const double h = (next->time_from_start - prev.time_from_start).toSec();
+  const double s = (t - prev.time_from_start).toSec() / h;
+  const bool cubic = !prev.velocities.empty() && !next->velocities.empty();
+  positions.resize(prev.positions.size());
+  velocities.resize(prev.positions.size());
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    const double p0 = prev.positions[i];
+    const double p1 = next->positions[i];
+    if (cubic)
+    {
+      // Hermite basis functions and their derivatives w.r.t. s
+      const double v0 = prev.velocities[i] * h;
+      const double v1 = next->velocities[i] * h;
+      const double s2 = s * s;
+      const double s3 = s2 * s;
+      positions[i] = (2 * s3 - 3 * s2 + 1) * p0 + (s3 - 2 * s2 + s) * v0 + (3 * s2 - 2 * s3) * p1 + (s3 - s2) * v1;
+      velocities[i] =
+          ((6 * s2 - 6 * s) * p0 + (3 * s2 - 4 * s + 1) * v0 + (6 * s - 6 * s2) * p1 + (3 * s2 - 2 * s) * v1) / h;
+    }
+    else
+    {
+      positions[i] = p0 + s * (p1 - p0);
+      velocities[i] = (p1 - p0) / h;
+    }
+  }
+}
+}  // namespace
+
+bool TrajectoryExecutionManager::validateSplice(const TrajectoryExecutionContext& context,
+                                                const std::vector<moveit_msgs::RobotTrajectory>& parts,
+                                                const ros::Time& start_time, const ros::Time& splice_time) const
+{
+  std::vector<double> positions, velocities;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    const trajectory_msgs::JointTrajectory& active = context.trajectory_parts_[i].joint_trajectory;
+    const trajectory_msgs::JointTrajectory& spliced = parts[i].joint_trajectory;
+    if (spliced.joint_names.empty())
+      continue;
+
+    // splicing at the very end of the active trajectory appends to it
+    const ros::Duration t = splice_time - std::max(active.header.stamp, start_time);
+    if (active.points.empty() || t > active.points.back().time_from_start)
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Cannot splice: the trajectory of controller '%s' ends before the splice time",
+                      context.controllers_[i].c_str());
+      return false;
+    }
+
+    const trajectory_msgs::JointTrajectoryPoint& first = spliced.points.front();
+    if (first.positions.size() != spliced.joint_names.size())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Wrong trajectory: #joints: %zu != #positions: %zu", spliced.joint_names.size(),
+                      first.positions.size());
+      return false;
+    }
+    if (!first.velocities.empty() && first.velocities.size() != spliced.joint_names.size())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Wrong trajectory: #joints: %zu != #velocities: %zu", spliced.joint_names.size(),
+                      first.velocities.size());
+      return false;
+    }
+
+    sampleJointTrajectory(active, t, positions, velocities);
+    for (std::size_t j = 0; j < spliced.joint_names.size(); ++j)
+    {
+      const moveit::core::JointModel* jm = robot_model_->getJointModel(spliced.joint_names[j]);
+      if (!jm)
+      {
+        ROS_ERROR_STREAM_NAMED(LOGNAME, "Unknown joint in trajectory: " << spliced.joint_names[j]);
+        return false;
+      }
+
+      double active_position = positions[j];
+      double spliced_position = first.positions[j];
+      double joint_tolerance = getJointAllowedStartTolerance(spliced.joint_names[j]);
+      // normalize positions and compare
+      jm->enforcePositionBounds(&active_position);
+      jm->enforcePositionBounds(&spliced_position);
+      if (joint_tolerance != 0 && jm->distance(&active_position, &spliced_position) > joint_tolerance)
+      {
+        ROS_ERROR_NAMED(LOGNAME,
+                        "\nInvalid Trajectory: splice point deviates from active trajectory more than %g"
+                        "\njoint '%s': expected: %g, active: %g",
+                        joint_tolerance, spliced.joint_names[j].c_str(), spliced_position, active_position);
+        return false;
+      }
+
+      double spliced_velocity = first.velocities.empty() ? 0.0 : first.velocities[j];
+      if (allowed_splice_velocity_tolerance_ != 0 &&
+          fabs(spliced_velocity - velocities[j]) > allowed_splice_velocity_tolerance_)
+      {
+        ROS_ERROR_NAMED(LOGNAME,
+                        "\nInvalid Trajectory: splice velocity deviates from active trajectory more than %g"
+                        "\njoint '%s': expected: %g, active: %g",
+                        allowed_splice_velocity_tolerance_, spliced.joint_names[j].c_str(), spliced_velocity,
+                        velocities[j]);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool TrajectoryExecutionManager::configure(TrajectoryExecutionContext& context,
                                            const moveit_msgs::RobotTrajectory& trajectory,
                                            const std::vector<std::string>& controllers)
@@ -1215,26 +1363,20 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
           longest_part = i;
       }
 
-      // prefer controller-specific values over global ones if defined
-      // TODO: the controller-specific parameters are static, but override
-      //       the global ones are configurable via dynamic reconfigure
-      std::map<std::string, double>::const_iterator scaling_it =
-          controller_allowed_execution_duration_scaling_.find(context.controllers_[i]);
-      const double current_scaling = scaling_it != controller_allowed_execution_duration_scaling_.end() ?
-                                         scaling_it->second :
-                                         allowed_execution_duration_scaling_;
-
-      std::map<std::string, double>::const_iterator margin_it =
-          controller_allowed_goal_duration_margin_.find(context.controllers_[i]);
-      const double current_margin = margin_it != controller_allowed_goal_duration_margin_.end() ?
-                                        margin_it->second :
-                                        allowed_goal_duration_margin_;
+      const double current_scaling = getAllowedExecutionDurationScaling(context.controllers_[i]);
+      const double current_margin = getAllowedGoalDurationMargin(context.controllers_[i]);
 
       // expected duration is the duration of the longest part
       expected_trajectory_duration =
           std::max(d * current_scaling + ros::Duration(current_margin), expected_trajectory_duration);
     }
 
+    {
+      boost::mutex::scoped_lock slock(time_index_mutex_);
+      part_start_time_ = current_time;
+      execution_deadline_ = current_time + expected_trajectory_duration;
+    }
+
     // construct a map from expected time to state index, for easy access to expected state location
     if (longest_part >= 0)
     {
@@ -1266,22 +1408,36 @@ bool TrajectoryExecutionManager::executePart(std::size_t part_index)
     {
       if (execution_duration_monitoring_)
       {
-        if (!handle->waitForExecution(expected_trajectory_duration))
-          if (!execution_complete_ && ros::Time::now() - current_time > expected_trajectory_duration)
+        // keep waiting while splice() postpones the deadline
+        ros::Time deadline = current_time + expected_trajectory_duration;
+        bool done = handle->waitForExecution(expected_trajectory_duration);
+        while (!done && !execution_complete_)
+        {
+          ros::Duration remaining;
           {
-            ROS_ERROR_NAMED(LOGNAME,
-                            "Controller is taking too long to execute trajectory (the expected upper "
-                            "bound for the trajectory execution was %lf seconds). Stopping trajectory.",
-                            expected_trajectory_duration.toSec());
-            {
-              boost::mutex::scoped_lock slock(execution_state_mutex_);
-              stopExecutionInternal();  // this is really tricky. we can't call stopExecution() here, so we call the
-                                        // internal function only
-            }
-            last_execution_status_ = moveit_controller_manager::ExecutionStatus::TIMED_OUT;
-            result = false;
+            boost::mutex::scoped_lock slock(time_index_mutex_);
+            deadline = execution_deadline_;
+            remaining = deadline - ros::Time::now();
+          }
+          if (remaining <= ros::Duration(0.0))
             break;
+          done = handle->waitForExecution(remaining);
+        }
+        if (!done && !execution_complete_)
+        {
+          ROS_ERROR_NAMED(LOGNAME,
+                          "Controller is taking too long to execute trajectory (the expected upper "
+                          "bound for the trajectory execution was %lf seconds). Stopping trajectory.",
+                          (deadline - current_time).toSec());
+          {
+            boost::mutex::scoped_lock slock(execution_state_mutex_);
+            stopExecutionInternal();  // this is really tricky. we can't call stopExecution() here, so we call the
+                                      // internal function only
           }
+          last_execution_status_ = moveit_controller_manager::ExecutionStatus::TIMED_OUT;
+          result = false;
+          break;
+        }
       }
       else
         handle->waitForExecution();
@@ -1394,6 +1550,120 @@ std::pair<int, int> TrajectoryExecutionManager::getCurrentExpectedTrajectoryInde
   return std::make_pair((int)current_context_, pos);
 }
 
+bool TrajectoryExecutionManager::splice(const moveit_msgs::RobotTrajectory& trajectory, const ros::Time& splice_time)
+{
+  if (trajectory.joint_trajectory.points.empty())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Cannot splice an empty trajectory");
+    return false;
+  }
+  if (!trajectory.multi_dof_joint_trajectory.points.empty())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Splicing multi-dof trajectories is not supported");
+    return false;
+  }
+
+  boost::mutex::scoped_lock slock(execution_state_mutex_);
+  ros::Time start_time;
+  {
+    // the time index is available once all trajectory parts are sent to the controllers
+    boost::mutex::scoped_lock tlock(time_index_mutex_);
+    if (execution_complete_ || current_context_ < 0 || active_handles_.empty() || time_index_.empty())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Cannot splice a trajectory while no trajectory is being executed");
+      return false;
+    }
+    start_time = part_start_time_;
+  }
+  if (splice_time <= ros::Time::now())
+  {
+    ROS_ERROR_NAMED(LOGNAME, "Cannot splice a trajectory at a time in the past");
+    return false;
+  }
+
+  TrajectoryExecutionContext& context = *trajectories_[current_context_];
+  std::vector<moveit_msgs::RobotTrajectory> parts;
+  if (!distributeTrajectory(trajectory, context.controllers_, parts))
+    return false;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    // distributeTrajectory() sorts joint names, so the parts are comparable
+    if (parts[i].joint_trajectory.joint_names != context.trajectory_parts_[i].joint_trajectory.joint_names ||
+        !context.trajectory_parts_[i].multi_dof_joint_trajectory.points.empty())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "A spliced trajectory needs to actuate the same joints as the active one");
+      return false;
+    }
+    if (!active_handles_[i]->supportsTrajectorySplicing())
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Controller '%s' does not support trajectory splicing",
+                      active_handles_[i]->getName().c_str());
+      return false;
+    }
+  }
+  if (!validateSplice(context, parts, start_time, splice_time))
+    return false;
+
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    parts[i].joint_trajectory.header.stamp = splice_time;
+    bool ok = false;
+    try
+    {
+      ok = active_handles_[i]->spliceTrajectory(parts[i]);
+    }
+    catch (std::exception& ex)
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Caught %s when splicing trajectory", ex.what());
+    }
+    if (!ok)
+    {
+      ROS_ERROR_NAMED(LOGNAME, "Failed to splice trajectory part %zu of %zu into controller %s", i + 1, parts.size(),
+                      active_handles_[i]->getName().c_str());
+      if (i > 0)
+      {
+        // the controllers would not execute a consistent motion anymore
+        ROS_ERROR_NAMED(LOGNAME, "Stopping execution as previous trajectory parts were spliced already");
+        execution_complete_ = true;
+        stopExecutionInternal();
+        last_execution_status_ = moveit_controller_manager::ExecutionStatus::ABORTED;
+      }
+      return false;
+    }
+  }
+
+  // keep the context in sync with what the controllers execute: the active trajectory up to splice_time followed by
+  // the spliced one
+  ros::Time deadline = splice_time;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+  {
+    trajectory_msgs::JointTrajectory& active = context.trajectory_parts_[i].joint_trajectory;
+    const ros::Duration offset = splice_time - std::max(active.header.stamp, start_time);
+    active.points.erase(std::lower_bound(active.points.begin(), active.points.end(), offset,
+                                         [](const trajectory_msgs::JointTrajectoryPoint& point,
+                                            const ros::Duration& t) { return point.time_from_start < t; }),
+                        active.points.end());
+    for (trajectory_msgs::JointTrajectoryPoint& point : parts[i].joint_trajectory.points)
+    {
+      point.time_from_start += offset;
+      active.points.push_back(point);
+    }
+
+    const ros::Duration d = trajectory.joint_trajectory.points.back().time_from_start;
+    deadline = std::max(deadline, splice_time + d * getAllowedExecutionDurationScaling(context.controllers_[i]) +
+                                      ros::Duration(getAllowedGoalDurationMargin(context.controllers_[i])));
+  }
+
+  boost::mutex::scoped_lock tlock(time_index_mutex_);
+  time_index_.erase(std::lower_bound(time_index_.begin(), time_index_.end(), splice_time), time_index_.end());
+  for (const trajectory_msgs::JointTrajectoryPoint& point : trajectory.joint_trajectory.points)
+    time_index_.push_back(splice_time + point.time_from_start);
+  execution_deadline_ = deadline;
+
+  ROS_DEBUG_NAMED(LOGNAME, "Spliced trajectory at t = %.3f", splice_time.toSec());
+  return true;
+}
+
 const std::vector<TrajectoryExecutionManager::TrajectoryExecutionContext*>&
 TrajectoryExecutionManager::getTrajectories() const
 {
@@ -1571,6 +1841,23 @@ double TrajectoryExecutionManager::getJointAllowedStartTolerance(std::string con
                                                                        allowed_start_tolerance_;
 }
 
+double TrajectoryExecutionManager::getAllowedExecutionDurationScaling(const std::string& controller) const
+{
+  // prefer controller-specific values over global ones if defined
+  // TODO: the controller-specific parameters are static, but override
+  //       the global ones are configurable via dynamic reconfigure
+  auto scaling_it = controller_allowed_execution_duration_scaling_.find(controller);
+  return scaling_it != controller_allowed_execution_duration_scaling_.end() ? scaling_it->second :
+                                                                              allowed_execution_duration_scaling_;
+}
+
+double TrajectoryExecutionManager::getAllowedGoalDurationMargin(const std::string& controller) const
+{
+  auto margin_it = controller_allowed_goal_duration_margin_.find(controller);
+  return margin_it != controller_allowed_goal_duration_margin_.end() ? margin_it->second :
+                                                                       allowed_goal_duration_margin_;
+}
+
 void TrajectoryExecutionManager::updateJointsAllowedStartTolerance()
 {
   joints_allowed_start_tolerance_.clear();
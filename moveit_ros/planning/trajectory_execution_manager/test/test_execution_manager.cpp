@@ -48,8 +48,132 @@
 // Msgs
 #include <geometry_msgs/PointStamped.h>
 
+#include <moveit/controller_manager/controller_manager.h>
+#include <moveit/trajectory_execution_manager/trajectory_execution_manager.h>
+#include <moveit/trajectory_processing/streaming_time_parameterization.h>
+#include <mutex>
+
 namespace moveit_cpp
 {
+/** Controller handle that pretends to execute trajectories in real time and supports splicing */
+class SplicingControllerHandle : public moveit_controller_manager::MoveItControllerHandle
+{
+public:
+  SplicingControllerHandle() : MoveItControllerHandle("splicing_controller")
+  {
+  }
+
+  bool sendTrajectory(const moveit_msgs::RobotTrajectory& trajectory) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const trajectory_msgs::JointTrajectory& joint_trajectory = trajectory.joint_trajectory;
+    end_ = std::max(joint_trajectory.header.stamp, ros::Time::now()) + joint_trajectory.points.back().time_from_start;
+    cancelled_ = false;
+    return true;
+  }
+
+  bool supportsTrajectorySplicing() const override
+  {
+    return true;
+  }
+
+  bool spliceTrajectory(const moveit_msgs::RobotTrajectory& trajectory) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const trajectory_msgs::JointTrajectory& joint_trajectory = trajectory.joint_trajectory;
+    end_ = joint_trajectory.header.stamp + joint_trajectory.points.back().time_from_start;
+    spliced_.push_back(trajectory);
+    return true;
+  }
+
+  bool cancelExecution() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    return true;
+  }
+
+  bool waitForExecution(const ros::Duration& timeout = ros::Duration(0)) override
+  {
+    const ros::Time deadline = timeout.isZero() ? ros::TIME_MAX : ros::Time::now() + timeout;
+    while (ros::ok())
+    {
+      const ros::Time now = ros::Time::now();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cancelled_ || now >= end_)
+          return true;
+      }
+      if (now >= deadline)
+        return false;
+      ros::Duration(0.01).sleep();
+    }
+    return false;
+  }
+
+  moveit_controller_manager::ExecutionStatus getLastExecutionStatus() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cancelled_ ? moveit_controller_manager::ExecutionStatus::PREEMPTED :
+                        moveit_controller_manager::ExecutionStatus::SUCCEEDED;
+  }
+
+  std::vector<moveit_msgs::RobotTrajectory> getSplicedTrajectories()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spliced_;
+  }
+
+private:
+  std::mutex mutex_;
+  ros::Time end_;
+  bool cancelled_ = false;
+  std::vector<moveit_msgs::RobotTrajectory> spliced_;
+};
+
+/** Controller manager with a single active controller for panda_joint1 that supports splicing */
+class SplicingControllerManager : public moveit_controller_manager::MoveItControllerManager
+{
+public:
+  moveit_controller_manager::MoveItControllerHandlePtr getControllerHandle(const std::string& name) override
+  {
+    return name == handle_->getName() ? handle_ : moveit_controller_manager::MoveItControllerHandlePtr();
+  }
+
+  void getControllersList(std::vector<std::string>& names) override
+  {
+    names = { handle_->getName() };
+  }
+
+  void getActiveControllers(std::vector<std::string>& names) override
+  {
+    names = { handle_->getName() };
+  }
+
+  void getControllerJoints(const std::string& name, std::vector<std::string>& joints) override
+  {
+    joints.clear();
+    if (name == handle_->getName())
+      joints.push_back("panda_joint1");
+  }
+
+  ControllerState getControllerState(const std::string& /*name*/) override
+  {
+    ControllerState state;
+    state.active_ = true;
+    state.default_ = true;
+    return state;
+  }
+
+  bool switchControllers(const std::vector<std::string>& /*activate*/,
+                         const std::vector<std::string>& /*deactivate*/) override
+  {
+    return true;
+  }
+
+  std::shared_ptr<SplicingControllerHandle> handle_ = std::make_shared<SplicingControllerHandle>();
+};
+
 class MoveItCppTest : public ::testing::Test
 {
 public:
@@ -158,6 +282,177 @@ TEST_F(MoveItCppTest, DoNotValidateJointStartToleranceZero)
   ASSERT_EQ(last_execution_status, moveit_controller_manager::ExecutionStatus::SUCCEEDED);
 }
 
+TEST_F(MoveItCppTest, RejectSpliceWithoutActiveExecution)
+{
+  ASSERT_FALSE(trajectory_execution_manager_ptr->splice(traj1, ros::Time::now() + ros::Duration(0.1)));
+}
+
+TEST_F(MoveItCppTest, RejectSpliceIntoUnsupportedController)
+{
+  moveit_msgs::RobotTrajectory traj = traj1;
+  traj.joint_trajectory.points[1].time_from_start.fromSec(2.0);
+  trajectory_execution_manager_ptr->setAllowedStartTolerance(0);
+  ASSERT_TRUE(trajectory_execution_manager_ptr->push(traj));
+  trajectory_execution_manager_ptr->execute();
+
+  // the fake controllers don't support splicing, so execution continues unchanged
+  ros::Duration(0.5).sleep();
+  moveit_msgs::RobotTrajectory tail = traj1;
+  tail.joint_trajectory.points[0].positions[0] = 0.25;
+  tail.joint_trajectory.points[1].positions[0] = 0.0;
+  EXPECT_FALSE(trajectory_execution_manager_ptr->splice(tail, ros::Time::now() + ros::Duration(0.5)));
+  ASSERT_EQ(trajectory_execution_manager_ptr->waitForExecution(),
+            moveit_controller_manager::ExecutionStatus::SUCCEEDED);
+}
+
+TEST_F(MoveItCppTest, SpliceIntoSupportingController)
+{
+  auto controller_manager = std::make_shared<SplicingControllerManager>();
+  trajectory_execution_manager::TrajectoryExecutionManager tem(
+      moveit_cpp_ptr->getRobotModel(), moveit_cpp_ptr->getPlanningSceneMonitorNonConst()->getStateMonitor(),
+      controller_manager, false);
+  moveit::core::RobotStatePtr current_state = moveit_cpp_ptr->getCurrentState(1.0);
+  ASSERT_TRUE(current_state);
+  const double start = current_state->getVariablePosition("panda_joint1");
+
+  // move panda_joint1 by 1 rad within 2 s, from rest to rest
+  moveit_msgs::RobotTrajectory traj;
+  traj.joint_trajectory.joint_names.push_back("panda_joint1");
+  traj.joint_trajectory.header.stamp = ros::Time::now() + ros::Duration(0.5);
+  traj.joint_trajectory.points.resize(2);
+  traj.joint_trajectory.points[0].positions = { start };
+  traj.joint_trajectory.points[0].velocities = { 0.0 };
+  traj.joint_trajectory.points[1].positions = { start + 1.0 };
+  traj.joint_trajectory.points[1].velocities = { 0.0 };
+  traj.joint_trajectory.points[1].time_from_start.fromSec(2.0);
+  const ros::Time splice_time = traj.joint_trajectory.header.stamp + ros::Duration(1.0);
+
+  ASSERT_TRUE(tem.push(traj));
+  tem.execute();
+  // splicing is possible once the trajectory is sent to the controller
+  while (tem.getCurrentExpectedTrajectoryIndex().second < 0 && ros::Time::now() < splice_time)
+    ros::Duration(0.01).sleep();
+
+  // half way, the cubic motion is at start + 0.5 rad and moves with 0.75 rad/s (not the average 0.5 rad/s)
+  moveit_msgs::RobotTrajectory tail;
+  tail.joint_trajectory.joint_names.push_back("panda_joint1");
+  tail.joint_trajectory.points.resize(4);
+  const std::vector<double> positions = { start + 0.5, start + 1.1, start + 1.3, start + 1.3 };
+  const std::vector<double> velocities = { 0.75, 0.4, 0.1, 0.0 };
+  for (std::size_t i = 0; i < tail.joint_trajectory.points.size(); ++i)
+  {
+    tail.joint_trajectory.points[i].positions = { positions[i] };
+    tail.joint_trajectory.points[i].velocities = { velocities[i] };
+    tail.joint_trajectory.points[i].time_from_start.fromSec(i);
+  }
+
+  // tails that don't continue the active motion are rejected
+  moveit_msgs::RobotTrajectory jump = tail;
+  jump.joint_trajectory.points[0].positions[0] += 0.05;
+  EXPECT_FALSE(tem.splice(jump, splice_time));
+  moveit_msgs::RobotTrajectory linear = tail;
+  linear.joint_trajectory.points[0].velocities[0] = 0.5;
+  EXPECT_FALSE(tem.splice(linear, splice_time));
+  EXPECT_TRUE(controller_manager->handle_->getSplicedTrajectories().empty());
+
+  ASSERT_TRUE(tem.splice(tail, splice_time));
+  const std::vector<moveit_msgs::RobotTrajectory> spliced = controller_manager->handle_->getSplicedTrajectories();
+  ASSERT_EQ(spliced.size(), 1u);
+  EXPECT_EQ(spliced[0].joint_trajectory.header.stamp, splice_time);
+  EXPECT_EQ(spliced[0].joint_trajectory.points, tail.joint_trajectory.points);
+
+  // the context continues with the tail after the splice time
+  const trajectory_msgs::JointTrajectory& part = tem.getTrajectories().at(0)->trajectory_parts_.at(0).joint_trajectory;
+  ASSERT_EQ(part.points.size(), 5u);
+  EXPECT_EQ(part.points[0], traj.joint_trajectory.points[0]);
+  for (std::size_t i = 0; i < tail.joint_trajectory.points.size(); ++i)
+  {
+    EXPECT_EQ(part.points[i + 1].positions, tail.joint_trajectory.points[i].positions);
+    EXPECT_EQ(part.points[i + 1].time_from_start, ros::Duration(1.0) + tail.joint_trajectory.points[i].time_from_start);
+  }
+
+  // the time index follows the tail: between its second and third point, the third one is expected next
+  ros::Time::sleepUntil(splice_time + ros::Duration(1.5));
+  EXPECT_EQ(tem.getCurrentExpectedTrajectoryIndex(), std::make_pair(0, 3));
+
+  // the tail ends after the deadline of the original trajectory, which is postponed
+  EXPECT_EQ(tem.waitForExecution(), moveit_controller_manager::ExecutionStatus::SUCCEEDED);
+  EXPECT_GE(ros::Time::now(), splice_time + ros::Duration(3.0));
+}
+
+TEST_F(MoveItCppTest, SpliceStreamedSegments)
+{
+  auto controller_manager = std::make_shared<SplicingControllerManager>();
+  trajectory_execution_manager::TrajectoryExecutionManager tem(
+      moveit_cpp_ptr->getRobotModel(), moveit_cpp_ptr->getPlanningSceneMonitorNonConst()->getStateMonitor(),
+      controller_manager, false);
+  moveit::core::RobotStatePtr current_state = moveit_cpp_ptr->getCurrentState(1.0);
+  ASSERT_TRUE(current_state);
+  current_state->zeroVelocities();
+  current_state->zeroAccelerations();
+  const double start = current_state->getVariablePosition("panda_joint1");
+
+  // stream a motion of panda_joint1 by 0.6 rad, only the splicing controller's joint is executed
+  const moveit::core::JointModelGroup* group = current_state->getJointModelGroup("panda_arm");
+  trajectory_processing::StreamingTimeParameterization streamer(group, 3, 0.2, 0.2);
+  streamer.reset(*current_state);
+  const std::vector<std::string> joints = { "panda_joint1" };
+  moveit::core::RobotState waypoint(*current_state);
+  robot_trajectory::RobotTrajectory segment(moveit_cpp_ptr->getRobotModel(), group);
+  moveit_msgs::RobotTrajectory msg;
+
+  // execute the first segment, with some lead time for splicing the following ones
+  const ros::Time stamp = ros::Time::now() + ros::Duration(1.0);
+  std::size_t next = 1;
+  const std::size_t waypoints = 12;
+  for (; next <= waypoints && !streamer.getSegment(segment); ++next)
+  {
+    waypoint.setVariablePosition("panda_joint1", start + 0.6 * next / waypoints);
+    ASSERT_TRUE(streamer.addWayPoint(waypoint));
+  }
+  ASSERT_FALSE(segment.empty());
+  segment.getRobotTrajectoryMsg(msg, joints);
+  msg.joint_trajectory.header.stamp = stamp;
+  ASSERT_TRUE(tem.push(msg));
+  tem.execute();
+  while (tem.getCurrentExpectedTrajectoryIndex().second < 0 && ros::Time::now() < stamp)
+    ros::Duration(0.01).sleep();
+  double stream_time = segment.getDuration();
+
+  // append each following segment at the end of the previous ones
+  std::size_t spliced = 0;
+  for (; next <= waypoints + 1; ++next)
+  {
+    if (next <= waypoints)
+    {
+      waypoint.setVariablePosition("panda_joint1", start + 0.6 * next / waypoints);
+      ASSERT_TRUE(streamer.addWayPoint(waypoint));
+    }
+    else
+      ASSERT_TRUE(streamer.finish());
+
+    if (!streamer.getSegment(segment))
+      continue;
+    segment.getRobotTrajectoryMsg(msg, joints);
+    ASSERT_TRUE(tem.splice(msg, stamp + ros::Duration(stream_time)));
+    stream_time += segment.getDuration();
+    ++spliced;
+  }
+  EXPECT_TRUE(streamer.isDone());
+  EXPECT_EQ(controller_manager->handle_->getSplicedTrajectories().size(), spliced);
+  EXPECT_GT(spliced, 0u);
+
+  // the context ends at rest at the last waypoint after the duration of the whole stream
+  const trajectory_msgs::JointTrajectory& part = tem.getTrajectories().at(0)->trajectory_parts_.at(0).joint_trajectory;
+  EXPECT_NEAR(part.points.back().positions.at(0), start + 0.6, 1e-6);
+  EXPECT_NEAR(part.points.back().velocities.at(0), 0.0, 1e-6);
+  EXPECT_NEAR(part.points.back().time_from_start.toSec(), stream_time, 1e-6);
+  EXPECT_NEAR(stream_time, streamer.getDuration(), 1e-6);
+
+  EXPECT_EQ(tem.waitForExecution(), moveit_controller_manager::ExecutionStatus::SUCCEEDED);
+  EXPECT_GE(ros::Time::now(), stamp + ros::Duration(stream_time));
+}
+
 }  // namespace moveit_cpp
 
 int main(int argc, char** argv)